@@ -0,0 +1,19 @@
+include(cmake/LunaUtils.cmake)
+
+set(BENCHMARKS
+  Audio/Dsp
+  Audio/Resampler
+  Audio/VoiceMixer
+  Endian
+  Image/ImageDecoder
+)
+
+foreach(bench_name ${BENCHMARKS})
+  string(REPLACE "/" "_" BENCH_TARGET_NAME "${bench_name}.bench")
+  add_executable(${BENCH_TARGET_NAME} libluna/${bench_name}.bench.cpp)
+
+  add_dependencies(${BENCH_TARGET_NAME} luna)
+  target_link_libraries(${BENCH_TARGET_NAME} PRIVATE luna)
+
+  luna_make_rom(${BENCH_TARGET_NAME})
+endforeach()
@@ -1,5 +1,6 @@
 option(LUNA_BUILD_TESTS "Build tests" ON)
 option(LUNA_BUILD_EXAMPLES "Build examples" ON)
+option(LUNA_BUILD_BENCHMARKS "Build benchmarks" OFF)
 
 set(LUNA_WINDOW ${LUNA_DEFAULT_WINDOW} CACHE STRING "Choose one of: sdl2, glfw, egl, none")
 set_property(CACHE LUNA_WINDOW PROPERTY STRINGS "sdl2;glfw;egl;none")
@@ -22,5 +23,6 @@ option(LUNA_AUDIO_SDL2 "Enable audio via SDL2" ${LUNA_SUPPORTS_SDL2})
 option(LUNA_IMGUI "Enable ImGui" ${SUPPORTS_IMGUI})
 option(LUNA_STD_THREAD "Enable threading using std::thread" ${SUPPORTS_STD_THREAD})
 option(LUNA_GLM "Enable GLM support" ${SUPPORTS_GLM})
+option(LUNA_ALLOCATION_GUARD "Replace the global operator new in debug builds to check Audio::AllocationGuard" OFF)
 
 configure_file(libluna/config.h.in libluna/config.h)
@@ -12,3 +12,16 @@ ExternalProject_Add(
 )
 
 set(XXD "${LUNA_INSTALL_NATIVE_DIR}/bin/xxd")
+
+ExternalProject_Add(
+  lunapack-native
+  PREFIX "${LUNA_BUILD_NATIVE_DIR}"
+  CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=${LUNA_INSTALL_NATIVE_DIR}
+  CMAKE_ARGS -DCMAKE_PREFIX_PATH=${LUNA_INSTALL_NATIVE_DIR}
+  CMAKE_ARGS -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE}
+  ${EXT_PROJ_TOOLCHAIN}
+  SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/tools/lunapack
+  BUILD_ALWAYS ON
+)
+
+set(LUNAPACK "${LUNA_INSTALL_NATIVE_DIR}/bin/lunapack")
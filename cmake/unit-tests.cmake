@@ -3,10 +3,29 @@ include(cmake/LunaUtils.cmake)
 enable_testing()
 
 set(UNIT_TESTS
+  AssetCache
+  AssetLoader
+  Audio/AudioGraph
+  Audio/AudioManager
+  Audio/Dsp
+  Audio/Resampler
+  Audio/VoiceMixer
+  BufferedInputStream
+  CommandQueue
+  DecompressingReader
+  Endian
   Filesystem/FileReader
+  Filesystem/MappedFileReader
   Filesystem/Path
+  HotReloader
   Texture
+  TextureView
   InputManager
+  JobSystem
+  Image/ImageDecoder
+  PackArchive
+  Quantizer
+  RenderSnapshot
   # Matrix
   # ResourceReader
   String
@@ -6,6 +6,7 @@
 #include <libluna/Logger.hpp>
 #include <libluna/ResourceReader.hpp>
 #include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
 #include <libluna/Vector.hpp>
 
 #include "../../common.hpp"
@@ -92,21 +93,22 @@ class ExampleApp : public Application {
       getAssetsPath().cd("coin_16bpp.bmp"), mTexture16bpp
     );
 
+    // the frames refer to the sprite sheets, no pixels are copied
     for (int i = 0; i < NUM_FRAMES; i++) {
-      mTexture32bppFrames[i] = mTexture32bpp.crop(
-        Vector2i{32, 32}, Vector2i{32 * i, 0}
+      mCanvas->uploadTexture(
+        TEX_BASE_SLOT_32BPP + i,
+        TextureView(mTexture32bpp).crop(Vector2i{32, 32}, Vector2i{32 * i, 0})
       );
-      mCanvas->uploadTexture(TEX_BASE_SLOT_32BPP + i, &mTexture32bppFrames[i]);
 
-      mTexture24bppFrames[i] = mTexture24bpp.crop(
-        Vector2i{32, 32}, Vector2i{32 * i, 0}
+      mCanvas->uploadTexture(
+        TEX_BASE_SLOT_24BPP + i,
+        TextureView(mTexture24bpp).crop(Vector2i{32, 32}, Vector2i{32 * i, 0})
       );
-      mCanvas->uploadTexture(TEX_BASE_SLOT_24BPP + i, &mTexture24bppFrames[i]);
 
-      mTexture16bppFrames[i] = mTexture16bpp.crop(
-        Vector2i{32, 32}, Vector2i{32 * i, 0}
+      mCanvas->uploadTexture(
+        TEX_BASE_SLOT_16BPP + i,
+        TextureView(mTexture16bpp).crop(Vector2i{32, 32}, Vector2i{32 * i, 0})
       );
-      mCanvas->uploadTexture(TEX_BASE_SLOT_16BPP + i, &mTexture16bppFrames[i]);
     }
   }
 
@@ -117,9 +119,6 @@ class ExampleApp : public Application {
   Texture mTexture32bpp;
   Texture mTexture24bpp;
   Texture mTexture16bpp;
-  Texture mTexture32bppFrames[NUM_FRAMES];
-  Texture mTexture24bppFrames[NUM_FRAMES];
-  Texture mTexture16bppFrames[NUM_FRAMES];
   Sprite* mSprite32bpp{nullptr};
   Sprite* mSprite24bpp{nullptr};
   Sprite* mSprite16bpp{nullptr};
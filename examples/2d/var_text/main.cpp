@@ -6,6 +6,7 @@
 #include <libluna/Logger.hpp>
 #include <libluna/ResourceReader.hpp>
 #include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
 #include <libluna/Vector.hpp>
 
 #include "../../common.hpp"
@@ -100,10 +101,6 @@ class ExampleApp : public Application {
 #endif
     }
 
-#ifdef N64
-    mGlyphTextures.resize(bmFont->charCount);
-#endif
-
     for (int i = 0; i < bmFont->charCount; ++i) {
       BMFontChar& bmChar = bmFont->chars[i];
 
@@ -123,11 +120,13 @@ class ExampleApp : public Application {
       glyph->advance = bmChar.xadvance;
 
 #ifdef N64
-      mGlyphTextures[i] = mFontTextures[bmChar.page].crop(
-        Vector2i{bmChar.width, bmChar.height},
-        Vector2i{bmChar.x, bmChar.y}
+      mCanvas->uploadTexture(
+        glyph->textureSlot,
+        TextureView(mFontTextures[bmChar.page]).crop(
+          Vector2i{bmChar.width, bmChar.height},
+          Vector2i{bmChar.x, bmChar.y}
+        )
       );
-      mCanvas->uploadTexture(glyph->textureSlot, &mGlyphTextures[i]);
 #endif
     }
   }
@@ -138,9 +137,6 @@ class ExampleApp : public Application {
   Camera2d mCamera;
   Font mFont;
   std::vector<Texture> mFontTextures;
-#ifdef N64
-  std::vector<Texture> mGlyphTextures;
-#endif
   double mTime{0.f};
 };
 
@@ -9,3 +9,5 @@ AbstractRenderer::~AbstractRenderer() = default;
 void AbstractRenderer::setCanvas(Canvas* canvas) { mCanvas = canvas; }
 
 Canvas* AbstractRenderer::getCanvas() const { return mCanvas; }
+
+void AbstractRenderer::reloadShader(const std::string&, const std::string&) {}
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <string>
+
 #include <libluna/Internal/GraphicsMetrics.hpp>
+#include <libluna/Rect.hpp>
+#include <libluna/RenderSnapshot.hpp>
 #include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
 
 namespace Luna {
   class Canvas;
@@ -60,7 +65,9 @@ namespace Luna {
      * @brief Called once per frame to initiate rendering.
      *
      * The implementation should clear the background and render every camera
-     * associated with the canvas.
+     * of the given snapshot. It must not read the cameras or stages from the
+     * canvas directly, since the application may already be modifying them
+     * for the next frame.
      *
      * The @ref CommonRenderer provides a good abstraction, which can be used by
      * renderers on modern platforms which easily allow arbitrary drawing of
@@ -68,7 +75,7 @@ namespace Luna {
      *
      * @see present()
      */
-    virtual void render() = 0;
+    virtual void render(const RenderSnapshot& snapshot) = 0;
 
     /**
      * @brief Called once per frame after @ref render() to display the rendered frame.
@@ -88,8 +95,38 @@ namespace Luna {
      *
      * If the texture is too large for the underlying system, it may be sliced
      * into smaller textures under the hood.
+     *
+     * Indexed (4 or 8 bpp) textures use their assigned palette or a grayscale
+     * ramp if no palette is assigned.
+     *
+     * The view may refer to a region of a larger image. Implementations should
+     * pass the row length to the graphics API where possible instead of
+     * copying the region into contiguous memory.
+     */
+    virtual void uploadTexture(int slot, const TextureView& texture) = 0;
+
+    /**
+     * @brief Replace a region of the texture at the given slot.
+     *
+     * Only the pixels of the given region are transferred and the existing GPU
+     * storage is reused. The data must have the same bits per pixel as the
+     * uploaded texture and must be at least as large as the region.
+     *
+     * @see uploadTexture()
+     */
+    virtual void updateTextureRegion(
+      int slot, const Recti& rect, const TextureView& data
+    ) = 0;
+
+    /**
+     * @brief Replace the palette of the indexed texture at the given slot.
+     *
+     * Only the colors are uploaded, the pixel indices remain untouched. This
+     * allows for cheap palette animations such as color cycling.
+     *
+     * @see uploadTexture()
      */
-    virtual void uploadTexture(int slot, const Texture* texture) = 0;
+    virtual void uploadPalette(int slot, const Palette* palette) = 0;
 
     /**
      * @brief Free the GPU resources associated with the texture at the given slot.
@@ -98,6 +135,18 @@ namespace Luna {
      */
     virtual void freeTexture(int slot) = 0;
 
+    /**
+     * @brief Replace the source of a shader file and rebuild the programs
+     * using it.
+     *
+     * Programs that fail to build are kept as they are. Renderers without
+     * shaders ignore this.
+     *
+     * @param filename Name of the shader file, such as `sprite_frag.glsl`.
+     */
+    virtual void
+    reloadShader(const std::string& filename, const std::string& source);
+
     private:
     Canvas* mCanvas;
   };
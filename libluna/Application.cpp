@@ -2,6 +2,9 @@
 
 #include <libluna/Application.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef __SWITCH__
 #include <switch.h>
 #endif
@@ -35,6 +38,7 @@
 #include <libluna/Internal/DebugMetrics.hpp>
 #include <libluna/Internal/Keyboard.hpp>
 #include <libluna/IntervalManager.hpp>
+#include <libluna/JobSystem.hpp>
 #include <libluna/Logger.hpp>
 #include <libluna/PathManager.hpp>
 #include <libluna/Performance/Ticker.hpp>
@@ -117,7 +121,9 @@ void Application::mainLoop() {
   logInfo("entering main loop");
 
   mIntervalManager.addAlways([this](float deltaTime) {
-    if (mTimeScale > 0.f) {
+    if (mFixedTickRate > 0) {
+      runFixedTicks(deltaTime);
+    } else if (mTimeScale > 0.f) {
       this->update(deltaTime * mTimeScale);
     } else if (mDoStep) {
       this->update(deltaTime);
@@ -125,6 +131,8 @@ void Application::mainLoop() {
     }
   });
 
+  auto firstFrameStart = Clock::now();
+
   while (hasCanvas() && mRaisedErrorMessage.isEmpty()) {
 #ifdef __SWITCH__
     if (!appletMainLoop()) {
@@ -148,6 +156,12 @@ void Application::mainLoop() {
     }
 
     executeKeyboardShortcuts();
+
+    if (mHotReloader) {
+      mHotReloader->update();
+    }
+
+    JobSystem::getInstance()->executeMainThreadJobs();
     mIntervalManager.executePendingIntervals();
 
     mAudioManager.update();
@@ -161,7 +175,11 @@ void Application::mainLoop() {
     mDebugMetrics->renderTicker.measure();
 
     for (auto canvas : getOpenCanvases()) {
-      canvas->sync();
+      if (mMaxFramesInFlight > 0) {
+        canvas->waitForFrames(mMaxFramesInFlight);
+      } else {
+        canvas->sync();
+      }
     }
 
     // logDebug("==============");
@@ -169,6 +187,18 @@ void Application::mainLoop() {
     // logDebug("update time: {}ms; updates/second: {}", (mDebugMetrics->frameTicker.getTickDuration() * 1000), mDebugMetrics->frameTicker.getTicksPerSecond());
     // logDebug("render time: {}ms; renders/second: {}", (mDebugMetrics->renderTicker.getTickDuration() * 1000), mDebugMetrics->renderTicker.getTicksPerSecond());
 
+    if (mDebugMetrics->framesElapsed == 0) {
+      auto& startupTimer = mDebugMetrics->startupTimer;
+      startupTimer.record("first frame", firstFrameStart, Clock::now());
+      mDebugMetrics->timeToFirstFrame = startupTimer.getElapsed();
+
+      startupTimer.log("startup");
+      logInfo(
+        "time to first frame: {:.2f}ms",
+        mDebugMetrics->timeToFirstFrame * std::milli::den
+      );
+    }
+
     ++mDebugMetrics->framesElapsed;
   }
 
@@ -477,19 +507,36 @@ int Application::run() {
   SDL_SetHint(SDL_HINT_APP_NAME, mName.c_str());
 #endif
 
+  // main thread jobs are executed by the thread running the main loop
+  JobSystem::getInstance()->setMainThread();
+
+  mDebugMetrics = std::make_shared<Internal::DebugMetrics>();
+  auto& startupTimer = mDebugMetrics->startupTimer;
+
   String assetsPath = Application::getInstance()->getOptionValue("assets");
 
   if (!assetsPath.isEmpty()) {
     setAssetsPath(assetsPath);
   }
 
-  initSystem();
+  {
+    auto phase = startupTimer.measure("system");
+    initSystem();
+  }
 
-  printCompiler();
-  printDefines();
-  printArguments(mArgs);
+  // opening the audio device takes a while and doesn't depend on anything
+  // else, so it runs in the background while the application is initialized
+  auto openAudio = JobSystem::getInstance()->schedule([this, &startupTimer]() {
+    auto phase = startupTimer.measure("audio");
+    mAudioManager.open();
+  });
 
-  mDebugMetrics = std::make_shared<Internal::DebugMetrics>();
+  {
+    auto phase = startupTimer.measure("platform info");
+    printCompiler();
+    printDefines();
+    printArguments(mArgs);
+  }
 
 #ifdef N64
   mGamepadDevices = {
@@ -510,14 +557,24 @@ int Application::run() {
   mKeyboardDevice = InputDevice(Input::KeyboardDevice(&mKeyboardState));
 #endif
 
-  this->init();
+  {
+    // the canvases create their windows on their render threads meanwhile
+    auto phase = startupTimer.measure("init");
+    this->init();
+  }
+
+  {
+    auto phase = startupTimer.measure("waiting for audio");
+    JobSystem::getInstance()->wait(openAudio);
+  }
 
   if (hasCanvas()) {
-    mAudioManager.init();
+    mAudioManager.start();
     mainLoop();
-    mAudioManager.free();
   }
 
+  mAudioManager.free();
+
   shutDown();
 
   return 0;
@@ -642,6 +699,20 @@ AudioNodePtr Application::getAudioDestinationNode() const {
   return mAudioManager.getDestinationNode();
 }
 
+JobSystem* Application::getJobSystem() { return JobSystem::getInstance(); }
+
+HotReloader* Application::getHotReloader() {
+  if (!mHotReloader) {
+    mHotReloader = std::make_unique<HotReloader>(getAssetsPath());
+
+    if (!mHotReloader->isWatching()) {
+      logWarn("hot reloading is not supported on this platform");
+    }
+  }
+
+  return mHotReloader.get();
+}
+
 void Application::openDebugger([[maybe_unused]] Canvas* canvas) {
 #ifdef LUNA_IMGUI
   if (!isDebuggerOpen(canvas)) {
@@ -691,6 +762,65 @@ void Application::setTimeScale(float timeScale) {
 
 void Application::step() { mDoStep = true; }
 
+void Application::setMaxFramesInFlight(int maxFramesInFlight) {
+  mMaxFramesInFlight =
+    std::clamp(maxFramesInFlight, 0, Canvas::kMaxFramesInFlight);
+}
+
+int Application::getMaxFramesInFlight() const { return mMaxFramesInFlight; }
+
+void Application::setFixedTickRate(int ticksPerSecond) {
+  mFixedTickRate = std::max(0, ticksPerSecond);
+  mTickAccumulator = 0.0;
+  mInterpolationAlpha = 1.0f;
+}
+
+int Application::getFixedTickRate() const { return mFixedTickRate; }
+
+void Application::setMaxTicksPerFrame(int maxTicksPerFrame) {
+  mMaxTicksPerFrame = std::max(1, maxTicksPerFrame);
+}
+
+int Application::getMaxTicksPerFrame() const { return mMaxTicksPerFrame; }
+
+float Application::getInterpolationAlpha() const { return mInterpolationAlpha; }
+
+void Application::runFixedTicks(float deltaTime) {
+  double tickDuration = 1.0 / mFixedTickRate;
+
+  if (mTimeScale > 0.f) {
+    mTickAccumulator += static_cast<double>(deltaTime * mTimeScale);
+  } else if (mDoStep) {
+    mTickAccumulator += tickDuration;
+    mDoStep = false;
+  }
+
+  int ticks = 0;
+
+  while (mTickAccumulator >= tickDuration && ticks < mMaxTicksPerFrame) {
+    for (auto&& canvas : mCanvases) {
+      if (!canvas.isClosed()) {
+        canvas.storePreviousPositions();
+      }
+    }
+
+    this->update(static_cast<float>(tickDuration));
+    mTickAccumulator -= tickDuration;
+    ++ticks;
+  }
+
+  mDebugMetrics->ticksElapsed += static_cast<unsigned int>(ticks);
+
+  if (mTickAccumulator >= tickDuration) {
+    // can't catch up, drop whole ticks to avoid a spiral of death
+    auto droppedTicks = std::floor(mTickAccumulator / tickDuration);
+    mDebugMetrics->ticksDropped += static_cast<unsigned int>(droppedTicks);
+    mTickAccumulator -= droppedTicks * tickDuration;
+  }
+
+  mInterpolationAlpha = static_cast<float>(mTickAccumulator / tickDuration);
+}
+
 std::optional<InputDevice> Application::getKeyboardDevice() {
 #ifdef LUNA_FLEXIBLE_INPUT
   return mKeyboardDevice;
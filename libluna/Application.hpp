@@ -15,10 +15,12 @@
 #include <libluna/Audio/AudioManager.hpp>
 #include <libluna/Canvas.hpp>
 #include <libluna/Filesystem/Path.hpp>
+#include <libluna/HotReloader.hpp>
 #include <libluna/InputDevice.hpp>
 #include <libluna/InputManager.hpp>
 #include <libluna/Internal/DebugMetrics.hpp>
 #include <libluna/IntervalManager.hpp>
+#include <libluna/JobSystem.hpp>
 #include <libluna/PathManager.hpp>
 #include <libluna/String.hpp>
 
@@ -205,6 +207,22 @@ namespace Luna {
 
     Audio::AudioNodePtr getAudioDestinationNode() const;
 
+    /**
+     * @brief Get the job system for running work in the background.
+     *
+     * Jobs scheduled with JobSystem::scheduleOnMainThread() are executed once
+     * per frame, right before update() is called.
+     */
+    JobSystem* getJobSystem();
+
+    /**
+     * @brief Get the hot reloader watching the assets path.
+     *
+     * It is created on first use. Once created, the changed assets are
+     * reloaded once per frame, right before update() is called.
+     */
+    HotReloader* getHotReloader();
+
     void openDebugger(Canvas* canvas);
 
     void closeDebugger(Canvas* canvas);
@@ -226,6 +244,60 @@ namespace Luna {
 
     void step();
 
+    /**
+     * @brief Set how many frames may be rendered while the next one is updated.
+     *
+     * With 0 (default), the main loop waits for each frame to be presented
+     * before updating the next one. With 1 or 2, the update of frame N+1
+     * overlaps with the rendering of frame N (and N-1), which increases the
+     * throughput at the cost of the given number of frames of latency.
+     *
+     * Resources referred to by submitted commands must stay valid and
+     * unmodified until the frames using them have finished, see
+     * Canvas::waitForFrames().
+     *
+     * Values are clamped to Canvas::kMaxFramesInFlight.
+     */
+    void setMaxFramesInFlight(int maxFramesInFlight);
+
+    int getMaxFramesInFlight() const;
+
+    /**
+     * @name Fixed tick rate
+     *
+     * By default, update() is called once per frame with the time elapsed
+     * since the last frame. With a fixed tick rate, update() is called as
+     * often as needed to advance the simulation in steps of exactly
+     * 1 / ticksPerSecond seconds, regardless of the frame rate. The time
+     * scale then changes how many ticks are run, not their duration.
+     *
+     * If rendering falls behind, at most getMaxTicksPerFrame() ticks are run
+     * per frame and the remaining time is dropped, so slow frames don't cause
+     * even slower frames.
+     *
+     * Frames are usually rendered between two ticks. The 2D drawables and
+     * camera are then shown between their position of the previous and the
+     * current tick, according to getInterpolationAlpha().
+     */
+    ///@{
+    /**
+     * @brief Set the number of ticks per second or 0 to update once per frame.
+     */
+    void setFixedTickRate(int ticksPerSecond);
+    int getFixedTickRate() const;
+
+    void setMaxTicksPerFrame(int maxTicksPerFrame);
+    int getMaxTicksPerFrame() const;
+
+    /**
+     * @brief Get the fraction of the next tick that has already elapsed.
+     *
+     * This is between 0 (the last tick just happened) and 1. Without a fixed
+     * tick rate, this is always 1.
+     */
+    float getInterpolationAlpha() const;
+    ///@}
+
     std::optional<InputDevice> getKeyboardDevice();
 
     std::optional<InputDevice> getGamepadDevice(int index);
@@ -244,6 +316,7 @@ namespace Luna {
     void executeKeyboardShortcuts();
 
     void mainLoop();
+    void runFixedTicks(float deltaTime);
     void processEvents();
     void shutDown();
     bool hasCanvas();
@@ -256,9 +329,15 @@ namespace Luna {
     PathManager mPathManager;
     String mName;
     std::shared_ptr<Internal::DebugMetrics> mDebugMetrics;
+    std::unique_ptr<HotReloader> mHotReloader;
     InputManager mHotkeysManager;
     float mTimeScale{1.0f};
     bool mDoStep{false}; ///< Step one frame if paused
+    int mMaxFramesInFlight{0};
+    int mFixedTickRate{0};
+    int mMaxTicksPerFrame{8};
+    double mTickAccumulator{0.0};
+    float mInterpolationAlpha{1.0f};
 
 #ifdef N64
     std::array<std::optional<InputDevice>, 4> mGamepadDevices;
@@ -0,0 +1,536 @@
+#include <libluna/AssetCache.hpp>
+
+#include <atomic>
+#include <cstdio>  // remove
+#include <cstring> // memcpy
+#include <exception>
+#include <filesystem>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include <libluna/Logger.hpp>
+#include <libluna/Palette.hpp>
+
+using namespace Luna;
+
+namespace {
+  constexpr char kMagic[4] = {'L', 'C', 'A', 'C'};
+  constexpr uint32_t kVersion = 1;
+
+  /**
+   * @brief Reads differently on machines of the other byte order.
+   */
+  constexpr uint32_t kByteOrder = 0x01020304;
+  constexpr std::size_t kHeaderSize = 96;
+  constexpr std::size_t kAlignment = 16;
+  constexpr uint64_t kMaxTextureSize = 65536;
+
+  enum EntryType : uint32_t { kTextureEntry = 1, kMeshEntry = 2 };
+
+  constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ull;
+  constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4full;
+  constexpr uint64_t kPrime3 = 0x165667b19e3779f9ull;
+  constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ull;
+  constexpr uint64_t kPrime5 = 0x27d4eb2f165667c5ull;
+
+  inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  inline uint64_t read64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+
+    return value;
+  }
+
+  inline uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+
+    return value;
+  }
+
+  inline uint64_t mix(uint64_t accumulator, uint64_t input) {
+    accumulator += input * kPrime2;
+    accumulator = rotateLeft(accumulator, 31);
+
+    return accumulator * kPrime1;
+  }
+
+  inline uint64_t mergeRound(uint64_t accumulator, uint64_t value) {
+    accumulator ^= mix(0, value);
+
+    return accumulator * kPrime1 + kPrime4;
+  }
+
+  inline std::size_t align(std::size_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  /**
+   * @brief Hand out the aligned sections of a mapped entry in order.
+   */
+  class SectionReader {
+    public:
+    SectionReader(const uint8_t* data, std::size_t size)
+        : mData(data), mSize(size) {}
+
+    /**
+     * @brief Get the next section or nullptr if it exceeds the entry.
+     */
+    const uint8_t* next(uint64_t size) {
+      mOffset = align(mOffset);
+
+      if (size > mSize || mOffset > mSize - size) {
+        return nullptr;
+      }
+
+      auto section = mData + mOffset;
+      mOffset += static_cast<std::size_t>(size);
+
+      return section;
+    }
+
+    private:
+    const uint8_t* mData;
+    std::size_t mSize;
+    std::size_t mOffset{kHeaderSize};
+  };
+
+  /**
+   * @brief Copy a section into a vector of plain values.
+   *
+   * The element types have non-trivial constructors, but consist of nothing
+   * but their values. Vector2 is not one of them, it has reference members.
+   */
+  template <typename T>
+  bool readArray(SectionReader& reader, uint64_t count, std::vector<T>& array) {
+    if (count > SIZE_MAX / sizeof(T)) {
+      return false;
+    }
+
+    auto section = reader.next(count * sizeof(T));
+
+    if (!section) {
+      return false;
+    }
+
+    array.resize(static_cast<std::size_t>(count));
+    std::memcpy(
+      reinterpret_cast<uint8_t*>(array.data()), section, array.size() * sizeof(T)
+    );
+
+    return true;
+  }
+
+  bool readArray(
+    SectionReader& reader, uint64_t count, std::vector<Vector2f>& array
+  ) {
+    std::vector<float> values;
+
+    if (count > SIZE_MAX / 2 || !readArray(reader, count * 2, values)) {
+      return false;
+    }
+
+    array.clear();
+    array.reserve(static_cast<std::size_t>(count));
+
+    for (std::size_t i = 0; i < values.size(); i += 2) {
+      array.emplace_back(values[i], values[i + 1]);
+    }
+
+    return true;
+  }
+
+  static_assert(sizeof(Vector3f) == 3 * sizeof(float));
+  static_assert(sizeof(Mesh::Face) == 3 * sizeof(uint32_t));
+} // namespace
+
+struct AssetCache::Header {
+  char magic[4];
+  uint32_t version;
+  uint32_t type;
+  uint32_t byteOrder;
+  uint64_t key;
+
+  /**
+   * @brief Dimensions and section sizes, depending on the type.
+   */
+  uint64_t values[8];
+};
+
+AssetCache::AssetCache(const Filesystem::Path& directory)
+    : mDirectory(directory) {
+  std::error_code error;
+  std::filesystem::create_directories(
+    mDirectory.getRawPath().c_str(), error
+  );
+
+  if (error) {
+    logError(
+      "unable to create asset cache {}: {}", mDirectory.getRawPath().c_str(),
+      error.message()
+    );
+  }
+}
+
+AssetCache::~AssetCache() = default;
+
+uint64_t AssetCache::hash(const void* data, std::size_t size, uint64_t seed) {
+  auto input = static_cast<const uint8_t*>(data);
+  auto end = input + size;
+  uint64_t result;
+
+  if (size >= 32) {
+    uint64_t lanes[4] = {
+      seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+
+    // four independent lanes keep the multipliers busy
+    do {
+      lanes[0] = mix(lanes[0], read64(input));
+      lanes[1] = mix(lanes[1], read64(input + 8));
+      lanes[2] = mix(lanes[2], read64(input + 16));
+      lanes[3] = mix(lanes[3], read64(input + 24));
+      input += 32;
+    } while (end - input >= 32);
+
+    result = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) +
+             rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+
+    for (auto lane : lanes) {
+      result = mergeRound(result, lane);
+    }
+  } else {
+    result = seed + kPrime5;
+  }
+
+  result += size;
+
+  for (; end - input >= 8; input += 8) {
+    result ^= mix(0, read64(input));
+    result = rotateLeft(result, 27) * kPrime1 + kPrime4;
+  }
+
+  if (end - input >= 4) {
+    result ^= read32(input) * kPrime1;
+    result = rotateLeft(result, 23) * kPrime2 + kPrime3;
+    input += 4;
+  }
+
+  for (; input < end; ++input) {
+    result ^= *input * kPrime5;
+    result = rotateLeft(result, 11) * kPrime1;
+  }
+
+  result ^= result >> 33;
+  result *= kPrime2;
+  result ^= result >> 29;
+  result *= kPrime3;
+  result ^= result >> 32;
+
+  return result;
+}
+
+uint64_t AssetCache::makeKey(uint64_t sourceHash, const std::string& recipe) {
+  return hash(recipe.data(), recipe.size(), sourceHash);
+}
+
+bool AssetCache::load(uint64_t key, Texture& texture) {
+  Header header;
+  auto reader = open(key, kTextureEntry, header);
+
+  if (!reader) {
+    return false;
+  }
+
+  auto bitsPerPixel = header.values[0];
+  auto width = header.values[1];
+  auto height = header.values[2];
+  auto paletteBits = header.values[4];
+  auto paletteCount = header.values[5];
+  auto dataSize = header.values[6];
+  auto paletteSize = header.values[7];
+
+  bool valid =
+    (bitsPerPixel == 4 || bitsPerPixel == 8 || bitsPerPixel == 16 ||
+     bitsPerPixel == 24 || bitsPerPixel == 32) &&
+    width <= kMaxTextureSize && height <= kMaxTextureSize &&
+    dataSize == width * height * (bitsPerPixel / 4) / 2 &&
+    paletteCount <= 256 && paletteSize == paletteCount * paletteBits / 8;
+
+  SectionReader sections(reader->getData(), reader->getSize());
+  auto palette = valid ? sections.next(paletteSize) : nullptr;
+  auto pixels = valid ? sections.next(dataSize) : nullptr;
+
+  if (!palette || !pixels) {
+    logWarn("invalid asset cache entry {}", getFilename(key));
+    countError();
+    countLoad(false, 0);
+
+    return false;
+  }
+
+  Texture result(
+    static_cast<int>(bitsPerPixel),
+    Vector2i(static_cast<int>(width), static_cast<int>(height))
+  );
+  std::memcpy(result.getData(), pixels, static_cast<std::size_t>(dataSize));
+  result.setInterpolation(header.values[3] != 0);
+
+  if (paletteCount > 0) {
+    auto colors = Palette::make(
+      static_cast<int>(paletteBits), static_cast<int>(paletteCount)
+    );
+    std::memcpy(
+      colors->colorsRgb16(), palette, static_cast<std::size_t>(paletteSize)
+    );
+    result.setPalette(colors);
+  }
+
+  texture = std::move(result);
+  countLoad(true, reader->getSize());
+
+  return true;
+}
+
+bool AssetCache::load(uint64_t key, Mesh& mesh) {
+  Header header;
+  auto reader = open(key, kMeshEntry, header);
+
+  if (!reader) {
+    return false;
+  }
+
+  Mesh result;
+  SectionReader sections(reader->getData(), reader->getSize());
+
+  if (!readArray(sections, header.values[0], result.getVertices()) ||
+      !readArray(sections, header.values[1], result.getFaces()) ||
+      !readArray(sections, header.values[2], result.getTexCoords()) ||
+      !readArray(sections, header.values[3], result.getNormals()) ||
+      !readArray(sections, header.values[4], result.getTangents()) ||
+      !readArray(sections, header.values[5], result.getBitangents())) {
+    logWarn("invalid asset cache entry {}", getFilename(key));
+    countError();
+    countLoad(false, 0);
+
+    return false;
+  }
+
+  mesh = std::move(result);
+  countLoad(true, reader->getSize());
+
+  return true;
+}
+
+bool AssetCache::store(uint64_t key, const Texture& texture) {
+  auto palette = texture.getPalette();
+  auto paletteSize =
+    palette ? static_cast<std::size_t>(
+                palette->getColorCount() * palette->getBitsPerColor() / 8
+              )
+            : 0;
+
+  Header header{};
+  header.type = kTextureEntry;
+  header.values[0] = static_cast<uint64_t>(texture.getBitsPerPixel());
+  header.values[1] = static_cast<uint64_t>(texture.getWidth());
+  header.values[2] = static_cast<uint64_t>(texture.getHeight());
+  header.values[3] = texture.isInterpolated() ? 1 : 0;
+  header.values[4] =
+    palette ? static_cast<uint64_t>(palette->getBitsPerColor()) : 0;
+  header.values[5] =
+    palette ? static_cast<uint64_t>(palette->getColorCount()) : 0;
+  header.values[6] = static_cast<uint64_t>(texture.getByteCount());
+  header.values[7] = paletteSize;
+
+  const void* paletteData =
+    palette ? static_cast<const Palette&>(*palette).colorsRgb16() : nullptr;
+
+  return write(
+    key, header,
+    {{paletteData, paletteSize},
+     {texture.getData(), static_cast<std::size_t>(texture.getByteCount())}}
+  );
+}
+
+bool AssetCache::store(uint64_t key, const Mesh& mesh) {
+  Header header{};
+  header.type = kMeshEntry;
+  header.values[0] = mesh.getVertices().size();
+  header.values[1] = mesh.getFaces().size();
+  header.values[2] = mesh.getTexCoords().size();
+  header.values[3] = mesh.getNormals().size();
+  header.values[4] = mesh.getTangents().size();
+  header.values[5] = mesh.getBitangents().size();
+
+  auto section = [](const auto& array) {
+    return Section{array.data(), array.size() * sizeof(array[0])};
+  };
+
+  std::vector<float> texCoords;
+  texCoords.reserve(mesh.getTexCoords().size() * 2);
+
+  for (auto& texCoord : mesh.getTexCoords()) {
+    texCoords.push_back(texCoord.x);
+    texCoords.push_back(texCoord.y);
+  }
+
+  return write(
+    key, header,
+    {section(mesh.getVertices()), section(mesh.getFaces()), section(texCoords),
+     section(mesh.getNormals()), section(mesh.getTangents()),
+     section(mesh.getBitangents())}
+  );
+}
+
+AssetCache::Stats AssetCache::getStats() const {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  return mStats;
+}
+
+const Filesystem::Path& AssetCache::getDirectory() const { return mDirectory; }
+
+Filesystem::MappedFileReaderPtr
+AssetCache::open(uint64_t key, uint32_t type, Header& header) {
+  static_assert(sizeof(Header) <= kHeaderSize);
+
+  auto filename = getFilename(key);
+  std::error_code error;
+
+  // a missing entry is the common case and not worth an exception
+  if (!std::filesystem::is_regular_file(filename, error)) {
+    countLoad(false, 0);
+
+    return nullptr;
+  }
+
+  Filesystem::MappedFileReaderPtr reader;
+
+  try {
+    reader = Filesystem::MappedFileReader::make(String(filename));
+  } catch (const std::exception& exception) {
+    logWarn("could not open asset cache entry: {}", exception.what());
+    countError();
+    countLoad(false, 0);
+
+    return nullptr;
+  }
+
+  if (reader->getSize() < kHeaderSize) {
+    countLoad(false, 0);
+
+    return nullptr;
+  }
+
+  std::memcpy(&header, reader->getData(), sizeof(header));
+
+  // entries of other versions, machines or types are simply replaced
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.byteOrder != kByteOrder ||
+      header.type != type || header.key != key) {
+    countLoad(false, 0);
+
+    return nullptr;
+  }
+
+  return reader;
+}
+
+bool AssetCache::write(
+  uint64_t key, const Header& header, std::initializer_list<Section> sections
+) {
+  static std::atomic<unsigned int> temporaryCount{0};
+
+  Header completeHeader = header;
+  std::memcpy(completeHeader.magic, kMagic, sizeof(kMagic));
+  completeHeader.version = kVersion;
+  completeHeader.byteOrder = kByteOrder;
+  completeHeader.key = key;
+
+  std::vector<char> padding(kHeaderSize, 0);
+  auto filename = getFilename(key);
+
+  // concurrent writers of the same entry must not share the temporary file
+  auto temporaryFilename = fmt::format("{}.{}.tmp", filename, ++temporaryCount);
+
+  {
+    std::ofstream file(temporaryFilename, std::ios::binary);
+    file.write(
+      reinterpret_cast<const char*>(&completeHeader), sizeof(completeHeader)
+    );
+    file.write(
+      padding.data(),
+      static_cast<std::streamsize>(kHeaderSize - sizeof(completeHeader))
+    );
+
+    std::size_t offset = kHeaderSize;
+
+    for (auto& section : sections) {
+      auto aligned = align(offset);
+      file.write(padding.data(), static_cast<std::streamsize>(aligned - offset));
+      file.write(
+        static_cast<const char*>(section.data),
+        static_cast<std::streamsize>(section.size)
+      );
+      offset = aligned + section.size;
+    }
+
+    if (!file) {
+      logWarn("could not write asset cache entry {}", filename);
+      file.close();
+      std::remove(temporaryFilename.c_str());
+      countError();
+
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporaryFilename, filename, error);
+
+  if (error) {
+    logWarn("could not write asset cache entry {}: {}", filename, error.message());
+    std::filesystem::remove(temporaryFilename, error);
+    countError();
+
+    return false;
+  }
+
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+  ++mStats.stores;
+  mStats.bytesStored += std::filesystem::file_size(filename, error);
+
+  return true;
+}
+
+void AssetCache::countLoad(bool hit, uint64_t bytes) {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  if (hit) {
+    ++mStats.hits;
+    mStats.bytesLoaded += bytes;
+  } else {
+    ++mStats.misses;
+  }
+}
+
+void AssetCache::countError() {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+  ++mStats.errors;
+}
+
+std::string AssetCache::getFilename(uint64_t key) const {
+  return fmt::format("{}/{:016x}.lca", mDirectory.getRawPath().c_str(), key);
+}
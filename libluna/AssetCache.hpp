@@ -0,0 +1,136 @@
+#pragma once
+
+#include <libluna/config.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+#ifdef LUNA_STD_THREAD
+#include <mutex>
+#endif
+
+#include <libluna/Filesystem/MappedFileReader.hpp>
+#include <libluna/Filesystem/Path.hpp>
+#include <libluna/Mesh.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  /**
+   * @brief Store decoded and converted assets on disk to skip the work on the
+   * next start.
+   *
+   * Each entry is keyed by a hash of the source file contents combined with a
+   * hash of the recipe, a string identifying the conversion applied after
+   * decoding. Changing either the source or the recipe results in a new key,
+   * so stale entries are never used and nothing needs to be invalidated.
+   *
+   * Entries hold the final texture or mesh data, so loading one maps the file
+   * and copies its sections without any decoding. Entries are written to a
+   * temporary file first and then renamed, so concurrent writers and crashes
+   * never leave partial entries behind.
+   *
+   * ```cpp
+   * Luna::AssetCache cache("cache");
+   * loader.setCache(&cache);
+   *
+   * // cached as long as neither the file nor the recipe change
+   * loader.loadTexture("font.bmp", convertFont, "font:rgb16:v2");
+   * ```
+   *
+   * Entries are stored in the byte order of the machine writing them and are
+   * treated as missing on other machines.
+   *
+   * @ingroup system
+   */
+  class AssetCache {
+    public:
+    struct Stats {
+      int hits{0};
+      int misses{0};
+      int stores{0};
+
+      /**
+       * @brief Number of entries that could not be read or written.
+       */
+      int errors{0};
+      uint64_t bytesLoaded{0};
+      uint64_t bytesStored{0};
+    };
+
+    /**
+     * @brief Use the given directory for the entries, creating it if needed.
+     */
+    explicit AssetCache(const Filesystem::Path& directory);
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+    ~AssetCache();
+
+    /**
+     * @brief Hash arbitrary data using 64-bit xxHash.
+     */
+    static uint64_t
+    hash(const void* data, std::size_t size, uint64_t seed = 0);
+
+    /**
+     * @brief Combine the source and recipe hashes into the key of an entry.
+     */
+    static uint64_t makeKey(uint64_t sourceHash, const std::string& recipe);
+
+    /**
+     * @name Thread-safe
+     */
+    ///@{
+    /**
+     * @brief Load the entry into @p texture.
+     *
+     * @return false if there is no valid entry, leaving @p texture untouched.
+     */
+    bool load(uint64_t key, Texture& texture);
+    bool load(uint64_t key, Mesh& mesh);
+
+    /**
+     * @brief Write the entry, replacing an existing one.
+     */
+    bool store(uint64_t key, const Texture& texture);
+    bool store(uint64_t key, const Mesh& mesh);
+
+    Stats getStats() const;
+    ///@}
+
+    const Filesystem::Path& getDirectory() const;
+
+    private:
+    struct Header;
+    struct Section {
+      const void* data;
+      std::size_t size;
+    };
+
+    /**
+     * @brief Map the entry and check its header.
+     *
+     * @return nullptr if there is no valid entry of the given type.
+     */
+    Filesystem::MappedFileReaderPtr
+    open(uint64_t key, uint32_t type, Header& header);
+
+    bool write(
+      uint64_t key, const Header& header,
+      std::initializer_list<Section> sections
+    );
+
+    void countLoad(bool hit, uint64_t bytes);
+    void countError();
+
+    std::string getFilename(uint64_t key) const;
+
+    Filesystem::Path mDirectory;
+
+#ifdef LUNA_STD_THREAD
+    mutable std::mutex mMutex;
+#endif
+
+    Stats mStats;
+  };
+} // namespace Luna
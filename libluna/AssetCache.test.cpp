@@ -0,0 +1,139 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <libluna/AssetCache.hpp>
+#include <libluna/Palette.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+
+namespace fs = std::filesystem;
+
+static const char* cachePath = "AssetCache.test.cache";
+
+int main(int, char**) {
+  TEST("hash() matches xxHash64", []() {
+    const char* text = "Nobody inspects the spammish repetition";
+
+    ASSERT(AssetCache::hash("", 0) == 0xef46db3751d8e999ull, "empty");
+    ASSERT(AssetCache::hash("abc", 3) == 0x44bc2cf5ad770999ull, "short");
+    ASSERT(
+      AssetCache::hash(text, std::strlen(text)) == 0xfbcea83c8a378bf1ull,
+      "long"
+    );
+
+    std::string data(1000, '\0');
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<char>(i * 7);
+    }
+
+    // every length takes a different path through the tail
+    bool distinct = true;
+    auto previous = AssetCache::hash(data.data(), 0);
+
+    for (std::size_t size = 1; size < 70; ++size) {
+      auto hash = AssetCache::hash(data.data(), size);
+      distinct = distinct && hash != previous;
+      previous = hash;
+    }
+
+    ASSERT(distinct, "lengths distinct");
+    ASSERT(
+      AssetCache::makeKey(1, "rgb16") != AssetCache::makeKey(1, "rgb32"),
+      "recipes distinct"
+    );
+    ASSERT(
+      AssetCache::makeKey(1, "rgb16") != AssetCache::makeKey(2, "rgb16"),
+      "sources distinct"
+    );
+  });
+
+  TEST("store and load a texture", []() {
+    fs::remove_all(cachePath);
+    AssetCache cache(cachePath);
+
+    Texture texture(8, Vector2i(5, 3));
+
+    for (int i = 0; i < texture.getByteCount(); ++i) {
+      texture.getData()[i] = static_cast<uint8_t>(i);
+    }
+
+    auto palette = Palette::make(32, 16);
+    palette->rgb32At(3) = ColorRgb32{1, 2, 3, 4};
+    texture.setPalette(palette);
+    texture.enableInterpolation();
+
+    Texture loaded;
+    ASSERT(!cache.load(42, loaded), "missing");
+    ASSERT(cache.store(42, texture), "stored");
+    ASSERT(cache.load(42, loaded), "loaded");
+
+    ASSERT_EQL(loaded.getBitsPerPixel(), 8, "bits per pixel");
+    ASSERT_EQL(loaded.getWidth(), 5, "width");
+    ASSERT_EQL(loaded.getHeight(), 3, "height");
+    ASSERT(loaded.isInterpolated(), "interpolated");
+    ASSERT(
+      std::memcmp(loaded.getData(), texture.getData(), 15) == 0, "pixels"
+    );
+    ASSERT(loaded.getPalette() != nullptr, "palette");
+
+    if (loaded.getPalette()) {
+      ASSERT_EQL(loaded.getPalette()->getColorCount(), 16, "colors");
+      ASSERT_EQL(loaded.getPalette()->rgb32At(3).blue, 3, "color");
+    }
+
+    Mesh mesh;
+    ASSERT(!cache.load(42, mesh), "texture is not a mesh");
+
+    auto stats = cache.getStats();
+    ASSERT_EQL(stats.hits, 1, "hits");
+    ASSERT_EQL(stats.misses, 2, "misses");
+    ASSERT_EQL(stats.stores, 1, "stores");
+    ASSERT(stats.bytesLoaded == stats.bytesStored, "bytes");
+  });
+
+  TEST("store and load a mesh", []() {
+    AssetCache cache(cachePath);
+
+    Mesh mesh;
+    mesh.getVertices() = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    mesh.getFaces() = {{0, 1, 2}};
+    mesh.getTexCoords() = {{0, 0}, {1, 0}, {0, 1}};
+    mesh.getNormals() = {{0, 0, 1}, {0, 0, 1}, {0, 0, 1}};
+
+    Mesh loaded;
+    ASSERT(cache.store(7, mesh), "stored");
+    ASSERT(cache.load(7, loaded), "loaded");
+
+    ASSERT_EQL(static_cast<int>(loaded.getVertices().size()), 3, "vertices");
+    ASSERT(loaded.getVertices()[1] == Vector3f(1, 0, 0), "vertex");
+    ASSERT_EQL(static_cast<int>(loaded.getFaces()[0][2]), 2, "face");
+    ASSERT_EQL(loaded.getTexCoords()[2].y, 1.0f, "tex coord");
+    ASSERT_EQL(loaded.getNormals()[0].z, 1.0f, "normal");
+    ASSERT(loaded.getTangents().empty(), "no tangents");
+  });
+
+  TEST("reject truncated entries", []() {
+    AssetCache cache(cachePath);
+
+    Texture texture(32, Vector2i(64, 64));
+    ASSERT(cache.store(1, texture), "stored");
+
+    char filename[64];
+    std::snprintf(filename, sizeof(filename), "%s/%016x.lca", cachePath, 1);
+    fs::resize_file(filename, fs::file_size(filename) - 100);
+
+    Texture loaded;
+    ASSERT(!cache.load(1, loaded), "rejected");
+    ASSERT_EQL(loaded.getWidth(), 0, "untouched");
+    ASSERT_EQL(cache.getStats().errors, 1, "error");
+
+    fs::remove_all(cachePath);
+  });
+
+  return runTests();
+}
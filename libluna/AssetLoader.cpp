@@ -0,0 +1,324 @@
+#include <libluna/AssetLoader.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+
+#include <libluna/Audio/WavDecoder.hpp>
+#include <libluna/Canvas.hpp>
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/Logger.hpp>
+#include <libluna/ObjDecoder.hpp>
+#include <libluna/ResourceReader.hpp>
+
+using namespace Luna;
+using Internal::AssetRequest;
+
+namespace {
+  /**
+   * @brief Run a stage of @p request, failing the request if it throws.
+   *
+   * A job must not throw, it would never finish.
+   */
+  template <typename F>
+  void runStage(AssetRequest& request, const char* stage, F&& function) {
+    try {
+      function();
+    } catch (const std::exception& error) {
+      logError("could not {} asset {}: {}", stage, request.name, error.what());
+      request.failed = true;
+    } catch (...) {
+      logError("could not {} asset {}", stage, request.name);
+      request.failed = true;
+    }
+  }
+
+  void openAsset(AssetRequest& request) {
+    runStage(request, "open", [&request]() {
+      request.reader =
+        ResourceReader::make(request.name.c_str(), request.access);
+    });
+  }
+
+  /**
+   * @brief Whether the AssetCache can store assets of the type.
+   */
+  template <typename T>
+  constexpr bool kCacheable =
+    std::is_same_v<T, Texture> || std::is_same_v<T, Mesh>;
+} // namespace
+
+AssetLoader::AssetLoader(JobSystem* jobSystem) : mJobSystem(jobSystem) {}
+
+AssetLoader::~AssetLoader() { waitForAll(); }
+
+void AssetLoader::setCache(AssetCache* cache) { mCache = cache; }
+
+AssetCache* AssetLoader::getCache() const { return mCache; }
+
+void AssetLoader::setReloading(bool isReloading) {
+  mIsReloading = isReloading;
+}
+
+AssetFuture<Texture> AssetLoader::loadTexture(
+  const char* name, Converter<Texture> convert, const std::string& recipe
+) {
+  // without a recipe, the result of the conversion can't be identified
+  auto cache = convert && recipe.empty() ? nullptr : mCache;
+
+  return AssetFuture<Texture>(scheduleRequest<Texture>(
+    AssetRequest::kTexture, name, Image::decode, std::move(convert), cache,
+    recipe
+  ));
+}
+
+AssetFuture<Texture>
+AssetLoader::loadTexture(const char* name, Canvas* canvas, int slot) {
+  auto future = loadTexture(name);
+
+  future.then([canvas, slot](std::shared_ptr<Texture> texture) {
+    if (texture) {
+      canvas->uploadTexture(slot, std::shared_ptr<const Texture>(texture));
+    }
+  });
+
+  return future;
+}
+
+AssetFuture<Mesh> AssetLoader::loadMesh(
+  const char* name, Converter<Mesh> convert, const std::string& recipe
+) {
+  auto cache = convert && recipe.empty() ? nullptr : mCache;
+
+  return AssetFuture<Mesh>(scheduleRequest<Mesh>(
+    AssetRequest::kMesh, name, decodeObj, std::move(convert), cache, recipe
+  ));
+}
+
+AssetFuture<SoundBuffer>
+AssetLoader::loadSoundBuffer(const char* name, Converter<SoundBuffer> convert) {
+  return AssetFuture<SoundBuffer>(scheduleRequest<SoundBuffer>(
+    AssetRequest::kSoundBuffer, name, Audio::decodeWav, std::move(convert)
+  ));
+}
+
+int AssetLoader::executePendingCallbacks() {
+  std::vector<RequestPtr> finished;
+
+  {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(mMutex);
+#endif
+    std::swap(finished, mFinished);
+
+    for (auto& request : finished) {
+      mInFlight.erase(std::find(mInFlight.begin(), mInFlight.end(), request));
+
+      auto shared = mShared.find({request->type, request->name});
+
+      if (shared != mShared.end() && shared->second == request) {
+        mShared.erase(shared);
+      }
+
+      ++mProgress.delivered;
+
+      if (request->failed) {
+        ++mProgress.failed;
+      }
+    }
+  }
+
+  for (auto& request : finished) {
+    request->delivered = true;
+
+    std::vector<std::function<void()>> callbacks;
+    std::swap(callbacks, request->callbacks);
+
+    for (auto& callback : callbacks) {
+      callback();
+    }
+  }
+
+  return static_cast<int>(finished.size());
+}
+
+void AssetLoader::waitForAll() {
+  std::vector<RequestPtr> inFlight;
+
+  {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(mMutex);
+#endif
+    inFlight = mInFlight;
+  }
+
+  for (auto& request : inFlight) {
+    mJobSystem->wait(request->job);
+  }
+}
+
+bool AssetLoader::isIdle() const {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  return mInFlight.empty();
+}
+
+AssetLoader::Progress AssetLoader::getProgress() const {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  return mProgress;
+}
+
+AssetLoader::RequestPtr AssetLoader::scheduleRequest(
+  AssetRequest::Type type, const char* name, Decoder decode,
+  std::function<void(const RequestPtr& request)> convert,
+  std::function<void(const RequestPtr& request)> store, bool shared
+) {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  shared = shared && !mIsReloading;
+
+  if (shared) {
+    auto existing = mShared.find({type, name});
+
+    if (existing != mShared.end()) {
+      return existing->second;
+    }
+  }
+
+  if (mInFlight.empty()) {
+    // start counting the progress of a new batch
+    mProgress = Progress();
+  }
+
+  ++mProgress.requested;
+
+  auto request = std::make_shared<AssetRequest>();
+  request->type = type;
+  request->name = name;
+  request->access = mIsReloading ? ResourceReader::kCopy : ResourceReader::kMap;
+
+  mInFlight.push_back(request);
+
+  if (shared) {
+    mShared[{type, name}] = request;
+  }
+
+  // With threads, scheduling never runs a job on this thread, so the lock
+  // can be held. Without threads, the jobs run right away and there is no
+  // lock.
+  auto open = mJobSystem->schedule([request]() { openAsset(*request); });
+
+  auto last = mJobSystem->schedule(
+    [request, decode]() {
+      if (!request->failed) {
+        runStage(*request, "decode", [&request, &decode]() {
+          if (!decode(request)) {
+            logError("could not decode asset {}", request->name);
+            request->failed = true;
+          }
+        });
+      }
+
+      request->reader.reset();
+    },
+    {open}
+  );
+
+  if (convert) {
+    last = mJobSystem->schedule(
+      [request, convert]() {
+        if (!request->failed && !request->fromCache) {
+          runStage(*request, "convert", [&request, &convert]() {
+            convert(request);
+          });
+        }
+      },
+      {last}
+    );
+  }
+
+  request->job = mJobSystem->schedule(
+    [this, request, store]() {
+      if (store && !request->failed && !request->fromCache) {
+        runStage(*request, "store", [&request, &store]() { store(request); });
+      }
+
+#ifdef LUNA_STD_THREAD
+      std::lock_guard finishedLock(mMutex);
+#endif
+      mFinished.push_back(request);
+    },
+    {last}
+  );
+
+  return request;
+}
+
+template <typename T>
+AssetLoader::RequestPtr AssetLoader::scheduleRequest(
+  AssetRequest::Type type, const char* name,
+  bool (*decode)(const uint8_t* data, std::size_t size, T& asset),
+  Converter<T> convert, AssetCache* cache, const std::string& recipe
+) {
+  bool shared = convert == nullptr;
+
+  auto decodeRequest = [decode, cache, recipe](const RequestPtr& request) {
+    auto asset = std::make_shared<T>();
+
+    auto& reader = request->reader;
+
+    if constexpr (kCacheable<T>) {
+      if (cache) {
+        request->cacheKey = AssetCache::makeKey(
+          AssetCache::hash(reader->getData(), reader->getSize()), recipe
+        );
+
+        if (cache->load(request->cacheKey, *asset)) {
+          request->asset = asset;
+          request->fromCache = true;
+
+          return true;
+        }
+      }
+    }
+
+    if (!decode(reader->getData(), reader->getSize(), *asset)) {
+      return false;
+    }
+
+    request->asset = asset;
+
+    return true;
+  };
+
+  std::function<void(const RequestPtr&)> convertRequest;
+
+  if (convert) {
+    convertRequest = [convert](const RequestPtr& request) {
+      convert(*std::static_pointer_cast<T>(request->asset));
+    };
+  }
+
+  std::function<void(const RequestPtr&)> storeRequest;
+
+  if constexpr (kCacheable<T>) {
+    if (cache) {
+      storeRequest = [cache](const RequestPtr& request) {
+        cache->store(
+          request->cacheKey, *std::static_pointer_cast<T>(request->asset)
+        );
+      };
+    }
+  }
+
+  return scheduleRequest(
+    type, name, decodeRequest, convertRequest, storeRequest, shared
+  );
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <libluna/config.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef LUNA_STD_THREAD
+#include <mutex>
+#endif
+
+#include <libluna/AssetCache.hpp>
+#include <libluna/JobSystem.hpp>
+#include <libluna/Mesh.hpp>
+#include <libluna/ResourceReader.hpp>
+#include <libluna/SoundBuffer.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  class Canvas;
+
+  namespace Internal {
+    /**
+     * @brief State of a single asset request, shared by all of its futures.
+     */
+    struct AssetRequest {
+      enum Type { kTexture, kMesh, kSoundBuffer };
+
+      Type type;
+      std::string name;
+
+      /**
+       * @brief Reader of the mapped file, closed after decoding.
+       */
+      ResourceReaderPtr reader;
+      ResourceReader::Access access{ResourceReader::kMap};
+      std::shared_ptr<void> asset;
+      bool failed{false};
+
+      /**
+       * @brief Key of the entry in the AssetCache, if the asset is cached.
+       */
+      uint64_t cacheKey{0};
+
+      /**
+       * @brief Whether the asset has been loaded from the AssetCache, so it
+       * is neither converted nor stored again.
+       */
+      bool fromCache{false};
+
+      /**
+       * @brief Handle of the last stage.
+       */
+      JobHandle job;
+
+      /**
+       * @name Main thread only
+       */
+      ///@{
+      bool delivered{false};
+      std::vector<std::function<void()>> callbacks;
+      ///@}
+    };
+  } // namespace Internal
+
+  /**
+   * @brief Result of an asset requested from the AssetLoader.
+   *
+   * The asset becomes available once the loader delivered it on the main
+   * thread, see AssetLoader::executePendingCallbacks(). Futures of the same
+   * request share the asset.
+   *
+   * @ingroup system
+   */
+  template <typename T> class AssetFuture {
+    public:
+    AssetFuture() = default;
+
+    /**
+     * @brief Check whether the future refers to a request.
+     */
+    bool isValid() const { return mRequest != nullptr; }
+
+    /**
+     * @brief Check whether the request has been delivered, whether it
+     * succeeded or not.
+     */
+    bool isReady() const { return mRequest && mRequest->delivered; }
+
+    bool hasFailed() const { return isReady() && mRequest->failed; }
+
+    /**
+     * @brief Get the asset or nullptr if it is not ready or has failed.
+     */
+    std::shared_ptr<T> get() const {
+      return isReady() ? std::static_pointer_cast<T>(mRequest->asset)
+                       : nullptr;
+    }
+
+    /**
+     * @brief Call @p callback on the main thread once the asset has been
+     * delivered.
+     *
+     * The callback receives nullptr if loading failed. If the asset has
+     * already been delivered, the callback is called right away. Must be
+     * called on the main thread.
+     */
+    void then(std::function<void(std::shared_ptr<T>)> callback) {
+      if (!mRequest) {
+        return;
+      }
+
+      if (mRequest->delivered) {
+        callback(get());
+        return;
+      }
+
+      // the callbacks are owned by the request, so it mustn't be captured
+      auto request = mRequest.get();
+
+      mRequest->callbacks.emplace_back([request, callback]() {
+        callback(std::static_pointer_cast<T>(request->asset));
+      });
+    }
+
+    private:
+    friend class AssetLoader;
+
+    explicit AssetFuture(std::shared_ptr<Internal::AssetRequest> request)
+        : mRequest(std::move(request)) {}
+
+    std::shared_ptr<Internal::AssetRequest> mRequest;
+  };
+
+  /**
+   * @brief Load assets in the background.
+   *
+   * Each request is split into stages that run as jobs on the JobSystem:
+   * opening the file using a ResourceReader, decoding it in place and,
+   * optionally,
+   * converting the result (e.g. quantizing a texture). The finished assets
+   * are queued until the application calls executePendingCallbacks(), which
+   * delivers them on the main thread, typically once per frame from
+   * update(). Thus, loading a level doesn't block rendering or audio.
+   *
+   * Requests for the same asset while a previous request is still in flight
+   * share the same result, so the file is only read and decoded once.
+   *
+   * With an AssetCache assigned, decoded and converted textures and meshes
+   * are stored on disk and loaded from there as long as the file has not
+   * changed, skipping the decoding and conversion.
+   *
+   * ```cpp
+   * auto font = loader.loadTexture("font.bmp", canvas, 1);
+   * auto music = loader.loadSoundBuffer("music.wav");
+   *
+   * music.then([](std::shared_ptr<Luna::SoundBuffer> buffer) {
+   *   // play it
+   * });
+   *
+   * // in update()
+   * loader.executePendingCallbacks();
+   * auto progress = loader.getProgress();
+   * ```
+   *
+   * @ingroup system
+   */
+  class AssetLoader {
+    public:
+    template <typename T> using Converter = std::function<void(T&)>;
+
+    /**
+     * @brief Number of requests since the loader was last idle.
+     */
+    struct Progress {
+      int requested{0};
+      int delivered{0};
+      int failed{0};
+
+      /**
+       * @brief Get the delivered fraction between 0 and 1.
+       */
+      float getFraction() const {
+        return requested == 0 ? 1.0f
+                              : static_cast<float>(delivered) /
+                                  static_cast<float>(requested);
+      }
+    };
+
+    explicit AssetLoader(JobSystem* jobSystem = JobSystem::getInstance());
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /**
+     * @brief Wait for the requests in flight.
+     *
+     * Assets not delivered yet are discarded.
+     */
+    ~AssetLoader();
+
+    /**
+     * @brief Use @p cache for the textures and meshes requested from now on.
+     *
+     * The cache must outlive the requests. Pass nullptr to stop caching.
+     */
+    void setCache(AssetCache* cache);
+
+    AssetCache* getCache() const;
+
+    /**
+     * @brief Load files that may change while being loaded.
+     *
+     * Requests are no longer shared, so each one reads the file anew instead
+     * of delivering a request started before the last change. Files are
+     * copied instead of mapped, so truncating them can't crash the loader.
+     */
+    void setReloading(bool isReloading);
+
+    /**
+     * @brief Load a BMP, TGA or QOI image.
+     *
+     * @param convert Optional conversion run in the background after
+     * decoding. Requests with a conversion are never shared.
+     * @param recipe Identifies the conversion for the AssetCache and must
+     * change whenever the conversion does. Converted textures are only
+     * cached if a recipe is given.
+     */
+    AssetFuture<Texture> loadTexture(
+      const char* name, Converter<Texture> convert = nullptr,
+      const std::string& recipe = ""
+    );
+
+    /**
+     * @brief Load an image and upload it to the canvas when delivered.
+     *
+     * The upload is enqueued on the main thread during
+     * executePendingCallbacks(), so the canvas must still exist then.
+     */
+    AssetFuture<Texture> loadTexture(const char* name, Canvas* canvas, int slot);
+
+    /**
+     * @brief Load a Wavefront OBJ mesh.
+     *
+     * @param recipe See loadTexture().
+     */
+    AssetFuture<Mesh> loadMesh(
+      const char* name, Converter<Mesh> convert = nullptr,
+      const std::string& recipe = ""
+    );
+
+    /**
+     * @brief Load a WAVE file.
+     */
+    AssetFuture<SoundBuffer>
+    loadSoundBuffer(const char* name, Converter<SoundBuffer> convert = nullptr);
+
+    /**
+     * @brief Deliver the assets finished in the background and call their
+     * callbacks.
+     *
+     * Must be called on the main thread.
+     *
+     * @return The number of requests delivered.
+     */
+    int executePendingCallbacks();
+
+    /**
+     * @brief Block until all requests have finished in the background.
+     *
+     * They still need to be delivered with executePendingCallbacks().
+     */
+    void waitForAll();
+
+    /**
+     * @brief Check whether all requests have been delivered.
+     */
+    bool isIdle() const;
+
+    Progress getProgress() const;
+
+    private:
+    using RequestPtr = std::shared_ptr<Internal::AssetRequest>;
+    using Key = std::pair<Internal::AssetRequest::Type, std::string>;
+    using Decoder = std::function<bool(const RequestPtr& request)>;
+
+    /**
+     * @brief Find the request in flight or schedule a new one.
+     */
+    RequestPtr scheduleRequest(
+      Internal::AssetRequest::Type type, const char* name, Decoder decode,
+      std::function<void(const RequestPtr& request)> convert,
+      std::function<void(const RequestPtr& request)> store, bool shared
+    );
+
+    /**
+     * @param cache Cache to use, nullptr to neither load nor store.
+     */
+    template <typename T>
+    RequestPtr scheduleRequest(
+      Internal::AssetRequest::Type type, const char* name,
+      bool (*decode)(const uint8_t* data, std::size_t size, T& asset),
+      Converter<T> convert, AssetCache* cache = nullptr,
+      const std::string& recipe = ""
+    );
+
+    JobSystem* mJobSystem;
+    AssetCache* mCache{nullptr};
+    bool mIsReloading{false};
+
+#ifdef LUNA_STD_THREAD
+    mutable std::mutex mMutex;
+#endif
+
+    /**
+     * @brief All requests not delivered yet.
+     */
+    std::vector<RequestPtr> mInFlight;
+
+    /**
+     * @brief Shareable requests not delivered yet.
+     */
+    std::map<Key, RequestPtr> mShared;
+
+    /**
+     * @brief Requests finished in the background, waiting to be delivered.
+     */
+    std::vector<RequestPtr> mFinished;
+
+    Progress mProgress;
+  };
+} // namespace Luna
@@ -0,0 +1,282 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef N64
+#include <libdragon.h>
+#endif
+
+#include <libluna/Application.hpp>
+#include <libluna/AssetLoader.hpp>
+#include <libluna/Audio/WavDecoder.hpp>
+#include <libluna/ObjDecoder.hpp>
+#include <libluna/PackFormat.hpp>
+#include <libluna/ResourceReader.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+
+#ifdef __SWITCH__
+static const char* assetsPath = "romfs:/assets";
+#elif defined(N64)
+static const char* assetsPath = "rom:/assets";
+#else
+static const char* assetsPath = "data/assets";
+#endif
+
+/**
+ * The loader reads the assets using a ResourceReader, which needs an
+ * application context.
+ */
+class TestApp : public Application {
+  public:
+  using Application::Application;
+
+  protected:
+  void init() override final {}
+  void update(float) override final {}
+};
+
+static void append(std::vector<uint8_t>& data, const char* text) {
+  data.insert(data.end(), text, text + std::strlen(text));
+}
+
+static void appendLe(std::vector<uint8_t>& data, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+  }
+}
+
+static std::vector<uint8_t> makeStereoWav() {
+  std::vector<uint8_t> data;
+  append(data, "RIFF");
+  appendLe(data, 36 + 8, 4);
+  append(data, "WAVE");
+  append(data, "fmt ");
+  appendLe(data, 16, 4);
+  appendLe(data, 1, 2);         // PCM
+  appendLe(data, 2, 2);         // channels
+  appendLe(data, 22050, 4);     // frame rate
+  appendLe(data, 22050 * 4, 4); // bytes per second
+  appendLe(data, 4, 2);         // bytes per frame
+  appendLe(data, 16, 2);        // bits per sample
+  append(data, "data");
+  appendLe(data, 8, 4);
+  appendLe(data, 0x4000, 2);
+  appendLe(data, 0x4000, 2);
+  appendLe(data, 0x8000, 2); // -1.0
+  appendLe(data, 0x0000, 2);
+
+  return data;
+}
+
+int main(int, char**) {
+#ifdef N64
+  dfs_init(DFS_DEFAULT_LOCATION);
+#endif
+
+  TEST("decodeWav() mixes down to mono", []() {
+    auto file = makeStereoWav();
+    SoundBuffer buffer;
+
+    ASSERT(Audio::decodeWav(file.data(), file.size(), buffer), "decoded");
+    ASSERT_EQL(static_cast<int>(buffer.getSamples().size()), 2, "frames");
+    ASSERT_EQL(buffer.getSamples()[0], 0.5f, "first frame");
+    ASSERT_EQL(buffer.getSamples()[1], -0.5f, "second frame");
+    ASSERT_EQL(buffer.getFrameRate(), 22050, "frame rate");
+  });
+
+  TEST("decodeObj() splits polygons into triangles", []() {
+    const char* text = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                       "f 1 2 3 4\nf -4 -2 -1\n";
+    Mesh mesh;
+
+    ASSERT(
+      decodeObj(
+        reinterpret_cast<const uint8_t*>(text), std::strlen(text), mesh
+      ),
+      "decoded"
+    );
+    ASSERT_EQL(static_cast<int>(mesh.getVertices().size()), 4, "vertices");
+    ASSERT_EQL(static_cast<int>(mesh.getNormals().size()), 4, "normals");
+    ASSERT_EQL(static_cast<int>(mesh.getFaces().size()), 3, "faces");
+    ASSERT_EQL(static_cast<int>(mesh.getFaces()[1][2]), 3, "fan");
+    ASSERT_EQL(static_cast<int>(mesh.getFaces()[2][1]), 2, "relative index");
+  });
+
+  TEST("load and deliver assets", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+    AssetLoader loader;
+
+    auto texture = loader.loadTexture("coin_24bpp.bmp");
+    auto sameTexture = loader.loadTexture("coin_24bpp.bmp");
+    auto mesh = loader.loadMesh("quad.obj");
+    auto missing = loader.loadSoundBuffer("missing.wav");
+
+    int callbacks = 0;
+    mesh.then([&](std::shared_ptr<Mesh> result) {
+      ASSERT(result != nullptr, "mesh in callback");
+      ++callbacks;
+    });
+
+    ASSERT_EQL(loader.getProgress().requested, 3, "deduplicated");
+
+    loader.waitForAll();
+    ASSERT(!texture.isReady(), "not delivered before the callbacks");
+
+    ASSERT_EQL(loader.executePendingCallbacks(), 3, "delivered");
+    ASSERT(loader.isIdle(), "idle");
+    ASSERT_EQL(callbacks, 1, "callback called");
+
+    ASSERT(texture.get() == sameTexture.get(), "shared texture");
+    ASSERT_EQL(texture.get()->getBitsPerPixel(), 24, "texture format");
+    ASSERT_EQL(
+      static_cast<int>(mesh.get()->getFaces().size()), 2, "mesh faces"
+    );
+    ASSERT(missing.hasFailed(), "missing file failed");
+
+    auto progress = loader.getProgress();
+    ASSERT_EQL(progress.delivered, 3, "progress delivered");
+    ASSERT_EQL(progress.failed, 1, "progress failed");
+  });
+
+  TEST("convert in the background", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+    AssetLoader loader;
+
+    auto texture = loader.loadTexture("coin_24bpp.bmp", [](Texture& result) {
+      result = Texture(32, result.getSize());
+    });
+
+    loader.waitForAll();
+    loader.executePendingCallbacks();
+
+    ASSERT_EQL(texture.get()->getBitsPerPixel(), 32, "converted");
+  });
+
+  TEST("reload without sharing requests", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+    AssetLoader loader;
+    loader.setReloading(true);
+
+    auto mesh = loader.loadMesh("quad.obj");
+    auto reloaded = loader.loadMesh("quad.obj");
+
+    ASSERT_EQL(loader.getProgress().requested, 2, "not deduplicated");
+
+    loader.waitForAll();
+    loader.executePendingCallbacks();
+
+    ASSERT(mesh.get() != nullptr, "copied file decoded");
+    ASSERT(mesh.get() != reloaded.get(), "separate meshes");
+  });
+
+  TEST("fail requests whose stages throw", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+    AssetLoader loader;
+
+    auto texture = loader.loadTexture("coin_24bpp.bmp", [](Texture&) {
+      throw std::runtime_error("conversion failed");
+    });
+
+    loader.waitForAll();
+    loader.executePendingCallbacks();
+
+    ASSERT(texture.hasFailed(), "failed");
+    ASSERT(loader.isIdle(), "finished");
+  });
+
+  TEST("load from a mounted pack", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+
+    auto wav = makeStereoWav();
+    Pack::Builder builder;
+    builder.add("sounds/stereo.wav", wav);
+
+    auto coin = ResourceReader::make("coin_24bpp.bmp");
+    builder.add(
+      "sprites/coin.bmp",
+      std::vector<uint8_t>(coin->getData(), coin->getData() + coin->getSize()),
+      Pack::kLz
+    );
+    auto pack = builder.build();
+
+    const char* packPath = "AssetLoader.test.lpak";
+    std::ofstream(packPath, std::ios::binary)
+      .write(
+        reinterpret_cast<const char*>(pack.data()),
+        static_cast<std::streamsize>(pack.size())
+      );
+    ASSERT(ResourceReader::mount(packPath), "mounted");
+
+    AssetLoader loader;
+    auto sound = loader.loadSoundBuffer("sounds/stereo.wav");
+    auto texture = loader.loadTexture("coin_24bpp.bmp");
+    auto compressedTexture = loader.loadTexture("sprites/coin.bmp");
+    loader.waitForAll();
+    loader.executePendingCallbacks();
+
+    ResourceReader::unmountAll();
+    std::remove(packPath);
+
+    ASSERT(sound.get() != nullptr, "sound from pack");
+    ASSERT_EQL(sound.get()->getFrameRate(), 22050, "frame rate");
+    ASSERT(texture.get() != nullptr, "texture from directory");
+    ASSERT(compressedTexture.get() != nullptr, "compressed texture from pack");
+    ASSERT(
+      compressedTexture.get()->getWidth() == texture.get()->getWidth(),
+      "same width"
+    );
+  });
+
+  TEST("load converted assets from the cache", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+    const char* cachePath = "AssetLoader.test.cache";
+    std::filesystem::remove_all(cachePath);
+
+    AssetCache cache(cachePath);
+    int conversions = 0;
+    auto convert = [&conversions](Texture& result) {
+      result = Texture(32, result.getSize());
+      ++conversions;
+    };
+
+    for (int run = 0; run < 2; ++run) {
+      AssetLoader loader;
+      loader.setCache(&cache);
+
+      auto texture = loader.loadTexture("coin_24bpp.bmp", convert, "rgb32");
+      auto mesh = loader.loadMesh("quad.obj");
+      auto uncached = loader.loadTexture("coin_24bpp.bmp", convert);
+      loader.waitForAll();
+      loader.executePendingCallbacks();
+
+      ASSERT_EQL(texture.get()->getBitsPerPixel(), 32, "converted");
+      ASSERT_EQL(
+        static_cast<int>(mesh.get()->getFaces().size()), 2, "mesh faces"
+      );
+      ASSERT(uncached.get() != nullptr, "without a recipe");
+    }
+
+    // the conversion without a recipe runs every time
+    ASSERT_EQL(conversions, 3, "conversions");
+
+    auto stats = cache.getStats();
+    ASSERT_EQL(stats.misses, 2, "misses");
+    ASSERT_EQL(stats.stores, 2, "stores");
+    ASSERT_EQL(stats.hits, 2, "hits");
+
+    std::filesystem::remove_all(cachePath);
+  });
+
+  return runTests();
+}
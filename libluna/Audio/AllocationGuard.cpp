@@ -0,0 +1,54 @@
+#include <libluna/Audio/AllocationGuard.hpp>
+
+#ifdef LUNA_AUDIO_ALLOCATION_GUARD
+#include <cassert>
+#include <cstdlib> // malloc, free
+#include <new>
+#endif
+
+using namespace Luna::Audio;
+
+namespace {
+  /**
+   * @brief Number of guards on the current thread.
+   *
+   * Constant-initialized, so accessing it never allocates.
+   */
+  thread_local int gGuardDepth = 0;
+} // namespace
+
+AllocationGuard::AllocationGuard() { ++gGuardDepth; }
+
+AllocationGuard::~AllocationGuard() { --gGuardDepth; }
+
+bool AllocationGuard::isActive() { return gGuardDepth > 0; }
+
+#ifdef LUNA_AUDIO_ALLOCATION_GUARD
+// Replacing the plain forms is sufficient, the array and nothrow forms call
+// them.
+void* operator new(std::size_t size) {
+  assert(gGuardDepth == 0 && "memory allocated within an AllocationGuard");
+
+  if (size == 0) {
+    size = 1;
+  }
+
+  while (true) {
+    if (void* memory = std::malloc(size)) {
+      return memory;
+    }
+
+    auto handler = std::get_new_handler();
+
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+
+    handler();
+  }
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+#endif
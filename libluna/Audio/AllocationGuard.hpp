@@ -0,0 +1,45 @@
+#pragma once
+
+#include <libluna/config.h>
+
+/**
+ * @brief Defined if allocating while an AllocationGuard exists fails an
+ * assertion.
+ *
+ * This is the case for debug builds with threads configured with the CMake
+ * option `LUNA_ALLOCATION_GUARD`, where the global `operator new` is
+ * replaced to check the guard. The option is off by default, as the
+ * replacement applies to the whole application and conflicts with its own.
+ */
+#if defined(LUNA_ALLOCATION_GUARD) && !defined(NDEBUG) && \
+  defined(LUNA_STD_THREAD)
+#define LUNA_AUDIO_ALLOCATION_GUARD
+#endif
+
+namespace Luna::Audio {
+  /**
+   * @brief Forbid allocating memory on the current thread while the guard
+   * exists.
+   *
+   * The audio callback renders the nodes within a guard. Allocating memory
+   * may wait for a lock held by another thread, which results in dropouts, so
+   * nodes must allocate their buffers before rendering.
+   *
+   * If enabled (see @ref LUNA_AUDIO_ALLOCATION_GUARD), any allocation using
+   * `operator new` fails an assertion. Otherwise, the guard does nothing.
+   *
+   * Guards may be nested.
+   */
+  class AllocationGuard {
+    public:
+    AllocationGuard();
+    AllocationGuard(const AllocationGuard&) = delete;
+    AllocationGuard& operator=(const AllocationGuard&) = delete;
+    ~AllocationGuard();
+
+    /**
+     * @brief Check whether allocating is forbidden on the current thread.
+     */
+    static bool isActive();
+  };
+} // namespace Luna::Audio
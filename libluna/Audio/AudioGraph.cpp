@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstring>
+
+#include <libluna/Audio/AudioGraph.hpp>
+#include <libluna/Audio/Dsp.hpp>
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+AudioGraph::AudioGraph(
+  const AudioNodePtr& destination, int maxFrameCount, int channelCount
+)
+    : mMaxFrameCount(maxFrameCount), mChannelCount(channelCount) {
+  std::unordered_set<AudioNode*> visiting;
+  std::unordered_map<AudioNode*, std::size_t> steps;
+
+  // the destination is the last step
+  addNode(destination.get(), visiting, steps);
+
+  mBuffers.resize(
+    mSteps.size() * static_cast<std::size_t>(maxFrameCount * channelCount)
+  );
+}
+
+AudioGraph::~AudioGraph() = default;
+
+void AudioGraph::render(float* buffer, int frameCount) {
+  auto sampleCount = static_cast<std::size_t>(frameCount * mChannelCount);
+
+  if (mSteps.empty()) {
+    std::fill(buffer, buffer + sampleCount, 0.0f);
+    return;
+  }
+
+  for (int offset = 0; offset < frameCount; offset += mMaxFrameCount) {
+    int chunkFrameCount = std::min(mMaxFrameCount, frameCount - offset);
+    auto chunkSampleCount =
+      static_cast<std::size_t>(chunkFrameCount * mChannelCount);
+
+    for (std::size_t i = 0; i < mSteps.size(); ++i) {
+      const auto& step = mSteps[i];
+      float* output = getBuffer(i);
+
+      if (step.inputCount == 0) {
+        std::fill(output, output + chunkSampleCount, 0.0f);
+      } else {
+        const auto* inputs = mInputs.data() + step.firstInput;
+
+        std::memcpy(
+          output, getBuffer(inputs[0]), chunkSampleCount * sizeof(float)
+        );
+
+        for (std::size_t input = 1; input < step.inputCount; ++input) {
+          Dsp::mixAdd(output, getBuffer(inputs[input]), chunkSampleCount);
+        }
+      }
+
+      step.node->render(output, chunkFrameCount);
+    }
+
+    std::memcpy(
+      buffer + offset * mChannelCount, getBuffer(mSteps.size() - 1),
+      chunkSampleCount * sizeof(float)
+    );
+  }
+}
+
+std::size_t AudioGraph::getNodeCount() const { return mSteps.size(); }
+
+std::size_t AudioGraph::addNode(
+  AudioNode* node, std::unordered_set<AudioNode*>& visiting,
+  std::unordered_map<AudioNode*, std::size_t>& steps
+) {
+  visiting.insert(node);
+
+  std::vector<std::size_t> inputs;
+
+  for (auto& input : node->mInputs) {
+    if (visiting.count(input.get())) {
+      logWarn("ignoring audio node connection forming a cycle");
+      continue;
+    }
+
+    auto step = steps.find(input.get());
+
+    inputs.push_back(
+      step != steps.end() ? step->second
+                          : addNode(input.get(), visiting, steps)
+    );
+  }
+
+  visiting.erase(node);
+
+  std::size_t index = mSteps.size();
+  mSteps.push_back({node, mInputs.size(), inputs.size()});
+  mInputs.insert(mInputs.end(), inputs.begin(), inputs.end());
+  mNodes.push_back(node->shared_from_this());
+  steps[node] = index;
+
+  return index;
+}
+
+float* AudioGraph::getBuffer(std::size_t step) {
+  return mBuffers.data() +
+         step * static_cast<std::size_t>(mMaxFrameCount * mChannelCount);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <libluna/Audio/AudioNode.hpp>
+
+namespace Luna::Audio {
+  /**
+   * @brief Audio nodes compiled into a flat schedule.
+   *
+   * The nodes leading to the destination node are sorted so that every node
+   * comes after its inputs. Each node has its own buffer, which receives the
+   * sum of the buffers of its inputs before the node processes it in place.
+   * A node connected to multiple destinations is rendered only once, its
+   * buffer is read by all of them.
+   *
+   * Rendering iterates the schedule once per block, without recursion and
+   * without allocating memory.
+   *
+   * The graph holds references to its nodes, so they stay alive while the
+   * graph is in use.
+   *
+   * @see AudioManager
+   */
+  class AudioGraph {
+    public:
+    /**
+     * @brief Compile the nodes leading to @p destination.
+     *
+     * @param maxFrameCount Number of frames rendered at once, larger requests
+     * are rendered in parts.
+     *
+     * Connections forming a cycle are ignored.
+     */
+    AudioGraph(
+      const AudioNodePtr& destination, int maxFrameCount, int channelCount
+    );
+    AudioGraph(const AudioGraph&) = delete;
+    AudioGraph& operator=(const AudioGraph&) = delete;
+    ~AudioGraph();
+
+    /**
+     * @brief Render @p frameCount frames of the destination into @p buffer.
+     */
+    void render(float* buffer, int frameCount);
+
+    /**
+     * @brief Get the number of nodes rendered per block.
+     */
+    std::size_t getNodeCount() const;
+
+    private:
+    struct Step {
+      AudioNode* node;
+
+      /**
+       * @brief Range within mInputs of the steps this step reads from.
+       */
+      std::size_t firstInput;
+      std::size_t inputCount;
+    };
+
+    /**
+     * @brief Add @p node after its inputs and get its step.
+     */
+    std::size_t addNode(
+      AudioNode* node, std::unordered_set<AudioNode*>& visiting,
+      std::unordered_map<AudioNode*, std::size_t>& steps
+    );
+
+    float* getBuffer(std::size_t step);
+
+    std::vector<AudioNodePtr> mNodes;
+    std::vector<Step> mSteps;
+    std::vector<std::size_t> mInputs;
+    std::vector<float> mBuffers;
+    int mMaxFrameCount;
+    int mChannelCount;
+  };
+} // namespace Luna::Audio
@@ -0,0 +1,124 @@
+#include <memory>
+#include <vector>
+
+#include <libluna/Audio/AudioGraph.hpp>
+#include <libluna/Audio/AudioManager.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  /**
+   * @brief Add a constant to its input and count how often it is rendered.
+   */
+  class ConstantNode : public AudioNode {
+    public:
+    ConstantNode(AudioManager* manager, float value)
+        : AudioNode(manager), mValue(value) {}
+
+    void render(float* buffer, int frameCount) override {
+      ++mRenderCount;
+
+      for (int i = 0; i < frameCount * getChannelCount(); ++i) {
+        buffer[i] += mValue;
+      }
+    }
+
+    int getRenderCount() const { return mRenderCount; }
+
+    private:
+    float mValue;
+    int mRenderCount{0};
+  };
+} // namespace
+
+int main(int, char**) {
+  TEST("sum the inputs", []() {
+    AudioManager manager;
+    auto first = std::make_shared<ConstantNode>(&manager, 1.0f);
+    auto second = std::make_shared<ConstantNode>(&manager, 2.0f);
+    auto gain = manager.createGain(0.5f);
+    first->connect(gain);
+    second->connect(gain);
+    gain->connect(manager.getDestinationNode());
+
+    // the voice mixer is connected to the destination, too
+    AudioGraph graph(manager.getDestinationNode(), 16, 2);
+    ASSERT(graph.getNodeCount() == 5, "node count");
+
+    std::vector<float> buffer(40 * 2);
+    graph.render(buffer.data(), 40);
+
+    ASSERT_EQL(buffer[0], 1.5f, "first sample");
+    ASSERT_EQL(buffer[79], 1.5f, "last sample");
+    ASSERT_EQL(first->getRenderCount(), 3, "rendered in parts");
+  });
+
+  TEST("render shared nodes once", []() {
+    AudioManager manager;
+    auto source = std::make_shared<ConstantNode>(&manager, 1.0f);
+    auto left = std::make_shared<ConstantNode>(&manager, 10.0f);
+    auto right = std::make_shared<ConstantNode>(&manager, 100.0f);
+    source->connect(left);
+    source->connect(right);
+    source->connect(right); // connected already
+    left->connect(manager.getDestinationNode());
+    right->connect(manager.getDestinationNode());
+
+    AudioGraph graph(manager.getDestinationNode(), 64, 2);
+    ASSERT(graph.getNodeCount() == 5, "node count");
+
+    std::vector<float> buffer(8 * 2);
+    graph.render(buffer.data(), 8);
+
+    ASSERT_EQL(buffer[0], 112.0f, "sample");
+    ASSERT_EQL(source->getRenderCount(), 1, "rendered once");
+
+    source->disconnect(right);
+    AudioGraph changed(manager.getDestinationNode(), 64, 2);
+    changed.render(buffer.data(), 8);
+
+    ASSERT_EQL(buffer[0], 111.0f, "disconnected");
+  });
+
+  TEST("ignore cycles", []() {
+    AudioManager manager;
+    auto first = std::make_shared<ConstantNode>(&manager, 1.0f);
+    auto second = std::make_shared<ConstantNode>(&manager, 2.0f);
+    first->connect(second);
+    second->connect(first);
+    second->connect(manager.getDestinationNode());
+
+    AudioGraph graph(manager.getDestinationNode(), 64, 2);
+    ASSERT(graph.getNodeCount() == 4, "node count");
+
+    std::vector<float> buffer(8 * 2);
+    graph.render(buffer.data(), 8);
+
+    ASSERT_EQL(buffer[15], 3.0f, "sample");
+
+    first->disconnect();
+  });
+
+  TEST("apply changes with the update", []() {
+    AudioManager manager;
+    auto source = std::make_shared<ConstantNode>(&manager, 0.25f);
+    std::vector<float> buffer(8 * 2, 1.0f);
+
+    source->connect(manager.getDestinationNode());
+    manager.render(buffer.data(), 8);
+    ASSERT_EQL(buffer[0], 0.0f, "silent before the update");
+
+    manager.update();
+    manager.render(buffer.data(), 8);
+    ASSERT_EQL(buffer[0], 0.25f, "audible after the update");
+
+    source->disconnect();
+    manager.update();
+    manager.render(buffer.data(), 8);
+    ASSERT_EQL(buffer[0], 0.0f, "silent after disconnecting");
+  });
+
+  return runTests();
+}
@@ -1,9 +1,9 @@
 #include <libluna/config.h>
 
 #include <algorithm>
-#include <future>
+#include <cmath>
+#include <limits>
 #include <list>
-#include <queue>
 
 #ifdef LUNA_AUDIO_SDL2
 #include <SDL2/SDL.h>
@@ -14,8 +14,8 @@
 #endif
 
 #include <libluna/Application.hpp>
+#include <libluna/Audio/AllocationGuard.hpp>
 #include <libluna/Audio/AudioManager.hpp>
-#include <libluna/Command.hpp>
 #include <libluna/Logger.hpp>
 
 using namespace Luna;
@@ -25,23 +25,22 @@ using namespace Luna::Audio;
 constexpr int kInternalBufferCount = 4;
 #endif
 
+/**
+ * @brief Frames per audio callback requested from the device.
+ */
+constexpr int kBufferFrameCount = 4096;
+
+/**
+ * @brief Node receiving the mix of all nodes connected to it.
+ *
+ * The compiled graph has already summed the inputs, so there is nothing left
+ * to do.
+ */
 class DestinationAudioNode : public AudioNode {
   public:
   DestinationAudioNode(AudioManager* manager) : AudioNode(manager) {}
-  void render(float* buffer, int frameCount) override {
-    int sampleCount = frameCount * 2;
-    std::fill(buffer, buffer + sampleCount, 0.0f);
-    std::vector<float> mixBuffer(sampleCount);
-
-    for (auto&& input : mInputs) {
-      input->render(mixBuffer.data(), frameCount);
-
-      std::transform(
-        buffer, buffer + sampleCount, mixBuffer.data(), buffer,
-        [](float a, float b) { return a + b; }
-      );
-    }
-  }
+
+  void render(float*, int) override {}
 };
 
 namespace {
@@ -49,11 +48,18 @@ namespace {
 
   [[maybe_unused]] void
   audioCallback(void* userData, std::uint8_t* stream, int byteCount) {
-    auto metrics = &AudioManager::getInstance()->getMetrics();
+    // SDL calls back on the same thread, so the identifier is only set once
+    static thread_local bool isIdentified = false;
+
+    if (!isIdentified) {
+      Logger::getInstance().setThreadIdentifier("audio");
+      isIdentified = true;
+    }
+
+    AllocationGuard guard;
 
-    Logger::getInstance().setThreadIdentifier("audio");
-    auto destinationNode = reinterpret_cast<DestinationAudioNode*>(userData);
-    auto audioManager = AudioManager::getInstance();
+    auto audioManager = reinterpret_cast<AudioManager*>(userData);
+    auto metrics = &audioManager->getMetrics();
 
     auto sampleCount = byteCount / sizeof(float);
     auto frameCount = sampleCount / audioManager->getChannelCount();
@@ -63,7 +69,7 @@ namespace {
 
     metrics->renderTicker.tick();
 
-    destinationNode->render(
+    audioManager->render(
       reinterpret_cast<float*>(stream), static_cast<int>(frameCount)
     );
 
@@ -80,6 +86,12 @@ AudioManager::AudioManager() {
   mTime = 0.0;
   mChannelCount = 2;
   mFrameRate = 48000.0f;
+  mGraphFrameCount = kBufferFrameCount;
+
+  mVoiceMixer = std::make_shared<VoiceMixer>(this);
+  mVoiceMixer->connect(mDestinationNode);
+
+  compileGraph();
 }
 
 AudioManager::~AudioManager() = default;
@@ -88,36 +100,40 @@ std::shared_ptr<AudioNode> AudioManager::getDestinationNode() const {
   return mDestinationNode;
 }
 
+std::shared_ptr<VoiceMixer> AudioManager::getVoiceMixer() const {
+  return mVoiceMixer;
+}
+
 void AudioManager::init() {
+  open();
+  start();
+}
+
+void AudioManager::open() {
 #ifdef LUNA_AUDIO_SDL2
-  SDL_AudioSpec desired, obtained;
+  SDL_AudioSpec desired;
 
   desired.freq = static_cast<int>(getFrameRate());
   desired.format = AUDIO_F32;
   desired.channels = static_cast<uint8_t>(getChannelCount());
-  desired.samples = 4096; /* sample FRAMES (channels combined) */
+  desired.samples = kBufferFrameCount; /* sample FRAMES (channels combined) */
   desired.callback = audioCallback;
-  desired.userdata = mDestinationNode.get();
+  desired.userdata = this;
 
+  // the device stays paused until start()
   mSdlAudioDeviceId = SDL_OpenAudioDevice(
     nullptr, /* use suitable device */
     false,   /* no capture */
-    &desired, &obtained, 0
+    &desired, &mSdlAudioSpec, 0
   );
 
-  mFrameRate = static_cast<float>(obtained.freq);
-  mChannelCount = obtained.channels;
-
   logDebug(
-    "obtained format: {}Hz, {} channels, {} ({})", obtained.freq,
-    obtained.channels, obtained.format, AUDIO_F32
+    "obtained format: {}Hz, {} channels, {} ({})", mSdlAudioSpec.freq,
+    mSdlAudioSpec.channels, mSdlAudioSpec.format, AUDIO_F32
   );
 
   if (mSdlAudioDeviceId == 0) {
     logError(SDL_GetError());
-  } else {
-    SDL_PauseAudioDevice(mSdlAudioDeviceId, false);
-    logInfo("audio opened");
   }
 #endif
 #ifdef N64
@@ -130,19 +146,53 @@ void AudioManager::init() {
 #endif
 }
 
-void AudioManager::update() {
+void AudioManager::start() {
 #ifdef LUNA_AUDIO_SDL2
-  SDL_LockAudioDevice(mSdlAudioDeviceId);
+  if (mSdlAudioDeviceId == 0) {
+    return;
+  }
+
+  mFrameRate = static_cast<float>(mSdlAudioSpec.freq);
+  mChannelCount = mSdlAudioSpec.channels;
+
+  // the callback must not allocate, so the buffers are prepared for the
+  // obtained block size
+  mGraphFrameCount = mSdlAudioSpec.samples;
+  compileGraph();
+
+  SDL_PauseAudioDevice(mSdlAudioDeviceId, false);
+  logInfo("audio opened");
 #endif
-  while (!mCommandQueue.empty()) {
-    auto command = mCommandQueue.front();
-    mCommandQueue.pop();
-    command->execute();
+}
+
+void AudioManager::update() {
+  if (mIsGraphInvalid) {
+    compileGraph();
   }
+
+  // the audio thread executes the commands pushed so far at the start of the
+  // same block, using the graph compiled above
+  mPublishedCommandCount.store(
+    mPushedCommandCount, std::memory_order_release
+  );
+
 #ifdef LUNA_AUDIO_SDL2
-  SDL_UnlockAudioDevice(mSdlAudioDeviceId);
+  if (mSdlAudioDeviceId == 0) {
+    // without a device, neither commands nor voices would ever finish
+    discardCommands();
+  }
 #endif
+
 #ifdef N64
+  // the nodes aren't rendered by an audio thread here
+  executeCommands(
+    std::numeric_limits<std::uint64_t>::max(),
+    std::numeric_limits<std::uint64_t>::max()
+  );
+#endif
+
+  releaseGraphs();
+
   for (auto it = mPlayingSounds.begin(); it != mPlayingSounds.end();) {
     auto sound = *it;
     if (!sound->isPlaying()) {
@@ -152,7 +202,7 @@ void AudioManager::update() {
       ++it;
     }
   }
-
+#ifdef N64
   for (int i = 0; i < kInternalBufferCount; i++) {
     mixer_try_play();
   }
@@ -171,6 +221,26 @@ void AudioManager::free() {
 #endif
 }
 
+void AudioManager::render(float* buffer, int frameCount) {
+  auto endFrame = mRenderedFrameCount + static_cast<std::uint64_t>(frameCount);
+
+  // split the block at the frames where commands are due
+  for (int offset = 0; offset < frameCount;) {
+    auto frame = mRenderedFrameCount + static_cast<std::uint64_t>(offset);
+    auto chunkFrameCount =
+      static_cast<int>(executeCommands(frame, endFrame) - frame);
+
+    // loaded after the commands, as they may rely on the graph published with
+    // them
+    auto graph = mGraph.load();
+    graph->render(buffer + offset * mChannelCount, chunkFrameCount);
+    offset += chunkFrameCount;
+  }
+
+  mRenderedFrameCount = endFrame;
+  ++mRenderCount;
+}
+
 AudioManager* AudioManager::getInstance() { return gInstance; }
 
 double AudioManager::getTime() const { return mTime; }
@@ -179,13 +249,32 @@ int AudioManager::getChannelCount() const { return mChannelCount; }
 
 float AudioManager::getFrameRate() const { return mFrameRate; }
 
+#ifdef N64
 Sound* AudioManager::createSound() { return mSounds.acquire(); }
+#else
+Sound* AudioManager::createSound() {
+  return mSounds.acquire(mVoiceMixer.get());
+}
+#endif
+
+void AudioManager::destroySound(Sound* sound) {
+#ifndef N64
+  // the voice would keep playing otherwise
+  sound->stop();
+#endif
 
-void AudioManager::destroySound(Sound* sound) { mSounds.release(sound); }
+  mSounds.release(sound);
+}
 
 #ifdef N64
 void AudioManager::playSound(const char* source) {
   auto sound = createSound();
+
+  if (!sound) {
+    logWarn("too many sounds, not playing another one");
+    return;
+  }
+
   mPlayingSounds.push_front(sound);
 
   sound->setSource(source);
@@ -194,9 +283,15 @@ void AudioManager::playSound(const char* source) {
 #else
 void AudioManager::playSound(SoundBufferSource* source) {
   auto sound = createSound();
+
+  if (!sound) {
+    logWarn("too many sounds, not playing another one");
+    return;
+  }
+
   mPlayingSounds.push_front(sound);
 
-  sound->setSource(source);
+  sound->setSource(*source);
   sound->play();
 }
 #endif
@@ -217,3 +312,84 @@ AudioManager::createOscillator(float frequency, OscillatorNode::Type type) {
 Internal::AudioMetrics& AudioManager::getMetrics() { return mMetrics; }
 
 void AudioManager::advanceTime(double time) { mTime += time; }
+
+std::uint64_t AudioManager::getFrame(double time) const {
+  if (time <= 0.0) {
+    return 0;
+  }
+
+  return static_cast<std::uint64_t>(std::llround(time * mFrameRate));
+}
+
+bool AudioManager::countCommand(bool isPushed) {
+  if (isPushed) {
+    ++mPushedCommandCount;
+  } else {
+    logWarn("audio command queue is full, dropping command");
+  }
+
+  return isPushed;
+}
+
+std::uint64_t
+AudioManager::executeCommands(std::uint64_t frame, std::uint64_t endFrame) {
+  auto publishedCount = mPublishedCommandCount.load(std::memory_order_acquire);
+  std::uint64_t dueFrame;
+
+  while (mExecutedCommandCount != publishedCount &&
+         mCommandQueue.peekStamp(dueFrame)) {
+    if (dueFrame > frame) {
+      return std::min(dueFrame, endFrame);
+    }
+
+    mCommandQueue.executeNext();
+    ++mExecutedCommandCount;
+  }
+
+  return endFrame;
+}
+
+#ifdef LUNA_AUDIO_SDL2
+void AudioManager::discardCommands() {
+  executeCommands(
+    std::numeric_limits<std::uint64_t>::max(),
+    std::numeric_limits<std::uint64_t>::max()
+  );
+  mVoiceMixer->stopAll();
+
+  // no block uses the replaced graphs
+  ++mRenderCount;
+}
+#endif
+
+void AudioManager::invalidateGraph() { mIsGraphInvalid = true; }
+
+void AudioManager::compileGraph() {
+  auto graph = std::make_unique<AudioGraph>(
+    mDestinationNode, mGraphFrameCount, mChannelCount
+  );
+
+  mGraph.store(graph.get());
+
+  // the audio thread may still be rendering the previous graph
+  if (mCurrentGraph) {
+    mRetiredGraphs.push_back({std::move(mCurrentGraph), mRenderCount.load()});
+  }
+
+  mCurrentGraph = std::move(graph);
+  mIsGraphInvalid = false;
+}
+
+void AudioManager::releaseGraphs() {
+  auto renderCount = mRenderCount.load();
+
+  mRetiredGraphs.erase(
+    std::remove_if(
+      mRetiredGraphs.begin(), mRetiredGraphs.end(),
+      [=](const RetiredGraph& retired) {
+        return retired.renderCount != renderCount;
+      }
+    ),
+    mRetiredGraphs.end()
+  );
+}
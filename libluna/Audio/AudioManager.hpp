@@ -2,17 +2,23 @@
 
 #include <libluna/config.h>
 
+#include <atomic>
+#include <cstdint>
 #include <list>
-#include <queue>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #ifdef LUNA_AUDIO_SDL2
 #include <SDL2/SDL.h>
 #endif
 
+#include <libluna/Audio/AudioGraph.hpp>
 #include <libluna/Audio/DelayNode.hpp>
 #include <libluna/Audio/GainNode.hpp>
 #include <libluna/Audio/OscillatorNode.hpp>
-#include <libluna/Command.hpp>
+#include <libluna/Audio/VoiceMixer.hpp>
+#include <libluna/CommandQueue.hpp>
 #include <libluna/Internal/AudioMetrics.hpp>
 #include <libluna/Pool.hpp>
 #include <libluna/Sound.hpp>
@@ -30,11 +36,35 @@ namespace Luna::Audio {
     ~AudioManager();
     std::shared_ptr<AudioNode> getDestinationNode() const;
 
+    /**
+     * @brief Get the node playing the sounds, connected to the destination.
+     */
+    std::shared_ptr<VoiceMixer> getVoiceMixer() const;
+
     /**
      * @brief Initialize the audio system.
+     *
+     * Same as open() followed by start().
      */
     void init();
 
+    /**
+     * @brief Open the audio device without starting the playback.
+     *
+     * Opening the device may take a while, so it may be called on another
+     * thread while the application is initializing.
+     */
+    void open();
+
+    /**
+     * @brief Start the playback on the opened device.
+     *
+     * Must be called on the main thread after open() has returned. The frame
+     * rate and channel count of the device only apply from here on, as nodes
+     * may have been created using the previous ones in the meantime.
+     */
+    void start();
+
     /**
      * @brief Update the audio.
      *
@@ -44,9 +74,56 @@ namespace Luna::Audio {
      * (sample perfect). For example, as long as two audio nodes are started
      * before calling this function, these audio nodes are guaranteed to be
      * synced with each other.
+     *
+     * Changed connections between nodes are compiled into a new AudioGraph,
+     * which replaces the previous one before the next rendered block.
+     *
+     * Neither this nor the audio thread wait for each other.
      */
     void update();
 
+    /**
+     * @brief Execute @p command on the audio thread.
+     *
+     * All commands pushed until the next update() are executed at the start
+     * of the same block, before any node is rendered.
+     *
+     * The command and its captures are destroyed on the audio thread, so
+     * neither executing nor destroying it may allocate or free memory.
+     *
+     * @return false if the queue is full. The command is not executed then.
+     */
+    template <typename F> bool pushCommand(F&& command) {
+      return scheduleCommand(0.0, std::forward<F>(command));
+    }
+
+    /**
+     * @brief Execute @p command on the audio thread once the playback reaches
+     * @p time.
+     *
+     * The time is compared to getTime(). The block is split at the exact
+     * frame, so the nodes render the frames before and after the command
+     * separately. Commands scheduled for the past are executed at the start
+     * of the next block.
+     *
+     * Commands are executed in the order they have been pushed, so a command
+     * scheduled for later also delays the commands pushed after it.
+     *
+     * @see pushCommand()
+     */
+    template <typename F> bool scheduleCommand(double time, F&& command) {
+      return countCommand(
+        mCommandQueue.tryPush(std::forward<F>(command), getFrame(time))
+      );
+    }
+
+    /**
+     * @brief Render @p frameCount frames of the current graph into @p buffer.
+     *
+     * Called on the audio thread. Never allocates memory.
+     */
+    void render(float* buffer, int frameCount);
+
     /**
      * @brief Shut down the audio system.
      */
@@ -60,9 +137,24 @@ namespace Luna::Audio {
 
     float getFrameRate() const;
 
+    /**
+     * @brief Create a sound owned by the caller.
+     *
+     * @return nullptr if the maximum number of sounds exist.
+     */
     Sound* createSound();
     void destroySound(Sound* sound);
 
+    /**
+     * @brief Play a sound once.
+     *
+     * The sound is destroyed by update() once it has finished.
+     *
+     * Except for N64, the buffer of @p source is played from the start with a
+     * position of its own, so the same source may be played any number of
+     * times at once. Only the buffer must stay alive until the sound has
+     * finished.
+     */
 #ifdef N64
     void playSound(const char* source);
 #else
@@ -82,20 +174,134 @@ namespace Luna::Audio {
     void advanceTime(double time);
 
     private:
-    inline void pushCommand(std::shared_ptr<Command> command) {
-      mCommandQueue.push(command);
-    }
+    friend class AudioNode;
+
+    /**
+     * @brief Compile the graph again with the next update().
+     */
+    void invalidateGraph();
+
+    /**
+     * @brief Compile the nodes and let the audio thread use the new graph.
+     */
+    void compileGraph();
+
+    /**
+     * @brief Destroy the replaced graphs the audio thread no longer uses.
+     */
+    void releaseGraphs();
+
+#ifdef N64
+    static constexpr std::size_t kMaxSoundCount = 64;
+#else
+    static constexpr std::size_t kMaxSoundCount = VoiceMixer::kVoiceCount;
+#endif
+
+    /**
+     * @brief Maximum number of commands pending for the audio thread.
+     */
+    static constexpr std::size_t kCommandQueueCapacity = 1024;
+
+    /**
+     * @brief Maximum size of a command lambda including its captures.
+     */
+    static constexpr std::size_t kCommandSize = 64;
+
+    /**
+     * @brief Get the index of the frame played at @p time.
+     */
+    std::uint64_t getFrame(double time) const;
+
+    /**
+     * @brief Count a command pushed for the next update().
+     */
+    bool countCommand(bool isPushed);
+
+    /**
+     * @brief Execute the published commands due at @p frame (audio thread
+     * only).
+     *
+     * @return Index of the frame the next published command is due at, but
+     * no later than @p endFrame.
+     */
+    std::uint64_t executeCommands(std::uint64_t frame, std::uint64_t endFrame);
+
+#ifdef LUNA_AUDIO_SDL2
+    /**
+     * @brief Execute the published commands and stop all voices, in place of
+     * the audio thread while no device is open.
+     */
+    void discardCommands();
+#endif
 
     AudioNodePtr mDestinationNode;
-    std::queue<std::shared_ptr<Command>> mCommandQueue;
+    std::shared_ptr<VoiceMixer> mVoiceMixer;
+
+    struct RetiredGraph {
+      std::unique_ptr<AudioGraph> graph;
+
+      /**
+       * @brief Value of mRenderCount when the graph was replaced.
+       */
+      std::uint32_t renderCount;
+    };
+
+    /**
+     * @brief Graph the audio thread renders, owned by mCurrentGraph.
+     */
+    std::atomic<AudioGraph*> mGraph{nullptr};
+
+    std::unique_ptr<AudioGraph> mCurrentGraph;
+    std::vector<RetiredGraph> mRetiredGraphs;
+
+    /**
+     * @brief Number of blocks rendered, incremented by the audio thread.
+     *
+     * Once it changes after replacing a graph, any block that may have used
+     * the previous graph has been completed.
+     */
+    std::atomic<std::uint32_t> mRenderCount{0};
+
+    /**
+     * @brief Frames per block the graph is compiled for.
+     */
+    int mGraphFrameCount;
+
+    bool mIsGraphInvalid{false};
+    CommandQueue<kCommandQueueCapacity, kCommandSize> mCommandQueue;
+
+    /**
+     * @brief Number of commands pushed, only used by the main thread.
+     */
+    std::size_t mPushedCommandCount{0};
+
+    /**
+     * @brief Number of commands the audio thread may execute, set by update().
+     */
+    std::atomic<std::size_t> mPublishedCommandCount{0};
+
+    /**
+     * @brief Number of commands executed, only used by the audio thread.
+     */
+    std::size_t mExecutedCommandCount{0};
+
+    /**
+     * @brief Number of frames rendered, only used by the audio thread.
+     */
+    std::uint64_t mRenderedFrameCount{0};
     double mTime;
     float mFrameRate;
     int mChannelCount;
     Internal::AudioMetrics mMetrics;
 #ifdef LUNA_AUDIO_SDL2
     SDL_AudioDeviceID mSdlAudioDeviceId{0};
+
+    /**
+     * @brief Format of the device, applied in start().
+     */
+    SDL_AudioSpec mSdlAudioSpec{};
 #endif
-    Pool<Sound, 64> mSounds;
+    Pool<Sound, kMaxSoundCount> mSounds;
     std::list<Sound*> mPlayingSounds;
   };
 } // namespace Luna::Audio
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <libluna/Audio/AllocationGuard.hpp>
+#include <libluna/Audio/AudioManager.hpp>
+#include <libluna/Performance/Ticker.hpp>
+#include <libluna/SoundBuffer.hpp>
+#include <libluna/SoundBufferSource.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  /**
+   * @brief Output a constant value.
+   */
+  class ConstantNode : public AudioNode {
+    public:
+    ConstantNode(AudioManager* manager) : AudioNode(manager) {}
+
+    void render(float* buffer, int frameCount) override {
+      std::fill(buffer, buffer + frameCount * getChannelCount(), value);
+    }
+
+    float value{0.0f};
+  };
+} // namespace
+
+int main(int, char**) {
+  TEST("guards nest", []() {
+    ASSERT(!AllocationGuard::isActive(), "inactive");
+
+    {
+      AllocationGuard outer;
+
+      {
+        AllocationGuard inner;
+        ASSERT(AllocationGuard::isActive(), "inner");
+      }
+
+      ASSERT(AllocationGuard::isActive(), "outer");
+    }
+
+    ASSERT(!AllocationGuard::isActive(), "inactive again");
+  });
+
+  TEST("render without allocating", []() {
+    AudioManager manager;
+    auto oscillator = manager.createOscillator(440.0f);
+    auto gain = manager.createGain(0.5f);
+    auto delay = manager.createDelay(0.01f);
+    oscillator->connect(gain);
+    gain->connect(delay);
+    delay->connect(manager.getDestinationNode());
+    manager.update();
+
+    SoundBuffer sound;
+    sound.getSamples() = {0.25f, 0.5f};
+    SoundBufferSource source(&sound, true);
+
+    // more frames than the mix buffer has been prepared for
+    std::vector<float> buffer(10000 * 2);
+    std::vector<float> sourceBuffer(64 * 2);
+    Performance::Ticker ticker;
+    int framesWritten = 0;
+
+    {
+      AllocationGuard guard;
+
+      for (int i = 0; i < 20; ++i) {
+        ticker.tick();
+        manager.render(buffer.data(), 10000);
+        framesWritten += source.write(sourceBuffer.data(), 64);
+        ticker.measure();
+      }
+    }
+
+    bool audible = false;
+
+    for (auto sample : buffer) {
+      audible = audible || sample != 0.0f;
+    }
+
+    ASSERT(audible, "rendered");
+    ASSERT_EQL(framesWritten, 20 * 64, "source looped");
+    ASSERT_EQL(sourceBuffer[3], 0.5f, "source samples");
+    ASSERT(ticker.getTickDuration() > 0.0f, "ticker");
+  });
+
+  TEST("execute commands at their frame", []() {
+    AudioManager manager;
+    auto node = std::make_shared<ConstantNode>(&manager);
+    node->connect(manager.getDestinationNode());
+    manager.update();
+
+    auto* target = node.get();
+    int executed = 0;
+    ASSERT(manager.pushCommand([&executed]() { ++executed; }), "pushed");
+    ASSERT(
+      manager.scheduleCommand(
+        100.0 / manager.getFrameRate(), [target]() { target->value = 1.0f; }
+      ),
+      "scheduled"
+    );
+
+    std::vector<float> buffer(256 * 2);
+    manager.render(buffer.data(), 64);
+    ASSERT_EQL(executed, 0, "waiting for the update");
+
+    manager.update();
+
+    {
+      AllocationGuard guard;
+      manager.render(buffer.data(), 256);
+    }
+
+    // the first render has played frames 0 to 63
+    ASSERT_EQL(executed, 1, "executed");
+    ASSERT_EQL(buffer[35 * 2 + 1], 0.0f, "before the frame");
+    ASSERT_EQL(buffer[36 * 2], 1.0f, "at the frame");
+    ASSERT_EQL(buffer[255 * 2], 1.0f, "after the frame");
+  });
+
+  return runTests();
+}
@@ -8,31 +8,40 @@
 using namespace Luna;
 using namespace Luna::Audio;
 
-class AudioCommand : public Command {
-  public:
-  AudioCommand(std::function<void()> callback) : mCallback(callback) {}
-
-  void execute() const override { mCallback(); }
-
-  private:
-  std::function<void()> mCallback;
-};
-
 AudioNode::AudioNode(AudioManager* manager) { mManager = manager; }
 
 AudioNode::~AudioNode() = default;
 
 void AudioNode::connect(AudioNodePtr destination) {
-  disconnect();
-  mConnectedNode = destination;
+  for (auto& output : mOutputs) {
+    if (output.lock() == destination) {
+      return;
+    }
+  }
+
+  mOutputs.emplace_back(destination);
   destination->addInput(shared_from_this());
+  mManager->invalidateGraph();
 }
 
 void AudioNode::disconnect() {
-  if (mConnectedNode) {
-    mConnectedNode->removeInput(shared_from_this());
-    mConnectedNode = nullptr;
+  for (auto& output : mOutputs) {
+    if (auto destination = output.lock()) {
+      destination->removeInput(shared_from_this());
+    }
   }
+
+  mOutputs.clear();
+  mManager->invalidateGraph();
+}
+
+void AudioNode::disconnect(const AudioNodePtr& destination) {
+  mOutputs.remove_if([&](const std::weak_ptr<AudioNode>& output) {
+    return output.lock() == destination;
+  });
+
+  destination->removeInput(shared_from_this());
+  mManager->invalidateGraph();
 }
 
 void AudioNode::addInput(AudioNodePtr input) { mInputs.emplace_back(input); }
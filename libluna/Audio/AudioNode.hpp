@@ -17,28 +17,55 @@ namespace Luna::Audio {
     virtual ~AudioNode();
 
     /**
-     * @brief Render @p frameCount frames into @p buffer.
+     * @brief Process @p frameCount frames in @p buffer.
+     *
+     * On entry, @p buffer holds the sum of the outputs of all inputs, or
+     * silence if there are none. The node replaces it with its own output.
      *
      * In stereo mode (2 channels), a frame represents 2 samples (2 floats).
+     *
+     * This is called on the audio thread by the compiled AudioGraph and must
+     * not allocate memory.
      */
     virtual void render(float* buffer, int frameCount) = 0;
 
-    // void addInput(std::shared_ptr<AudioNode> source);
-
+    /**
+     * @brief Connect the output of this node to @p destination.
+     *
+     * A node may be connected to multiple destinations, all of which receive
+     * the same output.
+     *
+     * The change applies with the next AudioManager::update().
+     */
     void connect(AudioNodePtr destination);
 
+    /**
+     * @brief Disconnect the output of this node from all destinations.
+     */
     void disconnect();
 
+    /**
+     * @brief Disconnect the output of this node from @p destination.
+     */
+    void disconnect(const AudioNodePtr& destination);
+
     int getChannelCount() const;
 
     float getFrameRate() const;
 
     protected:
+    friend class AudioGraph;
     friend class AudioManager;
     AudioNode();
     std::list<AudioNodePtr> mInputs;
-    AudioManager* mManager;
-    AudioNodePtr mConnectedNode;
+    AudioManager* mManager{nullptr};
+
+    /**
+     * @brief Destinations of this node.
+     *
+     * They don't own the destinations, as the destinations own their inputs.
+     */
+    std::list<std::weak_ptr<AudioNode>> mOutputs;
 
     private:
     void addInput(AudioNodePtr input);
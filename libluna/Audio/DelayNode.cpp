@@ -1,4 +1,4 @@
-#include <cstring>
+#include <algorithm>
 
 #include <libluna/Audio/DelayNode.hpp>
 #include <libluna/Logger.hpp>
@@ -15,33 +15,29 @@ DelayNode::DelayNode(AudioManager* manager, float delay) : AudioNode(manager) {
 DelayNode::~DelayNode() = default;
 
 void DelayNode::render(float* buffer, int frameCount) {
-  int sampleCount = frameCount * getChannelCount();
-  int renderedSampleCount = 0;
+  if (mBuffer.empty()) {
+    return;
+  }
+
+  auto sampleCount = static_cast<std::size_t>(frameCount * getChannelCount());
+  std::size_t renderedSampleCount = 0;
 
   while (renderedSampleCount < sampleCount) {
-    size_t chunkSampleCount = sampleCount - renderedSampleCount;
+    std::size_t chunkSampleCount = sampleCount - renderedSampleCount;
+    auto bufferOffset = static_cast<std::size_t>(mBufferOffset);
 
-    if (mBufferOffset + chunkSampleCount > mBuffer.size()) {
-      chunkSampleCount = mBuffer.size() - mBufferOffset;
+    if (bufferOffset + chunkSampleCount > mBuffer.size()) {
+      chunkSampleCount = mBuffer.size() - bufferOffset;
     }
 
-    // copy previous data
-    memcpy(
-      buffer, mBuffer.data() + mBufferOffset, sizeof(float) * chunkSampleCount
+    // output the previous input and keep the current one for later
+    std::swap_ranges(
+      buffer, buffer + chunkSampleCount, mBuffer.data() + bufferOffset
     );
     buffer += chunkSampleCount;
 
-    // render new input
-    if (mInputs.size() > 0) {
-      auto input = mInputs.front();
-      input->render(
-        mBuffer.data() + mBufferOffset,
-        static_cast<int>(chunkSampleCount / getChannelCount())
-      );
-    }
-
     mBufferOffset =
-      static_cast<int>((mBufferOffset + chunkSampleCount) % mBuffer.size());
-    renderedSampleCount += static_cast<int>(chunkSampleCount);
+      static_cast<int>((bufferOffset + chunkSampleCount) % mBuffer.size());
+    renderedSampleCount += chunkSampleCount;
   }
 }
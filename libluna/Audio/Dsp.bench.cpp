@@ -0,0 +1,91 @@
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/Dsp.hpp>
+#include <libluna/Bench.hpp>
+
+using namespace std;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr size_t kVoiceCount = 64;
+  constexpr size_t kFrameCount = 512;
+
+  struct Voice {
+    vector<float> samples;
+    Dsp::PanGains gains;
+  };
+
+  vector<Voice> makeVoices() {
+    vector<Voice> voices(kVoiceCount);
+
+    for (size_t v = 0; v < kVoiceCount; ++v) {
+      voices[v].samples.resize(kFrameCount);
+
+      for (size_t i = 0; i < kFrameCount; ++i) {
+        voices[v].samples[i] =
+          sinf(static_cast<float>(i * (v + 1)) * 0.01f) * 0.1f;
+      }
+
+      float pan = static_cast<float>(v) / kVoiceCount * 2.0f - 1.0f;
+      voices[v].gains = Dsp::getPanGains(pan, 0.5f);
+    }
+
+    return voices;
+  }
+} // namespace
+
+int main(int, char**) {
+  static auto voices = makeVoices();
+  static vector<float> stereo(kFrameCount * 2);
+  static vector<float> stereoVoice(kFrameCount * 2);
+
+  BENCH_ITEMS("pan and mix one by one", kVoiceCount, "voices", []() {
+    fill(stereo.begin(), stereo.end(), 0.0f);
+
+    for (auto& voice : voices) {
+      for (size_t i = 0; i < kFrameCount; ++i) {
+        stereo[i * 2] += voice.samples[i] * voice.gains.left;
+        stereo[i * 2 + 1] += voice.samples[i] * voice.gains.right;
+      }
+    }
+
+    benchKeep(stereo);
+  });
+
+  BENCH_ITEMS("pan and mix with panAdd", kVoiceCount, "voices", []() {
+    fill(stereo.begin(), stereo.end(), 0.0f);
+
+    for (auto& voice : voices) {
+      Dsp::panAdd(
+        stereo.data(), voice.samples.data(), voice.gains, kFrameCount
+      );
+    }
+
+    benchKeep(stereo);
+  });
+
+  BENCH_ITEMS("interleave, scale and mix like the nodes", kVoiceCount, "voices", []() {
+    fill(stereo.begin(), stereo.end(), 0.0f);
+
+    for (auto& voice : voices) {
+      Dsp::interleave(
+        stereoVoice.data(), voice.samples.data(), voice.samples.data(),
+        kFrameCount
+      );
+      Dsp::scale(stereoVoice.data(), voice.gains.left, kFrameCount * 2);
+      Dsp::mixAdd(stereo.data(), stereoVoice.data(), kFrameCount * 2);
+    }
+
+    benchKeep(stereo);
+  });
+
+  static vector<int16_t> output(kFrameCount * 2);
+
+  BENCH("convert to 16-bit", kFrameCount * 2 * sizeof(float), []() {
+    Dsp::convertToInt16(output.data(), stereo.data(), output.size());
+    benchKeep(output);
+  });
+
+  return runBenchmarks();
+}
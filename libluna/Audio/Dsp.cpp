@@ -0,0 +1,901 @@
+#include <libluna/Audio/Dsp.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                  \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUNA_DSP_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LUNA_DSP_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#define LUNA_DSP_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace Luna::Audio;
+using namespace Luna::Audio::Dsp;
+
+namespace {
+  constexpr float kPi = 3.14159265358979323846f;
+
+  /**
+   * @brief Vectorized kernels.
+   *
+   * The kernels process whole vectors and return the number of samples
+   * (frames for stereo kernels) done, the remaining ones are processed one by
+   * one. The convolution kernels add the sums of the samples done to their
+   * first argument.
+   */
+  struct Kernels {
+    std::size_t (*mixAdd)(float*, const float*, std::size_t);
+    std::size_t (*scale)(float*, float, std::size_t);
+    std::size_t (*scaleAdd)(float*, const float*, float, std::size_t);
+    std::size_t (*pan)(float*, PanGains, std::size_t);
+    std::size_t (*panAdd)(float*, const float*, PanGains, std::size_t);
+    std::size_t (*interleave)(float*, const float*, const float*, std::size_t);
+    std::size_t (*deinterleave)(float*, float*, const float*, std::size_t);
+    std::size_t (*convolve)(
+      float*, const float*, const float*, const float*, float, std::size_t
+    );
+    std::size_t (*convolveStereo)(
+      float*, const float*, const float*, const float*, float, std::size_t
+    );
+    std::size_t (*clamp)(float*, std::size_t);
+    std::size_t (*convertToInt16)(std::int16_t*, const float*, std::size_t);
+  };
+
+  inline float clampSample(float sample) {
+    return sample < -1.0f ? -1.0f : sample > 1.0f ? 1.0f : sample;
+  }
+
+#ifdef LUNA_DSP_SSE2
+  std::size_t mixAddSse2(
+    float* destination, const float* source, std::size_t count
+  ) {
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      _mm_storeu_ps(
+        destination + i,
+        _mm_add_ps(_mm_loadu_ps(destination + i), _mm_loadu_ps(source + i))
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t scaleSse2(float* buffer, float gain, std::size_t count) {
+    const auto factor = _mm_set1_ps(gain);
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), factor));
+    }
+
+    return done;
+  }
+
+  std::size_t scaleAddSse2(
+    float* destination, const float* source, float gain, std::size_t count
+  ) {
+    const auto factor = _mm_set1_ps(gain);
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto scaled = _mm_mul_ps(_mm_loadu_ps(source + i), factor);
+      _mm_storeu_ps(
+        destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), scaled)
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t panSse2(float* stereo, PanGains gains, std::size_t frameCount) {
+    const auto factor =
+      _mm_setr_ps(gains.left, gains.right, gains.left, gains.right);
+    std::size_t done = frameCount / 2 * 2;
+
+    for (std::size_t i = 0; i < done * 2; i += 4) {
+      _mm_storeu_ps(stereo + i, _mm_mul_ps(_mm_loadu_ps(stereo + i), factor));
+    }
+
+    return done;
+  }
+
+  std::size_t panAddSse2(
+    float* stereo, const float* mono, PanGains gains, std::size_t frameCount
+  ) {
+    const auto factor =
+      _mm_setr_ps(gains.left, gains.right, gains.left, gains.right);
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto samples = _mm_loadu_ps(mono + i);
+      auto* frames = stereo + i * 2;
+
+      // duplicate each sample to both channels
+      auto low = _mm_mul_ps(_mm_unpacklo_ps(samples, samples), factor);
+      auto high = _mm_mul_ps(_mm_unpackhi_ps(samples, samples), factor);
+
+      _mm_storeu_ps(frames, _mm_add_ps(_mm_loadu_ps(frames), low));
+      _mm_storeu_ps(frames + 4, _mm_add_ps(_mm_loadu_ps(frames + 4), high));
+    }
+
+    return done;
+  }
+
+  std::size_t interleaveSse2(
+    float* stereo, const float* left, const float* right,
+    std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto leftSamples = _mm_loadu_ps(left + i);
+      auto rightSamples = _mm_loadu_ps(right + i);
+
+      _mm_storeu_ps(stereo + i * 2, _mm_unpacklo_ps(leftSamples, rightSamples));
+      _mm_storeu_ps(
+        stereo + i * 2 + 4, _mm_unpackhi_ps(leftSamples, rightSamples)
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t deinterleaveSse2(
+    float* left, float* right, const float* stereo, std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto low = _mm_loadu_ps(stereo + i * 2);
+      auto high = _mm_loadu_ps(stereo + i * 2 + 4);
+
+      _mm_storeu_ps(
+        left + i, _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))
+      );
+      _mm_storeu_ps(
+        right + i, _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t convolveSse2(
+    float* sum, const float* samples, const float* first, const float* second,
+    float fraction, std::size_t count
+  ) {
+    const auto factor = _mm_set1_ps(fraction);
+    auto sums = _mm_setzero_ps();
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto from = _mm_loadu_ps(first + i);
+      auto coefficients = _mm_add_ps(
+        from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(second + i), from), factor)
+      );
+      sums =
+        _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(samples + i), coefficients));
+    }
+
+    sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+    sums = _mm_add_ss(
+      sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1))
+    );
+    *sum += _mm_cvtss_f32(sums);
+
+    return done;
+  }
+
+  std::size_t convolveStereoSse2(
+    float* frame, const float* stereo, const float* first, const float* second,
+    float fraction, std::size_t frameCount
+  ) {
+    const auto factor = _mm_set1_ps(fraction);
+    auto sums = _mm_setzero_ps();
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto from = _mm_loadu_ps(first + i);
+      auto coefficients = _mm_add_ps(
+        from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(second + i), from), factor)
+      );
+      const auto* frames = stereo + i * 2;
+
+      // duplicate each coefficient to both channels
+      auto low = _mm_unpacklo_ps(coefficients, coefficients);
+      auto high = _mm_unpackhi_ps(coefficients, coefficients);
+
+      sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(frames), low));
+      sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(frames + 4), high));
+    }
+
+    // lanes 0 and 2 hold the left channel, lanes 1 and 3 the right one
+    sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+    frame[0] += _mm_cvtss_f32(sums);
+    frame[1] +=
+      _mm_cvtss_f32(_mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    return done;
+  }
+
+  std::size_t clampSse2(float* buffer, std::size_t count) {
+    const auto minimum = _mm_set1_ps(-1.0f);
+    const auto maximum = _mm_set1_ps(1.0f);
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto samples = _mm_loadu_ps(buffer + i);
+      _mm_storeu_ps(
+        buffer + i, _mm_min_ps(_mm_max_ps(samples, minimum), maximum)
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t convertToInt16Sse2(
+    std::int16_t* destination, const float* source, std::size_t count
+  ) {
+    const auto minimum = _mm_set1_ps(-1.0f);
+    const auto maximum = _mm_set1_ps(1.0f);
+    const auto factor = _mm_set1_ps(32767.0f);
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto low =
+        _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), minimum), maximum);
+      auto high =
+        _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i + 4), minimum), maximum);
+
+      // converting rounds to the nearest value, like std::lrint()
+      auto values = _mm_packs_epi32(
+        _mm_cvtps_epi32(_mm_mul_ps(low, factor)),
+        _mm_cvtps_epi32(_mm_mul_ps(high, factor))
+      );
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), values);
+    }
+
+    return done;
+  }
+
+  const Kernels kSse2Kernels{
+    mixAddSse2,
+    scaleSse2,
+    scaleAddSse2,
+    panSse2,
+    panAddSse2,
+    interleaveSse2,
+    deinterleaveSse2,
+    convolveSse2,
+    convolveStereoSse2,
+    clampSse2,
+    convertToInt16Sse2};
+#endif
+
+#ifdef LUNA_DSP_X86_DISPATCH
+  // Converting to 16-bit is left to SSE2, as packing 256-bit vectors
+  // requires AVX2.
+
+  __attribute__((target("avx"))) std::size_t mixAddAvx(
+    float* destination, const float* source, std::size_t count
+  ) {
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      _mm256_storeu_ps(
+        destination + i, _mm256_add_ps(
+                           _mm256_loadu_ps(destination + i),
+                           _mm256_loadu_ps(source + i)
+                         )
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t
+  scaleAvx(float* buffer, float gain, std::size_t count) {
+    const auto factor = _mm256_set1_ps(gain);
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      _mm256_storeu_ps(
+        buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), factor)
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t scaleAddAvx(
+    float* destination, const float* source, float gain, std::size_t count
+  ) {
+    const auto factor = _mm256_set1_ps(gain);
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto scaled = _mm256_mul_ps(_mm256_loadu_ps(source + i), factor);
+      _mm256_storeu_ps(
+        destination + i, _mm256_add_ps(_mm256_loadu_ps(destination + i), scaled)
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t
+  panAvx(float* stereo, PanGains gains, std::size_t frameCount) {
+    const auto factor = _mm256_setr_ps(
+      gains.left, gains.right, gains.left, gains.right, gains.left,
+      gains.right, gains.left, gains.right
+    );
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done * 2; i += 8) {
+      _mm256_storeu_ps(
+        stereo + i, _mm256_mul_ps(_mm256_loadu_ps(stereo + i), factor)
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t panAddAvx(
+    float* stereo, const float* mono, PanGains gains, std::size_t frameCount
+  ) {
+    const auto factor = _mm256_setr_ps(
+      gains.left, gains.right, gains.left, gains.right, gains.left,
+      gains.right, gains.left, gains.right
+    );
+    std::size_t done = frameCount / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto samples = _mm256_loadu_ps(mono + i);
+      auto* frames = stereo + i * 2;
+
+      // unpacking works within each 128-bit lane, so the lanes are reordered
+      // afterwards
+      auto low = _mm256_unpacklo_ps(samples, samples);
+      auto high = _mm256_unpackhi_ps(samples, samples);
+      auto first =
+        _mm256_mul_ps(_mm256_permute2f128_ps(low, high, 0x20), factor);
+      auto second =
+        _mm256_mul_ps(_mm256_permute2f128_ps(low, high, 0x31), factor);
+
+      _mm256_storeu_ps(frames, _mm256_add_ps(_mm256_loadu_ps(frames), first));
+      _mm256_storeu_ps(
+        frames + 8, _mm256_add_ps(_mm256_loadu_ps(frames + 8), second)
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t interleaveAvx(
+    float* stereo, const float* left, const float* right,
+    std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto leftSamples = _mm256_loadu_ps(left + i);
+      auto rightSamples = _mm256_loadu_ps(right + i);
+      auto low = _mm256_unpacklo_ps(leftSamples, rightSamples);
+      auto high = _mm256_unpackhi_ps(leftSamples, rightSamples);
+
+      _mm256_storeu_ps(stereo + i * 2, _mm256_permute2f128_ps(low, high, 0x20));
+      _mm256_storeu_ps(
+        stereo + i * 2 + 8, _mm256_permute2f128_ps(low, high, 0x31)
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t deinterleaveAvx(
+    float* left, float* right, const float* stereo, std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto first = _mm256_loadu_ps(stereo + i * 2);
+      auto second = _mm256_loadu_ps(stereo + i * 2 + 8);
+
+      // shuffling works within each 128-bit lane, so the lanes are reordered
+      // beforehand
+      auto low = _mm256_permute2f128_ps(first, second, 0x20);
+      auto high = _mm256_permute2f128_ps(first, second, 0x31);
+
+      _mm256_storeu_ps(
+        left + i, _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))
+      );
+      _mm256_storeu_ps(
+        right + i, _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))
+      );
+    }
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t convolveAvx(
+    float* sum, const float* samples, const float* first, const float* second,
+    float fraction, std::size_t count
+  ) {
+    const auto factor = _mm256_set1_ps(fraction);
+    auto sums = _mm256_setzero_ps();
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto from = _mm256_loadu_ps(first + i);
+      auto coefficients = _mm256_add_ps(
+        from,
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(second + i), from), factor)
+      );
+      sums = _mm256_add_ps(
+        sums, _mm256_mul_ps(_mm256_loadu_ps(samples + i), coefficients)
+      );
+    }
+
+    auto half = _mm_add_ps(
+      _mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)
+    );
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(
+      half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1))
+    );
+    *sum += _mm_cvtss_f32(half);
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t convolveStereoAvx(
+    float* frame, const float* stereo, const float* first, const float* second,
+    float fraction, std::size_t frameCount
+  ) {
+    const auto factor = _mm256_set1_ps(fraction);
+    auto firstSums = _mm256_setzero_ps();
+    auto secondSums = _mm256_setzero_ps();
+    std::size_t done = frameCount / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto from = _mm256_loadu_ps(first + i);
+      auto coefficients = _mm256_add_ps(
+        from,
+        _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(second + i), from), factor)
+      );
+      const auto* frames = stereo + i * 2;
+
+      // duplicate each coefficient to both channels, reordering the lanes
+      // like panAddAvx()
+      auto low = _mm256_unpacklo_ps(coefficients, coefficients);
+      auto high = _mm256_unpackhi_ps(coefficients, coefficients);
+      auto firstHalf = _mm256_permute2f128_ps(low, high, 0x20);
+      auto secondHalf = _mm256_permute2f128_ps(low, high, 0x31);
+
+      // separate sums don't wait for each other
+      firstSums = _mm256_add_ps(
+        firstSums, _mm256_mul_ps(_mm256_loadu_ps(frames), firstHalf)
+      );
+      secondSums = _mm256_add_ps(
+        secondSums, _mm256_mul_ps(_mm256_loadu_ps(frames + 8), secondHalf)
+      );
+    }
+
+    auto sums = _mm256_add_ps(firstSums, secondSums);
+    auto half = _mm_add_ps(
+      _mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)
+    );
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    frame[0] += _mm_cvtss_f32(half);
+    frame[1] +=
+      _mm_cvtss_f32(_mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    return done;
+  }
+
+  __attribute__((target("avx"))) std::size_t
+  clampAvx(float* buffer, std::size_t count) {
+    const auto minimum = _mm256_set1_ps(-1.0f);
+    const auto maximum = _mm256_set1_ps(1.0f);
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto samples = _mm256_loadu_ps(buffer + i);
+      _mm256_storeu_ps(
+        buffer + i, _mm256_min_ps(_mm256_max_ps(samples, minimum), maximum)
+      );
+    }
+
+    return done;
+  }
+
+  const Kernels kAvxKernels{
+    mixAddAvx,
+    scaleAvx,
+    scaleAddAvx,
+    panAvx,
+    panAddAvx,
+    interleaveAvx,
+    deinterleaveAvx,
+    convolveAvx,
+    convolveStereoAvx,
+    clampAvx,
+    convertToInt16Sse2};
+
+  /**
+   * @brief Choose the widest kernels supported by the processor.
+   */
+  const Kernels& selectKernels() {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx")) {
+      return kAvxKernels;
+    }
+
+    return kSse2Kernels;
+  }
+#endif
+
+#ifdef LUNA_DSP_NEON
+  std::size_t mixAddNeon(
+    float* destination, const float* source, std::size_t count
+  ) {
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      vst1q_f32(
+        destination + i,
+        vaddq_f32(vld1q_f32(destination + i), vld1q_f32(source + i))
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t scaleNeon(float* buffer, float gain, std::size_t count) {
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      vst1q_f32(buffer + i, vmulq_n_f32(vld1q_f32(buffer + i), gain));
+    }
+
+    return done;
+  }
+
+  std::size_t scaleAddNeon(
+    float* destination, const float* source, float gain, std::size_t count
+  ) {
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      vst1q_f32(
+        destination + i,
+        vmlaq_n_f32(vld1q_f32(destination + i), vld1q_f32(source + i), gain)
+      );
+    }
+
+    return done;
+  }
+
+  std::size_t panNeon(float* stereo, PanGains gains, std::size_t frameCount) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto frames = vld2q_f32(stereo + i * 2);
+      frames.val[0] = vmulq_n_f32(frames.val[0], gains.left);
+      frames.val[1] = vmulq_n_f32(frames.val[1], gains.right);
+      vst2q_f32(stereo + i * 2, frames);
+    }
+
+    return done;
+  }
+
+  std::size_t panAddNeon(
+    float* stereo, const float* mono, PanGains gains, std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto samples = vld1q_f32(mono + i);
+      auto frames = vld2q_f32(stereo + i * 2);
+      frames.val[0] = vmlaq_n_f32(frames.val[0], samples, gains.left);
+      frames.val[1] = vmlaq_n_f32(frames.val[1], samples, gains.right);
+      vst2q_f32(stereo + i * 2, frames);
+    }
+
+    return done;
+  }
+
+  std::size_t interleaveNeon(
+    float* stereo, const float* left, const float* right,
+    std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      float32x4x2_t frames{{vld1q_f32(left + i), vld1q_f32(right + i)}};
+      vst2q_f32(stereo + i * 2, frames);
+    }
+
+    return done;
+  }
+
+  std::size_t deinterleaveNeon(
+    float* left, float* right, const float* stereo, std::size_t frameCount
+  ) {
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto frames = vld2q_f32(stereo + i * 2);
+      vst1q_f32(left + i, frames.val[0]);
+      vst1q_f32(right + i, frames.val[1]);
+    }
+
+    return done;
+  }
+
+  float sumLanesNeon(float32x4_t sums) {
+    auto pair = vadd_f32(vget_low_f32(sums), vget_high_f32(sums));
+
+    return vget_lane_f32(vpadd_f32(pair, pair), 0);
+  }
+
+  std::size_t convolveNeon(
+    float* sum, const float* samples, const float* first, const float* second,
+    float fraction, std::size_t count
+  ) {
+    auto sums = vdupq_n_f32(0.0f);
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto from = vld1q_f32(first + i);
+      auto coefficients =
+        vmlaq_n_f32(from, vsubq_f32(vld1q_f32(second + i), from), fraction);
+      sums = vmlaq_f32(sums, vld1q_f32(samples + i), coefficients);
+    }
+
+    *sum += sumLanesNeon(sums);
+
+    return done;
+  }
+
+  std::size_t convolveStereoNeon(
+    float* frame, const float* stereo, const float* first, const float* second,
+    float fraction, std::size_t frameCount
+  ) {
+    auto left = vdupq_n_f32(0.0f);
+    auto right = vdupq_n_f32(0.0f);
+    std::size_t done = frameCount / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto from = vld1q_f32(first + i);
+      auto coefficients =
+        vmlaq_n_f32(from, vsubq_f32(vld1q_f32(second + i), from), fraction);
+      auto frames = vld2q_f32(stereo + i * 2);
+      left = vmlaq_f32(left, frames.val[0], coefficients);
+      right = vmlaq_f32(right, frames.val[1], coefficients);
+    }
+
+    frame[0] += sumLanesNeon(left);
+    frame[1] += sumLanesNeon(right);
+
+    return done;
+  }
+
+  std::size_t clampNeon(float* buffer, std::size_t count) {
+    const auto minimum = vdupq_n_f32(-1.0f);
+    const auto maximum = vdupq_n_f32(1.0f);
+    std::size_t done = count / 4 * 4;
+
+    for (std::size_t i = 0; i < done; i += 4) {
+      auto samples = vld1q_f32(buffer + i);
+      vst1q_f32(buffer + i, vminq_f32(vmaxq_f32(samples, minimum), maximum));
+    }
+
+    return done;
+  }
+
+  std::size_t convertToInt16Neon(
+    std::int16_t* destination, const float* source, std::size_t count
+  ) {
+#ifdef __aarch64__
+    const auto minimum = vdupq_n_f32(-1.0f);
+    const auto maximum = vdupq_n_f32(1.0f);
+    std::size_t done = count / 8 * 8;
+
+    for (std::size_t i = 0; i < done; i += 8) {
+      auto low = vminq_f32(vmaxq_f32(vld1q_f32(source + i), minimum), maximum);
+      auto high =
+        vminq_f32(vmaxq_f32(vld1q_f32(source + i + 4), minimum), maximum);
+
+      // converting rounds to the nearest value, like std::lrint()
+      vst1q_s16(
+        destination + i,
+        vcombine_s16(
+          vqmovn_s32(vcvtnq_s32_f32(vmulq_n_f32(low, 32767.0f))),
+          vqmovn_s32(vcvtnq_s32_f32(vmulq_n_f32(high, 32767.0f)))
+        )
+      );
+    }
+
+    return done;
+#else
+    // 32-bit ARM lacks rounding to the nearest value
+    (void)destination;
+    (void)source;
+    (void)count;
+
+    return 0;
+#endif
+  }
+
+  const Kernels kNeonKernels{
+    mixAddNeon,
+    scaleNeon,
+    scaleAddNeon,
+    panNeon,
+    panAddNeon,
+    interleaveNeon,
+    deinterleaveNeon,
+    convolveNeon,
+    convolveStereoNeon,
+    clampNeon,
+    convertToInt16Neon};
+#endif
+
+#if !defined(LUNA_DSP_SSE2) && !defined(LUNA_DSP_NEON)
+  template <typename... Args> std::size_t none(Args...) { return 0; }
+
+  const Kernels kScalarKernels{
+    none<float*, const float*, std::size_t>,
+    none<float*, float, std::size_t>,
+    none<float*, const float*, float, std::size_t>,
+    none<float*, PanGains, std::size_t>,
+    none<float*, const float*, PanGains, std::size_t>,
+    none<float*, const float*, const float*, std::size_t>,
+    none<float*, float*, const float*, std::size_t>,
+    none<float*, const float*, const float*, const float*, float, std::size_t>,
+    none<float*, const float*, const float*, const float*, float, std::size_t>,
+    none<float*, std::size_t>,
+    none<std::int16_t*, const float*, std::size_t>};
+#endif
+
+  const Kernels& getKernels() {
+#ifdef LUNA_DSP_X86_DISPATCH
+    static const Kernels& kernels = selectKernels();
+
+    return kernels;
+#elif defined(LUNA_DSP_SSE2)
+    return kSse2Kernels;
+#elif defined(LUNA_DSP_NEON)
+    return kNeonKernels;
+#else
+    return kScalarKernels;
+#endif
+  }
+} // namespace
+
+PanGains Dsp::getPanGains(float pan, float volume) {
+  float angle = (clampSample(pan) + 1.0f) * kPi * 0.25f;
+
+  return {std::cos(angle) * volume, std::sin(angle) * volume};
+}
+
+void Dsp::mixAdd(float* destination, const float* source, std::size_t count) {
+  for (std::size_t i = getKernels().mixAdd(destination, source, count);
+       i < count; ++i) {
+    destination[i] += source[i];
+  }
+}
+
+void Dsp::scale(float* buffer, float gain, std::size_t count) {
+  for (std::size_t i = getKernels().scale(buffer, gain, count); i < count;
+       ++i) {
+    buffer[i] *= gain;
+  }
+}
+
+void Dsp::scaleAdd(
+  float* destination, const float* source, float gain, std::size_t count
+) {
+  for (std::size_t i = getKernels().scaleAdd(destination, source, gain, count);
+       i < count; ++i) {
+    destination[i] += source[i] * gain;
+  }
+}
+
+void Dsp::pan(float* stereo, PanGains gains, std::size_t frameCount) {
+  for (std::size_t i = getKernels().pan(stereo, gains, frameCount);
+       i < frameCount; ++i) {
+    stereo[i * 2] *= gains.left;
+    stereo[i * 2 + 1] *= gains.right;
+  }
+}
+
+void Dsp::panAdd(
+  float* stereo, const float* mono, PanGains gains, std::size_t frameCount
+) {
+  for (std::size_t i = getKernels().panAdd(stereo, mono, gains, frameCount);
+       i < frameCount; ++i) {
+    stereo[i * 2] += mono[i] * gains.left;
+    stereo[i * 2 + 1] += mono[i] * gains.right;
+  }
+}
+
+void Dsp::interleave(
+  float* stereo, const float* left, const float* right, std::size_t frameCount
+) {
+  for (std::size_t i = getKernels().interleave(stereo, left, right, frameCount);
+       i < frameCount; ++i) {
+    stereo[i * 2] = left[i];
+    stereo[i * 2 + 1] = right[i];
+  }
+}
+
+void Dsp::deinterleave(
+  float* left, float* right, const float* stereo, std::size_t frameCount
+) {
+  for (std::size_t i =
+         getKernels().deinterleave(left, right, stereo, frameCount);
+       i < frameCount; ++i) {
+    left[i] = stereo[i * 2];
+    right[i] = stereo[i * 2 + 1];
+  }
+}
+
+float Dsp::convolve(
+  const float* samples, const float* first, const float* second,
+  float fraction, std::size_t count
+) {
+  float sum = 0.0f;
+
+  for (std::size_t i = getKernels().convolve(
+         &sum, samples, first, second, fraction, count
+       );
+       i < count; ++i) {
+    sum += samples[i] * (first[i] + (second[i] - first[i]) * fraction);
+  }
+
+  return sum;
+}
+
+void Dsp::convolveStereo(
+  float* frame, const float* stereo, const float* first, const float* second,
+  float fraction, std::size_t frameCount
+) {
+  frame[0] = 0.0f;
+  frame[1] = 0.0f;
+
+  for (std::size_t i = getKernels().convolveStereo(
+         frame, stereo, first, second, fraction, frameCount
+       );
+       i < frameCount; ++i) {
+    float coefficient = first[i] + (second[i] - first[i]) * fraction;
+    frame[0] += stereo[i * 2] * coefficient;
+    frame[1] += stereo[i * 2 + 1] * coefficient;
+  }
+}
+
+void Dsp::clamp(float* buffer, std::size_t count) {
+  for (std::size_t i = getKernels().clamp(buffer, count); i < count; ++i) {
+    buffer[i] = clampSample(buffer[i]);
+  }
+}
+
+void Dsp::convertToInt16(
+  std::int16_t* destination, const float* source, std::size_t count
+) {
+  for (std::size_t i = getKernels().convertToInt16(destination, source, count);
+       i < count; ++i) {
+    destination[i] =
+      static_cast<std::int16_t>(std::lrint(clampSample(source[i]) * 32767.0f));
+  }
+}
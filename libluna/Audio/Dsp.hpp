@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sample processing kernels used by the audio nodes.
+ *
+ * The kernels use SSE2, AVX or NEON where available, choosing the widest
+ * instruction set supported by the processor at runtime, and process any
+ * remaining samples one by one.
+ *
+ * Buffers may be unaligned. Unless noted otherwise, the buffers of a single
+ * call must either be identical or not overlap.
+ *
+ * None of the kernels allocate memory, so they may be used while rendering.
+ */
+namespace Luna::Audio::Dsp {
+  /**
+   * @brief Gains of the left and right channel for panning.
+   */
+  struct PanGains {
+    float left;
+    float right;
+  };
+
+  /**
+   * @brief Get the constant-power gains for panning a mono signal.
+   *
+   * @param pan -1 for left, 0 for center and 1 for right.
+   * @param volume Factor applied to both gains.
+   *
+   * The combined power of both channels is the same for every position, so a
+   * signal moving across the stereo field keeps its loudness.
+   */
+  PanGains getPanGains(float pan, float volume = 1.0f);
+
+  /**
+   * @brief Add @p count samples of @p source to @p destination.
+   */
+  void mixAdd(float* destination, const float* source, std::size_t count);
+
+  /**
+   * @brief Multiply @p count samples of @p buffer by @p gain.
+   */
+  void scale(float* buffer, float gain, std::size_t count);
+
+  /**
+   * @brief Add @p count samples of @p source multiplied by @p gain to
+   * @p destination.
+   */
+  void scaleAdd(
+    float* destination, const float* source, float gain, std::size_t count
+  );
+
+  /**
+   * @brief Multiply the channels of interleaved stereo frames by the pan
+   * gains.
+   */
+  void pan(float* stereo, PanGains gains, std::size_t frameCount);
+
+  /**
+   * @brief Pan a mono signal and add it to interleaved stereo frames.
+   */
+  void panAdd(
+    float* stereo, const float* mono, PanGains gains, std::size_t frameCount
+  );
+
+  /**
+   * @brief Interleave two channels to stereo frames.
+   *
+   * @p left and @p right may be the same buffer to duplicate a mono signal.
+   */
+  void interleave(
+    float* stereo, const float* left, const float* right,
+    std::size_t frameCount
+  );
+
+  /**
+   * @brief Split stereo frames into two channels.
+   */
+  void deinterleave(
+    float* left, float* right, const float* stereo, std::size_t frameCount
+  );
+
+  /**
+   * @brief Filter @p count samples with coefficients interpolated between two
+   * sets.
+   *
+   * @return The sum of `samples[i] * (first[i] + (second[i] - first[i]) *
+   * fraction)`.
+   */
+  float convolve(
+    const float* samples, const float* first, const float* second,
+    float fraction, std::size_t count
+  );
+
+  /**
+   * @brief Filter interleaved stereo frames like convolve(), applying each
+   * coefficient to both channels of a frame.
+   *
+   * @param frame Receives the filtered left and right sample.
+   */
+  void convolveStereo(
+    float* frame, const float* stereo, const float* first, const float* second,
+    float fraction, std::size_t frameCount
+  );
+
+  /**
+   * @brief Limit @p count samples to the range from -1 to 1.
+   */
+  void clamp(float* buffer, std::size_t count);
+
+  /**
+   * @brief Convert @p count samples to signed 16-bit, clamping them to the
+   * range from -1 to 1 and rounding to the nearest value.
+   */
+  void convertToInt16(
+    std::int16_t* destination, const float* source, std::size_t count
+  );
+} // namespace Luna::Audio::Dsp
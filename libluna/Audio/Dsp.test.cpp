@@ -0,0 +1,176 @@
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/Dsp.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna::Audio;
+
+namespace {
+  // enough samples for whole vectors of every width plus a tail
+  constexpr std::size_t kCount = 37;
+
+  std::vector<float> makeSamples(std::size_t count, float offset) {
+    std::vector<float> samples(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      samples[i] = std::sin(static_cast<float>(i) * 0.7f + offset);
+    }
+
+    return samples;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("mix, scale and scale-and-add", []() {
+    // starting at an odd index makes the buffers unaligned
+    auto destination = makeSamples(kCount + 1, 0.0f);
+    auto source = makeSamples(kCount + 1, 1.0f);
+    auto expected = destination;
+
+    Dsp::mixAdd(destination.data() + 1, source.data() + 1, kCount);
+    Dsp::scale(destination.data() + 1, 0.5f, kCount);
+    Dsp::scaleAdd(destination.data() + 1, source.data() + 1, -2.0f, kCount);
+
+    bool equal = true;
+
+    for (std::size_t i = 1; i <= kCount; ++i) {
+      expected[i] = (expected[i] + source[i]) * 0.5f + source[i] * -2.0f;
+      equal = equal && std::abs(destination[i] - expected[i]) < 1e-6f;
+    }
+
+    ASSERT(equal, "samples");
+    ASSERT_EQL(destination[0], expected[0], "untouched");
+  });
+
+  TEST("pan with constant power", []() {
+    auto center = Dsp::getPanGains(0.0f);
+    auto left = Dsp::getPanGains(-1.0f);
+    auto right = Dsp::getPanGains(1.0f, 0.5f);
+
+    ASSERT(std::abs(center.left - center.right) < 1e-6f, "center");
+    ASSERT(
+      std::abs(center.left * center.left + center.right * center.right - 1.0f) <
+        1e-6f,
+      "power"
+    );
+    ASSERT(left.left > 0.999f && std::abs(left.right) < 1e-6f, "left");
+    ASSERT(right.right > 0.499f && std::abs(right.left) < 1e-6f, "right");
+
+    auto mono = makeSamples(kCount, 0.0f);
+    auto stereo = makeSamples(kCount * 2, 2.0f);
+    auto expected = stereo;
+    Dsp::PanGains gains{0.25f, 0.75f};
+
+    Dsp::panAdd(stereo.data(), mono.data(), gains, kCount);
+    Dsp::pan(stereo.data(), gains, kCount);
+
+    bool equal = true;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+      float expectedLeft = (expected[i * 2] + mono[i] * 0.25f) * 0.25f;
+      float expectedRight = (expected[i * 2 + 1] + mono[i] * 0.75f) * 0.75f;
+      equal = equal && std::abs(stereo[i * 2] - expectedLeft) < 1e-6f &&
+              std::abs(stereo[i * 2 + 1] - expectedRight) < 1e-6f;
+    }
+
+    ASSERT(equal, "frames");
+  });
+
+  TEST("interleave and deinterleave", []() {
+    auto left = makeSamples(kCount, 0.0f);
+    auto right = makeSamples(kCount, 3.0f);
+    std::vector<float> stereo(kCount * 2);
+
+    Dsp::interleave(stereo.data(), left.data(), right.data(), kCount);
+
+    bool interleaved = true;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+      interleaved = interleaved && stereo[i * 2] == left[i] &&
+                    stereo[i * 2 + 1] == right[i];
+    }
+
+    ASSERT(interleaved, "interleaved");
+
+    std::vector<float> splitLeft(kCount);
+    std::vector<float> splitRight(kCount);
+    Dsp::deinterleave(
+      splitLeft.data(), splitRight.data(), stereo.data(), kCount
+    );
+
+    ASSERT(splitLeft == left, "left");
+    ASSERT(splitRight == right, "right");
+
+    Dsp::interleave(stereo.data(), left.data(), left.data(), kCount);
+    ASSERT_EQL(stereo[kCount * 2 - 1], left[kCount - 1], "duplicated");
+  });
+
+  TEST("convolve with interpolated coefficients", []() {
+    auto samples = makeSamples(kCount * 2 + 1, 0.0f);
+    auto first = makeSamples(kCount + 1, 1.0f);
+    auto second = makeSamples(kCount + 1, 2.0f);
+    float fraction = 0.25f;
+
+    float expected = 0.0f;
+    float expectedLeft = 0.0f;
+    float expectedRight = 0.0f;
+
+    for (std::size_t i = 1; i <= kCount; ++i) {
+      float coefficient = first[i] * 0.75f + second[i] * 0.25f;
+      expected += samples[i] * coefficient;
+      expectedLeft += samples[i * 2 - 1] * coefficient;
+      expectedRight += samples[i * 2] * coefficient;
+    }
+
+    float sum = Dsp::convolve(
+      samples.data() + 1, first.data() + 1, second.data() + 1, fraction, kCount
+    );
+    float frame[2];
+    Dsp::convolveStereo(
+      frame, samples.data() + 1, first.data() + 1, second.data() + 1, fraction,
+      kCount
+    );
+
+    ASSERT(std::abs(sum - expected) < 1e-5f, "mono");
+    ASSERT(std::abs(frame[0] - expectedLeft) < 1e-5f, "left");
+    ASSERT(std::abs(frame[1] - expectedRight) < 1e-5f, "right");
+  });
+
+  TEST("clamp and convert to 16-bit", []() {
+    std::vector<float> samples(kCount);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+      samples[i] = (static_cast<float>(i) - 18.0f) / 12.0f;
+    }
+
+    samples[3] = 0.4f / 32767.0f;
+    samples[4] = 1.6f / 32767.0f;
+    samples[5] = -0.7f / 32767.0f;
+
+    std::vector<std::int16_t> values(kCount);
+    Dsp::convertToInt16(values.data(), samples.data(), kCount);
+
+    ASSERT_EQL(values[0], -32767, "clamped low");
+    ASSERT_EQL(values[3], 0, "rounded down");
+    ASSERT_EQL(values[4], 2, "rounded up");
+    ASSERT_EQL(values[5], -1, "rounded negative");
+    ASSERT_EQL(values[18], 0, "zero");
+    ASSERT_EQL(values[30], 32767, "one");
+    ASSERT_EQL(values[kCount - 1], 32767, "clamped high");
+
+    Dsp::clamp(samples.data(), kCount);
+
+    bool clamped = true;
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+      clamped = clamped && samples[i] >= -1.0f && samples[i] <= 1.0f;
+    }
+
+    ASSERT(clamped, "clamped");
+    ASSERT_EQL(samples[kCount - 1], 1.0f, "limit");
+    ASSERT_EQL(samples[20], 2.0f / 12.0f, "unchanged");
+  });
+
+  return runTests();
+}
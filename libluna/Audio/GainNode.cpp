@@ -1,5 +1,4 @@
-#include <algorithm>
-
+#include <libluna/Audio/Dsp.hpp>
 #include <libluna/Audio/GainNode.hpp>
 
 using namespace Luna;
@@ -11,13 +10,12 @@ GainNode::GainNode(AudioManager* manager, float volume)
 GainNode::~GainNode() = default;
 
 void GainNode::render(float* buffer, int frameCount) {
-  if (mInputs.size() > 0) {
-    auto input = mInputs.front();
-    input->render(buffer, frameCount);
+  Dsp::scale(
+    buffer, mVolume.load(std::memory_order_relaxed),
+    static_cast<std::size_t>(frameCount * getChannelCount())
+  );
+}
 
-    std::transform(
-      buffer, buffer + frameCount * getChannelCount(), buffer,
-      [=](float a) { return a *= mVolume; }
-    );
-  }
+void GainNode::setVolume(float volume) {
+  mVolume.store(volume, std::memory_order_relaxed);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <libluna/Audio/AudioNode.hpp>
 
 namespace Luna::Audio {
@@ -8,9 +10,13 @@ namespace Luna::Audio {
     GainNode(AudioManager* manager, float volume);
     ~GainNode();
     void render(float* buffer, int frameCount) override;
+
+    /**
+     * @brief Change the volume, safe to call while the audio thread renders.
+     */
     void setVolume(float volume);
 
     private:
-    float mVolume;
+    std::atomic<float> mVolume;
   };
 } // namespace Luna::Audio
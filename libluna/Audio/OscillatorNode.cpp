@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cmath>
 
+#include <libluna/Audio/Dsp.hpp>
 #include <libluna/Audio/OscillatorNode.hpp>
 
 using namespace Luna;
@@ -7,6 +9,11 @@ using namespace Luna::Audio;
 
 constexpr double pi = 3.14159265358979323846;
 
+/**
+ * @brief Frames generated at once before interleaving them.
+ */
+constexpr int kChunkFrameCount = 256;
+
 OscillatorNode::OscillatorNode(
   AudioManager* manager, float frequency, Type type
 )
@@ -24,39 +31,57 @@ void OscillatorNode::render(float* buffer, int frameCount) {
   float phaseIncrement =
     static_cast<float>(pi * 2.0f * mFrequency / getFrameRate());
 
-  for (int i = 0; i < frameCount; ++i) {
-    float sample;
-
-    switch (mType) {
-    default:
-      sample = sinf(mPhase);
-      break;
-    case kSquare: {
-      sample = sinf(mPhase);
-      float threshold = 1.0f - mDuty * 2.0f;
-      sample = (sample < threshold) ? -0.33f : 0.33f;
-      break;
-    }
-    case kTriangle:
-      sample = -1.0f + mPhase / static_cast<float>(pi) * 2.0f;
-
-      if (sample > 1.0f) {
-        sample = 1.0f - (sample - 1.0f);
-      }
-      break;
-    case kSawtooth:
-      sample = (-1.0f + mPhase / static_cast<float>(pi)) * 0.5f;
-      break;
-    }
+  // the samples are generated in mono on the stack, as rendering must not
+  // allocate
+  float samples[kChunkFrameCount];
+
+  for (int offset = 0; offset < frameCount; offset += kChunkFrameCount) {
+    int chunkFrameCount = std::min(kChunkFrameCount, frameCount - offset);
 
-    buffer[i * 2] = buffer[i * 2 + 1] = sample;
+    for (int i = 0; i < chunkFrameCount; ++i) {
+      samples[i] = generate();
 
-    mPhase = fmodf(
-      static_cast<float>(mPhase + phaseIncrement), static_cast<float>(pi * 2.0f)
+      mPhase = fmodf(
+        static_cast<float>(mPhase + phaseIncrement),
+        static_cast<float>(pi * 2.0f)
+      );
+    }
+
+    Dsp::interleave(
+      buffer + offset * 2, samples, samples,
+      static_cast<std::size_t>(chunkFrameCount)
     );
   }
 }
 
+float OscillatorNode::generate() const {
+  float sample;
+
+  switch (mType) {
+  default:
+    sample = sinf(mPhase);
+    break;
+  case kSquare: {
+    sample = sinf(mPhase);
+    float threshold = 1.0f - mDuty * 2.0f;
+    sample = (sample < threshold) ? -0.33f : 0.33f;
+    break;
+  }
+  case kTriangle:
+    sample = -1.0f + mPhase / static_cast<float>(pi) * 2.0f;
+
+    if (sample > 1.0f) {
+      sample = 1.0f - (sample - 1.0f);
+    }
+    break;
+  case kSawtooth:
+    sample = (-1.0f + mPhase / static_cast<float>(pi)) * 0.5f;
+    break;
+  }
+
+  return sample;
+}
+
 void OscillatorNode::setFrequency(float frequency) { mFrequency = frequency; }
 
 void OscillatorNode::setType(Type type) { mType = type; }
@@ -17,6 +17,11 @@ namespace Luna::Audio {
     void setDuty(float duty);
 
     private:
+    /**
+     * @brief Get the sample at the current phase.
+     */
+    float generate() const;
+
     float mFrequency;
     Type mType;
     float mPhase;
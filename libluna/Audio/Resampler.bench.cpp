@@ -0,0 +1,111 @@
+#include <cmath>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <libluna/Audio/Resampler.hpp>
+#include <libluna/Bench.hpp>
+
+using namespace std;
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr int kFrameCount = 512;
+  constexpr double kPi = 3.14159265358979323846;
+
+  vector<float> makeSine(int frameCount, double frequency, int channelCount) {
+    vector<float> samples;
+
+    for (int i = 0; i < frameCount; ++i) {
+      for (int channel = 0; channel < channelCount; ++channel) {
+        samples.push_back(
+          static_cast<float>(sin(2.0 * kPi * frequency * i + channel))
+        );
+      }
+    }
+
+    return samples;
+  }
+
+  /**
+   * @brief Render @p frameCount frames of @p input, which must hold enough
+   * frames.
+   */
+  void render(
+    Resampler& resampler, const vector<float>& input, vector<float>& window,
+    vector<float>& output, int frameCount, double step
+  ) {
+    int readFrameCount = resampler.getReadFrameCount(frameCount, step);
+    auto sampleCount = readFrameCount * resampler.getChannelCount();
+    copy(
+      input.begin(), input.begin() + sampleCount, resampler.begin(window.data())
+    );
+    resampler.render(
+      output.data(), frameCount, step, window.data(), readFrameCount
+    );
+  }
+
+  /**
+   * @brief Measure how loud a sine that would alias is after halving the
+   * frame rate, relative to the input.
+   */
+  double measureAliasing(Resampler::Quality quality) {
+    auto input = makeSine(kFrameCount * 3, 0.4, 1);
+    vector<float> window(
+      static_cast<size_t>(Resampler::getWindowFrameCount(kFrameCount * 3))
+    );
+    vector<float> output(kFrameCount);
+    Resampler resampler(quality, 1);
+    render(resampler, input, window, output, kFrameCount, 2.0);
+
+    double sum = 0.0;
+
+    // skip the frames filtered with the silence before the input
+    for (int i = Resampler::kMaxTapCount; i < kFrameCount; ++i) {
+      sum += output[static_cast<size_t>(i)] * output[static_cast<size_t>(i)];
+    }
+
+    double rms = sqrt(sum / (kFrameCount - Resampler::kMaxTapCount));
+
+    return 20.0 * log10(rms / sqrt(0.5));
+  }
+} // namespace
+
+int main(int, char**) {
+  static auto input =
+    makeSine(kFrameCount * 4 + Resampler::kMaxTapCount, 0.01, 2);
+  static vector<float> window(
+    static_cast<size_t>(Resampler::getWindowFrameCount(kFrameCount * 4)) * 2
+  );
+  static vector<float> output(kFrameCount * 2);
+
+  static const pair<Resampler::Quality, const char*> qualities[] = {
+    {Resampler::kLinear, "linear"},
+    {Resampler::kCubic, "cubic"},
+    {Resampler::kSinc, "sinc"}};
+
+  for (const auto& quality : qualities) {
+    auto description = fmt::format(
+      "{} at pitch 1.5, aliasing {:.1f} dB", quality.second,
+      measureAliasing(quality.first)
+    );
+
+    BENCH_ITEMS(description, kFrameCount, "frames", [&quality]() {
+      Resampler resampler(quality.first);
+      render(resampler, input, window, output, kFrameCount, 1.5);
+      benchKeep(output);
+    });
+  }
+
+  static SoundBuffer sound(makeSine(44100, 0.01, 1));
+
+  BENCH_ITEMS("convert a second from 44.1 to 48 kHz", 48000, "frames", []() {
+    SoundBuffer buffer(sound);
+    buffer.setFrameRate(44100);
+    Resampler::convert(buffer, 48000);
+    benchKeep(buffer);
+  });
+
+  return runBenchmarks();
+}
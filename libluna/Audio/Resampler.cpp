@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/Dsp.hpp>
+#include <libluna/Audio/Resampler.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr double kPi = 3.14159265358979323846;
+
+  constexpr int kSincTapCount = Resampler::kMaxTapCount;
+
+  /**
+   * @brief Number of fractions between two frames with precomputed
+   * coefficients, those in between are interpolated.
+   */
+  constexpr int kPhaseCount = 128;
+
+  constexpr int kSincTableSize = (kPhaseCount + 1) * kSincTapCount;
+
+  /**
+   * @brief Shape of the Kaiser window, attenuating aliasing by about 70 dB.
+   */
+  constexpr double kKaiserBeta = 6.8;
+
+  /**
+   * @brief Width of the band between passing and stopping frequencies, in
+   * cycles per input frame, resulting from the tap count and window.
+   */
+  constexpr double kTransitionWidth = 0.135;
+
+  /**
+   * @brief Steps with a separate filter.
+   *
+   * Larger steps require lower cutoff frequencies against aliasing. Each
+   * step uses the filter of the next larger one.
+   */
+  constexpr double kSincSteps[] = {1.0, 1.25, 1.5, 2.0, 2.5, 3.0, 4.0};
+
+  constexpr int kSincStepCount = sizeof(kSincSteps) / sizeof(kSincSteps[0]);
+
+  /**
+   * @brief Modified Bessel function of the first kind and order 0.
+   */
+  double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; term > sum * 1e-12; ++k) {
+      double factor = x / (2.0 * k);
+      term *= factor * factor;
+      sum += term;
+    }
+
+    return sum;
+  }
+
+  /**
+   * @brief Build the filters of all steps.
+   *
+   * Each filter has a row of coefficients per phase plus one for the next
+   * frame, so that the coefficients of any fraction are interpolated between
+   * two consecutive rows. Each row is normalized to not change the volume.
+   */
+  std::vector<float> makeSincTables() {
+    std::vector<float> tables(kSincTableSize * kSincStepCount);
+    constexpr double halfWidth = kSincTapCount / 2;
+    const double windowScale = 1.0 / besselI0(kKaiserBeta);
+
+    for (int step = 0; step < kSincStepCount; ++step) {
+      double cutoff = 0.5 / kSincSteps[step] - kTransitionWidth * 0.5;
+
+      for (int phase = 0; phase <= kPhaseCount; ++phase) {
+        double fraction = static_cast<double>(phase) / kPhaseCount;
+        float* row = tables.data() + step * kSincTableSize +
+                     phase * kSincTapCount;
+        double sum = 0.0;
+        double coefficients[kSincTapCount];
+
+        for (int tap = 0; tap < kSincTapCount; ++tap) {
+          double t = tap - (halfWidth - 1.0) - fraction;
+          double ratio = t / halfWidth;
+          double window =
+            ratio * ratio >= 1.0
+              ? 0.0
+              : besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) *
+                  windowScale;
+          double x = 2.0 * cutoff * t;
+          double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+
+          coefficients[tap] = sinc * window;
+          sum += coefficients[tap];
+        }
+
+        for (int tap = 0; tap < kSincTapCount; ++tap) {
+          row[tap] = static_cast<float>(coefficients[tap] / sum);
+        }
+      }
+    }
+
+    return tables;
+  }
+
+  const std::vector<float>& getSincTables() {
+    static const std::vector<float> tables = makeSincTables();
+
+    return tables;
+  }
+
+  const float* getSincTable(double step) {
+    int index = 0;
+
+    while (index + 1 < kSincStepCount && kSincSteps[index] < step) {
+      ++index;
+    }
+
+    return getSincTables().data() + index * kSincTableSize;
+  }
+
+  struct LinearInterpolator {
+    template <int channelCount>
+    static void interpolate(
+      float* output, const float* frames, float fraction, const float*
+    ) {
+      for (int channel = 0; channel < channelCount; ++channel) {
+        float from = frames[channel];
+        output[channel] =
+          from + (frames[channelCount + channel] - from) * fraction;
+      }
+    }
+  };
+
+  struct CubicInterpolator {
+    template <int channelCount>
+    static void interpolate(
+      float* output, const float* frames, float fraction, const float*
+    ) {
+      for (int channel = 0; channel < channelCount; ++channel) {
+        float p0 = frames[channel];
+        float p1 = frames[channelCount + channel];
+        float p2 = frames[channelCount * 2 + channel];
+        float p3 = frames[channelCount * 3 + channel];
+
+        output[channel] =
+          p1 + 0.5f * fraction *
+                 (p2 - p0 +
+                  fraction * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                              fraction * (3.0f * (p1 - p2) + p3 - p0)));
+      }
+    }
+  };
+
+  struct SincInterpolator {
+    template <int channelCount>
+    static void interpolate(
+      float* output, const float* frames, float fraction, const float* table
+    ) {
+      float phase = fraction * kPhaseCount;
+      int index = std::min(static_cast<int>(phase), kPhaseCount - 1);
+      const float* row = table + index * kSincTapCount;
+      float rowFraction = phase - static_cast<float>(index);
+
+      if (channelCount == 2) {
+        Dsp::convolveStereo(
+          output, frames, row, row + kSincTapCount, rowFraction, kSincTapCount
+        );
+      } else {
+        output[0] = Dsp::convolve(
+          frames, row, row + kSincTapCount, rowFraction, kSincTapCount
+        );
+      }
+    }
+  };
+
+  /**
+   * @brief Render frames until @p frameCount frames are rendered or the
+   * next one would read from @p frameLimit on.
+   *
+   * The interpolation and channel count are fixed, so that the compiler can
+   * optimize the loop for each combination.
+   */
+  template <typename Interpolator, int channelCount>
+  int renderFrames(
+    float* output, int frameCount, double position, double step,
+    const float* window, int frameLimit, int halfTapCount, const float* table
+  ) {
+    int renderedFrameCount = 0;
+
+    for (; renderedFrameCount < frameCount; ++renderedFrameCount) {
+      double framePosition =
+        position + static_cast<double>(renderedFrameCount) * step;
+      auto frame = static_cast<int>(framePosition);
+
+      if (frame >= frameLimit) {
+        break;
+      }
+
+      Interpolator::template interpolate<channelCount>(
+        output + renderedFrameCount * channelCount,
+        window + (frame - halfTapCount + 1) * channelCount,
+        static_cast<float>(framePosition - frame), table
+      );
+    }
+
+    return renderedFrameCount;
+  }
+
+  template <typename Interpolator>
+  int renderFrames(
+    int channelCount, float* output, int frameCount, double position,
+    double step, const float* window, int frameLimit, int halfTapCount,
+    const float* table
+  ) {
+    if (channelCount == 2) {
+      return renderFrames<Interpolator, 2>(
+        output, frameCount, position, step, window, frameLimit, halfTapCount,
+        table
+      );
+    }
+
+    return renderFrames<Interpolator, 1>(
+      output, frameCount, position, step, window, frameLimit, halfTapCount,
+      table
+    );
+  }
+
+  int getQualityTapCount(Resampler::Quality quality) {
+    switch (quality) {
+    case Resampler::kLinear:
+      return 2;
+    case Resampler::kCubic:
+      return 4;
+    case Resampler::kSinc:
+      return kSincTapCount;
+    }
+
+    return 2;
+  }
+} // namespace
+
+Resampler::Resampler(Quality quality, int channelCount)
+    : mQuality(quality), mChannelCount(std::clamp(channelCount, 1, 2)),
+      mTapCount(getQualityTapCount(quality)) {
+  if (mQuality == kSinc) {
+    // build the filters now rather than on the audio thread
+    getSincTables();
+  }
+
+  reset();
+}
+
+Resampler::Quality Resampler::getQuality() const { return mQuality; }
+
+int Resampler::getChannelCount() const { return mChannelCount; }
+
+int Resampler::getTapCount() const { return mTapCount; }
+
+void Resampler::reset() {
+  // the first input frame is preceded by silence
+  mHistory.fill(0.0f);
+  mHistoryFrameCount = mTapCount / 2 - 1;
+  mPosition = static_cast<double>(mHistoryFrameCount);
+}
+
+int Resampler::getReadFrameCount(int frameCount, double step) const {
+  double last = mPosition + static_cast<double>(frameCount - 1) * step;
+  int windowFrameCount = static_cast<int>(last) + mTapCount / 2 + 1;
+
+  return std::max(windowFrameCount - mHistoryFrameCount, 0);
+}
+
+int Resampler::getWindowFrameCount(int readFrameCount) {
+  // the history and the silence following the end of the input
+  return readFrameCount + kMaxTapCount + kMaxTapCount / 2;
+}
+
+float* Resampler::begin(float* window) const {
+  auto count = static_cast<std::size_t>(mHistoryFrameCount * mChannelCount);
+  std::copy(mHistory.begin(), mHistory.begin() + count, window);
+
+  return window + count;
+}
+
+int Resampler::render(
+  float* output, int frameCount, double step, float* window,
+  int readFrameCount
+) {
+  int halfTapCount = mTapCount / 2;
+  int windowFrameCount = mHistoryFrameCount + readFrameCount;
+  int availableFrameCount = windowFrameCount;
+
+  if (readFrameCount < getReadFrameCount(frameCount, step)) {
+    std::fill(
+      window + windowFrameCount * mChannelCount,
+      window + (windowFrameCount + halfTapCount) * mChannelCount, 0.0f
+    );
+    availableFrameCount += halfTapCount;
+  }
+
+  // the last frame read must be available
+  int frameLimit =
+    std::min(windowFrameCount, availableFrameCount - halfTapCount);
+  int renderedFrameCount = 0;
+
+  switch (mQuality) {
+  case kLinear:
+    renderedFrameCount = renderFrames<LinearInterpolator>(
+      mChannelCount, output, frameCount, mPosition, step, window, frameLimit,
+      halfTapCount, nullptr
+    );
+    break;
+  case kCubic:
+    renderedFrameCount = renderFrames<CubicInterpolator>(
+      mChannelCount, output, frameCount, mPosition, step, window, frameLimit,
+      halfTapCount, nullptr
+    );
+    break;
+  case kSinc:
+    renderedFrameCount = renderFrames<SincInterpolator>(
+      mChannelCount, output, frameCount, mPosition, step, window, frameLimit,
+      halfTapCount, getSincTable(step)
+    );
+    break;
+  }
+
+  // keep the frames from the first one the next output frame reads
+  double position =
+    mPosition + static_cast<double>(renderedFrameCount) * step;
+  int first = std::clamp(
+    static_cast<int>(position) - halfTapCount + 1, windowFrameCount - mTapCount,
+    windowFrameCount
+  );
+
+  std::copy(
+    window + first * mChannelCount, window + windowFrameCount * mChannelCount,
+    mHistory.begin()
+  );
+  mHistoryFrameCount = windowFrameCount - first;
+  mPosition = position - first;
+
+  return renderedFrameCount;
+}
+
+void Resampler::convert(SoundBuffer& buffer, int frameRate, Quality quality) {
+  if (frameRate <= 0 || buffer.getFrameRate() == frameRate) {
+    return;
+  }
+
+  const auto& samples = buffer.getSamples();
+  double step = static_cast<double>(buffer.getFrameRate()) / frameRate;
+  auto frameCount =
+    static_cast<int>(std::ceil(static_cast<double>(samples.size()) / step));
+
+  Resampler resampler(quality, 1);
+  auto readFrameCount = std::min(
+    resampler.getReadFrameCount(frameCount, step),
+    static_cast<int>(samples.size())
+  );
+
+  std::vector<float> window(
+    static_cast<std::size_t>(getWindowFrameCount(readFrameCount))
+  );
+  std::copy(
+    samples.begin(), samples.begin() + readFrameCount,
+    resampler.begin(window.data())
+  );
+
+  std::vector<float> converted(static_cast<std::size_t>(frameCount));
+  converted.resize(static_cast<std::size_t>(resampler.render(
+    converted.data(), frameCount, step, window.data(), readFrameCount
+  )));
+
+  buffer = SoundBuffer(std::move(converted));
+  buffer.setFrameRate(frameRate);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+
+#include <libluna/SoundBuffer.hpp>
+
+namespace Luna::Audio {
+  /**
+   * @brief Streaming conversion of interleaved mono or stereo frames to
+   * another frame rate.
+   *
+   * The resampler reads input frames at a @p step per output frame, so a
+   * step of 2 plays an octave higher and a step of 44100 / 48000 converts
+   * from 44.1 kHz to 48 kHz. The step may change between calls, like the
+   * pitch of a voice.
+   *
+   * Input frames are read into a window provided by the caller, which is
+   * prefixed with the frames kept from the previous call:
+   *
+   * ```cpp
+   * auto readFrameCount = resampler.getReadFrameCount(frameCount, step);
+   * float* input = resampler.begin(window);
+   * int read = source->write(input, readFrameCount);
+   * resampler.render(output, frameCount, step, window, read);
+   * ```
+   *
+   * The window must hold getWindowFrameCount() frames. As it may be shared
+   * by any number of resamplers, each one only keeps a few frames and none
+   * of the methods used while rendering allocate memory.
+   */
+  class Resampler {
+    public:
+    enum Quality {
+      /**
+       * @brief Interpolate linearly between 2 frames.
+       */
+      kLinear,
+
+      /**
+       * @brief Interpolate a Catmull-Rom spline through 4 frames.
+       */
+      kCubic,
+
+      /**
+       * @brief Filter 32 frames with a Kaiser-windowed sinc.
+       *
+       * Frequencies that would alias are removed, so even large steps sound
+       * clean, at the cost of the highest frequencies.
+       */
+      kSinc
+    };
+
+    /**
+     * @brief Highest number of frames a quality reads per output frame.
+     */
+    static constexpr int kMaxTapCount = 32;
+
+    explicit Resampler(Quality quality = kSinc, int channelCount = 2);
+
+    Quality getQuality() const;
+
+    int getChannelCount() const;
+
+    /**
+     * @brief Get the number of frames read per output frame.
+     */
+    int getTapCount() const;
+
+    /**
+     * @brief Forget the frames read so far, as if starting a new input.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of input frames needed to render @p frameCount
+     * frames at @p step.
+     */
+    int getReadFrameCount(int frameCount, double step) const;
+
+    /**
+     * @brief Get the number of frames a window must hold for reading
+     * @p readFrameCount frames.
+     */
+    static int getWindowFrameCount(int readFrameCount);
+
+    /**
+     * @brief Copy the frames kept from the previous call to @p window.
+     *
+     * @return Where to read the next input frames to.
+     */
+    float* begin(float* window) const;
+
+    /**
+     * @brief Render up to @p frameCount frames to @p output.
+     *
+     * @param window The window passed to begin().
+     * @param readFrameCount Number of input frames read after begin().
+     * Reading fewer than getReadFrameCount() marks the end of the input, the
+     * remaining frames are rendered as if silence followed.
+     *
+     * @return Number of frames rendered, less than @p frameCount once the
+     * input has ended.
+     */
+    int render(
+      float* output, int frameCount, double step, float* window,
+      int readFrameCount
+    );
+
+    /**
+     * @brief Convert the mono samples of @p buffer to @p frameRate.
+     *
+     * Meant to run once per asset when loading it, e.g. as the conversion of
+     * AssetLoader::loadSoundBuffer(), so sounds play at the rate of the
+     * audio device without being resampled while playing.
+     */
+    static void
+    convert(SoundBuffer& buffer, int frameRate, Quality quality = kSinc);
+
+    private:
+    Quality mQuality;
+    int mChannelCount;
+    int mTapCount;
+
+    /**
+     * @brief Frames kept from the previous call, continuing the input.
+     */
+    std::array<float, kMaxTapCount * 2> mHistory;
+    int mHistoryFrameCount;
+
+    /**
+     * @brief Position of the next output frame, relative to the first frame
+     * of the history.
+     */
+    double mPosition;
+  };
+} // namespace Luna::Audio
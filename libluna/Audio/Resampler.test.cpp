@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/AllocationGuard.hpp>
+#include <libluna/Audio/Resampler.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr double kPi = 3.14159265358979323846;
+
+  /**
+   * @brief Samples of a sine with @p frequency in cycles per frame.
+   *
+   * Stereo frames get a cosine on the right channel.
+   */
+  std::vector<float>
+  makeSine(int frameCount, double frequency, int channelCount) {
+    std::vector<float> samples;
+
+    for (int i = 0; i < frameCount; ++i) {
+      double angle = 2.0 * kPi * frequency * i;
+      samples.push_back(static_cast<float>(std::sin(angle)));
+
+      if (channelCount == 2) {
+        samples.push_back(static_cast<float>(std::cos(angle)));
+      }
+    }
+
+    return samples;
+  }
+
+  /**
+   * @brief Resample @p input in chunks of @p chunkFrameCount frames, reading
+   * it like a SoundSource.
+   */
+  std::vector<float> resample(
+    Resampler& resampler, const std::vector<float>& input, double step,
+    int chunkFrameCount
+  ) {
+    int channelCount = resampler.getChannelCount();
+    auto inputFrameCount = static_cast<int>(input.size()) / channelCount;
+    std::vector<float> output;
+    std::vector<float> chunk(
+      static_cast<std::size_t>(chunkFrameCount * channelCount)
+    );
+    std::vector<float> window(static_cast<std::size_t>(
+      Resampler::getWindowFrameCount(
+        static_cast<int>(chunkFrameCount * step) + Resampler::kMaxTapCount
+      ) *
+      channelCount
+    ));
+    int readPosition = 0;
+
+    while (true) {
+      int readFrameCount = std::min(
+        resampler.getReadFrameCount(chunkFrameCount, step),
+        inputFrameCount - readPosition
+      );
+      float* destination = resampler.begin(window.data());
+      std::copy(
+        input.begin() + readPosition * channelCount,
+        input.begin() + (readPosition + readFrameCount) * channelCount,
+        destination
+      );
+      readPosition += readFrameCount;
+
+      int renderedFrameCount = resampler.render(
+        chunk.data(), chunkFrameCount, step, window.data(), readFrameCount
+      );
+      output.insert(
+        output.end(), chunk.begin(),
+        chunk.begin() + renderedFrameCount * channelCount
+      );
+
+      if (renderedFrameCount < chunkFrameCount) {
+        return output;
+      }
+    }
+  }
+
+  /**
+   * @brief Get the largest difference between @p output and a sine read at
+   * @p step, skipping the frames filtered with the silence before the input.
+   */
+  double getError(
+    const std::vector<float>& output, double frequency, double step,
+    int channelCount, int skippedFrameCount
+  ) {
+    double error = 0.0;
+    auto frameCount = static_cast<int>(output.size()) / channelCount;
+
+    for (int i = skippedFrameCount; i < frameCount - skippedFrameCount; ++i) {
+      double angle = 2.0 * kPi * frequency * i * step;
+      error = std::max(
+        error, std::abs(output[i * channelCount] - std::sin(angle))
+      );
+
+      if (channelCount == 2) {
+        error = std::max(
+          error, std::abs(output[i * channelCount + 1] - std::cos(angle))
+        );
+      }
+    }
+
+    return error;
+  }
+
+  double getRms(const std::vector<float>& output, int skippedFrameCount) {
+    double sum = 0.0;
+    int count = 0;
+
+    for (std::size_t i = static_cast<std::size_t>(skippedFrameCount);
+         i + static_cast<std::size_t>(skippedFrameCount) < output.size();
+         ++i) {
+      sum += output[i] * output[i];
+      ++count;
+    }
+
+    return std::sqrt(sum / count);
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("interpolate linearly", []() {
+    std::vector<float> ramp;
+
+    for (int i = 0; i < 100; ++i) {
+      ramp.push_back(static_cast<float>(i));
+    }
+
+    Resampler resampler(Resampler::kLinear, 1);
+    auto output = resample(resampler, ramp, 0.25, 64);
+
+    ASSERT_EQL(static_cast<int>(output.size()), 400, "frame count");
+    ASSERT_EQL(output[1], 0.25f, "first");
+    ASSERT_EQL(output[130], 32.5f, "after a chunk");
+    ASSERT_EQL(output[396], 99.0f, "last");
+  });
+
+  TEST("follow smooth signals", []() {
+    for (auto quality : {Resampler::kCubic, Resampler::kSinc}) {
+      for (int channelCount = 1; channelCount <= 2; ++channelCount) {
+        Resampler resampler(quality, channelCount);
+        auto input = makeSine(2000, 0.01, channelCount);
+        auto output = resample(resampler, input, 0.75, 100);
+
+        ASSERT(
+          getError(output, 0.01, 0.75, channelCount, 32) < 2e-3,
+          "error"
+        );
+      }
+    }
+  });
+
+  TEST("keep frequencies up to the band limit", []() {
+    // 0.3 cycles per frame are close to 14 kHz at 48 kHz
+    Resampler resampler(Resampler::kSinc);
+    auto input = makeSine(2000, 0.3, 2);
+    auto output = resample(resampler, input, 0.5, 128);
+
+    ASSERT(getError(output, 0.3, 0.5, 2, 32) < 1e-3, "sinc");
+  });
+
+  TEST("remove frequencies that would alias", []() {
+    // at half the frame rate, 0.4 cycles per frame alias to 0.2
+    auto input = makeSine(4000, 0.4, 1);
+
+    Resampler linear(Resampler::kLinear, 1);
+    Resampler sinc(Resampler::kSinc, 1);
+    auto aliased = resample(linear, input, 2.0, 256);
+    auto filtered = resample(sinc, input, 2.0, 256);
+
+    ASSERT(getRms(aliased, 32) > 0.5, "linear aliases");
+    ASSERT(getRms(filtered, 32) < 0.001, "sinc filters");
+  });
+
+  TEST("render the end of the input", []() {
+    auto input = makeSine(100, 0.01, 2);
+    Resampler resampler;
+    auto output = resample(resampler, input, 1.5, 16);
+
+    ASSERT_EQL(static_cast<int>(output.size()), 67 * 2, "frame count");
+  });
+
+  TEST("change the step while rendering", []() {
+    Resampler resampler(Resampler::kSinc);
+    auto input = makeSine(4000, 0.01, 2);
+    std::vector<float> window(
+      static_cast<std::size_t>(Resampler::getWindowFrameCount(256 * 4 + 32)) *
+      2
+    );
+    std::vector<float> output(256 * 2);
+    std::size_t readPosition = 0;
+    bool isComplete = true;
+
+    {
+      AllocationGuard guard;
+
+      for (double step : {0.5, 4.0, 1.0, 3.3}) {
+        int readFrameCount = resampler.getReadFrameCount(256, step);
+        auto readSampleCount = static_cast<std::size_t>(readFrameCount) * 2;
+        std::copy(
+          input.begin() + static_cast<std::ptrdiff_t>(readPosition),
+          input.begin() +
+            static_cast<std::ptrdiff_t>(readPosition + readSampleCount),
+          resampler.begin(window.data())
+        );
+        readPosition += readSampleCount;
+
+        isComplete = isComplete && resampler.render(
+                                     output.data(), 256, step, window.data(),
+                                     readFrameCount
+                                   ) == 256;
+      }
+    }
+
+    ASSERT(isComplete, "frame count");
+  });
+
+  TEST("convert sound buffers", []() {
+    SoundBuffer buffer(makeSine(2205, 0.01, 1));
+    buffer.setFrameRate(22050);
+
+    Resampler::convert(buffer, 44100);
+
+    ASSERT_EQL(buffer.getFrameRate(), 44100, "frame rate");
+    ASSERT_EQL(static_cast<int>(buffer.getSamples().size()), 4410, "size");
+    ASSERT(getError(buffer.getSamples(), 0.01, 0.5, 1, 32) < 2e-3, "samples");
+
+    Resampler::convert(buffer, 44100);
+    ASSERT_EQL(static_cast<int>(buffer.getSamples().size()), 4410, "same rate");
+  });
+
+  return runTests();
+}
@@ -0,0 +1,75 @@
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/AudioManager.hpp>
+#include <libluna/Bench.hpp>
+
+using namespace std;
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr int kFrameCount = 512;
+
+  SoundBuffer makeSound() {
+    SoundBuffer sound;
+
+    for (int i = 0; i < 4096; ++i) {
+      sound.getSamples().push_back(sinf(static_cast<float>(i) * 0.05f) * 0.1f);
+    }
+
+    return sound;
+  }
+
+  /**
+   * @brief Play every voice of @p manager, looping @p sources.
+   */
+  void playVoices(
+    AudioManager& manager, vector<SoundBufferSource>& sources, float pitch
+  ) {
+    VoiceMixer::Parameters parameters;
+    parameters.pitch = pitch;
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+      parameters.pan = static_cast<float>(i) / VoiceMixer::kVoiceCount * 2.0f -
+                       1.0f;
+      manager.getVoiceMixer()->play(&sources[i], parameters);
+    }
+
+    manager.update();
+  }
+} // namespace
+
+int main(int, char**) {
+  static auto sound = makeSound();
+  static vector<float> buffer(kFrameCount * 2);
+
+  static AudioManager original;
+  static vector<SoundBufferSource> originalSources(
+    VoiceMixer::kVoiceCount, SoundBufferSource(&sound, true)
+  );
+  playVoices(original, originalSources, 1.0f);
+
+  BENCH_ITEMS(
+    "mix voices at their original pitch", VoiceMixer::kVoiceCount, "voices",
+    []() {
+      original.render(buffer.data(), kFrameCount);
+      benchKeep(buffer);
+    }
+  );
+
+  static AudioManager pitched;
+  static vector<SoundBufferSource> pitchedSources(
+    VoiceMixer::kVoiceCount, SoundBufferSource(&sound, true)
+  );
+  playVoices(pitched, pitchedSources, 1.5f);
+
+  BENCH_ITEMS(
+    "mix pitched voices", VoiceMixer::kVoiceCount, "voices", []() {
+      pitched.render(buffer.data(), kFrameCount);
+      benchKeep(buffer);
+    }
+  );
+
+  return runBenchmarks();
+}
@@ -0,0 +1,279 @@
+#include <algorithm>
+
+#include <libluna/Audio/AudioManager.hpp>
+#include <libluna/Audio/VoiceMixer.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  /**
+   * @brief Frames mixed at once, limiting the size of the voice buffers.
+   */
+  constexpr int kChunkFrameCount = 256;
+
+  /**
+   * @brief Upper limit of the source frames read to render a chunk at the
+   * highest pitch, including the frames the resampler reads ahead.
+   */
+  constexpr int kReadFrameCount =
+    static_cast<int>(kChunkFrameCount * VoiceMixer::kMaxPitch) +
+    Resampler::kMaxTapCount;
+} // namespace
+
+VoiceMixer::VoiceMixer(AudioManager* manager) : AudioNode(manager) {
+  for (auto& id : mPlayingIds) {
+    id.store(0);
+  }
+
+  mVoiceBuffer.resize(kChunkFrameCount * 2);
+  mSourceBuffer.resize(
+    static_cast<std::size_t>(Resampler::getWindowFrameCount(kReadFrameCount)) *
+    2
+  );
+}
+
+VoiceMixer::~VoiceMixer() = default;
+
+void VoiceMixer::render(float* buffer, int frameCount) {
+  // the sources write stereo frames
+  if (getChannelCount() != 2) {
+    return;
+  }
+
+  for (int offset = 0; offset < frameCount; offset += kChunkFrameCount) {
+    int chunkFrameCount = std::min(kChunkFrameCount, frameCount - offset);
+    float* chunk = buffer + offset * 2;
+
+    for (int i = 0; i < mActiveCount;) {
+      int index = mActiveVoices[static_cast<std::size_t>(i)];
+      auto& voice = mVoices[static_cast<std::size_t>(index)];
+      int renderedFrameCount =
+        voice.source ? renderVoice(voice, chunkFrameCount) : 0;
+
+      if (renderedFrameCount > 0) {
+        auto count = static_cast<std::size_t>(renderedFrameCount);
+        Dsp::pan(mVoiceBuffer.data(), voice.gains, count);
+        Dsp::mixAdd(chunk, mVoiceBuffer.data(), count * 2);
+      }
+
+      if (renderedFrameCount == chunkFrameCount) {
+        ++i;
+        continue;
+      }
+
+      // the active voices are unordered, so the last one takes the place of
+      // the finished one
+      release(index);
+      mActiveVoices[static_cast<std::size_t>(i)] =
+        mActiveVoices[static_cast<std::size_t>(--mActiveCount)];
+    }
+  }
+}
+
+void VoiceMixer::stopAll() {
+  for (int i = 0; i < mActiveCount; ++i) {
+    release(mActiveVoices[static_cast<std::size_t>(i)]);
+  }
+
+  mActiveCount = 0;
+}
+
+VoiceMixer::Handle
+VoiceMixer::play(SoundSource* source, const Parameters& parameters) {
+  auto handle = assignVoice(parameters.priority);
+
+  if (!handle.isValid()) {
+    return handle;
+  }
+
+  bool isPushed = mManager->pushCommand(
+    [this, handle, source, parameters, quality = mQuality]() {
+      start(handle.voice, handle.id, source, parameters, quality);
+    }
+  );
+
+  if (!isPushed) {
+    mPlayingIds[static_cast<std::size_t>(handle.voice)].store(0);
+    return {};
+  }
+
+  return handle;
+}
+
+VoiceMixer::Handle VoiceMixer::play(
+  const SoundBufferSource& source, const Parameters& parameters
+) {
+  auto handle = assignVoice(parameters.priority);
+
+  if (!handle.isValid()) {
+    return handle;
+  }
+
+  bool isPushed = mManager->pushCommand(
+    [this, handle, buffer = source.getBuffer(), loop = source.isLooping(),
+     parameters, quality = mQuality]() {
+      auto& voice = mVoices[static_cast<std::size_t>(handle.voice)];
+      voice.bufferSource = SoundBufferSource(buffer, loop);
+      start(handle.voice, handle.id, &voice.bufferSource, parameters, quality);
+    }
+  );
+
+  if (!isPushed) {
+    mPlayingIds[static_cast<std::size_t>(handle.voice)].store(0);
+    return {};
+  }
+
+  return handle;
+}
+
+void VoiceMixer::setParameters(Handle handle, const Parameters& parameters) {
+  if (!isPlaying(handle)) {
+    return;
+  }
+
+  mManager->pushCommand([this, handle, parameters]() {
+    auto& voice = mVoices[static_cast<std::size_t>(handle.voice)];
+
+    if (voice.id == handle.id) {
+      apply(voice, parameters);
+    }
+  });
+}
+
+void VoiceMixer::stop(Handle handle) {
+  if (!handle.isValid()) {
+    return;
+  }
+
+  auto id = handle.id;
+
+  if (!mPlayingIds[static_cast<std::size_t>(handle.voice)]
+         .compare_exchange_strong(id, 0)) {
+    return;
+  }
+
+  mManager->pushCommand([this, handle]() {
+    auto& voice = mVoices[static_cast<std::size_t>(handle.voice)];
+
+    // the voice is released while rendering
+    if (voice.id == handle.id) {
+      voice.source = nullptr;
+    }
+  });
+}
+
+bool VoiceMixer::isPlaying(Handle handle) const {
+  return handle.isValid() &&
+         mPlayingIds[static_cast<std::size_t>(handle.voice)].load() ==
+           handle.id;
+}
+
+int VoiceMixer::getPlayingCount() const {
+  return static_cast<int>(std::count_if(
+    mPlayingIds.begin(), mPlayingIds.end(),
+    [](const std::atomic<std::uint32_t>& id) { return id.load() != 0; }
+  ));
+}
+
+void VoiceMixer::setQuality(Resampler::Quality quality) { mQuality = quality; }
+
+Resampler::Quality VoiceMixer::getQuality() const { return mQuality; }
+
+VoiceMixer::Handle VoiceMixer::assignVoice(int priority) {
+  int index = -1;
+
+  for (std::size_t i = 0; i < kVoiceCount; ++i) {
+    if (mPlayingIds[i].load() == 0) {
+      index = static_cast<int>(i);
+      break;
+    }
+  }
+
+  if (index < 0) {
+    // take over the voice with the lowest priority playing the longest
+    index = 0;
+
+    for (std::size_t i = 1; i < kVoiceCount; ++i) {
+      const auto& slot = mSlots[i];
+      const auto& victim = mSlots[static_cast<std::size_t>(index)];
+
+      if (slot.priority < victim.priority ||
+          (slot.priority == victim.priority && slot.order < victim.order)) {
+        index = static_cast<int>(i);
+      }
+    }
+
+    if (mSlots[static_cast<std::size_t>(index)].priority > priority) {
+      return {};
+    }
+  }
+
+  // 0 marks a free voice
+  if (++mNextId == 0) {
+    ++mNextId;
+  }
+
+  auto voiceIndex = static_cast<std::size_t>(index);
+  mPlayingIds[voiceIndex].store(mNextId);
+  mSlots[voiceIndex] = {priority, ++mPlayCount};
+
+  return {index, mNextId};
+}
+
+void VoiceMixer::start(
+  int index, std::uint32_t id, SoundSource* source,
+  const Parameters& parameters, Resampler::Quality quality
+) {
+  auto& voice = mVoices[static_cast<std::size_t>(index)];
+  voice.source = source;
+  voice.id = id;
+  voice.resampler = Resampler(quality);
+  voice.isResampling = false;
+  apply(voice, parameters);
+
+  // a voice taken over is active already
+  if (!voice.isActive) {
+    voice.isActive = true;
+    mActiveVoices[static_cast<std::size_t>(mActiveCount++)] = index;
+  }
+}
+
+void VoiceMixer::apply(Voice& voice, const Parameters& parameters) {
+  voice.pitch = std::clamp(parameters.pitch, 0.0f, kMaxPitch);
+  voice.gains = Dsp::getPanGains(parameters.pan, parameters.volume);
+}
+
+int VoiceMixer::renderVoice(Voice& voice, int frameCount) {
+  // once resampled, the resampler holds source frames and must continue to
+  // resample
+  if (voice.pitch == 1.0f && !voice.isResampling) {
+    return voice.source->write(mVoiceBuffer.data(), frameCount);
+  }
+
+  voice.isResampling = true;
+
+  auto& resampler = voice.resampler;
+  float* window = mSourceBuffer.data();
+  int readFrameCount = resampler.getReadFrameCount(frameCount, voice.pitch);
+  float* input = resampler.begin(window);
+
+  if (readFrameCount > 0) {
+    readFrameCount = voice.source->write(input, readFrameCount);
+  }
+
+  return resampler.render(
+    mVoiceBuffer.data(), frameCount, voice.pitch, window, readFrameCount
+  );
+}
+
+void VoiceMixer::release(int index) {
+  auto& voice = mVoices[static_cast<std::size_t>(index)];
+  auto id = voice.id;
+
+  // the main thread may have assigned the voice to another sound already
+  mPlayingIds[static_cast<std::size_t>(index)].compare_exchange_strong(id, 0);
+
+  voice.source = nullptr;
+  voice.isActive = false;
+}
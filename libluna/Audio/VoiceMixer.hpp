@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <libluna/Audio/AudioNode.hpp>
+#include <libluna/Audio/Dsp.hpp>
+#include <libluna/Audio/Resampler.hpp>
+#include <libluna/SoundBufferSource.hpp>
+
+namespace Luna::Audio {
+  /**
+   * @brief Node mixing a fixed number of voices playing sound sources.
+   *
+   * Each voice plays a SoundSource with its own pitch, pan and volume. A
+   * voice whose pitch is not 1 is read through a Resampler. The voices are
+   * assigned on the main thread. If all of them are busy, the voice with the
+   * lowest priority is taken over, preferring the one playing the longest.
+   *
+   * Starting, changing and stopping a voice is sent to the audio thread as a
+   * command, so it applies with the next AudioManager::update(). Voices
+   * whose source has finished are released by the audio thread.
+   *
+   * The sources must write interleaved stereo frames and are read on the
+   * audio thread, so they must not allocate memory and must stay alive while
+   * they are playing. A source playing on multiple voices at once is read by
+   * each of them. Sound buffers are played with a position per voice
+   * instead, so the same effect can play any number of times at once.
+   *
+   * @see Sound
+   */
+  class VoiceMixer : public AudioNode {
+    public:
+    /**
+     * @brief Number of voices that may play at the same time.
+     */
+    static constexpr std::size_t kVoiceCount = 256;
+
+    /**
+     * @brief Highest supported pitch, higher values are limited to it.
+     */
+    static constexpr float kMaxPitch = 4.0f;
+
+    struct Parameters {
+      /**
+       * @brief Playback speed, 2 plays an octave higher.
+       */
+      float pitch{1.0f};
+
+      /**
+       * @brief -1 for left, 0 for center and 1 for right.
+       */
+      float pan{0.0f};
+
+      float volume{1.0f};
+
+      /**
+       * @brief Voices with a higher priority take over voices with a lower
+       * one if no voice is free.
+       */
+      int priority{0};
+    };
+
+    /**
+     * @brief Reference to a voice playing a specific source.
+     *
+     * It stays valid after the voice has been taken over, isPlaying() is
+     * false for it then.
+     */
+    struct Handle {
+      int voice{-1};
+      std::uint32_t id{0};
+
+      bool isValid() const { return voice >= 0; }
+    };
+
+    VoiceMixer(AudioManager* manager);
+    ~VoiceMixer();
+
+    void render(float* buffer, int frameCount) override;
+
+    /**
+     * @brief Release all voices at once (audio thread only).
+     */
+    void stopAll();
+
+    /**
+     * @name Main thread
+     */
+    ///@{
+    /**
+     * @brief Play @p source on a voice.
+     *
+     * @return An invalid handle if all voices are busy with sounds of a
+     * higher priority.
+     */
+    Handle play(SoundSource* source, const Parameters& parameters);
+
+    /**
+     * @brief Play the buffer of @p source from the start on a voice with a
+     * position of its own.
+     *
+     * The source is copied, so it doesn't need to stay alive, but its buffer
+     * must until the voice has finished or been stopped.
+     */
+    Handle play(const SoundBufferSource& source, const Parameters& parameters);
+
+    /**
+     * @brief Change the pitch, pan and volume of a playing voice.
+     *
+     * The priority of a voice can't be changed while it is playing.
+     */
+    void setParameters(Handle handle, const Parameters& parameters);
+
+    void stop(Handle handle);
+
+    bool isPlaying(Handle handle) const;
+
+    /**
+     * @brief Get the number of voices playing or about to play.
+     */
+    int getPlayingCount() const;
+
+    /**
+     * @brief Set how voices played from now on are resampled when their
+     * pitch is not 1, Resampler::kSinc by default.
+     */
+    void setQuality(Resampler::Quality quality);
+
+    Resampler::Quality getQuality() const;
+    ///@}
+
+    private:
+    /**
+     * @brief State of a voice on the audio thread.
+     */
+    struct Voice {
+      SoundSource* source{nullptr};
+
+      /**
+       * @brief Copy of a sound buffer source played by this voice only.
+       */
+      SoundBufferSource bufferSource{nullptr};
+
+      std::uint32_t id{0};
+      float pitch{1.0f};
+      Dsp::PanGains gains{0.0f, 0.0f};
+      Resampler resampler;
+
+      /**
+       * @brief Whether the source is read through the resampler, which keeps
+       * some of its frames.
+       */
+      bool isResampling{false};
+
+      bool isActive{false};
+    };
+
+    /**
+     * @brief State of a voice on the main thread.
+     */
+    struct Slot {
+      int priority{0};
+      std::uint64_t order{0};
+    };
+
+    /**
+     * @brief Assign a voice to a new sound (main thread only).
+     *
+     * @return An invalid handle if all voices are busy with sounds of a
+     * higher priority.
+     */
+    Handle assignVoice(int priority);
+
+    /**
+     * @name Audio thread
+     */
+    ///@{
+    void start(
+      int index, std::uint32_t id, SoundSource* source,
+      const Parameters& parameters, Resampler::Quality quality
+    );
+
+    void apply(Voice& voice, const Parameters& parameters);
+
+    /**
+     * @brief Render up to @p frameCount frames of @p voice into mVoiceBuffer.
+     *
+     * @return Number of frames rendered, less than @p frameCount if the
+     * source has finished.
+     */
+    int renderVoice(Voice& voice, int frameCount);
+
+    void release(int index);
+    ///@}
+
+    std::array<Voice, kVoiceCount> mVoices;
+
+    /**
+     * @brief Indices of the active voices, so that only those are visited.
+     */
+    std::array<int, kVoiceCount> mActiveVoices;
+    int mActiveCount{0};
+
+    std::vector<float> mVoiceBuffer;
+
+    /**
+     * @brief Window the voices are resampled from.
+     */
+    std::vector<float> mSourceBuffer;
+
+    std::array<Slot, kVoiceCount> mSlots;
+    std::uint32_t mNextId{0};
+    std::uint64_t mPlayCount{0};
+    Resampler::Quality mQuality{Resampler::kSinc};
+
+    /**
+     * @brief Identifier of the sound each voice plays, or 0 if it is free.
+     *
+     * Set by the main thread when assigning a voice and reset by the audio
+     * thread when the source has finished.
+     */
+    std::array<std::atomic<std::uint32_t>, kVoiceCount> mPlayingIds;
+  };
+} // namespace Luna::Audio
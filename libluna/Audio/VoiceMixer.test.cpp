@@ -0,0 +1,215 @@
+#include <cmath>
+#include <vector>
+
+#include <libluna/Audio/AllocationGuard.hpp>
+#include <libluna/Audio/AudioManager.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  SoundBuffer makeRamp(int sampleCount) {
+    SoundBuffer buffer;
+
+    for (int i = 0; i < sampleCount; ++i) {
+      buffer.getSamples().push_back(static_cast<float>(i) / 1000.0f);
+    }
+
+    return buffer;
+  }
+
+  bool isNear(float value, float expected) {
+    return std::abs(value - expected) < 1e-4f;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("play sounds until they have finished", []() {
+    AudioManager manager;
+    SoundBuffer sound(std::vector<float>(100, 0.5f));
+    SoundBufferSource source(&sound);
+
+    manager.playSound(&source);
+    ASSERT_EQL(manager.getVoiceMixer()->getPlayingCount(), 1, "playing");
+
+    manager.update();
+
+    std::vector<float> buffer(256 * 2);
+
+    {
+      AllocationGuard guard;
+      manager.render(buffer.data(), 256);
+    }
+
+    // center panning keeps the power constant
+    ASSERT(isNear(buffer[0], 0.5f * std::sqrt(0.5f)), "left");
+    ASSERT(isNear(buffer[99 * 2 + 1], 0.5f * std::sqrt(0.5f)), "right");
+    ASSERT_EQL(buffer[100 * 2], 0.0f, "finished");
+    ASSERT_EQL(manager.getVoiceMixer()->getPlayingCount(), 0, "released");
+
+    manager.update();
+
+    // the finished sound has been returned to the pool
+    std::vector<Sound*> sounds;
+
+    while (auto created = manager.createSound()) {
+      sounds.push_back(created);
+    }
+
+    ASSERT_EQL(
+      static_cast<int>(sounds.size()),
+      static_cast<int>(VoiceMixer::kVoiceCount), "recycled"
+    );
+
+    for (auto created : sounds) {
+      manager.destroySound(created);
+    }
+  });
+
+  TEST("play a sound buffer on several voices", []() {
+    AudioManager manager;
+    auto ramp = makeRamp(100);
+    SoundBufferSource source(&ramp);
+
+    manager.playSound(&source);
+    manager.playSound(&source);
+    manager.update();
+
+    std::vector<float> buffer(256 * 2);
+    manager.render(buffer.data(), 256);
+
+    // both voices read the ramp from the start
+    auto gain = 2.0f * std::sqrt(0.5f);
+    ASSERT(isNear(buffer[10 * 2], 0.010f * gain), "own positions");
+    ASSERT(isNear(buffer[99 * 2], 0.099f * gain), "full length");
+    ASSERT_EQL(manager.getVoiceMixer()->getPlayingCount(), 0, "finished");
+
+    manager.update();
+    manager.playSound(&source);
+    manager.update();
+    manager.render(buffer.data(), 256);
+
+    ASSERT(isNear(buffer[10 * 2], 0.010f * std::sqrt(0.5f)), "played again");
+  });
+
+  TEST("change pitch and pan", []() {
+    AudioManager manager;
+    auto ramp = makeRamp(1000);
+    SoundBufferSource fastSource(&ramp);
+
+    // interpolating linearly keeps the ramp exact
+    manager.getVoiceMixer()->setQuality(Resampler::kLinear);
+    SoundBufferSource slowSource(&ramp);
+
+    auto fast = manager.createSound();
+    fast->setSource(&fastSource);
+    fast->setPitch(2.0f);
+    fast->setPan(-1.0f);
+    fast->play();
+
+    manager.update();
+
+    std::vector<float> buffer(300 * 2);
+    manager.render(buffer.data(), 300);
+
+    ASSERT(isNear(buffer[10 * 2], 0.020f), "faster");
+    ASSERT(isNear(buffer[299 * 2], 0.598f), "faster after a chunk");
+    ASSERT(isNear(buffer[10 * 2 + 1], 0.0f), "left only");
+
+    fast->stop();
+    ASSERT(!fast->isPlaying(), "stopped");
+
+    auto slow = manager.createSound();
+    slow->setSource(&slowSource);
+    slow->setPitch(0.5f);
+    slow->setPan(1.0f);
+    slow->play();
+
+    manager.update();
+    manager.render(buffer.data(), 300);
+
+    ASSERT(isNear(buffer[1 * 2 + 1], 0.0005f), "interpolated");
+    ASSERT(isNear(buffer[257 * 2 + 1], 0.1285f), "interpolated after a chunk");
+    ASSERT(isNear(buffer[299 * 2 + 1], 0.1495f), "slower");
+    ASSERT(isNear(buffer[299 * 2], 0.0f), "right only");
+
+    slow->setPitch(1.0f);
+    manager.update();
+    manager.render(buffer.data(), 2);
+
+    ASSERT(isNear(buffer[1 * 2 + 1], 0.151f), "original pitch");
+
+    manager.destroySound(fast);
+    manager.destroySound(slow);
+  });
+
+  TEST("take over voices by priority", []() {
+    AudioManager manager;
+    auto mixer = manager.getVoiceMixer();
+    auto ramp = makeRamp(64);
+    SoundBufferSource source(&ramp, true);
+    VoiceMixer::Parameters parameters;
+    parameters.priority = 1;
+
+    std::vector<VoiceMixer::Handle> handles;
+
+    for (std::size_t i = 0; i < VoiceMixer::kVoiceCount; ++i) {
+      handles.push_back(mixer->play(&source, parameters));
+    }
+
+    ASSERT(handles.back().isValid(), "all voices");
+
+    parameters.priority = 0;
+    ASSERT(!mixer->play(&source, parameters).isValid(), "lower priority");
+
+    parameters.priority = 1;
+    auto same = mixer->play(&source, parameters);
+    ASSERT(same.isValid(), "same priority");
+    ASSERT(!mixer->isPlaying(handles[0]), "oldest taken over");
+    ASSERT(mixer->isPlaying(handles[1]), "others playing");
+
+    parameters.priority = 2;
+    auto higher = mixer->play(&source, parameters);
+    ASSERT(higher.isValid(), "higher priority");
+    ASSERT_EQL(higher.voice, handles[1].voice, "next oldest taken over");
+
+    manager.update();
+
+    std::vector<float> buffer(64 * 2);
+
+    {
+      AllocationGuard guard;
+      manager.render(buffer.data(), 64);
+    }
+
+    ASSERT_EQL(
+      mixer->getPlayingCount(), static_cast<int>(VoiceMixer::kVoiceCount),
+      "looping"
+    );
+
+    mixer->stop(same);
+    ASSERT(!mixer->isPlaying(same), "stopped");
+    ASSERT(mixer->play(&source, parameters).voice == same.voice, "reused");
+  });
+
+  TEST("stop all voices", []() {
+    AudioManager manager;
+    auto mixer = manager.getVoiceMixer();
+    auto ramp = makeRamp(64);
+    SoundBufferSource source(&ramp, true);
+
+    auto handle = mixer->play(&source, VoiceMixer::Parameters());
+    manager.update();
+
+    std::vector<float> buffer(64 * 2);
+    manager.render(buffer.data(), 64);
+    ASSERT(mixer->isPlaying(handle), "looping");
+
+    mixer->stopAll();
+    ASSERT(!mixer->isPlaying(handle), "stopped");
+    ASSERT_EQL(mixer->getPlayingCount(), 0, "all free");
+  });
+
+  return runTests();
+}
@@ -0,0 +1,143 @@
+#include <libluna/Audio/WavDecoder.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Audio;
+
+namespace {
+  constexpr uint16_t kFormatPcm = 1;
+  constexpr uint16_t kFormatFloat = 3;
+  constexpr uint16_t kFormatExtensible = 0xfffe;
+
+  uint16_t readLe16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+  }
+
+  uint32_t readLe32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) |
+           (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) |
+           (static_cast<uint32_t>(data[3]) << 24);
+  }
+
+  float readSample(const uint8_t* data, uint16_t format, uint16_t bits) {
+    if (format == kFormatFloat) {
+      float value;
+      uint32_t raw = readLe32(data);
+      std::memcpy(&value, &raw, sizeof(value));
+
+      return value;
+    }
+
+    switch (bits) {
+    case 8:
+      // 8 bit samples are unsigned
+      return static_cast<float>(data[0] - 128) / 128.0f;
+    case 16:
+      return static_cast<float>(static_cast<int16_t>(readLe16(data))) /
+             32768.0f;
+    case 24: {
+      auto value = static_cast<int32_t>(
+        (static_cast<uint32_t>(data[0]) << 8) |
+        (static_cast<uint32_t>(data[1]) << 16) |
+        (static_cast<uint32_t>(data[2]) << 24)
+      );
+
+      return static_cast<float>(value / 256) / 8388608.0f;
+    }
+    default:
+      return static_cast<float>(
+               static_cast<double>(static_cast<int32_t>(readLe32(data))) /
+               2147483648.0
+             );
+    }
+  }
+} // namespace
+
+bool Audio::decodeWav(const uint8_t* data, std::size_t size, SoundBuffer& buffer) {
+  if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 ||
+      std::memcmp(data + 8, "WAVE", 4) != 0) {
+    logError("not a WAVE file");
+    return false;
+  }
+
+  const uint8_t* format = nullptr;
+  std::size_t formatSize = 0;
+  const uint8_t* samples = nullptr;
+  std::size_t samplesSize = 0;
+  std::size_t offset = 12;
+
+  while (offset + 8 <= size) {
+    auto chunkSize = static_cast<std::size_t>(readLe32(data + offset + 4));
+    auto chunk = data + offset + 8;
+    auto available = size - offset - 8;
+
+    if (std::memcmp(data + offset, "fmt ", 4) == 0 && chunkSize >= 16 &&
+        chunkSize <= available) {
+      format = chunk;
+      formatSize = chunkSize;
+    } else if (std::memcmp(data + offset, "data", 4) == 0) {
+      // tolerate truncated files and streaming writers leaving the size at 0
+      samples = chunk;
+      samplesSize = chunkSize == 0 ? available : std::min(chunkSize, available);
+    }
+
+    // chunks are padded to an even size
+    offset += 8 + chunkSize + (chunkSize & 1);
+  }
+
+  if (!format || !samples) {
+    logError("WAVE file is missing the format or data chunk");
+    return false;
+  }
+
+  auto formatTag = readLe16(format);
+  auto channels = readLe16(format + 2);
+  auto frameRate = readLe32(format + 4);
+  auto bits = readLe16(format + 14);
+
+  if (formatTag == kFormatExtensible) {
+    // the sub format GUID starts with the actual format tag
+    formatTag = formatSize >= 26 ? readLe16(format + 24) : kFormatPcm;
+  }
+
+  bool supported =
+    (formatTag == kFormatPcm &&
+     (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+    (formatTag == kFormatFloat && bits == 32);
+
+  if (!supported || channels == 0) {
+    logError(
+      "unsupported WAVE format {} with {} bits per sample", formatTag, bits
+    );
+    return false;
+  }
+
+  std::size_t bytesPerSample = bits / 8u;
+  std::size_t bytesPerFrame = bytesPerSample * channels;
+  std::size_t frameCount = samplesSize / bytesPerFrame;
+
+  std::vector<float> mono(frameCount);
+  float scale = 1.0f / static_cast<float>(channels);
+
+  for (std::size_t frame = 0; frame < frameCount; ++frame) {
+    auto frameData = samples + frame * bytesPerFrame;
+    float sum = 0.0f;
+
+    for (std::size_t channel = 0; channel < channels; ++channel) {
+      sum += readSample(frameData + channel * bytesPerSample, formatTag, bits);
+    }
+
+    mono[frame] = sum * scale;
+  }
+
+  buffer = SoundBuffer(std::move(mono));
+  buffer.setFrameRate(static_cast<int>(frameRate));
+
+  return true;
+}
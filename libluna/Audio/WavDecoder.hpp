@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+#include <libluna/SoundBuffer.hpp>
+
+namespace Luna::Audio {
+  /**
+   * @brief Decode a RIFF WAVE file into a sound buffer.
+   *
+   * Supports 8, 16, 24 and 32 bit integer and 32 bit floating point PCM,
+   * including the extensible format. Multiple channels are mixed down to a
+   * single channel. The frame rate of the file is stored in the buffer.
+   *
+   * @return false and logs an error if the file is invalid or not supported.
+   * The buffer is left untouched in that case.
+   */
+  bool decodeWav(const uint8_t* data, std::size_t size, SoundBuffer& buffer);
+} // namespace Luna::Audio
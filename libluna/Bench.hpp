@@ -0,0 +1,134 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <libluna/Console.hpp>
+#include <libluna/Performance/Timer.hpp>
+
+struct Bench {
+  std::string description;
+  std::size_t bytesPerIteration;
+  std::function<void()> callback;
+  std::size_t itemsPerIteration{0};
+  std::string itemName;
+};
+
+static std::list<Bench> benchmarks;
+
+/**
+ * @brief Minimum time each benchmark is repeated for, in seconds.
+ */
+static double benchMinTime = 0.5;
+
+/**
+ * @brief Register a benchmark.
+ *
+ * If @p bytesPerIteration is not zero, the throughput is reported in MB/s in
+ * addition to the time per iteration.
+ */
+static void BENCH(
+  const std::string& description, std::size_t bytesPerIteration,
+  std::function<void()> callback
+) {
+  benchmarks.push_back(Bench{
+    description,
+    bytesPerIteration,
+    callback,
+    0,
+    "",
+  });
+}
+
+static void BENCH(const std::string& description, std::function<void()> callback) {
+  BENCH(description, 0, callback);
+}
+
+/**
+ * @brief Register a benchmark processing @p itemsPerIteration items.
+ *
+ * The throughput is reported in items per millisecond, such as voices mixed.
+ */
+static void BENCH_ITEMS(
+  const std::string& description, std::size_t itemsPerIteration,
+  const std::string& itemName, std::function<void()> callback
+) {
+  benchmarks.push_back(Bench{
+    description,
+    0,
+    callback,
+    itemsPerIteration,
+    itemName,
+  });
+}
+
+/**
+ * @brief Prevent the compiler from optimizing away a computed value.
+ */
+template <typename T> static void benchKeep(T&& value) {
+#ifdef _MSC_VER
+  // MSVC has no inline assembly on x64, so the address escapes into a
+  // volatile variable instead
+  static const void* volatile sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+static int runBenchmarks() {
+  Luna::Console::init();
+
+  int index = 0;
+
+  for (auto& bench : benchmarks) {
+    ++index;
+    Luna::Console::write("[{}/{}]: {}:", index, benchmarks.size(), bench.description);
+
+    // warm up caches and lazy initialization
+    bench.callback();
+
+    Luna::Performance::Timer timer;
+    double elapsed = 0.0;
+    std::size_t iterations = 0;
+    std::size_t batch = 1;
+    timer.start();
+
+    while (elapsed < benchMinTime) {
+      for (std::size_t i = 0; i < batch; ++i) {
+        bench.callback();
+      }
+
+      iterations += batch;
+      elapsed += timer.elapse();
+      batch *= 2;
+    }
+
+    double secondsPerIteration = elapsed / static_cast<double>(iterations);
+    Luna::Console::write(" {:.3f} us", secondsPerIteration * 1e6);
+
+    if (bench.bytesPerIteration > 0) {
+      double megabytes = static_cast<double>(bench.bytesPerIteration) / 1e6;
+      Luna::Console::write(", {:.1f} MB/s", megabytes / secondsPerIteration);
+    }
+
+    if (bench.itemsPerIteration > 0) {
+      double items = static_cast<double>(bench.itemsPerIteration);
+      Luna::Console::write(
+        ", {:.1f} {}/ms", items / (secondsPerIteration * 1e3), bench.itemName
+      );
+    }
+
+    Luna::Console::writeLine(" ({} iterations)", iterations);
+  }
+
+  Luna::Console::quit();
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+#include <libluna/BufferedInputStream.hpp>
+
+#include <algorithm>
+#include <cstring> // memchr, memcpy, memmove
+
+using namespace Luna;
+
+BufferedInputStream::BufferedInputStream(
+  InputStream& source, std::size_t bufferSize
+)
+    : mSource(&source), mBuffer(std::max<std::size_t>(bufferSize, 1)),
+      mBufferPosition(source.tell()) {}
+
+BufferedInputStream::BufferedInputStream(
+  std::unique_ptr<InputStream> source, std::size_t bufferSize
+)
+    : BufferedInputStream(*source, bufferSize) {
+  mOwnedSource = std::move(source);
+}
+
+BufferedInputStream::~BufferedInputStream() = default;
+
+bool BufferedInputStream::isValid() const { return mSource->isValid(); }
+
+std::size_t BufferedInputStream::getSize() const { return mSource->getSize(); }
+
+bool BufferedInputStream::eof() const {
+  return mBegin == mEnd && mBufferPosition + mEnd >= getSize();
+}
+
+std::size_t BufferedInputStream::tell() { return mBufferPosition + mBegin; }
+
+std::size_t BufferedInputStream::seek(std::size_t position) {
+  if (position >= mBufferPosition && position <= mBufferPosition + mEnd) {
+    mBegin = position - mBufferPosition;
+
+    return position;
+  }
+
+  mBufferPosition = mSource->seek(position);
+  mBegin = 0;
+  mEnd = 0;
+
+  return mBufferPosition;
+}
+
+std::size_t BufferedInputStream::seekRelative(int relativePosition) {
+  auto position = tell();
+
+  if (relativePosition < 0 &&
+      static_cast<std::size_t>(-relativePosition) > position) {
+    return seek(0);
+  }
+
+  return seek(position + static_cast<std::size_t>(relativePosition));
+}
+
+std::size_t BufferedInputStream::read(
+  uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+) {
+  if (objectSize == 0) {
+    return 0;
+  }
+
+  auto byteCount = objectSize * objectCount;
+  std::size_t bytesRead = 0;
+
+  while (bytesRead < byteCount) {
+    if (mBegin == mEnd) {
+      auto remaining = byteCount - bytesRead;
+
+      if (remaining >= mBuffer.size()) {
+        // large reads go straight into the destination
+        mBufferPosition += mEnd;
+        mBegin = 0;
+        mEnd = 0;
+
+        auto count = mSource->read(buffer + bytesRead, 1, remaining);
+        mBufferPosition += count;
+        bytesRead += count;
+        break;
+      }
+
+      if (!refill()) {
+        break;
+      }
+    }
+
+    auto count = std::min(byteCount - bytesRead, mEnd - mBegin);
+    std::memcpy(buffer + bytesRead, mBuffer.data() + mBegin, count);
+    mBegin += count;
+    bytesRead += count;
+  }
+
+  // don't consume incomplete objects
+  auto partial = bytesRead % objectSize;
+
+  if (partial > 0) {
+    seek(tell() - partial);
+  }
+
+  return bytesRead / objectSize;
+}
+
+int BufferedInputStream::peek() {
+  if (mBegin == mEnd && !refill()) {
+    return -1;
+  }
+
+  return mBuffer[mBegin];
+}
+
+bool BufferedInputStream::readUntil(char delimiter, std::string& output) {
+  output.clear();
+  bool hasData = false;
+
+  while (mBegin < mEnd || refill()) {
+    hasData = true;
+
+    auto begin = mBuffer.data() + mBegin;
+    auto size = mEnd - mBegin;
+    auto found = static_cast<const uint8_t*>(std::memchr(begin, delimiter, size));
+
+    if (found) {
+      auto length = static_cast<std::size_t>(found - begin);
+      output.append(reinterpret_cast<const char*>(begin), length);
+      mBegin += length + 1;
+
+      return true;
+    }
+
+    output.append(reinterpret_cast<const char*>(begin), size);
+    mBegin = mEnd;
+  }
+
+  return hasData;
+}
+
+bool BufferedInputStream::readLine(std::string& line) {
+  if (!readUntil('\n', line)) {
+    return false;
+  }
+
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+
+  return true;
+}
+
+bool BufferedInputStream::readLine(char* buffer, std::size_t bufferSize) {
+  if (bufferSize == 0 || (mBegin == mEnd && !refill())) {
+    return false;
+  }
+
+  std::size_t length = 0;
+  bool lineBreak = false;
+
+  while (length + 1 < bufferSize && (mBegin < mEnd || refill())) {
+    auto begin = mBuffer.data() + mBegin;
+    auto size = std::min(mEnd - mBegin, bufferSize - 1 - length);
+    auto found = static_cast<const uint8_t*>(std::memchr(begin, '\n', size));
+    auto count = found ? static_cast<std::size_t>(found - begin) : size;
+
+    std::memcpy(buffer + length, begin, count);
+    length += count;
+    mBegin += count;
+
+    if (found) {
+      // consume the line break
+      ++mBegin;
+      lineBreak = true;
+      break;
+    }
+  }
+
+  // a line filling the buffer exactly doesn't leave an empty line behind
+  if (!lineBreak && peek() == '\n') {
+    ++mBegin;
+  }
+
+  if (length > 0 && buffer[length - 1] == '\r') {
+    --length;
+  }
+
+  buffer[length] = '\0';
+
+  return true;
+}
+
+bool BufferedInputStream::refill() {
+  auto remaining = mEnd - mBegin;
+
+  if (mBegin > 0) {
+    std::memmove(mBuffer.data(), mBuffer.data() + mBegin, remaining);
+    mBufferPosition += mBegin;
+    mBegin = 0;
+    mEnd = remaining;
+  }
+
+  if (mEnd == mBuffer.size()) {
+    return false;
+  }
+
+  auto count = mSource->read(mBuffer.data() + mEnd, 1, mBuffer.size() - mEnd);
+  mEnd += count;
+
+  return count > 0;
+}
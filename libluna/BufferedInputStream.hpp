@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libluna/InputStream.hpp>
+
+namespace Luna {
+  /**
+   * @brief Input stream reading ahead from another stream in large chunks.
+   *
+   * Small reads, peek() and the line and token scanning functions are served
+   * from an internal buffer, so they don't cost a call into the underlying
+   * stream for each byte. Lines and tokens are located using memchr().
+   *
+   * ```cpp
+   * Luna::BufferedInputStream input(Luna::ResourceReader::make("font.fnt"));
+   * std::string line;
+   *
+   * while (input.readLine(line)) {
+   *   parseLine(line);
+   * }
+   * ```
+   *
+   * Data is read from the underlying stream as bytes, so its endianness is
+   * not applied.
+   *
+   * @ingroup streams
+   */
+  class BufferedInputStream final : public InputStream {
+    public:
+    static constexpr std::size_t kDefaultBufferSize = 64 * 1024;
+
+    /**
+     * @brief Read from a stream which must outlive this one.
+     */
+    explicit BufferedInputStream(
+      InputStream& source, std::size_t bufferSize = kDefaultBufferSize
+    );
+
+    explicit BufferedInputStream(
+      std::unique_ptr<InputStream> source,
+      std::size_t bufferSize = kDefaultBufferSize
+    );
+
+    ~BufferedInputStream();
+
+    bool isValid() const override;
+    std::size_t getSize() const override;
+    bool eof() const override;
+    std::size_t tell() override;
+    std::size_t seek(std::size_t position) override;
+    std::size_t seekRelative(int relativePosition) override;
+    std::size_t read(
+      uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+    ) override;
+    using InputStream::read;
+
+    /**
+     * @brief Get the next byte without consuming it.
+     *
+     * @return -1 at the end of the stream.
+     */
+    int peek();
+
+    /**
+     * @brief Read up to the next delimiter.
+     *
+     * The delimiter is consumed, but not stored in @p output.
+     *
+     * @return false if the end of the stream was reached before reading
+     * anything.
+     */
+    bool readUntil(char delimiter, std::string& output);
+
+    /**
+     * @brief Read the next line without the line break.
+     *
+     * Both `\n` and `\r\n` line breaks are supported.
+     *
+     * @return false if the end of the stream was reached.
+     */
+    bool readLine(std::string& line);
+
+    /**
+     * @brief Read the next line into a null-terminated buffer.
+     *
+     * At most @p bufferSize - 1 characters are stored. The remainder of a
+     * longer line is returned by the next call.
+     *
+     * @return false if the end of the stream was reached.
+     */
+    bool readLine(char* buffer, std::size_t bufferSize);
+
+    private:
+    /**
+     * @brief Keep the unread bytes and read more behind them.
+     *
+     * @return false if no more bytes could be read.
+     */
+    bool refill();
+
+    std::unique_ptr<InputStream> mOwnedSource;
+    InputStream* mSource;
+    std::vector<uint8_t> mBuffer;
+
+    /**
+     * @brief Position of the first buffered byte in the source.
+     */
+    std::size_t mBufferPosition;
+    std::size_t mBegin{0};
+    std::size_t mEnd{0};
+  };
+} // namespace Luna
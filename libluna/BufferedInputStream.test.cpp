@@ -0,0 +1,84 @@
+#include <string>
+
+#include <libluna/BufferedInputStream.hpp>
+#include <libluna/MemoryReader.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+int main(int, char**) {
+  TEST("readLine() across buffer boundaries", []() {
+    string text = "first line\r\nsecond\n\nlast line without break";
+    MemoryReader source(text.data(), text.size());
+    BufferedInputStream input(source, 4);
+    string line;
+
+    ASSERT(input.readLine(line), "first");
+    ASSERT_EQL(line, "first line", "first contents");
+    ASSERT(input.readLine(line), "second");
+    ASSERT_EQL(line, "second", "second contents");
+    ASSERT(input.readLine(line), "empty");
+    ASSERT_EQL(line, "", "empty contents");
+    ASSERT(input.readLine(line), "last");
+    ASSERT_EQL(line, "last line without break", "last contents");
+    ASSERT(!input.readLine(line), "end");
+    ASSERT(input.eof(), "eof");
+  });
+
+  TEST("readLine() into a fixed buffer", []() {
+    string text = "abcdefgh\nij\n";
+    MemoryReader source(text.data(), text.size());
+    BufferedInputStream input(source, 3);
+    char buffer[5];
+
+    ASSERT(input.readLine(buffer, sizeof(buffer)), "truncated");
+    ASSERT_EQL(string(buffer), "abcd", "truncated contents");
+    ASSERT(input.readLine(buffer, sizeof(buffer)), "remainder");
+    ASSERT_EQL(string(buffer), "efgh", "remainder contents");
+    ASSERT(input.readLine(buffer, sizeof(buffer)), "next");
+    ASSERT_EQL(string(buffer), "ij", "next contents");
+    ASSERT(!input.readLine(buffer, sizeof(buffer)), "end");
+  });
+
+  TEST("readUntil() and peek()", []() {
+    string text = "key=value;x";
+    MemoryReader source(text.data(), text.size());
+    BufferedInputStream input(source, 2);
+    string token;
+
+    ASSERT_EQL(input.peek(), 'k', "peek");
+    ASSERT(input.readUntil('=', token), "key");
+    ASSERT_EQL(token, "key", "key contents");
+    ASSERT_EQL(input.peek(), 'v', "peek after delimiter");
+    ASSERT(input.readUntil(';', token), "value");
+    ASSERT_EQL(token, "value", "value contents");
+    ASSERT(input.readUntil(';', token), "rest");
+    ASSERT_EQL(token, "x", "rest contents");
+    ASSERT_EQL(input.peek(), -1, "peek at end");
+  });
+
+  TEST("read() and seek()", []() {
+    string text = "0123456789abcdefghij";
+    MemoryReader source(text.data(), text.size());
+    BufferedInputStream input(source, 4);
+    char bytes[16] = {};
+
+    ASSERT_EQL(static_cast<int>(input.read(bytes, 3)), 3, "small read");
+    ASSERT_EQL(string(bytes, 3), "012", "small contents");
+    ASSERT_EQL(static_cast<int>(input.read(bytes, 10)), 10, "large read");
+    ASSERT_EQL(string(bytes, 10), "3456789abc", "large contents");
+    ASSERT_EQL(static_cast<int>(input.tell()), 13, "tell");
+
+    input.seekRelative(-2);
+    ASSERT_EQL(input.peek(), 'b', "seek back");
+    input.seek(18);
+    ASSERT_EQL(input.peek(), 'i', "seek forward");
+
+    uint32_t value;
+    ASSERT_EQL(static_cast<int>(input.read(&value)), 0, "incomplete object");
+    ASSERT_EQL(static_cast<int>(input.tell()), 18, "incomplete not consumed");
+  });
+
+  return runTests();
+}
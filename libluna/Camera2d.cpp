@@ -4,12 +4,16 @@ using namespace Luna;
 
 Camera2d::Camera2d() = default;
 
-Camera2d::Camera2d(const Camera2d& other) : mPosition{other.mPosition}, mStage{other.mStage} {}
+Camera2d::Camera2d(const Camera2d& other)
+    : mPosition{other.mPosition}, mPreviousPosition{other.mPreviousPosition},
+      mHasPreviousPosition{other.mHasPreviousPosition}, mStage{other.mStage} {}
 
 Camera2d::~Camera2d() = default;
 
 Camera2d& Camera2d::operator=(const Camera2d& other) {
   mPosition = other.mPosition;
+  mPreviousPosition = other.mPreviousPosition;
+  mHasPreviousPosition = other.mHasPreviousPosition;
   mStage = other.mStage;
 
   return *this;
@@ -19,6 +23,19 @@ Vector2f Camera2d::getPosition() const { return mPosition; }
 
 void Camera2d::setPosition(const Vector2f& position) { mPosition = position; }
 
+void Camera2d::storePreviousPosition() {
+  mPreviousPosition = mPosition;
+  mHasPreviousPosition = true;
+}
+
+Vector2f Camera2d::getInterpolatedPosition(float alpha) const {
+  if (!mHasPreviousPosition || alpha >= 1.0f) {
+    return mPosition;
+  }
+
+  return mPreviousPosition + (mPosition - mPreviousPosition) * alpha;
+}
+
 void Camera2d::setStage(Stage* stage) { mStage = stage; }
 
 Stage* Camera2d::getStage() const { return mStage; }
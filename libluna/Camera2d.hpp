@@ -21,11 +21,22 @@ namespace Luna {
     Vector2f getPosition() const;
     void setPosition(const Vector2f& position);
 
+    /**
+     * @brief Remember the current position for interpolation.
+     *
+     * @see Drawable2d::storePreviousPosition()
+     */
+    void storePreviousPosition();
+
+    Vector2f getInterpolatedPosition(float alpha) const;
+
     void setStage(Stage* stage);
     Stage* getStage() const;
 
     private:
     Vector2f mPosition;
+    Vector2f mPreviousPosition;
+    bool mHasPreviousPosition{false};
     Stage* mStage{nullptr};
   };
 } // namespace Luna
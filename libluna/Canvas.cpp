@@ -13,13 +13,16 @@
 #include <libluna/Canvas.hpp>
 
 #include <functional>
+#include <utility>
 
 #include <fmt/format.h>
 
 #include <libluna/AbstractRenderer.hpp>
 #include <libluna/Application.hpp>
+#include <libluna/Command.hpp>
 #include <libluna/Console.hpp>
 #include <libluna/Logger.hpp>
+#include <libluna/Performance/Timer.hpp>
 
 #ifdef LUNA_WINDOW_SDL2
 #include <SDL2/SDL.h>
@@ -96,19 +99,36 @@ namespace {
 #endif // #ifdef LUNA_USE_GLFW
   }
 #endif // #ifdef LUNA_RENDERER_OPENGL
-} // namespace
 
-Command::~Command() = default;
+#ifdef LUNA_THREADED_CANVAS
+  /**
+   * @brief Wait for the render thread and add the time spent to @p waitTime.
+   */
+  template <typename Predicate>
+  bool timedWait(
+    Internal::EventCount& event, Predicate predicate, double& waitTime
+  ) {
+    using namespace std::chrono_literals;
+
+    if (predicate()) {
+      return true;
+    }
 
-class CanvasCommand : public Command {
-  public:
-  CanvasCommand(std::function<void()> callback) : mCallback(callback) {}
+    Performance::Timer timer;
+    timer.start();
+    bool result = event.waitFor(predicate, 4s);
+    waitTime += timer.elapse();
 
-  void execute() const override { mCallback(); }
+    if (!result) {
+      logError("wait timeout expired and predicate still false");
+    }
 
-  private:
-  std::function<void()> mCallback;
-};
+    return result;
+  }
+#endif
+} // namespace
+
+Command::~Command() = default;
 
 void Canvas::createWindow([[maybe_unused]] const DisplayMode& displayMode) {
   Console::quit();
@@ -206,22 +226,38 @@ void Canvas::createWindow([[maybe_unused]] const DisplayMode& displayMode) {
 
 void Canvas::processCommandQueue() {
 #ifdef LUNA_THREADED_CANVAS
-  mCv.notify_one();
+  mCommandEvent.notify();
 #else
-  while (!mCommandQueue.empty()) {
-    auto command = mCommandQueue.front();
-    mCommandQueue.pop();
-    command->execute();
+  while (mCommandQueue.executeNext()) {
   }
 #endif
 }
 
+void Canvas::waitForCommandQueueSpace() {
+#ifdef LUNA_THREADED_CANVAS
+  timedWait(
+    mCommandEvent, [this]() { return !mCommandQueue.full(); },
+    mMainThreadWaitTime
+  );
+#else
+  processCommandQueue();
+#endif
+}
+
 Internal::GraphicsMetrics Canvas::getMetrics() {
-  if (!mRenderer) {
-    return {};
+  Internal::GraphicsMetrics metrics;
+
+  if (mRenderer) {
+    metrics = mRenderer->getMetrics();
   }
 
-  return mRenderer->getMetrics();
+  metrics.commandQueueDepth = static_cast<int>(mCommandQueue.size());
+  metrics.commandQueueMaxDepth = static_cast<int>(mCommandQueue.getMaxSize());
+  metrics.commandQueueCapacity = static_cast<int>(mCommandQueue.getCapacity());
+  metrics.mainThreadWaitTime = mLastMainThreadWaitTime;
+  metrics.renderThreadWaitTime = mLastRenderThreadWaitTime;
+
+  return metrics;
 }
 
 #ifdef LUNA_THREADED_CANVAS
@@ -232,14 +268,18 @@ void Canvas::renderThread() {
   Logger::getInstance().setThreadIdentifier(fmt::format("Render {}", threadId));
   logDebug("renderThread #{} spawned", threadId);
 
-  std::unique_lock lock(mMutex);
-
   logDebug("entering renderThread #{} loop", threadId);
 
+  Performance::Timer timer;
+
   while (true) {
-    mCv.wait(lock, [this]() {
-      return mExitRequested || !mCommandQueue.empty();
-    });
+    if (!mExitRequested && mCommandQueue.empty()) {
+      timer.start();
+      mCommandEvent.wait([this]() {
+        return mExitRequested || !mCommandQueue.empty();
+      });
+      mRenderThreadWaitTime += timer.elapse();
+    }
 
     if (mExitRequested) {
       logDebug("exiting renderThread #{}", threadId);
@@ -249,19 +289,31 @@ void Canvas::renderThread() {
         mRenderer.reset();
       }
 
+      mCommandQueue.clear();
       mExitRequested = false;
       return;
     }
 
-    while (!mCommandQueue.empty()) {
-      auto command = mCommandQueue.front();
-      mCommandQueue.pop();
-      command->execute();
+    while (mCommandQueue.executeNext()) {
+      // the main thread may be waiting for a free slot or a finished frame
+      mCommandEvent.notify();
     }
-
-    mCv.notify_one();
   }
 }
+
+void Canvas::enqueueSdlEventPolling() {
+#ifdef LUNA_WINDOW_SDL2
+  // on Linux, SDL events are sent to the main thread only
+  // on Windows, SDL events are sent to the individual threads
+  enqueueCommand([]() {
+    SDL_Event event;
+
+    while (SDL_PollEvent(&event)) {
+      Application::getInstance()->pushSdlEvent(&event);
+    }
+  });
+#endif
+}
 #endif
 
 #ifdef LUNA_WINDOW_SDL2
@@ -289,22 +341,19 @@ bool Canvas::sdlEventTargetsThis(const SDL_Event* event) {
 }
 
 bool Canvas::sendSdlEventToImmediateGui(const SDL_Event* event) {
-  if (mImmediateGuis.size() > 0) {
-    bool result{false};
-    auto command = std::make_shared<CanvasCommand>(([this, &result, event]() {
-      result = ImmediateGui::processSdlEvent(event);
-    }));
-
-    mCommandQueue.emplace(command);
-    processCommandQueue();
-    sync();
+  if (mImmediateGuis.empty() || !mRenderer) {
+    return false;
+  }
 
-    if (result) {
-      return true;
-    }
+  // only the latest mouse position matters to the gui
+  if (event->type == SDL_MOUSEMOTION && !mSdlEvents.empty() &&
+      mSdlEvents.back().type == SDL_MOUSEMOTION) {
+    mSdlEvents.back() = *event;
+  } else {
+    mSdlEvents.push_back(*event);
   }
 
-  return false;
+  return (ImmediateGui::getSdlEventInput(event) & mImmediateGuiCapture) != 0;
 }
 #endif
 
@@ -325,11 +374,8 @@ void Canvas::close() {
 
 #ifdef LUNA_THREADED_CANVAS
   if (mThread.joinable()) {
-    {
-      std::lock_guard lock(mMutex);
-      mExitRequested = true;
-    }
-    mCv.notify_one();
+    mExitRequested = true;
+    mCommandEvent.notify();
     mThread.join();
   }
 #else
@@ -391,7 +437,7 @@ void Canvas::setDisplayMode(DisplayMode mode) {
     mode.videoDriver = Application::getInstance()->getDefaultVideoDriver();
   }
 
-  auto command = std::make_shared<CanvasCommand>(([this, mode]() {
+  enqueueCommand([this, mode]() {
     createWindow(mode);
 
     logInfo("setting canvas video driver to {}", mode.videoDriver.c_str());
@@ -469,36 +515,37 @@ void Canvas::setDisplayMode(DisplayMode mode) {
     mRenderer->setCanvas(this);
 
     mRenderer->initialize();
-  }));
-
-  mCommandQueue.emplace(command);
-
-  processCommandQueue();
+  });
 }
 
 void Canvas::attachImmediateGui(std::unique_ptr<ImmediateGui> gui) {
+  // frames in flight iterate the guis on the render thread
+  this->sync();
+
   auto guiPtr = gui.get();
   mImmediateGuis.emplace_back(std::move(gui));
 
-  auto command = std::make_shared<CanvasCommand>(([this, guiPtr]() {
+  enqueueCommand([this, guiPtr]() {
     guiPtr->init(this);
     mRenderer->initializeImmediateGui();
-  }));
-
-  mCommandQueue.emplace(command);
-  processCommandQueue();
+  });
 }
 
 void Canvas::detachImmediateGui(ImmediateGui* gui) {
+  // frames in flight may still render the gui
+  this->sync();
+
   mImmediateGuis.remove_if([gui](auto& item) { return item.get() == gui; });
 
   if (mImmediateGuis.size() == 0) {
-    auto command = std::make_shared<CanvasCommand>(([this]() {
-      mRenderer->quitImmediateGui();
-    }));
+#ifdef LUNA_WINDOW_SDL2
+    mSdlEvents.clear();
+    mImmediateGuiCapture = 0;
+#endif
 
-    mCommandQueue.emplace(command);
-    processCommandQueue();
+    enqueueCommand([this]() {
+      mRenderer->quitImmediateGui();
+    });
     this->sync();
   }
 }
@@ -526,52 +573,84 @@ void Canvas::setBackgroundColor(ColorRgb color) { mBackgroundColor = color; }
 ColorRgb Canvas::getBackgroundColor() const { return mBackgroundColor; }
 
 void Canvas::uploadTexture(int slot, const Texture* texture) {
-  auto command = std::make_shared<CanvasCommand>([this, slot, texture]() {
+  enqueueCommand([this, slot, texture]() {
+    if (mRenderer) {
+      mRenderer->uploadTexture(slot, TextureView(*texture));
+    }
+  });
+}
+
+void Canvas::uploadTexture(int slot, std::shared_ptr<const Texture> texture) {
+  enqueueCommand([this, slot, texture = std::move(texture)]() {
+    if (mRenderer) {
+      mRenderer->uploadTexture(slot, TextureView(*texture));
+    }
+  });
+}
+
+void Canvas::uploadTexture(int slot, const TextureView& texture) {
+  enqueueCommand([this, slot, texture]() {
     if (mRenderer) {
       mRenderer->uploadTexture(slot, texture);
     }
   });
+}
 
-  mCommandQueue.emplace(command);
-  processCommandQueue();
+void Canvas::updateTextureRegion(
+  int slot, const Recti& rect, const TextureView& data
+) {
+  enqueueCommand([this, slot, rect, data]() {
+    if (mRenderer) {
+      mRenderer->updateTextureRegion(slot, rect, data);
+    }
+  });
 }
 
 void Canvas::uploadTextures(int firstSlot, int lastSlot, const Texture** textures) {
-  auto command = std::make_shared<CanvasCommand>([this, firstSlot, lastSlot, textures]() {
+  enqueueCommand([this, firstSlot, lastSlot, textures]() {
     if (mRenderer) {
       for (int slot = firstSlot; slot <= lastSlot; ++slot) {
         int index = slot - firstSlot;
-        mRenderer->uploadTexture(slot, textures[index]);
+        mRenderer->uploadTexture(slot, TextureView(*textures[index]));
       }
     }
   });
+}
 
-  mCommandQueue.emplace(command);
-  processCommandQueue();
+void Canvas::uploadPalette(int slot, const Palette* palette) {
+  enqueueCommand([this, slot, palette]() {
+    if (mRenderer) {
+      mRenderer->uploadPalette(slot, palette);
+    }
+  });
 }
 
 void Canvas::freeTexture(int slot) {
-  auto command = std::make_shared<CanvasCommand>([this, slot]() {
+  enqueueCommand([this, slot]() {
     if (mRenderer) {
       mRenderer->freeTexture(slot);
     }
   });
-
-  mCommandQueue.emplace(command);
-  processCommandQueue();
 }
 
 void Canvas::freeTextures(int firstSlot, int lastSlot) {
-  auto command = std::make_shared<CanvasCommand>([this, firstSlot, lastSlot]() {
+  enqueueCommand([this, firstSlot, lastSlot]() {
     if (mRenderer) {
       for (int slot = firstSlot; slot <= lastSlot; ++slot) {
         mRenderer->freeTexture(slot);
       }
     }
   });
+}
 
-  mCommandQueue.emplace(command);
-  processCommandQueue();
+void Canvas::reloadShader(std::string filename, std::string source) {
+  enqueueCommand(
+    [this, filename = std::move(filename), source = std::move(source)]() {
+      if (mRenderer) {
+        mRenderer->reloadShader(filename, source);
+      }
+    }
+  );
 }
 
 #ifdef LUNA_WINDOW_SDL2
@@ -594,57 +673,102 @@ void Canvas::render() {
     return;
   }
 
-  auto command = std::make_shared<CanvasCommand>(([this]() {
+  mLastMainThreadWaitTime = static_cast<float>(mMainThreadWaitTime);
+  mMainThreadWaitTime = 0.0;
+
+  // frames finish in order, so the oldest snapshot is free again once no more
+  // than kMaxFramesInFlight frames are in flight
+  waitForFramesInFlight(kMaxFramesInFlight);
+
+  auto slot = mNextSnapshot;
+  mNextSnapshot = (mNextSnapshot + 1) % mSnapshots.size();
+  mSnapshots[slot].capture(
+    mBackgroundColor, mCamera2d, mCamera3d,
+    Application::getInstance()->getInterpolationAlpha()
+  );
+  ++mFramesInFlight;
+
+#ifdef LUNA_WINDOW_SDL2
+  // swapping keeps the capacity of both vectors, so this doesn't allocate
+  mSdlEventBatches[slot].clear();
+  std::swap(mSdlEventBatches[slot], mSdlEvents);
+#endif
+
+  enqueueCommand([this, slot]() {
 #if defined(LUNA_WINDOW_SDL2) && defined(LUNA_RENDERER_OPENGL)
     if (sdl.glContext) {
       SDL_GL_MakeCurrent(sdl.window, sdl.glContext);
     }
 #endif
 
-    mRenderer->render();
+#ifdef LUNA_WINDOW_SDL2
+    for (auto& event : mSdlEventBatches[slot]) {
+      ImmediateGui::processSdlEvent(&event);
+    }
+#endif
+
+    mRenderer->render(mSnapshots[slot]);
 
     for (auto& gui : mImmediateGuis) {
       gui->render(gui.get());
     }
 
+#ifdef LUNA_WINDOW_SDL2
+    if (!mImmediateGuis.empty()) {
+      mImmediateGuiCapture = ImmediateGui::getInputCapture();
+    }
+#endif
+
     mRenderer->present();
-  }));
 
-  mCommandQueue.emplace(command);
-  processCommandQueue();
+    mLastRenderThreadWaitTime = static_cast<float>(mRenderThreadWaitTime);
+    mRenderThreadWaitTime = 0.0;
+    --mFramesInFlight;
+  });
 }
 
 void Canvas::sync() {
 #ifdef LUNA_THREADED_CANVAS
-  using namespace std::chrono_literals;
+  enqueueSdlEventPolling();
 
-  std::unique_lock lock(mMutex);
-
-#ifdef LUNA_WINDOW_SDL2
-  // on Linux, SDL events are sent to the main thread only
-  // on Windows, SDL events are sent to the individual threads
-  auto command = std::make_shared<CanvasCommand>(([]() {
-    SDL_Event event;
+  // commands are removed from the queue after they have been executed
+  timedWait(
+    mCommandEvent, [this]() { return mCommandQueue.empty(); },
+    mMainThreadWaitTime
+  );
+#endif
+}
 
-    while (SDL_PollEvent(&event)) {
-      Application::getInstance()->pushSdlEvent(&event);
-    }
-  }));
+void Canvas::waitForFrames(int maxFramesInFlight) {
+#ifdef LUNA_THREADED_CANVAS
+  enqueueSdlEventPolling();
+#endif
 
-  mCommandQueue.emplace(command);
+  waitForFramesInFlight(maxFramesInFlight);
+}
 
-  processCommandQueue();
+void Canvas::waitForFramesInFlight([[maybe_unused]] int maxFramesInFlight) {
+#ifdef LUNA_THREADED_CANVAS
+  timedWait(
+    mCommandEvent,
+    [this, maxFramesInFlight]() { return mFramesInFlight <= maxFramesInFlight; },
+    mMainThreadWaitTime
+  );
 #endif
+}
 
-  if (!mCommandQueue.empty()) {
-    bool result =
-      mCv.wait_for(lock, 4s, [this]() { return mCommandQueue.empty(); });
+int Canvas::getFramesInFlight() const { return mFramesInFlight; }
 
-    if (!result) {
-      logError("wait timeout expired and predicate still false");
-    }
+void Canvas::storePreviousPositions() {
+  if (!mCamera2d) {
+    return;
+  }
+
+  mCamera2d->storePreviousPosition();
+
+  if (auto stage = mCamera2d->getStage()) {
+    stage->storePreviousPositions();
   }
-#endif
 }
 
 bool Canvas::isClosed() const { return mClosed; }
@@ -2,10 +2,14 @@
 
 #include <libluna/config.h>
 
+#include <array>
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 #if defined(__linux__) || defined(_WIN32)
 #define LUNA_THREADED_CANVAS
@@ -18,10 +22,9 @@
 #endif
 
 #ifdef LUNA_THREADED_CANVAS
-#include <condition_variable>
-#include <mutex>
-#include <queue>
 #include <thread>
+
+#include <libluna/Internal/EventCount.hpp>
 #endif
 
 #ifdef LUNA_WINDOW_SDL2
@@ -42,10 +45,13 @@
 #include <libluna/Camera3d.hpp>
 #include <libluna/Canvas.hpp>
 #include <libluna/Color.hpp>
-#include <libluna/Command.hpp>
+#include <libluna/CommandQueue.hpp>
 #include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
 #include <libluna/ImmediateGui.hpp>
 #include <libluna/Internal/GraphicsMetrics.hpp>
+#include <libluna/Rect.hpp>
+#include <libluna/RenderSnapshot.hpp>
 #include <libluna/Stage.hpp>
 #include <libluna/String.hpp>
 #include <libluna/Vector.hpp>
@@ -76,6 +82,14 @@ namespace Luna {
    * The same stage can be assigned to multiple canvases, for example to render
    * the same screen using different renderers or cameras.
    *
+   * On platforms with threading support, the graphics run on a dedicated
+   * thread. @ref render() captures the cameras and their stages into a
+   * RenderSnapshot, so the stage may be modified for the next frame as soon as
+   * @ref render() returns. Whether the main thread waits for the frame to
+   * finish (@ref sync()) or continues while up to @ref kMaxFramesInFlight
+   * frames are being rendered (@ref waitForFrames()) is decided by the
+   * application, see Application::setMaxFramesInFlight().
+   *
    * @ingroup canvas
    */
   class Canvas {
@@ -85,6 +99,12 @@ namespace Luna {
     Canvas();
 
     public:
+    /**
+     * @brief Maximum number of frames that may be rendered while the
+     * application already updates the next one.
+     */
+    static constexpr int kMaxFramesInFlight = 2;
+
     Canvas(const Canvas&) = delete;
     Canvas& operator=(const Canvas&) = delete;
 
@@ -112,15 +132,83 @@ namespace Luna {
     ColorRgb getBackgroundColor() const;
 
     void uploadTexture(int slot, const Texture* texture);
+
+    /**
+     * @brief Upload a shared texture, keeping it alive until the command has
+     * been processed.
+     */
+    void uploadTexture(int slot, std::shared_ptr<const Texture> texture);
+
+    /**
+     * @brief Upload a region of an image without copying it first.
+     *
+     * The pixel data the view refers to must stay valid until the command has
+     * been processed.
+     */
+    void uploadTexture(int slot, const TextureView& texture);
+
+    /**
+     * @brief Replace a region of an uploaded texture.
+     *
+     * This is much cheaper than uploading the whole texture again if only a
+     * small part of it changed. The data is placed at the position of @p rect
+     * and must be at least as large as the rect. The pixel data the view
+     * refers to must stay valid until the command has been processed.
+     */
+    void updateTextureRegion(int slot, const Recti& rect, const TextureView& data);
     void uploadTextures(int firstSlot, int lastSlot, const Texture** textures);
+
+    /**
+     * @brief Replace the palette of the indexed texture at the given slot.
+     *
+     * The palette must stay valid until the command has been processed.
+     */
+    void uploadPalette(int slot, const Palette* palette);
     void freeTexture(int slot);
     void freeTextures(int firstSlot, int lastSlot);
 
+    /**
+     * @brief Replace the source of a shader file of the renderer.
+     *
+     * @see AbstractRenderer::reloadShader()
+     */
+    void reloadShader(std::string filename, std::string source);
+
     TexturePtr captureScreenshot();
 
+    /**
+     * @brief Submit a frame for rendering.
+     *
+     * The cameras and stages are captured at the time of this call. If
+     * @ref kMaxFramesInFlight frames are already in flight, this blocks until
+     * the oldest one has finished.
+     */
     void render();
+
+    /**
+     * @brief Wait until all submitted commands, including frames, have been
+     * processed.
+     */
     void sync();
 
+    /**
+     * @brief Wait until at most the given number of frames are in flight.
+     *
+     * Unlike @ref sync(), this allows the application to update the next frame
+     * while the previous ones are still being rendered. Resources referred to
+     * by commands (textures, palettes, fonts, shapes, meshes) must stay valid
+     * and unmodified until the frames using them have finished.
+     *
+     * @param maxFramesInFlight 0 to wait for all frames, up to
+     * @ref kMaxFramesInFlight.
+     */
+    void waitForFrames(int maxFramesInFlight);
+
+    /**
+     * @brief Get the number of frames submitted but not yet presented.
+     */
+    int getFramesInFlight() const;
+
     /**
      * @brief Get the current value of an axis input.
      *
@@ -138,6 +226,17 @@ namespace Luna {
 
 #ifdef LUNA_WINDOW_SDL2
     bool sdlEventTargetsThis(const SDL_Event* event);
+
+    /**
+     * @brief Forward an event to the immediate guis of this canvas.
+     *
+     * The events are collected and passed to the render thread in one batch
+     * with the next frame. Whether an event is consumed is answered right
+     * away, based on the input the guis captured during the last rendered
+     * frame.
+     *
+     * @return true if the event was consumed by the guis.
+     */
     bool sendSdlEventToImmediateGui(const SDL_Event* event);
     struct {
       SDL_Window* window{nullptr};
@@ -160,8 +259,43 @@ namespace Luna {
 #endif
 
     private:
+    /**
+     * @brief Maximum number of pending commands.
+     */
+    static constexpr std::size_t kCommandQueueCapacity = 256;
+
+    /**
+     * @brief Maximum size of a command lambda including its captures.
+     */
+    static constexpr std::size_t kCommandSize = 128;
+
     void createWindow(const DisplayMode& mode);
+
+    /**
+     * @brief Remember the positions of the 2D camera and its drawables at the
+     * start of a fixed tick.
+     */
+    void storePreviousPositions();
+
+    /**
+     * @brief Queue a command for the render thread.
+     *
+     * On platforms without threads, the command is executed immediately. If
+     * the queue is full, this blocks until the render thread caught up.
+     */
+    template <typename F> void enqueueCommand(F&& command) {
+      // a failed push leaves the command untouched, so it may be forwarded
+      // again
+      while (!mCommandQueue.tryPush(std::forward<F>(command))) {
+        waitForCommandQueueSpace();
+      }
+
+      processCommandQueue();
+    }
+
     void processCommandQueue();
+    void waitForCommandQueueSpace();
+    void waitForFramesInFlight(int maxFramesInFlight);
 
     Vector2i mSize;
     Vector2i mInternalResolution;
@@ -173,7 +307,46 @@ namespace Luna {
     std::map<std::string, float> mAxisValues;
     bool mClosed{true};
 
-    std::queue<std::shared_ptr<Command>> mCommandQueue;
+    CommandQueue<kCommandQueueCapacity, kCommandSize> mCommandQueue;
+
+    /**
+     * @name Wait times
+     *
+     * Time in seconds the main thread spent waiting for the render thread and
+     * the other way round. The accumulated values of the last frame are
+     * reported in the metrics.
+     */
+    ///@{
+    double mMainThreadWaitTime{0.0};
+    double mRenderThreadWaitTime{0.0};
+    std::atomic<float> mLastMainThreadWaitTime{0.0f};
+    std::atomic<float> mLastRenderThreadWaitTime{0.0f};
+    ///@}
+
+    /**
+     * @brief Ring of snapshots, one per frame in flight plus the one being
+     * captured.
+     */
+    std::array<RenderSnapshot, kMaxFramesInFlight + 1> mSnapshots;
+    std::size_t mNextSnapshot{0};
+    std::atomic<int> mFramesInFlight{0};
+
+#ifdef LUNA_WINDOW_SDL2
+    /**
+     * @brief Events for the immediate guis collected for the next frame.
+     */
+    std::vector<SDL_Event> mSdlEvents;
+
+    /**
+     * @brief Event batches handed over to the render thread, one per snapshot.
+     */
+    std::array<std::vector<SDL_Event>, kMaxFramesInFlight + 1> mSdlEventBatches;
+
+    /**
+     * @brief ImmediateGui::InputCapture flags of the last rendered frame.
+     */
+    std::atomic<int> mImmediateGuiCapture{0};
+#endif
 
 #ifdef LUNA_THREADED_CANVAS
     /**
@@ -181,6 +354,7 @@ namespace Luna {
      */
     ///@{
     void renderThread();
+    void enqueueSdlEventPolling();
 
     /**
      * @brief The thread on which the graphics were initialized and a loop is
@@ -189,17 +363,12 @@ namespace Luna {
     std::thread mThread;
 
     /**
-     * @brief The mutex for notifications via `mCv`.
-     */
-    std::mutex mMutex;
-
-    /**
-     * @brief Condition variable to either notify the thread to process the
-     * command queue or the main thread if the command queue is empty.
+     * @brief Wakes either the thread to process the command queue or the main
+     * thread waiting for commands or frames to finish.
      */
-    std::condition_variable mCv;
+    Internal::EventCount mCommandEvent;
 
-    bool mExitRequested{false};
+    std::atomic<bool> mExitRequested{false};
     ///@}
 #endif
   };
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Luna {
+  /**
+   * @brief Bounded single-producer, single-consumer queue of commands.
+   *
+   * A command is any callable taking no arguments, such as a lambda. It is
+   * stored by value in a fixed-size slot of a ring buffer, so pushing and
+   * executing commands never allocates memory and never locks. The callable
+   * and everything it captures must fit into @p kCommandSize bytes, which is
+   * checked at compile time.
+   *
+   * Exactly one thread may push commands (the producer) and exactly one
+   * thread may execute them (the consumer) at the same time. The queue does
+   * not block: @ref tryPush() fails if the queue is full and
+   * @ref executeNext() returns false if it is empty. It is up to the owner to
+   * decide how to wait.
+   *
+   * ```cpp
+   * Luna::CommandQueue<64> queue;
+   *
+   * // producer
+   * queue.tryPush([value]() { process(value); });
+   *
+   * // consumer
+   * while (queue.executeNext()) {}
+   * ```
+   *
+   * @tparam kCapacity Maximum number of pending commands. Must be a power of
+   * two.
+   * @tparam kCommandSize Maximum size of a command in bytes.
+   */
+  template <std::size_t kCapacity, std::size_t kCommandSize = 64>
+  class CommandQueue {
+    static_assert(
+      kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+      "capacity must be a power of two"
+    );
+
+    public:
+    CommandQueue() = default;
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    ~CommandQueue() { clear(); }
+
+    /**
+     * @brief Add a command to the queue (producer only).
+     *
+     * @return false if the queue is full. In that case, @p command is left
+     * untouched and may be pushed again later.
+     */
+    template <typename F> bool tryPush(F&& command) {
+      return tryPush(std::forward<F>(command), 0);
+    }
+
+    /**
+     * @brief Add a command with a stamp to the queue (producer only).
+     *
+     * The stamp is not interpreted by the queue. The consumer may use it to
+     * decide when to execute the command, such as a time.
+     *
+     * @see peekStamp()
+     */
+    template <typename F> bool tryPush(F&& command, std::uint64_t stamp) {
+      using Callable = std::decay_t<F>;
+
+      static_assert(
+        sizeof(Callable) <= kCommandSize,
+        "command does not fit into a queue slot"
+      );
+      static_assert(
+        alignof(Callable) <= alignof(std::max_align_t),
+        "command is over-aligned"
+      );
+
+      auto head = mHead.load(std::memory_order_relaxed);
+      auto tail = mTail.load(std::memory_order_acquire);
+
+      if (head - tail == kCapacity) {
+        return false;
+      }
+
+      auto& slot = mSlots[head & kMask];
+      new (slot.storage) Callable(std::forward<F>(command));
+      slot.execute = [](void* storage) {
+        (*std::launder(reinterpret_cast<Callable*>(storage)))();
+      };
+      slot.destroy = [](void* storage) {
+        std::launder(reinterpret_cast<Callable*>(storage))->~Callable();
+      };
+      slot.stamp = stamp;
+
+      mHead.store(head + 1, std::memory_order_release);
+
+      auto size = head + 1 - tail;
+
+      if (size > mMaxSize.load(std::memory_order_relaxed)) {
+        mMaxSize.store(size, std::memory_order_relaxed);
+      }
+
+      return true;
+    }
+
+    /**
+     * @brief Execute and remove the oldest command (consumer only).
+     *
+     * The slot is released after the command has returned, so a producer
+     * waiting for @ref empty() knows that all commands have finished.
+     *
+     * @return false if the queue was empty.
+     */
+    bool executeNext() {
+      auto tail = mTail.load(std::memory_order_relaxed);
+
+      if (tail == mHead.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      auto& slot = mSlots[tail & kMask];
+      slot.execute(slot.storage);
+      slot.destroy(slot.storage);
+
+      mTail.store(tail + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief Get the stamp of the oldest command without executing it
+     * (consumer only).
+     *
+     * @return false if the queue is empty.
+     */
+    bool peekStamp(std::uint64_t& stamp) const {
+      auto tail = mTail.load(std::memory_order_relaxed);
+
+      if (tail == mHead.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      stamp = mSlots[tail & kMask].stamp;
+
+      return true;
+    }
+
+    /**
+     * @brief Remove all commands without executing them (consumer only).
+     */
+    void clear() {
+      auto tail = mTail.load(std::memory_order_relaxed);
+      auto head = mHead.load(std::memory_order_acquire);
+
+      for (; tail != head; ++tail) {
+        auto& slot = mSlots[tail & kMask];
+        slot.destroy(slot.storage);
+      }
+
+      mTail.store(tail, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of pending commands.
+     *
+     * This is only a snapshot if called while the other side is active.
+     */
+    std::size_t size() const {
+      return mHead.load(std::memory_order_acquire) -
+             mTail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    bool full() const { return size() == kCapacity; }
+
+    /**
+     * @brief Get the highest number of pending commands observed so far.
+     */
+    std::size_t getMaxSize() const {
+      return mMaxSize.load(std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t getCapacity() { return kCapacity; }
+
+    private:
+    static constexpr std::size_t kMask = kCapacity - 1;
+
+    struct Slot {
+      alignas(std::max_align_t) unsigned char storage[kCommandSize];
+      void (*execute)(void*);
+      void (*destroy)(void*);
+      std::uint64_t stamp;
+    };
+
+    std::array<Slot, kCapacity> mSlots;
+
+    /**
+     * @brief Total number of pushed commands, written by the producer.
+     *
+     * Head and tail are kept on separate cache lines so that producer and
+     * consumer don't invalidate each other's cache on every operation.
+     */
+    alignas(64) std::atomic<std::size_t> mHead{0};
+
+    /**
+     * @brief Total number of executed commands, written by the consumer.
+     */
+    alignas(64) std::atomic<std::size_t> mTail{0};
+
+    std::atomic<std::size_t> mMaxSize{0};
+  };
+} // namespace Luna
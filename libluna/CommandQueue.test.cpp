@@ -0,0 +1,107 @@
+#include <array>
+#include <memory>
+#include <thread>
+
+#include <libluna/CommandQueue.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+int main(int, char**) {
+  TEST("commands are executed in order", []() {
+    CommandQueue<4> queue;
+    int result = 0;
+
+    for (int i = 1; i <= 4; ++i) {
+      ASSERT(queue.tryPush([&result, i]() { result = result * 10 + i; }), "push");
+    }
+
+    ASSERT(queue.full(), "queue is full");
+    ASSERT(!queue.tryPush([]() {}), "push into full queue fails");
+    ASSERT_EQL(static_cast<int>(queue.size()), 4, "size");
+
+    while (queue.executeNext()) {
+    }
+
+    ASSERT_EQL(result, 1234, "execution order");
+    ASSERT(queue.empty(), "queue is empty");
+    ASSERT_EQL(static_cast<int>(queue.getMaxSize()), 4, "max size");
+  });
+
+  TEST("captures are destroyed", []() {
+    auto value = make_shared<int>(42);
+
+    {
+      CommandQueue<4> queue;
+      queue.tryPush([value]() {});
+      queue.tryPush([value]() {});
+      ASSERT_EQL(static_cast<int>(value.use_count()), 3, "captured twice");
+
+      queue.executeNext();
+      ASSERT_EQL(static_cast<int>(value.use_count()), 2, "destroyed after execution");
+    }
+
+    ASSERT_EQL(static_cast<int>(value.use_count()), 1, "destroyed with queue");
+  });
+
+  TEST("large captures fit into larger slots", []() {
+    CommandQueue<2, 128> queue;
+    array<int, 16> values{};
+    values[15] = 7;
+    int result = 0;
+
+    queue.tryPush([values, &result]() { result = values[15]; });
+    queue.executeNext();
+
+    ASSERT_EQL(result, 7, "result");
+  });
+
+  TEST("stamps are kept with their commands", []() {
+    CommandQueue<2> queue;
+    uint64_t stamp = 1;
+
+    ASSERT(!queue.peekStamp(stamp), "empty");
+
+    queue.tryPush([]() {}, 100);
+    queue.tryPush([]() {});
+
+    ASSERT(queue.peekStamp(stamp), "first");
+    ASSERT(stamp == 100, "first stamp");
+
+    queue.executeNext();
+
+    ASSERT(queue.peekStamp(stamp), "second");
+    ASSERT(stamp == 0, "default stamp");
+  });
+
+  TEST("producer and consumer on different threads", []() {
+    constexpr int kCount = 100000;
+    CommandQueue<64> queue;
+    long long sum = 0;
+
+    thread consumer([&queue, &sum]() {
+      int executed = 0;
+
+      while (executed < kCount) {
+        if (queue.executeNext()) {
+          ++executed;
+        } else {
+          this_thread::yield();
+        }
+      }
+    });
+
+    for (int i = 1; i <= kCount; ++i) {
+      while (!queue.tryPush([&sum, i]() { sum += i; })) {
+        this_thread::yield();
+      }
+    }
+
+    consumer.join();
+
+    ASSERT(sum == static_cast<long long>(kCount) * (kCount + 1) / 2, "sum");
+  });
+
+  return runTests();
+}
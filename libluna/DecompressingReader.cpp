@@ -0,0 +1,239 @@
+#include <libluna/DecompressingReader.hpp>
+
+#include <algorithm>
+#include <cstring> // memcmp, memcpy
+
+#include <libluna/Logger.hpp>
+#include <libluna/Lz.hpp>
+
+using namespace Luna;
+
+namespace {
+  uint64_t readLe(const uint8_t* data, int bytes) {
+    uint64_t value = 0;
+
+    for (int i = bytes - 1; i >= 0; --i) {
+      value = (value << 8) | data[i];
+    }
+
+    return value;
+  }
+} // namespace
+
+DecompressingReader::DecompressingReader(
+  InputStream& source, Endian::Endian endian, JobSystem* jobSystem
+)
+    : mSource(&source), mEndian(endian), mJobSystem(jobSystem),
+      mBase(source.tell()) {
+  mValid = readIndex();
+
+  if (!mValid) {
+    logError("invalid compressed stream");
+  }
+}
+
+DecompressingReader::DecompressingReader(
+  std::unique_ptr<InputStream> source, Endian::Endian endian,
+  JobSystem* jobSystem
+)
+    : DecompressingReader(*source, endian, jobSystem) {
+  mOwnedSource = std::move(source);
+}
+
+DecompressingReader::~DecompressingReader() = default;
+
+bool DecompressingReader::isValid() const { return mValid; }
+
+std::size_t DecompressingReader::getSize() const { return mSize; }
+
+bool DecompressingReader::eof() const { return mPosition >= mSize; }
+
+std::size_t DecompressingReader::tell() { return mPosition; }
+
+std::size_t DecompressingReader::seek(std::size_t position) {
+  mPosition = std::min(position, mSize);
+
+  return mPosition;
+}
+
+std::size_t DecompressingReader::seekRelative(int relativePosition) {
+  if (relativePosition < 0 &&
+      static_cast<std::size_t>(-relativePosition) > mPosition) {
+    return seek(0);
+  }
+
+  return seek(mPosition + static_cast<std::size_t>(relativePosition));
+}
+
+std::size_t DecompressingReader::read(
+  uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+) {
+  if (objectSize == 0 || !mValid) {
+    return 0;
+  }
+
+  objectCount = std::min(objectCount, (mSize - mPosition) / objectSize);
+  auto byteCount = objectSize * objectCount;
+  std::size_t bytesRead = 0;
+  auto blockCount = mBlockOffsets.size() - 1;
+
+  while (bytesRead < byteCount) {
+    auto block = mPosition / mBlockSize;
+    auto blockOffset = mPosition % mBlockSize;
+    auto remaining = byteCount - bytesRead;
+
+    if (blockOffset == 0 && remaining >= getBlockLength(block)) {
+      // whole blocks go straight into the destination
+      auto last = block;
+      std::size_t length = 0;
+
+      while (last < blockCount && length + getBlockLength(last) <= remaining) {
+        length += getBlockLength(last);
+        ++last;
+      }
+
+      if (!decompressBlocks(block, last, buffer + bytesRead)) {
+        mValid = false;
+        break;
+      }
+
+      bytesRead += length;
+      mPosition += length;
+      continue;
+    }
+
+    if (mCachedBlock != block) {
+      // the block size comes from the header, only the last block may be
+      // shorter
+      mBlock.resize(getBlockLength(block));
+
+      if (!decompressBlocks(block, block + 1, mBlock.data())) {
+        mValid = false;
+        break;
+      }
+
+      mCachedBlock = block;
+    }
+
+    auto length = std::min(remaining, getBlockLength(block) - blockOffset);
+    std::memcpy(buffer + bytesRead, mBlock.data() + blockOffset, length);
+    bytesRead += length;
+    mPosition += length;
+  }
+
+  if (!mValid) {
+    logError("corrupt compressed block at {}", mPosition);
+  }
+
+  objectCount = bytesRead / objectSize;
+
+  if (mEndian != Endian::getEndian()) {
+    Endian::swapArray(buffer, objectSize, objectCount);
+  }
+
+  return objectCount;
+}
+
+bool DecompressingReader::readIndex() {
+  uint8_t header[Lz::kHeaderSize];
+
+  if (mSource->read(header, 1, sizeof(header)) != sizeof(header) ||
+      std::memcmp(header, Lz::kMagic, sizeof(Lz::kMagic)) != 0) {
+    return false;
+  }
+
+  auto blockSize = readLe(header + 4, 4);
+  auto size = readLe(header + 8, 8);
+  auto sourceSize = mSource->getSize() - mBase;
+
+  if (blockSize == 0 || blockSize >= Lz::kStoredFlag ||
+      size != static_cast<std::size_t>(size)) {
+    return false;
+  }
+
+  mBlockSize = static_cast<std::size_t>(blockSize);
+  mSize = static_cast<std::size_t>(size);
+
+  auto blockCount = mSize / mBlockSize + (mSize % mBlockSize != 0 ? 1 : 0);
+
+  if (blockCount > (sourceSize - sizeof(header)) / 4) {
+    return false;
+  }
+
+  std::vector<uint8_t> index(blockCount * 4);
+
+  if (mSource->read(index.data(), 1, index.size()) != index.size()) {
+    return false;
+  }
+
+  mBlockOffsets.resize(blockCount + 1);
+  mBlockStored.resize(blockCount);
+  mBlockOffsets[0] = sizeof(header) + index.size();
+
+  for (std::size_t i = 0; i < blockCount; ++i) {
+    auto value = static_cast<uint32_t>(readLe(index.data() + i * 4, 4));
+    std::size_t storedSize = value & ~Lz::kStoredFlag;
+    mBlockStored[i] = (value & Lz::kStoredFlag) != 0;
+
+    if (storedSize > Lz::getBlockBound(getBlockLength(i)) ||
+        (mBlockStored[i] && storedSize != getBlockLength(i))) {
+      return false;
+    }
+
+    mBlockOffsets[i + 1] = mBlockOffsets[i] + storedSize;
+  }
+
+  return mBlockOffsets.back() <= sourceSize;
+}
+
+bool DecompressingReader::decompressBlocks(
+  std::size_t first, std::size_t last, uint8_t* output
+) {
+  auto begin = mBlockOffsets[first];
+  auto size = mBlockOffsets[last] - begin;
+  mCompressed.resize(size);
+
+  if (mSource->seek(mBase + begin) != mBase + begin ||
+      mSource->read(mCompressed.data(), 1, size) != size) {
+    return false;
+  }
+
+  auto decompress = [this, first, begin, output](std::size_t block) {
+    auto input = mCompressed.data() + mBlockOffsets[block] - begin;
+    auto inputSize = mBlockOffsets[block + 1] - mBlockOffsets[block];
+    auto destination = output + (block - first) * mBlockSize;
+    auto length = getBlockLength(block);
+
+    if (mBlockStored[block]) {
+      std::memcpy(destination, input, length);
+      return true;
+    }
+
+    return Lz::decompressBlock(input, inputSize, destination, length);
+  };
+
+  if (last - first == 1) {
+    return decompress(first);
+  }
+
+  // one flag per block, so the jobs don't share any state
+  std::vector<uint8_t> succeeded(last - first, 0);
+
+  mJobSystem->wait(mJobSystem->parallelFor(
+    static_cast<int>(first), static_cast<int>(last), 1,
+    [&](int blockBegin, int blockEnd) {
+      for (int block = blockBegin; block < blockEnd; ++block) {
+        auto index = static_cast<std::size_t>(block);
+        succeeded[index - first] = decompress(index) ? 1 : 0;
+      }
+    }
+  ));
+
+  return std::all_of(succeeded.begin(), succeeded.end(), [](uint8_t value) {
+    return value != 0;
+  });
+}
+
+std::size_t DecompressingReader::getBlockLength(std::size_t block) const {
+  return std::min(mBlockSize, mSize - block * mBlockSize);
+}
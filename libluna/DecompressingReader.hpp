@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <libluna/Endian.hpp>
+#include <libluna/InputStream.hpp>
+#include <libluna/JobSystem.hpp>
+
+namespace Luna {
+  /**
+   * @brief Input stream decompressing data written by Lz::compress().
+   *
+   * The block index is read when the reader is created, so seeking only
+   * costs decompressing the block at the new position. Reads spanning
+   * several blocks decompress them in parallel on the JobSystem, directly
+   * into the destination buffer. The block a read ends in is kept, so small
+   * sequential reads decompress each block only once.
+   *
+   * ```cpp
+   * Luna::DecompressingReader input(Luna::ResourceReader::make("level.lz"));
+   * std::vector<uint8_t> level(input.getSize());
+   * input.read(level.data(), 1, level.size());
+   * ```
+   *
+   * The compressed data is read from the underlying stream as bytes, the
+   * given endianness applies to the decompressed data.
+   *
+   * @ingroup streams
+   */
+  class DecompressingReader final : public InputStream {
+    public:
+    /**
+     * @brief Read from a stream which must outlive this one.
+     *
+     * The compressed data starts at the current position of @p source.
+     */
+    explicit DecompressingReader(
+      InputStream& source, Endian::Endian endian = Endian::Little,
+      JobSystem* jobSystem = JobSystem::getInstance()
+    );
+
+    explicit DecompressingReader(
+      std::unique_ptr<InputStream> source,
+      Endian::Endian endian = Endian::Little,
+      JobSystem* jobSystem = JobSystem::getInstance()
+    );
+
+    ~DecompressingReader();
+
+    /**
+     * @brief Check whether the header is valid and no corrupt block has been
+     * found.
+     */
+    bool isValid() const override;
+
+    /**
+     * @brief Get the decompressed size.
+     */
+    std::size_t getSize() const override;
+    bool eof() const override;
+    std::size_t tell() override;
+    std::size_t seek(std::size_t position) override;
+    std::size_t seekRelative(int relativePosition) override;
+    std::size_t read(
+      uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+    ) override;
+    using InputStream::read;
+
+    private:
+    bool readIndex();
+
+    /**
+     * @brief Decompress the blocks [first, last) into @p output.
+     */
+    bool decompressBlocks(std::size_t first, std::size_t last, uint8_t* output);
+
+    std::size_t getBlockLength(std::size_t block) const;
+
+    std::unique_ptr<InputStream> mOwnedSource;
+    InputStream* mSource;
+    Endian::Endian mEndian;
+    JobSystem* mJobSystem;
+    bool mValid{false};
+
+    /**
+     * @brief Position of the compressed data in the source.
+     */
+    std::size_t mBase;
+    std::size_t mSize{0};
+    std::size_t mBlockSize{0};
+    std::size_t mPosition{0};
+
+    /**
+     * @brief Offset of each block relative to @ref mBase, followed by the end
+     * of the last block.
+     */
+    std::vector<std::size_t> mBlockOffsets;
+    std::vector<bool> mBlockStored;
+
+    std::vector<uint8_t> mCompressed;
+
+    /**
+     * @brief Index of the block in @ref mBlock or -1.
+     */
+    std::size_t mCachedBlock{static_cast<std::size_t>(-1)};
+    std::vector<uint8_t> mBlock;
+  };
+} // namespace Luna
@@ -0,0 +1,186 @@
+#include <string>
+#include <vector>
+
+#include <libluna/DecompressingReader.hpp>
+#include <libluna/Lz.hpp>
+#include <libluna/MemoryReader.hpp>
+#include <libluna/PackArchive.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  /**
+   * @brief Text-like data with repetitions and some noise.
+   */
+  vector<uint8_t> makeSample(size_t size) {
+    vector<uint8_t> data(size);
+    uint32_t noise = 12345;
+
+    for (size_t i = 0; i < size; ++i) {
+      noise = noise * 1103515245 + 12345;
+
+      if ((i / 300) % 4 == 3) {
+        data[i] = static_cast<uint8_t>(noise >> 16);
+      } else {
+        data[i] = static_cast<uint8_t>("the quick brown fox "[i % 20]);
+      }
+    }
+
+    return data;
+  }
+
+  vector<uint8_t> readAll(DecompressingReader& reader) {
+    vector<uint8_t> output(reader.getSize());
+    InputStream& input = reader;
+    output.resize(input.read(output.data(), 1, output.size()));
+
+    return output;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("blocks round trip", []() {
+    for (size_t size : {0, 1, 5, 100, 4096, 10000}) {
+      auto data = makeSample(size);
+      vector<uint8_t> block(Lz::getBlockBound(size));
+      auto compressedSize =
+        Lz::compressBlock(data.data(), data.size(), block.data(), block.size());
+      ASSERT(compressedSize > 0, "compressed");
+
+      vector<uint8_t> output(size);
+      ASSERT(
+        Lz::decompressBlock(
+          block.data(), compressedSize, output.data(), output.size()
+        ),
+        "decompressed"
+      );
+      ASSERT(output == data, "same contents");
+    }
+  });
+
+  TEST("repetitive data gets smaller", []() {
+    vector<uint8_t> data(100000, 42);
+    auto compressed = Lz::compress(data.data(), data.size());
+    ASSERT(compressed.size() < data.size() / 50, "compressed");
+
+    MemoryReader source(compressed.data(), compressed.size());
+    DecompressingReader reader(source);
+    ASSERT(reader.isValid(), "valid");
+    ASSERT(readAll(reader) == data, "same contents");
+  });
+
+  TEST("read many blocks at once", []() {
+    auto data = makeSample(50000);
+    auto compressed = Lz::compress(data.data(), data.size(), 1000);
+
+    DecompressingReader reader(
+      make_unique<MemoryReader>(compressed.data(), compressed.size())
+    );
+    ASSERT_EQL(static_cast<int>(reader.getSize()), 50000, "size");
+    ASSERT(readAll(reader) == data, "same contents");
+    ASSERT(reader.eof(), "eof");
+  });
+
+  TEST("seek and read across blocks", []() {
+    auto data = makeSample(10000);
+    auto compressed = Lz::compress(data.data(), data.size(), 256);
+    MemoryReader source(compressed.data(), compressed.size());
+    DecompressingReader reader(source);
+    InputStream& input = reader;
+    bool matches = true;
+
+    for (size_t position : {9000, 0, 255, 256, 1234, 9990}) {
+      ASSERT_EQL(
+        static_cast<int>(input.seek(position)), static_cast<int>(position),
+        "seek"
+      );
+
+      uint8_t buffer[700];
+      auto count = input.read(buffer, 1, sizeof(buffer));
+      auto expected = min(sizeof(buffer), data.size() - position);
+      matches = matches && count == expected &&
+                equal(buffer, buffer + count, data.begin() + position);
+    }
+
+    ASSERT(matches, "same contents");
+  });
+
+  TEST("small reads", []() {
+    auto data = makeSample(3000);
+    auto compressed = Lz::compress(data.data(), data.size(), 512);
+    MemoryReader source(compressed.data(), compressed.size());
+    DecompressingReader reader(source);
+    InputStream& input = reader;
+    vector<uint8_t> output;
+    uint8_t buffer[7];
+    size_t count;
+
+    while ((count = input.read(buffer, 1, sizeof(buffer))) > 0) {
+      output.insert(output.end(), buffer, buffer + count);
+    }
+
+    ASSERT(output == data, "same contents");
+  });
+
+  TEST("endianness applies to the decompressed values", []() {
+    vector<uint8_t> data = {0x12, 0x34, 0x56, 0x78};
+    auto compressed = Lz::compress(data.data(), data.size());
+    MemoryReader source(compressed.data(), compressed.size());
+    DecompressingReader reader(source, Endian::Big);
+    InputStream& input = reader;
+
+    uint16_t values[2];
+    ASSERT(input.read(values, 2, 2) == 2, "read");
+    ASSERT_EQL(values[0], 0x1234, "values[0]");
+    ASSERT_EQL(values[1], 0x5678, "values[1]");
+  });
+
+  TEST("reject corrupt data", []() {
+    auto data = makeSample(5000);
+    auto compressed = Lz::compress(data.data(), data.size(), 1000);
+
+    auto truncated = compressed;
+    truncated.resize(truncated.size() - 10);
+    MemoryReader truncatedSource(truncated.data(), truncated.size());
+    DecompressingReader truncatedReader(truncatedSource);
+    ASSERT(!truncatedReader.isValid(), "truncated");
+
+    auto damaged = compressed;
+
+    for (size_t i = damaged.size() / 2; i < damaged.size(); i += 3) {
+      damaged[i] = static_cast<uint8_t>(damaged[i] ^ 0x5a);
+    }
+
+    MemoryReader damagedSource(damaged.data(), damaged.size());
+    DecompressingReader damagedReader(damagedSource);
+    readAll(damagedReader);
+    ASSERT(!damagedReader.isValid(), "damaged");
+  });
+
+  TEST("compressed pack entries", []() {
+    auto data = makeSample(20000);
+    Pack::Builder builder;
+    builder.add("level.txt", data, Pack::kLz);
+    builder.add("noise.bin", {1, 2, 3}, Pack::kLz);
+
+    auto pack = builder.build();
+    auto archive = PackArchive::open(pack.data(), pack.size());
+    ASSERT(archive != nullptr, "opened");
+
+    auto level = archive->find("level.txt");
+    ASSERT(level->compression == Pack::kLz, "compressed");
+    ASSERT(level->storedSize < level->size, "smaller");
+
+    auto noise = archive->find("noise.bin");
+    ASSERT(noise->compression == Pack::kUncompressed, "stored");
+
+    DecompressingReader reader(make_unique<MemoryReader>(
+      const_cast<uint8_t*>(level->data), level->storedSize
+    ));
+    ASSERT(readAll(reader) == data, "same contents");
+  });
+
+  return runTests();
+}
@@ -17,4 +17,21 @@ namespace Luna {
   void Drawable2d::setVisible(bool visible) { mVisible = visible; }
 
   bool Drawable2d::isVisible() const { return mVisible; }
+
+  void Drawable2d::storePreviousPosition() {
+    mPreviousPosition = mPosition;
+    mHasPreviousPosition = true;
+  }
+
+  Vector2f Drawable2d::getPreviousPosition() const {
+    return mHasPreviousPosition ? mPreviousPosition : mPosition;
+  }
+
+  Vector2f Drawable2d::getInterpolatedPosition(float alpha) const {
+    if (!mHasPreviousPosition || alpha >= 1.0f) {
+      return mPosition;
+    }
+
+    return mPreviousPosition + (mPosition - mPreviousPosition) * alpha;
+  }
 } // namespace Luna
@@ -33,8 +33,32 @@ namespace Luna {
     bool isVisible() const;
     ///@}
 
+    /**
+     * @name Interpolation
+     *
+     * With a fixed tick rate (see Application::setFixedTickRate()), the
+     * position at the start of each tick is remembered, so that frames
+     * rendered between two ticks can show the drawable in between.
+     *
+     * To move a drawable without interpolation (e.g. teleport it), call
+     * storePreviousPosition() after setPosition().
+     */
+    ///@{
+    void storePreviousPosition();
+    Vector2f getPreviousPosition() const;
+
+    /**
+     * @brief Get the position between the previous and the current one.
+     *
+     * @param alpha 0 for the previous position, 1 for the current one.
+     */
+    Vector2f getInterpolatedPosition(float alpha) const;
+    ///@}
+
     private:
     Vector2f mPosition;
+    Vector2f mPreviousPosition;
+    bool mHasPreviousPosition{false};
     float mPriority{0};
     bool mVisible{true};
   };
@@ -0,0 +1,55 @@
+#include <vector>
+
+#include <libluna/Bench.hpp>
+#include <libluna/Endian.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  constexpr size_t kByteCount = 1 << 20;
+
+  template <typename T> void swapScalar(vector<T>& values) {
+    for (auto& value : values) {
+      value = Endian::swapEndian(value);
+    }
+  }
+} // namespace
+
+int main(int, char**) {
+  static vector<uint16_t> values16(kByteCount / 2, 0x1234);
+  static vector<uint32_t> values32(kByteCount / 4, 0x12345678);
+  static vector<uint64_t> values64(kByteCount / 8, 0x123456789abcdef0);
+
+  BENCH("16-bit one by one", kByteCount, []() {
+    swapScalar(values16);
+    benchKeep(values16);
+  });
+
+  BENCH("16-bit swapArray", kByteCount, []() {
+    Endian::swapArray(values16.data(), values16.size());
+    benchKeep(values16);
+  });
+
+  BENCH("32-bit one by one", kByteCount, []() {
+    swapScalar(values32);
+    benchKeep(values32);
+  });
+
+  BENCH("32-bit swapArray", kByteCount, []() {
+    Endian::swapArray(values32.data(), values32.size());
+    benchKeep(values32);
+  });
+
+  BENCH("64-bit one by one", kByteCount, []() {
+    swapScalar(values64);
+    benchKeep(values64);
+  });
+
+  BENCH("64-bit swapArray", kByteCount, []() {
+    Endian::swapArray(values64.data(), values64.size());
+    benchKeep(values64);
+  });
+
+  return runBenchmarks();
+}
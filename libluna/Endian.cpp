@@ -0,0 +1,248 @@
+#include <libluna/Endian.hpp>
+
+#include <cstring> // memcpy
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                  \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUNA_ENDIAN_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LUNA_ENDIAN_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#define LUNA_ENDIAN_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace Luna;
+
+namespace {
+  using Kernel = std::size_t (*)(uint8_t* data, std::size_t count);
+
+  /**
+   * @brief Swap the values one by one.
+   *
+   * The values may be unaligned, so they are copied instead of dereferenced.
+   */
+  template <typename T> void swapScalar(uint8_t* data, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      T value;
+      std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+      value = Endian::swapEndian(value);
+      std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+  }
+
+  /**
+   * @brief Byte shuffle reversing each group of @p size bytes, as used by
+   * `pshufb`.
+   */
+  template <int size> constexpr char shuffleIndex(int index) {
+    return static_cast<char>(index / size * size + size - 1 - index % size);
+  }
+
+#ifdef LUNA_ENDIAN_SSE2
+  // The kernels process whole vectors and return the number of values done,
+  // the remaining values are swapped by swapScalar().
+
+  inline __m128i swapBytes16Sse2(__m128i value) {
+    return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+  }
+
+  std::size_t swap16Sse2(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 8;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = reinterpret_cast<__m128i*>(data + i * 16);
+      _mm_storeu_si128(address, swapBytes16Sse2(_mm_loadu_si128(address)));
+    }
+
+    return vectorCount * 8;
+  }
+
+  std::size_t swap32Sse2(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 4;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = reinterpret_cast<__m128i*>(data + i * 16);
+      auto value = _mm_loadu_si128(address);
+
+      // swap the 16-bit halves, then the bytes within them
+      value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+      value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+      _mm_storeu_si128(address, swapBytes16Sse2(value));
+    }
+
+    return vectorCount * 4;
+  }
+
+  std::size_t swap64Sse2(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 2;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = reinterpret_cast<__m128i*>(data + i * 16);
+      auto value = _mm_loadu_si128(address);
+
+      // reverse the 16-bit quarters, then the bytes within them
+      value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+      value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+      _mm_storeu_si128(address, swapBytes16Sse2(value));
+    }
+
+    return vectorCount * 2;
+  }
+#endif
+
+#ifdef LUNA_ENDIAN_X86_DISPATCH
+  template <int size>
+  __attribute__((target("ssse3"))) std::size_t
+  swapSsse3(uint8_t* data, std::size_t count) {
+    const auto mask = _mm_setr_epi8(
+      shuffleIndex<size>(0), shuffleIndex<size>(1), shuffleIndex<size>(2),
+      shuffleIndex<size>(3), shuffleIndex<size>(4), shuffleIndex<size>(5),
+      shuffleIndex<size>(6), shuffleIndex<size>(7), shuffleIndex<size>(8),
+      shuffleIndex<size>(9), shuffleIndex<size>(10), shuffleIndex<size>(11),
+      shuffleIndex<size>(12), shuffleIndex<size>(13), shuffleIndex<size>(14),
+      shuffleIndex<size>(15)
+    );
+
+    std::size_t vectorCount = count * size / 16;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = reinterpret_cast<__m128i*>(data + i * 16);
+      _mm_storeu_si128(
+        address, _mm_shuffle_epi8(_mm_loadu_si128(address), mask)
+      );
+    }
+
+    return vectorCount * 16 / size;
+  }
+
+  template <int size>
+  __attribute__((target("avx2"))) std::size_t
+  swapAvx2(uint8_t* data, std::size_t count) {
+    // vpshufb shuffles within each 128-bit lane, so both lanes use the same
+    // indices
+    const auto mask = _mm256_setr_epi8(
+      shuffleIndex<size>(0), shuffleIndex<size>(1), shuffleIndex<size>(2),
+      shuffleIndex<size>(3), shuffleIndex<size>(4), shuffleIndex<size>(5),
+      shuffleIndex<size>(6), shuffleIndex<size>(7), shuffleIndex<size>(8),
+      shuffleIndex<size>(9), shuffleIndex<size>(10), shuffleIndex<size>(11),
+      shuffleIndex<size>(12), shuffleIndex<size>(13), shuffleIndex<size>(14),
+      shuffleIndex<size>(15), shuffleIndex<size>(0), shuffleIndex<size>(1),
+      shuffleIndex<size>(2), shuffleIndex<size>(3), shuffleIndex<size>(4),
+      shuffleIndex<size>(5), shuffleIndex<size>(6), shuffleIndex<size>(7),
+      shuffleIndex<size>(8), shuffleIndex<size>(9), shuffleIndex<size>(10),
+      shuffleIndex<size>(11), shuffleIndex<size>(12), shuffleIndex<size>(13),
+      shuffleIndex<size>(14), shuffleIndex<size>(15)
+    );
+
+    std::size_t vectorCount = count * size / 32;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = reinterpret_cast<__m256i*>(data + i * 32);
+      _mm256_storeu_si256(
+        address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), mask)
+      );
+    }
+
+    return vectorCount * 32 / size;
+  }
+
+  /**
+   * @brief Choose the widest kernel supported by the processor.
+   */
+  template <int size> Kernel selectKernel(Kernel fallback) {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+      return swapAvx2<size>;
+    }
+
+    if (__builtin_cpu_supports("ssse3")) {
+      return swapSsse3<size>;
+    }
+
+    return fallback;
+  }
+#endif
+
+#ifdef LUNA_ENDIAN_NEON
+  std::size_t swap16Neon(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 8;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = data + i * 16;
+      vst1q_u8(address, vrev16q_u8(vld1q_u8(address)));
+    }
+
+    return vectorCount * 8;
+  }
+
+  std::size_t swap32Neon(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 4;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = data + i * 16;
+      vst1q_u8(address, vrev32q_u8(vld1q_u8(address)));
+    }
+
+    return vectorCount * 4;
+  }
+
+  std::size_t swap64Neon(uint8_t* data, std::size_t count) {
+    std::size_t vectorCount = count / 2;
+
+    for (std::size_t i = 0; i < vectorCount; ++i) {
+      auto* address = data + i * 16;
+      vst1q_u8(address, vrev64q_u8(vld1q_u8(address)));
+    }
+
+    return vectorCount * 2;
+  }
+#endif
+
+#if !defined(LUNA_ENDIAN_SSE2) && !defined(LUNA_ENDIAN_NEON)
+  std::size_t swapNone(uint8_t*, std::size_t) { return 0; }
+#endif
+
+  template <typename T> Kernel getKernel() {
+#if defined(LUNA_ENDIAN_X86_DISPATCH)
+    Kernel fallback = sizeof(T) == 2   ? swap16Sse2
+                      : sizeof(T) == 4 ? swap32Sse2
+                                       : swap64Sse2;
+    static const Kernel kernel = selectKernel<sizeof(T)>(fallback);
+
+    return kernel;
+#elif defined(LUNA_ENDIAN_SSE2)
+    return sizeof(T) == 2 ? swap16Sse2 : sizeof(T) == 4 ? swap32Sse2 : swap64Sse2;
+#elif defined(LUNA_ENDIAN_NEON)
+    return sizeof(T) == 2 ? swap16Neon : sizeof(T) == 4 ? swap32Neon : swap64Neon;
+#else
+    return swapNone;
+#endif
+  }
+
+  template <typename T> void swapValues(void* values, std::size_t count) {
+    auto* data = reinterpret_cast<uint8_t*>(values);
+
+    // short arrays aren't worth the call through the pointer
+    std::size_t done = count * sizeof(T) >= 16 ? getKernel<T>()(data, count) : 0;
+
+    swapScalar<T>(data + done * sizeof(T), count - done);
+  }
+} // namespace
+
+void Endian::swapArray16(void* values, std::size_t count) {
+  swapValues<uint16_t>(values, count);
+}
+
+void Endian::swapArray32(void* values, std::size_t count) {
+  swapValues<uint32_t>(values, count);
+}
+
+void Endian::swapArray64(void* values, std::size_t count) {
+  swapValues<uint64_t>(values, count);
+}
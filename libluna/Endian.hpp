@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -49,6 +50,58 @@ namespace Luna::Endian {
     }
   }
 
+  /**
+   * @name Bulk conversion
+   *
+   * Swap the endianness of many values in place. Depending on the platform,
+   * this uses SSE2, SSSE3 or AVX2 (chosen at runtime) or NEON to swap 16 to 32
+   * bytes per instruction.
+   */
+  ///@{
+  void swapArray16(void* values, std::size_t count);
+  void swapArray32(void* values, std::size_t count);
+  void swapArray64(void* values, std::size_t count);
+
+  /**
+   * @brief Swap the endianness of @p count values of type @p T.
+   */
+  template <typename T> void swapArray(T* values, std::size_t count) {
+    static_assert(
+      sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8,
+      "unsupported value size"
+    );
+
+    if constexpr (sizeof(T) == 2) {
+      swapArray16(values, count);
+    } else if constexpr (sizeof(T) == 4) {
+      swapArray32(values, count);
+    } else if constexpr (sizeof(T) == 8) {
+      swapArray64(values, count);
+    }
+  }
+
+  /**
+   * @brief Swap the endianness of @p count objects of @p objectSize bytes.
+   *
+   * Objects of other sizes than 2, 4 and 8 bytes are left untouched.
+   */
+  inline void swapArray(void* values, std::size_t objectSize, std::size_t count) {
+    switch (objectSize) {
+    case 2:
+      swapArray16(values, count);
+      break;
+    case 4:
+      swapArray32(values, count);
+      break;
+    case 8:
+      swapArray64(values, count);
+      break;
+    default:
+      break;
+    }
+  }
+  ///@}
+
   /**
    * @brief Convert a value from little-endian to the system's endianness.
    *
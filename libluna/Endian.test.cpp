@@ -0,0 +1,89 @@
+#include <cstring>
+#include <vector>
+
+#include <libluna/Endian.hpp>
+#include <libluna/MemoryReader.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  /**
+   * @brief Compare swapArray() with swapEndian() for many counts and
+   * unaligned addresses.
+   */
+  template <typename T> bool swapsLikeScalar() {
+    for (std::size_t offset = 0; offset < sizeof(T); ++offset) {
+      for (std::size_t count = 0; count < 100; ++count) {
+        vector<uint8_t> bytes(offset + count * sizeof(T));
+
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+          bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+
+        auto expected = bytes;
+
+        for (std::size_t i = 0; i < count; ++i) {
+          T value;
+          memcpy(&value, &expected[offset + i * sizeof(T)], sizeof(T));
+          value = Endian::swapEndian(value);
+          memcpy(&expected[offset + i * sizeof(T)], &value, sizeof(T));
+        }
+
+        Endian::swapArray(
+          reinterpret_cast<T*>(bytes.data() + offset), count
+        );
+
+        if (bytes != expected) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("swapArray swaps 16-bit values", []() {
+    ASSERT(swapsLikeScalar<uint16_t>(), "same as swapEndian");
+  });
+
+  TEST("swapArray swaps 32-bit values", []() {
+    ASSERT(swapsLikeScalar<uint32_t>(), "same as swapEndian");
+  });
+
+  TEST("swapArray swaps 64-bit values", []() {
+    ASSERT(swapsLikeScalar<uint64_t>(), "same as swapEndian");
+  });
+
+  TEST("swapArray by object size", []() {
+    uint8_t bytes[] = {1, 2, 3, 4, 5, 6};
+
+    Endian::swapArray(bytes, 3, 2);
+    ASSERT(bytes[0] == 1 && bytes[5] == 6, "unsupported size untouched");
+
+    Endian::swapArray(bytes, 2, 3);
+    ASSERT(bytes[0] == 2 && bytes[1] == 1, "bytes[0..1] == {2, 1}");
+    ASSERT(bytes[4] == 6 && bytes[5] == 5, "bytes[4..5] == {6, 5}");
+  });
+
+  TEST("MemoryReader converts the endianness", []() {
+    uint8_t bytes[] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0};
+    auto other =
+      Endian::getEndian() == Endian::Little ? Endian::Big : Endian::Little;
+
+    MemoryReader memoryReader(bytes, sizeof(bytes), other);
+    InputStream& reader = memoryReader;
+    uint32_t values[2];
+    ASSERT(reader.read(values, 4, 2) == 2, "read(values, 4, 2) == 2");
+
+    uint32_t expected[2];
+    memcpy(expected, bytes, sizeof(bytes));
+    ASSERT(values[0] == Endian::swapEndian(expected[0]), "values[0] swapped");
+    ASSERT(values[1] == Endian::swapEndian(expected[1]), "values[1] swapped");
+  });
+
+  return runTests();
+}
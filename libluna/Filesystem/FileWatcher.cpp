@@ -0,0 +1,168 @@
+#include <libluna/Filesystem/FileWatcher.hpp>
+
+#ifdef __linux__
+#include <sys/inotify.h> // inotify_init1, inotify_add_watch
+#include <unistd.h>      // close, read
+
+#include <algorithm>
+#include <filesystem>
+#endif
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna::Filesystem;
+using Luna::String;
+
+#ifdef __linux__
+namespace {
+  constexpr uint32_t kWatchMask =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+  /**
+   * @brief Get all files within @p root, relative to it.
+   */
+  std::vector<std::string> listFiles(const char* root) {
+    std::vector<std::string> files;
+    std::error_code error;
+
+    for (auto& entry :
+         std::filesystem::recursive_directory_iterator(root, error)) {
+      if (entry.is_regular_file(error)) {
+        files.push_back(
+          entry.path().lexically_relative(root).generic_string()
+        );
+      }
+    }
+
+    return files;
+  }
+} // namespace
+#endif
+
+FileWatcher::FileWatcher(const Path& root) : mRoot(root) {
+#ifdef __linux__
+  mDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+  if (mDescriptor < 0) {
+    logError("unable to watch {}", root.getRawPath().c_str());
+    return;
+  }
+
+  addWatch("");
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+  if (mDescriptor >= 0) {
+    // closing the descriptor removes all watches
+    close(mDescriptor);
+  }
+#endif
+}
+
+bool FileWatcher::isWatching() const {
+#ifdef __linux__
+  return mDescriptor >= 0 && !mDirectories.empty();
+#else
+  return false;
+#endif
+}
+
+std::vector<std::string> FileWatcher::poll() {
+  std::vector<std::string> changes;
+
+#ifdef __linux__
+  if (mDescriptor < 0) {
+    return changes;
+  }
+
+  alignas(inotify_event) char buffer[4096];
+  bool isOverflowed = false;
+
+  while (true) {
+    auto length = read(mDescriptor, buffer, sizeof(buffer));
+
+    if (length <= 0) {
+      // EAGAIN once all events have been read
+      break;
+    }
+
+    for (ssize_t offset = 0; offset < length;) {
+      auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        isOverflowed = true;
+        continue;
+      }
+
+      if (event->mask & IN_IGNORED) {
+        mDirectories.erase(event->wd);
+        continue;
+      }
+
+      auto directory = mDirectories.find(event->wd);
+
+      if (directory == mDirectories.end() || event->len == 0) {
+        continue;
+      }
+
+      auto name = directory->second.empty()
+                    ? std::string(event->name)
+                    : directory->second + "/" + event->name;
+
+      if (event->mask & IN_ISDIR) {
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          addWatch(name);
+        }
+
+        continue;
+      }
+
+      if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) &&
+          std::find(changes.begin(), changes.end(), name) == changes.end()) {
+        changes.push_back(name);
+      }
+    }
+  }
+
+  if (isOverflowed) {
+    // events have been dropped, so any file may have changed
+    auto rawPath = mRoot.getRawPath();
+    logWarn("too many changes in {}, reporting all files", rawPath.c_str());
+
+    // directories created meanwhile may not be watched yet
+    addWatch("");
+    changes = listFiles(rawPath.c_str());
+  }
+#endif
+
+  return changes;
+}
+
+void FileWatcher::addWatch([[maybe_unused]] const std::string& directory) {
+#ifdef __linux__
+  // the String must own a copy of the name
+  auto path = directory.empty() ? mRoot : mRoot.cd(String(directory));
+  auto rawPath = path.getRawPath();
+  int watch = inotify_add_watch(mDescriptor, rawPath.c_str(), kWatchMask);
+
+  if (watch < 0) {
+    logError("unable to watch {}", rawPath.c_str());
+    return;
+  }
+
+  mDirectories[watch] = directory;
+
+  std::error_code error;
+
+  for (auto& entry :
+       std::filesystem::directory_iterator(rawPath.c_str(), error)) {
+    if (entry.is_directory(error)) {
+      auto name = entry.path().filename().string();
+      addWatch(directory.empty() ? name : directory + "/" + name);
+    }
+  }
+#endif
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <libluna/Filesystem/Path.hpp>
+
+namespace Luna::Filesystem {
+  /**
+   * @brief Report files that have been written within a directory tree.
+   *
+   * On Linux, the directory and its subdirectories are watched using
+   * inotify, including subdirectories created later. A file is reported once
+   * it has been closed after writing or moved into the tree, so editors
+   * saving via a temporary file are covered as well. On other platforms,
+   * nothing is watched and poll() never reports any changes.
+   *
+   * ```cpp
+   * Luna::Filesystem::FileWatcher watcher(app->getAssetsPath());
+   *
+   * // once per frame
+   * for (auto& name : watcher.poll()) {
+   *   reload(name);
+   * }
+   * ```
+   *
+   * @ingroup system
+   */
+  class FileWatcher {
+    public:
+    explicit FileWatcher(const Path& root);
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    ~FileWatcher();
+
+    /**
+     * @brief Check whether changes can be reported.
+     */
+    bool isWatching() const;
+
+    /**
+     * @brief Get the files changed since the last call without blocking.
+     *
+     * If so many changes happened that the system dropped some of them, all
+     * files of the tree are reported.
+     *
+     * @return The paths relative to the root, using slashes, each reported
+     * once.
+     */
+    std::vector<std::string> poll();
+
+    private:
+    /**
+     * @brief Watch a directory and its subdirectories.
+     *
+     * @param directory Path relative to the root, empty for the root.
+     */
+    void addWatch(const std::string& directory);
+
+    Path mRoot;
+
+#ifdef __linux__
+    int mDescriptor{-1};
+
+    /**
+     * @brief Relative directory of each watch descriptor.
+     */
+    std::map<int, std::string> mDirectories;
+#endif
+  };
+} // namespace Luna::Filesystem
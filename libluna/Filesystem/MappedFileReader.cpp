@@ -0,0 +1,136 @@
+#include <libluna/Filesystem/MappedFileReader.hpp>
+
+#ifdef __linux__
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#else
+#include <fstream>
+#endif
+
+#include <algorithm>
+#include <cstring> // memcpy
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+using namespace Luna::Filesystem;
+
+MappedFileReaderPtr
+MappedFileReader::make(const Path& filename, Endian::Endian endian) {
+  return MappedFileReaderPtr(new MappedFileReader(filename, endian));
+}
+
+MappedFileReader::MappedFileReader(const Path& filename, Endian::Endian endian)
+    : mPath(filename), mEndian(endian) {
+  auto rawPath = filename.getRawPath();
+
+#ifdef __linux__
+  int fd = open(rawPath.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat status;
+
+  if (fd < 0 || fstat(fd, &status) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+
+    throw std::runtime_error(
+      fmt::format("unable to open file \"{}\" for reading", rawPath.c_str())
+    );
+  }
+
+  mSize = static_cast<std::size_t>(status.st_size);
+
+  if (mSize > 0) {
+    void* address = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (address == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error(
+        fmt::format("unable to map file \"{}\"", rawPath.c_str())
+      );
+    }
+
+    mData = static_cast<const std::uint8_t*>(address);
+  }
+
+  // the mapping stays valid without the descriptor
+  close(fd);
+#else
+  std::ifstream stream(rawPath.c_str(), std::ios::binary | std::ios::ate);
+
+  if (!stream.good()) {
+    throw std::runtime_error(
+      fmt::format("unable to open file \"{}\" for reading", rawPath.c_str())
+    );
+  }
+
+  mBuffer.resize(static_cast<std::size_t>(stream.tellg()));
+  stream.seekg(0, std::ios_base::beg);
+  stream.read(
+    reinterpret_cast<char*>(mBuffer.data()),
+    static_cast<std::streamsize>(mBuffer.size())
+  );
+
+  mSize = mBuffer.size();
+  mData = mBuffer.empty() ? nullptr : mBuffer.data();
+#endif
+}
+
+MappedFileReader::~MappedFileReader() {
+#ifdef __linux__
+  if (mData) {
+    munmap(const_cast<std::uint8_t*>(mData), mSize);
+  }
+#endif
+}
+
+bool MappedFileReader::isValid() const { return !mPath.isEmpty(); }
+
+std::size_t MappedFileReader::getSize() const { return mSize; }
+
+bool MappedFileReader::eof() const { return mPosition >= mSize; }
+
+std::size_t MappedFileReader::tell() { return mPosition; }
+
+std::size_t MappedFileReader::seek(std::size_t position) {
+  mPosition = std::min(position, mSize);
+
+  return mPosition;
+}
+
+std::size_t MappedFileReader::seekRelative(int relativePosition) {
+  if (relativePosition < 0 &&
+      static_cast<std::size_t>(-relativePosition) > mPosition) {
+    return seek(0);
+  }
+
+  return seek(mPosition + static_cast<std::size_t>(relativePosition));
+}
+
+std::size_t MappedFileReader::read(
+  std::uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+) {
+  if (objectSize == 0) {
+    return 0;
+  }
+
+  objectCount = std::min(objectCount, (mSize - mPosition) / objectSize);
+  auto byteCount = objectSize * objectCount;
+
+  if (byteCount == 0) {
+    return 0;
+  }
+
+  std::memcpy(buffer, mData + mPosition, byteCount);
+  mPosition += byteCount;
+
+  if (mEndian != Endian::getEndian()) {
+    Endian::swapArray(buffer, objectSize, objectCount);
+  }
+
+  return objectCount;
+}
+
+const std::uint8_t* MappedFileReader::getData() const { return mData; }
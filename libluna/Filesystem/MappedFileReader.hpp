@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <libluna/Endian.hpp>
+#include <libluna/Filesystem/Path.hpp>
+#include <libluna/InputStream.hpp>
+
+namespace Luna::Filesystem {
+  class MappedFileReader;
+  using MappedFileReaderPtr = std::unique_ptr<MappedFileReader>;
+
+  /**
+   * @brief Reading files mapped into memory.
+   *
+   * On Linux, the file is mapped read-only using mmap(). Its pages are only
+   * loaded when accessed and are shared with other processes through the page
+   * cache. On other platforms, the whole file is read into memory when opened.
+   *
+   * Either way, getData() gives direct access to the contents, so decoders can
+   * parse them in place instead of copying them into buffers first.
+   *
+   * @ingroup streams
+   */
+  class MappedFileReader final : public InputStream {
+    public:
+    /**
+     * @brief Map the file at the given path.
+     *
+     * @throw std::runtime_error if the file can't be opened.
+     */
+    static MappedFileReaderPtr
+    make(const Path& filename, Endian::Endian endian = Endian::Little);
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+    ~MappedFileReader();
+
+    bool isValid() const final override;
+    std::size_t getSize() const final override;
+    bool eof() const final override;
+    std::size_t tell() final override;
+    std::size_t seek(std::size_t position) final override;
+    std::size_t seekRelative(int relativePosition) final override;
+    std::size_t read(
+      std::uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
+    ) final override;
+    using InputStream::read;
+
+    /**
+     * @brief Get the contents of the file.
+     *
+     * The data stays valid as long as the reader exists. It is nullptr for
+     * empty files.
+     */
+    const std::uint8_t* getData() const;
+
+    private:
+    explicit MappedFileReader(const Path& filename, Endian::Endian endian);
+    Path mPath;
+    Endian::Endian mEndian;
+    const std::uint8_t* mData{nullptr};
+    std::size_t mSize{0};
+    std::size_t mPosition{0};
+
+    /**
+     * @brief Contents of the file if it could not be mapped.
+     */
+    std::vector<std::uint8_t> mBuffer;
+  };
+} // namespace Luna::Filesystem
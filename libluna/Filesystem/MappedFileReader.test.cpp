@@ -0,0 +1,103 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef N64
+#include <libdragon.h>
+#endif
+
+#include <libluna/Application.hpp>
+#include <libluna/Filesystem/MappedFileReader.hpp>
+#include <libluna/Filesystem/Path.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+using namespace Luna::Filesystem;
+
+#ifdef __SWITCH__
+static const char* assetsPath = "romfs:/assets";
+#elif defined(N64)
+static const char* assetsPath = "rom:/assets";
+#else
+static const char* assetsPath = "data/assets";
+#endif
+
+/**
+ * This test needs to be executed within an application context because it may
+ * need to initialize the path to the assets directory.
+ */
+class TestApp : public Application {
+  public:
+  using Application::Application;
+
+  protected:
+  void init() override final {}
+  void update(float) override final {}
+};
+
+int main(int, char**) {
+#ifdef N64
+  dfs_init(DFS_DEFAULT_LOCATION);
+#endif
+
+  TEST("access mapped text file", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+
+    auto reader = MappedFileReader::make(app.getAssetsPath().cd("test.txt"));
+
+    ASSERT(reader->isValid(), "isValid()");
+    ASSERT_EQL(reader->getSize(), 36, "getSize()");
+
+    std::string contents(
+      reinterpret_cast<const char*>(reader->getData()), reader->getSize()
+    );
+    ASSERT_EQL(
+      contents, "This text is read from a text file.\n", "file contents"
+    );
+  });
+
+  TEST("read and seek", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+
+    auto reader = MappedFileReader::make(
+      app.getAssetsPath().cd("test.txt"), Endian::Big
+    );
+
+    char word[4];
+    reader->seek(5);
+    ASSERT_EQL(reader->read(word, 4), 4, "read bytes");
+    ASSERT(std::memcmp(word, "text", 4) == 0, "read contents");
+    ASSERT_EQL(reader->tell(), 9, "position after read");
+
+    uint16_t value;
+    reader->seek(0);
+    reader->read(&value);
+    ASSERT_EQL(value, ('T' << 8) | 'h', "big endian value");
+
+    reader->seekRelative(-100);
+    ASSERT_EQL(reader->tell(), 0, "seek before start");
+
+    reader->seek(1000000);
+    ASSERT(reader->eof(), "seek past end");
+    ASSERT_EQL(reader->read(word, 4), 0, "read at end");
+  });
+
+  TEST("missing file", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath(assetsPath);
+
+    bool thrown = false;
+
+    try {
+      MappedFileReader::make(app.getAssetsPath().cd("missing.txt"));
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+
+    ASSERT(thrown, "throws");
+  });
+
+  return runTests();
+}
@@ -60,8 +60,15 @@ namespace Luna::GL {
     Shader(const Shader& other) = delete;
 
     inline Shader& operator=(Shader&& other) {
-      mShaderProgram = other.mShaderProgram;
-      other.mShaderProgram = 0;
+      if (this != &other) {
+        if (mShaderProgram) {
+          glDeleteProgram(mShaderProgram);
+        }
+
+        mShaderProgram = other.mShaderProgram;
+        other.mShaderProgram = 0;
+      }
+
       return *this;
     }
 
@@ -74,6 +81,20 @@ namespace Luna::GL {
 
     inline void use() const { glUseProgram(mShaderProgram); }
 
+    /**
+     * @brief Check whether the program has been linked successfully.
+     */
+    inline bool isLinked() const {
+      if (!mShaderProgram) {
+        return false;
+      }
+
+      int success;
+      glGetProgramiv(mShaderProgram, GL_LINK_STATUS, &success);
+
+      return success != 0;
+    }
+
     inline Uniform getUniform(const String& name) {
       return Uniform(mShaderProgram, name);
     }
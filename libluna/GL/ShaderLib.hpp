@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,27 @@ namespace Luna::GL {
       );
     }
 
+    /**
+     * @brief Replace the source of a registered file.
+     */
+    void replaceShader(const std::string& filename, const Luna::String& source) {
+      mRegisteredShaders[filename] = source;
+    }
+
+    bool hasShader(const std::string& filename) const {
+      return mRegisteredShaders.count(filename) != 0;
+    }
+
+    /**
+     * @brief Check whether a file is or includes @p dependency, directly or
+     * indirectly.
+     */
+    bool dependsOn(const std::string& filename, const std::string& dependency) {
+      std::set<std::string> visited;
+
+      return dependsOn(filename, dependency, visited);
+    }
+
     GL::Shader
     compileShader(const std::string& vertex, const std::string& fragment) {
       auto vertexLines = getShaderLines(vertex);
@@ -89,6 +111,45 @@ namespace Luna::GL {
     }
 
     private:
+    /**
+     * @param visited Files checked already, so that files including each
+     * other are only checked once.
+     */
+    bool dependsOn(
+      const std::string& filename, const std::string& dependency,
+      std::set<std::string>& visited
+    ) {
+      if (filename == dependency) {
+        return true;
+      }
+
+      if (!mRegisteredShaders.count(filename) ||
+          !visited.insert(filename).second) {
+        return false;
+      }
+
+      for (auto&& line : mRegisteredShaders.at(filename).split('\n')) {
+        if (!line.startsWith("#include ")) {
+          continue;
+        }
+
+        auto quote = line.indexOf('"');
+        auto endQuote = quote ? line.indexOf('"', *quote + 1) : std::nullopt;
+
+        if (!endQuote) {
+          continue;
+        }
+
+        auto included = line.subString(*quote + 1, *endQuote - *quote - 1);
+
+        if (dependsOn(included.c_str(), dependency, visited)) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
     std::map<std::string, Luna::String> mRegisteredShaders;
   };
 } // namespace Luna::GL
@@ -3,10 +3,18 @@
 in vec2 vTexCoord;
 
 uniform sampler2D uSpriteTexture;
+uniform sampler2D uPaletteTexture;
+uniform bool uIndexed;
 
 out vec4 fColor;
 
 void main()
 {
-  fColor = texture(uSpriteTexture, vTexCoord);
+  if (uIndexed) {
+    // indices are stored normalized in a single channel texture
+    int index = int(texture(uSpriteTexture, vTexCoord).r * 255.0 + 0.5);
+    fColor = texelFetch(uPaletteTexture, ivec2(index, 0), 0);
+  } else {
+    fColor = texture(uSpriteTexture, vTexCoord);
+  }
 }
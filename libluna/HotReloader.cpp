@@ -0,0 +1,131 @@
+#include <libluna/HotReloader.hpp>
+
+#include <algorithm>
+#include <exception>
+
+#include <libluna/Canvas.hpp>
+#include <libluna/Logger.hpp>
+#include <libluna/PackFormat.hpp>
+#include <libluna/ResourceReader.hpp>
+
+using namespace Luna;
+
+namespace {
+  constexpr char kShaderDirectory[] = "shaders/";
+}
+
+HotReloader::HotReloader(
+  const Filesystem::Path& assetsPath, JobSystem* jobSystem
+)
+    : mWatcher(assetsPath), mLoader(jobSystem), mJobSystem(jobSystem) {
+  mLoader.setReloading(true);
+}
+
+HotReloader::~HotReloader() = default;
+
+bool HotReloader::isWatching() const { return mWatcher.isWatching(); }
+
+void HotReloader::watch(const char* name, Callback callback) {
+  mCallbacks.emplace(Pack::normalizeName(name), std::move(callback));
+}
+
+void HotReloader::watchTexture(
+  const char* name, Canvas* canvas, int slot,
+  AssetLoader::Converter<Texture> convert
+) {
+  watch(name, [this, canvas, slot, convert](const std::string& changed) {
+    mLoader.loadTexture(changed.c_str(), convert)
+      .then([canvas, slot](std::shared_ptr<Texture> texture) {
+        if (texture) {
+          canvas->uploadTexture(slot, std::shared_ptr<const Texture>(texture));
+        }
+      });
+  });
+}
+
+void HotReloader::watchMesh(
+  const char* name, std::function<void(std::shared_ptr<Mesh>)> callback
+) {
+  watch(name, [this, callback](const std::string& changed) {
+    mLoader.loadMesh(changed.c_str())
+      .then([callback](std::shared_ptr<Mesh> mesh) {
+        if (mesh) {
+          callback(mesh);
+        }
+      });
+  });
+}
+
+void HotReloader::watchShaders(Canvas* canvas) {
+  if (std::find(mShaderCanvases.begin(), mShaderCanvases.end(), canvas) ==
+      mShaderCanvases.end()) {
+    mShaderCanvases.push_back(canvas);
+  }
+}
+
+void HotReloader::unwatchAll() {
+  mCallbacks.clear();
+  mShaderCanvases.clear();
+}
+
+int HotReloader::update() {
+  int reloadCount = 0;
+
+  for (auto& name : mWatcher.poll()) {
+    auto callbacks = mCallbacks.equal_range(name);
+    bool isShader =
+      !mShaderCanvases.empty() &&
+      name.compare(0, sizeof(kShaderDirectory) - 1, kShaderDirectory) == 0;
+
+    if (callbacks.first == callbacks.second && !isShader) {
+      continue;
+    }
+
+    logInfo("reloading {}", name);
+
+    for (auto it = callbacks.first; it != callbacks.second; ++it) {
+      it->second(name);
+      ++reloadCount;
+    }
+
+    if (isShader) {
+      reloadShader(name);
+      ++reloadCount;
+    }
+  }
+
+  mLoader.executePendingCallbacks();
+
+  return reloadCount;
+}
+
+void HotReloader::reloadShader(const std::string& name) {
+  auto source = std::make_shared<std::string>();
+
+  auto read = mJobSystem->schedule([name, source]() {
+    // a job must not throw
+    try {
+      auto reader = ResourceReader::make(name.c_str(), ResourceReader::kCopy);
+      source->assign(
+        reinterpret_cast<const char*>(reader->getData()), reader->getSize()
+      );
+    } catch (const std::exception& error) {
+      logError("could not read shader {}: {}", name, error.what());
+    }
+  });
+
+  // canvas commands are only enqueued on the main thread
+  mJobSystem->scheduleOnMainThread(
+    [canvases = mShaderCanvases,
+     filename = name.substr(sizeof(kShaderDirectory) - 1), source]() {
+      if (source->empty()) {
+        return;
+      }
+
+      for (auto canvas : canvases) {
+        canvas->reloadShader(filename, *source);
+      }
+    },
+    {read}
+  );
+}
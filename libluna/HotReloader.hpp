@@ -0,0 +1,121 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libluna/AssetLoader.hpp>
+#include <libluna/Filesystem/FileWatcher.hpp>
+#include <libluna/JobSystem.hpp>
+#include <libluna/Mesh.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  class Canvas;
+
+  /**
+   * @brief Reload assets while the application is running when their files
+   * change.
+   *
+   * The assets directory is watched using a Filesystem::FileWatcher. Changed
+   * files are decoded again in the background by an AssetLoader, and only the
+   * affected texture slots, meshes and shader programs are replaced. The
+   * replacement happens on the main thread in update(), which the
+   * Application calls once per frame, so a frame never sees half of a
+   * change.
+   *
+   * ```cpp
+   * auto reloader = app->getHotReloader();
+   * reloader->watchTexture("sprites/hero.bmp", canvas, 1);
+   * reloader->watchMesh("models/ship.obj", [this](auto mesh) {
+   *   mShip->setMesh(mesh);
+   * });
+   * reloader->watchShaders(canvas);
+   * ```
+   *
+   * Files are read through the ResourceReader, so entries of mounted packs
+   * take precedence over the changed files. Each change starts a new reload
+   * reading a copy of the file, see AssetLoader::setReloading(), as an editor
+   * may save the file again before the previous reload has finished.
+   *
+   * @ingroup system
+   */
+  class HotReloader {
+    public:
+    /**
+     * @brief Called on the main thread with the name of the changed file.
+     */
+    using Callback = std::function<void(const std::string& name)>;
+
+    explicit HotReloader(
+      const Filesystem::Path& assetsPath,
+      JobSystem* jobSystem = JobSystem::getInstance()
+    );
+    HotReloader(const HotReloader&) = delete;
+    HotReloader& operator=(const HotReloader&) = delete;
+    ~HotReloader();
+
+    /**
+     * @brief Check whether file changes can be detected on this platform.
+     */
+    bool isWatching() const;
+
+    /**
+     * @brief Call @p callback whenever the asset has changed.
+     */
+    void watch(const char* name, Callback callback);
+
+    /**
+     * @brief Upload the image to the texture slot again whenever it has
+     * changed.
+     *
+     * @param convert Optional conversion run in the background, as passed to
+     * AssetLoader::loadTexture().
+     */
+    void watchTexture(
+      const char* name, Canvas* canvas, int slot,
+      AssetLoader::Converter<Texture> convert = nullptr
+    );
+
+    /**
+     * @brief Pass the mesh to @p callback whenever it has changed.
+     *
+     * The callback is supposed to replace the mesh of the models using it.
+     */
+    void watchMesh(
+      const char* name, std::function<void(std::shared_ptr<Mesh>)> callback
+    );
+
+    /**
+     * @brief Replace the shaders of the canvas' renderer with the files in
+     * the `shaders` directory of the assets whenever they have changed.
+     *
+     * The files are named like the built-in shaders, e.g.
+     * `shaders/sprite_frag.glsl`.
+     */
+    void watchShaders(Canvas* canvas);
+
+    void unwatchAll();
+
+    /**
+     * @brief Start reloading the changed files and deliver the reloaded
+     * assets.
+     *
+     * Must be called on the main thread.
+     *
+     * @return The number of reloads started.
+     */
+    int update();
+
+    private:
+    void reloadShader(const std::string& name);
+
+    Filesystem::FileWatcher mWatcher;
+    AssetLoader mLoader;
+    JobSystem* mJobSystem;
+    std::multimap<std::string, Callback> mCallbacks;
+    std::vector<Canvas*> mShaderCanvases;
+  };
+} // namespace Luna
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <libluna/Application.hpp>
+#include <libluna/Filesystem/FileWatcher.hpp>
+#include <libluna/HotReloader.hpp>
+#include <libluna/Test.hpp>
+
+using namespace Luna;
+
+namespace fs = std::filesystem;
+
+/**
+ * The reloader reads the assets using a ResourceReader, which needs an
+ * application context.
+ */
+class TestApp : public Application {
+  public:
+  using Application::Application;
+
+  protected:
+  void init() override final {}
+  void update(float) override final {}
+};
+
+static void writeFile(const fs::path& path, const std::string& contents) {
+  std::ofstream(path, std::ios::binary) << contents;
+}
+
+int main(int, char**) {
+#ifdef __linux__
+  TEST("report written files", []() {
+    fs::path root = "FileWatcher.test";
+    fs::remove_all(root);
+    fs::create_directories(root / "sprites");
+
+    Filesystem::FileWatcher watcher(String(root.string()));
+    ASSERT(watcher.isWatching(), "watching");
+    ASSERT(watcher.poll().empty(), "no changes yet");
+
+    writeFile(root / "readme.txt", "hello");
+    writeFile(root / "readme.txt", "hello again");
+    writeFile(root / "sprites" / "hero.bmp", "BM");
+
+    auto changes = watcher.poll();
+    ASSERT_EQL(static_cast<int>(changes.size()), 2, "reported once each");
+
+    if (changes.size() != 2) {
+      return;
+    }
+
+    ASSERT_EQL(changes[0], "readme.txt", "file in the root");
+    ASSERT_EQL(changes[1], "sprites/hero.bmp", "file in a subdirectory");
+
+    fs::create_directories(root / "sounds");
+    watcher.poll();
+    writeFile(root / "sounds" / "jump.wav", "RIFF");
+
+    changes = watcher.poll();
+    ASSERT_EQL(static_cast<int>(changes.size()), 1, "new directory");
+
+    if (changes.size() != 1) {
+      return;
+    }
+
+    ASSERT_EQL(changes[0], "sounds/jump.wav", "file in a new directory");
+
+    fs::remove_all(root);
+  });
+
+  TEST("reload a changed mesh", []() {
+    TestApp app(0, nullptr);
+    app.setAssetsPath("HotReloader.test.assets");
+    fs::path root = app.getAssetsPath().getRawPath().c_str();
+    fs::remove_all(root);
+    fs::create_directories(root);
+
+    const std::string triangle = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    writeFile(root / "ship.obj", triangle);
+
+    HotReloader reloader(app.getAssetsPath());
+    std::shared_ptr<Mesh> mesh;
+    int calls = 0;
+
+    reloader.watchMesh("./ship.obj", [&](std::shared_ptr<Mesh> reloaded) {
+      mesh = reloaded;
+    });
+    reloader.watch("ship.obj", [&](const std::string& name) {
+      ASSERT_EQL(name, "ship.obj", "name");
+      ++calls;
+    });
+
+    ASSERT_EQL(reloader.update(), 0, "nothing changed");
+
+    writeFile(root / "unrelated.txt", "ignored");
+    writeFile(root / "ship.obj", triangle + "v 1 1 0\nf 2 4 3\n");
+    ASSERT_EQL(reloader.update(), 2, "reloads started");
+    ASSERT_EQL(calls, 1, "callback called");
+
+    for (int i = 0; i < 1000 && !mesh; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      reloader.update();
+    }
+
+    ASSERT(mesh != nullptr, "mesh delivered");
+
+    if (!mesh) {
+      return;
+    }
+
+    ASSERT_EQL(static_cast<int>(mesh->getFaces().size()), 2, "new faces");
+
+    fs::remove_all(root);
+  });
+#endif
+
+  return runTests();
+}
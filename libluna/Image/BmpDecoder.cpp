@@ -0,0 +1,466 @@
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/Image/ImageSource.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Image;
+
+namespace {
+  enum Compression : uint32_t {
+    kRgb = 0,
+    kRle8 = 1,
+    kRle4 = 2,
+    kBitfields = 3,
+    kAlphaBitfields = 6,
+  };
+
+  constexpr int kMaxDimension = 16384;
+
+  /**
+   * @brief Extract a color channel described by a bit mask.
+   */
+  class ChannelMask {
+    public:
+    ChannelMask(uint32_t mask = 0) : mMask{mask} {
+      if (mask == 0) {
+        return;
+      }
+
+      while (((mask >> mShift) & 1) == 0) {
+        ++mShift;
+      }
+
+      mMax = mask >> mShift;
+    }
+
+    inline bool isPresent() const { return mMask != 0; }
+
+    /**
+     * @brief Get channel value scaled to [0, @p targetMax].
+     */
+    inline uint32_t get(uint32_t pixel, uint32_t targetMax) const {
+      uint32_t value = (pixel & mMask) >> mShift;
+
+      return (value * targetMax + mMax / 2) / mMax;
+    }
+
+    private:
+    uint32_t mMask;
+    uint32_t mShift{0};
+    uint32_t mMax{1};
+  };
+
+  struct BmpInfo {
+    int width;
+    int height;
+    bool topDown;
+    int bitsPerPixel;
+    uint32_t compression;
+    std::array<uint32_t, 4> masks; ///< Red, green, blue and alpha.
+  };
+
+  void setIndex(Texture& texture, int x, int y, uint8_t index) {
+    if (texture.getBitsPerPixel() == 4) {
+      texture.setNibbleAt(x, y, index);
+    } else {
+      texture.byteAt(x, y) = index;
+    }
+  }
+
+  bool readPalette(
+    ImageSource& source, Texture& texture, int colorCount, int entrySize
+  ) {
+    std::array<uint8_t, 256 * 4> entries;
+    colorCount = std::min(colorCount, 256);
+
+    if (!source.read(entries.data(), static_cast<std::size_t>(colorCount * entrySize))) {
+      logError("unexpected end of BMP palette");
+      return false;
+    }
+
+    auto palette = Palette::make(32, 1 << texture.getBitsPerPixel());
+
+    for (int i = 0; i < std::min(colorCount, palette->getColorCount()); ++i) {
+      auto entry = entries.data() + i * entrySize;
+      palette->rgb32At(i) = ColorRgb32{entry[2], entry[1], entry[0], 255};
+    }
+
+    texture.setPalette(palette);
+
+    return true;
+  }
+
+  void convertRow32(uint8_t* row, int width, const BmpInfo& info) {
+    bool isBgra = info.masks[0] == 0x00ff0000 && info.masks[1] == 0x0000ff00 &&
+                  info.masks[2] == 0x000000ff;
+
+    if (isBgra && (info.masks[3] == 0xff000000 || info.masks[3] == 0)) {
+      bool opaque = info.masks[3] == 0;
+
+      for (int x = 0; x < width; ++x, row += 4) {
+        std::swap(row[0], row[2]);
+
+        if (opaque) {
+          row[3] = 255;
+        }
+      }
+
+      return;
+    }
+
+    ChannelMask red(info.masks[0]);
+    ChannelMask green(info.masks[1]);
+    ChannelMask blue(info.masks[2]);
+    ChannelMask alpha(info.masks[3]);
+
+    for (int x = 0; x < width; ++x, row += 4) {
+      uint32_t pixel = readLe32(row);
+      row[0] = static_cast<uint8_t>(red.get(pixel, 255));
+      row[1] = static_cast<uint8_t>(green.get(pixel, 255));
+      row[2] = static_cast<uint8_t>(blue.get(pixel, 255));
+      row[3] = alpha.isPresent() ? static_cast<uint8_t>(alpha.get(pixel, 255))
+                                 : 255;
+    }
+  }
+
+  void convertRow24(uint8_t* row, int width) {
+    for (int x = 0; x < width; ++x, row += 3) {
+      std::swap(row[0], row[2]);
+    }
+  }
+
+  void convertRow16(uint8_t* row, int width, const BmpInfo& info) {
+    ChannelMask red(info.masks[0]);
+    ChannelMask green(info.masks[1]);
+    ChannelMask blue(info.masks[2]);
+    ChannelMask alpha(info.masks[3]);
+    auto output = reinterpret_cast<ColorRgb16*>(row);
+
+    for (int x = 0; x < width; ++x) {
+      uint32_t pixel = readLe16(row + x * 2);
+      ColorRgb16 color;
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      color.red = static_cast<uint8_t>(red.get(pixel, 31));
+      color.green = static_cast<uint8_t>(green.get(pixel, 31));
+      color.blue = static_cast<uint8_t>(blue.get(pixel, 31));
+      color.alpha = alpha.isPresent() ? static_cast<uint8_t>(alpha.get(pixel, 1)) : 1;
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+      output[x] = color;
+    }
+  }
+
+  bool decodeUncompressed(
+    ImageSource& source, Texture& texture, const BmpInfo& info
+  ) {
+    int width = info.width;
+    auto fileRowSize = static_cast<std::size_t>(
+      ((width * info.bitsPerPixel + 31) / 32) * 4
+    );
+    // only needed if the file row can't be read into the texture directly
+    std::vector<uint8_t> rowBuffer;
+
+    if (info.bitsPerPixel == 1 || (info.bitsPerPixel == 4 && width % 2 != 0)) {
+      rowBuffer.resize(fileRowSize);
+    }
+
+    for (int fileY = 0; fileY < info.height; ++fileY) {
+      int y = info.topDown ? fileY : info.height - 1 - fileY;
+      std::size_t bytesRead = 0;
+
+      if (!rowBuffer.empty()) {
+        if (!source.read(rowBuffer.data(), fileRowSize)) {
+          logError("unexpected end of BMP pixel data");
+          return false;
+        }
+
+        bytesRead = fileRowSize;
+
+        for (int x = 0; x < width; ++x) {
+          uint8_t index;
+
+          if (info.bitsPerPixel == 1) {
+            index = (rowBuffer[static_cast<std::size_t>(x / 8)] >> (7 - x % 8)) & 1;
+          } else {
+            index = (rowBuffer[static_cast<std::size_t>(x / 2)] >> (x % 2 ? 0 : 4)) & 0xf;
+          }
+
+          texture.setNibbleAt(x, y, index);
+        }
+      } else {
+        auto rowSize = static_cast<std::size_t>(texture.getBytesPerRow());
+        auto row = texture.getData() + rowSize * static_cast<std::size_t>(y);
+
+        if (!source.read(row, rowSize)) {
+          logError("unexpected end of BMP pixel data");
+          return false;
+        }
+
+        bytesRead = rowSize;
+
+        switch (info.bitsPerPixel) {
+        case 4:
+          // BMP stores the left pixel in the high nibble
+          for (std::size_t i = 0; i < rowSize; ++i) {
+            row[i] = static_cast<uint8_t>((row[i] >> 4) | (row[i] << 4));
+          }
+          break;
+        case 16:
+          convertRow16(row, width, info);
+          break;
+        case 24:
+          convertRow24(row, width);
+          break;
+        case 32:
+          convertRow32(row, width, info);
+          break;
+        }
+      }
+
+      if (!source.skip(fileRowSize - bytesRead)) {
+        logError("unexpected end of BMP pixel data");
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool decodeRle(ImageSource& source, Texture& texture, const BmpInfo& info) {
+    bool isRle4 = info.compression == kRle4;
+    int x = 0;
+    int fileY = 0;
+
+    auto put = [&](uint8_t index) {
+      if (x < info.width && fileY < info.height) {
+        setIndex(texture, x, info.height - 1 - fileY, index);
+      }
+
+      ++x;
+    };
+
+    while (true) {
+      uint8_t count;
+      uint8_t value;
+
+      if (!source.readByte(count) || !source.readByte(value)) {
+        logError("unexpected end of BMP RLE data");
+        return false;
+      }
+
+      if (count > 0) {
+        for (int i = 0; i < count; ++i) {
+          if (isRle4) {
+            put(static_cast<uint8_t>(i % 2 ? value & 0xf : value >> 4));
+          } else {
+            put(value);
+          }
+        }
+
+        continue;
+      }
+
+      if (value == 0) {
+        // end of line
+        x = 0;
+        ++fileY;
+      } else if (value == 1) {
+        // end of bitmap
+        return true;
+      } else if (value == 2) {
+        uint8_t delta[2];
+
+        if (!source.read(delta, 2)) {
+          logError("unexpected end of BMP RLE data");
+          return false;
+        }
+
+        x += delta[0];
+        fileY += delta[1];
+      } else {
+        // absolute mode, padded to 16 bits
+        int byteCount = isRle4 ? (value + 1) / 2 : value;
+        uint8_t byte = 0;
+
+        for (int i = 0; i < value; ++i) {
+          if (isRle4) {
+            if (i % 2 == 0 && !source.readByte(byte)) {
+              logError("unexpected end of BMP RLE data");
+              return false;
+            }
+
+            put(static_cast<uint8_t>(i % 2 ? byte & 0xf : byte >> 4));
+          } else {
+            if (!source.readByte(byte)) {
+              logError("unexpected end of BMP RLE data");
+              return false;
+            }
+
+            put(byte);
+          }
+        }
+
+        if (byteCount % 2 != 0) {
+          source.skip(1);
+        }
+      }
+    }
+  }
+} // namespace
+
+bool Image::decodeBmp(ImageSource& source, Texture& texture) {
+  std::array<uint8_t, 14> fileHeader;
+  std::array<uint8_t, 124> header{};
+
+  if (!source.read(fileHeader.data(), fileHeader.size()) ||
+      fileHeader[0] != 'B' || fileHeader[1] != 'M') {
+    logError("invalid BMP signature");
+    return false;
+  }
+
+  uint32_t dataOffset = readLe32(fileHeader.data() + 10);
+
+  if (!source.read(header.data(), 4)) {
+    logError("unexpected end of BMP header");
+    return false;
+  }
+
+  uint32_t headerSize = readLe32(header.data());
+
+  if (headerSize < 12 || headerSize > header.size() ||
+      !source.read(header.data() + 4, headerSize - 4)) {
+    logError("invalid BMP header size {}", headerSize);
+    return false;
+  }
+
+  BmpInfo info;
+  int colorCount = 0;
+  int paletteEntrySize = 4;
+
+  if (headerSize == 12) {
+    // BITMAPCOREHEADER (OS/2)
+    info.width = readLe16(header.data() + 4);
+    info.height = readLe16(header.data() + 6);
+    info.bitsPerPixel = readLe16(header.data() + 10);
+    info.compression = kRgb;
+    paletteEntrySize = 3;
+  } else {
+    info.width = static_cast<int32_t>(readLe32(header.data() + 4));
+    info.height = static_cast<int32_t>(readLe32(header.data() + 8));
+    info.bitsPerPixel = readLe16(header.data() + 14);
+    info.compression = readLe32(header.data() + 16);
+    colorCount = static_cast<int>(readLe32(header.data() + 32));
+  }
+
+  // checked before taking the absolute value, which is undefined for the
+  // smallest integer
+  if (info.width <= 0 || info.height == 0 || info.width > kMaxDimension ||
+      info.height > kMaxDimension || info.height < -kMaxDimension) {
+    logError("invalid BMP size {}x{}", info.width, info.height);
+    return false;
+  }
+
+  info.topDown = info.height < 0;
+  info.height = std::abs(info.height);
+
+  if (info.bitsPerPixel == 16) {
+    info.masks = {0x7c00, 0x03e0, 0x001f, 0};
+  } else {
+    info.masks = {0x00ff0000, 0x0000ff00, 0x000000ff, 0};
+  }
+
+  if (info.compression == kBitfields || info.compression == kAlphaBitfields) {
+    std::size_t maskCount = info.compression == kAlphaBitfields ? 4 : 3;
+
+    if (headerSize >= 52) {
+      // BITMAPV2INFOHEADER or later include the masks
+      maskCount = headerSize >= 56 ? 4 : 3;
+    } else {
+      // BITMAPINFOHEADER is followed by the masks
+      if (!source.read(header.data() + 40, maskCount * 4)) {
+        logError("unexpected end of BMP bit masks");
+        return false;
+      }
+    }
+
+    for (std::size_t i = 0; i < maskCount; ++i) {
+      info.masks[i] = readLe32(header.data() + 40 + i * 4);
+    }
+  } else if (info.compression != kRgb && info.compression != kRle8 && info.compression != kRle4) {
+    logError("unsupported BMP compression {}", info.compression);
+    return false;
+  }
+
+  int textureBitsPerPixel;
+
+  switch (info.bitsPerPixel) {
+  case 1:
+  case 4:
+    textureBitsPerPixel = 4;
+    break;
+  case 8:
+  case 16:
+  case 24:
+  case 32:
+    textureBitsPerPixel = info.bitsPerPixel;
+    break;
+  default:
+    logError("unsupported BMP bits per pixel {}", info.bitsPerPixel);
+    return false;
+  }
+
+  if ((info.compression == kRle8 && info.bitsPerPixel != 8) ||
+      (info.compression == kRle4 && info.bitsPerPixel != 4)) {
+    logError("invalid BMP RLE bits per pixel {}", info.bitsPerPixel);
+    return false;
+  }
+
+  Texture result(textureBitsPerPixel, Vector2i(info.width, info.height));
+
+  if (info.bitsPerPixel <= 8) {
+    if (colorCount == 0) {
+      colorCount = 1 << info.bitsPerPixel;
+    }
+
+    if (!readPalette(source, result, colorCount, paletteEntrySize)) {
+      return false;
+    }
+  }
+
+  if (!source.seek(dataOffset)) {
+    logError("invalid BMP pixel data offset {}", dataOffset);
+    return false;
+  }
+
+  bool success = info.compression == kRle8 || info.compression == kRle4
+                   ? decodeRle(source, result, info)
+                   : decodeUncompressed(source, result, info);
+
+  if (success) {
+    texture = std::move(result);
+  }
+
+  return success;
+}
+
+bool Image::decodeBmp(InputStream& input, Texture& texture) {
+  ImageSource source(input);
+
+  return decodeBmp(source, texture);
+}
+
+bool Image::decodeBmp(const uint8_t* data, std::size_t size, Texture& texture) {
+  ImageSource source(data, size);
+
+  return decodeBmp(source, texture);
+}
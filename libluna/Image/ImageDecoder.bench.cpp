@@ -0,0 +1,211 @@
+#include <array>
+#include <vector>
+
+#include <libluna/Bench.hpp>
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/MemoryReader.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  constexpr int kWidth = 1024;
+  constexpr int kHeight = 1024;
+
+  void putLe16(vector<uint8_t>& data, int value) {
+    data.push_back(static_cast<uint8_t>(value));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+  }
+
+  void putLe32(vector<uint8_t>& data, int value) {
+    putLe16(data, value);
+    putLe16(data, value >> 16);
+  }
+
+  void putBe32(vector<uint8_t>& data, int value) {
+    data.push_back(static_cast<uint8_t>(value >> 24));
+    data.push_back(static_cast<uint8_t>(value >> 16));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+    data.push_back(static_cast<uint8_t>(value));
+  }
+
+  /**
+   * @brief Sprite-like test image with flat areas, gradients and noise.
+   */
+  ColorRgb32 samplePixel(int x, int y) {
+    auto noise = static_cast<uint8_t>((x * 7919 + y * 104729) >> 3);
+
+    if ((x / 64 + y / 64) % 3 == 0) {
+      return ColorRgb32{40, 80, 160, 255};
+    }
+
+    return ColorRgb32{
+      static_cast<uint8_t>(x), static_cast<uint8_t>(y),
+      static_cast<uint8_t>((x + y) / 2 + (noise & 7)),
+      static_cast<uint8_t>(x % 128 < 8 ? 0 : 255)};
+  }
+
+  vector<uint8_t> makeBmp32() {
+    vector<uint8_t> data = {'B', 'M'};
+    int dataOffset = 14 + 40;
+    putLe32(data, dataOffset + kWidth * kHeight * 4);
+    putLe32(data, 0);
+    putLe32(data, dataOffset);
+    putLe32(data, 40);
+    putLe32(data, kWidth);
+    putLe32(data, kHeight);
+    putLe16(data, 1);
+    putLe16(data, 32);
+    putLe32(data, 0);
+    putLe32(data, kWidth * kHeight * 4);
+    putLe32(data, 2835);
+    putLe32(data, 2835);
+    putLe32(data, 0);
+    putLe32(data, 0);
+
+    for (int y = kHeight - 1; y >= 0; --y) {
+      for (int x = 0; x < kWidth; ++x) {
+        auto color = samplePixel(x, y);
+        data.insert(data.end(), {color.blue, color.green, color.red, 255});
+      }
+    }
+
+    return data;
+  }
+
+  vector<uint8_t> makeTgaRle() {
+    vector<uint8_t> data = {0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    putLe16(data, kWidth);
+    putLe16(data, kHeight);
+    data.push_back(32);
+    data.push_back(0x28);
+
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth;) {
+        auto color = samplePixel(x, y);
+        int run = 1;
+
+        while (run < 128 && x + run < kWidth &&
+               samplePixel(x + run, y).red == color.red &&
+               samplePixel(x + run, y).green == color.green &&
+               samplePixel(x + run, y).blue == color.blue &&
+               samplePixel(x + run, y).alpha == color.alpha) {
+          ++run;
+        }
+
+        data.push_back(static_cast<uint8_t>(0x80 | (run - 1)));
+        data.insert(data.end(), {color.blue, color.green, color.red, color.alpha});
+        x += run;
+      }
+    }
+
+    return data;
+  }
+
+  /**
+   * @brief Minimal QOI encoder (index, run and RGBA ops only).
+   */
+  vector<uint8_t> makeQoi() {
+    vector<uint8_t> data = {'q', 'o', 'i', 'f'};
+    putBe32(data, kWidth);
+    putBe32(data, kHeight);
+    data.push_back(4);
+    data.push_back(0);
+
+    array<ColorRgb32, 64> index{};
+    ColorRgb32 previous{0, 0, 0, 255};
+    int run = 0;
+
+    auto same = [](const ColorRgb32& a, const ColorRgb32& b) {
+      return a.red == b.red && a.green == b.green && a.blue == b.blue &&
+             a.alpha == b.alpha;
+    };
+
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        auto color = samplePixel(x, y);
+
+        if (same(color, previous)) {
+          if (++run == 62) {
+            data.push_back(static_cast<uint8_t>(0xc0 | (run - 1)));
+            run = 0;
+          }
+
+          continue;
+        }
+
+        if (run > 0) {
+          data.push_back(static_cast<uint8_t>(0xc0 | (run - 1)));
+          run = 0;
+        }
+
+        auto hash = static_cast<uint8_t>(
+          (color.red * 3 + color.green * 5 + color.blue * 7 + color.alpha * 11) %
+          64
+        );
+
+        if (same(index[hash], color)) {
+          data.push_back(hash);
+        } else {
+          index[hash] = color;
+          data.insert(
+            data.end(), {0xff, color.red, color.green, color.blue, color.alpha}
+          );
+        }
+
+        previous = color;
+      }
+    }
+
+    if (run > 0) {
+      data.push_back(static_cast<uint8_t>(0xc0 | (run - 1)));
+    }
+
+    data.insert(data.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+
+    return data;
+  }
+} // namespace
+
+int main(int, char**) {
+  static auto bmp = makeBmp32();
+  static auto tga = makeTgaRle();
+  static auto qoi = makeQoi();
+  static Texture texture;
+  auto pixelBytes = static_cast<size_t>(kWidth * kHeight * 4);
+
+  BENCH("BMP 32 bpp from memory", pixelBytes, []() {
+    Image::decode(bmp.data(), bmp.size(), texture);
+    benchKeep(texture);
+  });
+
+  BENCH("BMP 32 bpp from stream", pixelBytes, []() {
+    MemoryReader reader(bmp.data(), bmp.size());
+    Image::decode(reader, texture);
+    benchKeep(texture);
+  });
+
+  BENCH("TGA RLE 32 bpp from memory", pixelBytes, []() {
+    Image::decode(tga.data(), tga.size(), texture);
+    benchKeep(texture);
+  });
+
+  BENCH("TGA RLE 32 bpp from stream", pixelBytes, []() {
+    MemoryReader reader(tga.data(), tga.size());
+    Image::decode(reader, texture);
+    benchKeep(texture);
+  });
+
+  BENCH("QOI 32 bpp from memory", pixelBytes, []() {
+    Image::decode(qoi.data(), qoi.size(), texture);
+    benchKeep(texture);
+  });
+
+  BENCH("QOI 32 bpp from stream", pixelBytes, []() {
+    MemoryReader reader(qoi.data(), qoi.size());
+    Image::decode(reader, texture);
+    benchKeep(texture);
+  });
+
+  return runBenchmarks();
+}
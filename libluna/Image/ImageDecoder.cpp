@@ -0,0 +1,73 @@
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/Image/ImageSource.hpp>
+
+#include <array>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Image;
+
+namespace {
+  bool decodeAny(ImageSource& source, Texture& texture) {
+    std::array<uint8_t, 18> header{};
+    auto start = source.tell();
+    std::size_t headerSize = 0;
+
+    while (headerSize < header.size() && source.readByte(header[headerSize])) {
+      ++headerSize;
+    }
+
+    source.seek(start);
+
+    switch (detectFormat(header.data(), headerSize)) {
+    case kBmp:
+      return decodeBmp(source, texture);
+    case kTga:
+      return decodeTga(source, texture);
+    case kQoi:
+      return decodeQoi(source, texture);
+    default:
+      logError("unknown image format");
+      return false;
+    }
+  }
+} // namespace
+
+Format Image::detectFormat(const uint8_t* data, std::size_t size) {
+  if (size >= 2 && data[0] == 'B' && data[1] == 'M') {
+    return kBmp;
+  }
+
+  if (size >= 4 && data[0] == 'q' && data[1] == 'o' && data[2] == 'i' &&
+      data[3] == 'f') {
+    return kQoi;
+  }
+
+  if (size >= 18) {
+    uint8_t colorMapType = data[1];
+    uint8_t imageType = data[2] & 0xf7;
+    uint8_t bitsPerPixel = data[16];
+    bool validDepth = bitsPerPixel == 8 || bitsPerPixel == 15 ||
+                      bitsPerPixel == 16 || bitsPerPixel == 24 ||
+                      bitsPerPixel == 32;
+
+    if (colorMapType <= 1 && imageType >= 1 && imageType <= 3 && validDepth) {
+      return kTga;
+    }
+  }
+
+  return kUnknown;
+}
+
+bool Image::decode(InputStream& input, Texture& texture) {
+  ImageSource source(input);
+
+  return decodeAny(source, texture);
+}
+
+bool Image::decode(const uint8_t* data, std::size_t size, Texture& texture) {
+  ImageSource source(data, size);
+
+  return decodeAny(source, texture);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+#include <libluna/InputStream.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  /**
+   * @defgroup image Image
+   *
+   * @brief Decoding image files into textures.
+   */
+
+  /**
+   * @brief Decode BMP, TGA and QOI images into textures.
+   *
+   * Each decoder runs in a single pass and writes the pixels straight into the
+   * texture memory, converting the channel order row by row while the data is
+   * still in cache. Images can be decoded from any InputStream or from a
+   * buffer that is already in memory (e.g. a memory-mapped file), in which
+   * case no data is buffered at all.
+   *
+   * The resulting texture formats are:
+   *
+   * - indexed images (BMP 1/4/8 bpp, TGA color-mapped and grayscale) become
+   *   4 or 8 bpp textures with a Palette
+   * - 15/16-bit images become 16 bpp (RGBA5551) textures
+   * - 24-bit images become 24 bpp (RGB) textures
+   * - 32-bit images and images with an alpha channel become 32 bpp (RGBA)
+   *   textures
+   *
+   * All functions return false and log an error if the image is invalid or
+   * not supported. The texture is left untouched in that case.
+   *
+   * @ingroup image
+   */
+  namespace Image {
+    enum Format { kUnknown, kBmp, kTga, kQoi };
+
+    /**
+     * @brief Guess the image format from the first bytes of a file.
+     *
+     * TGA files have no signature, so kTga is returned if the header merely
+     * looks plausible.
+     */
+    Format detectFormat(const uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Decode an image of any supported format.
+     */
+    ///@{
+    bool decode(InputStream& input, Texture& texture);
+    bool decode(const uint8_t* data, std::size_t size, Texture& texture);
+    ///@}
+
+    /**
+     * @brief Decode a Windows bitmap.
+     *
+     * Supports 1, 4, 8, 16, 24 and 32 bpp, uncompressed, RLE4, RLE8 and
+     * bit field encoded images.
+     */
+    ///@{
+    bool decodeBmp(InputStream& input, Texture& texture);
+    bool decodeBmp(const uint8_t* data, std::size_t size, Texture& texture);
+    ///@}
+
+    /**
+     * @brief Decode a Truevision TGA image.
+     *
+     * Supports color-mapped, true color and grayscale images, both
+     * uncompressed and run-length encoded.
+     */
+    ///@{
+    bool decodeTga(InputStream& input, Texture& texture);
+    bool decodeTga(const uint8_t* data, std::size_t size, Texture& texture);
+    ///@}
+
+    /**
+     * @brief Decode a QOI ("Quite OK Image") image.
+     */
+    ///@{
+    bool decodeQoi(InputStream& input, Texture& texture);
+    bool decodeQoi(const uint8_t* data, std::size_t size, Texture& texture);
+    ///@}
+  } // namespace Image
+} // namespace Luna
@@ -0,0 +1,202 @@
+#include <vector>
+
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/MemoryReader.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  void putLe16(vector<uint8_t>& data, int value) {
+    data.push_back(static_cast<uint8_t>(value));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+  }
+
+  void putLe32(vector<uint8_t>& data, int value) {
+    putLe16(data, value);
+    putLe16(data, value >> 16);
+  }
+
+  void putBe32(vector<uint8_t>& data, int value) {
+    data.push_back(static_cast<uint8_t>(value >> 24));
+    data.push_back(static_cast<uint8_t>(value >> 16));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+    data.push_back(static_cast<uint8_t>(value));
+  }
+
+  /**
+   * @brief Build a bottom-up BMP with a BITMAPINFOHEADER.
+   */
+  vector<uint8_t> makeBmp(
+    int width, int height, int bitsPerPixel, const vector<uint8_t>& palette,
+    const vector<uint8_t>& pixels
+  ) {
+    vector<uint8_t> data;
+    int dataOffset = 14 + 40 + static_cast<int>(palette.size());
+
+    data.push_back('B');
+    data.push_back('M');
+    putLe32(data, dataOffset + static_cast<int>(pixels.size()));
+    putLe32(data, 0);
+    putLe32(data, dataOffset);
+
+    putLe32(data, 40);
+    putLe32(data, width);
+    putLe32(data, height);
+    putLe16(data, 1);
+    putLe16(data, bitsPerPixel);
+    putLe32(data, 0); // compression
+    putLe32(data, static_cast<int>(pixels.size()));
+    putLe32(data, 2835);
+    putLe32(data, 2835);
+    putLe32(data, static_cast<int>(palette.size() / 4));
+    putLe32(data, 0);
+
+    data.insert(data.end(), palette.begin(), palette.end());
+    data.insert(data.end(), pixels.begin(), pixels.end());
+
+    return data;
+  }
+
+  bool isColor(const ColorRgb32& color, int red, int green, int blue, int alpha) {
+    return color.red == red && color.green == green && color.blue == blue &&
+           color.alpha == alpha;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("detectFormat()", []() {
+    uint8_t bmp[] = {'B', 'M', 0, 0};
+    uint8_t qoi[] = {'q', 'o', 'i', 'f'};
+    uint8_t tga[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 24, 0};
+    uint8_t other[18] = {0xff, 0xd8, 0xff};
+
+    ASSERT_EQL(Image::detectFormat(bmp, sizeof(bmp)), Image::kBmp, "BMP");
+    ASSERT_EQL(Image::detectFormat(qoi, sizeof(qoi)), Image::kQoi, "QOI");
+    ASSERT_EQL(Image::detectFormat(tga, sizeof(tga)), Image::kTga, "TGA");
+    ASSERT_EQL(
+      Image::detectFormat(other, sizeof(other)), Image::kUnknown, "unknown"
+    );
+  });
+
+  TEST("24 bpp BMP", []() {
+    // 3x2, rows padded to 12 bytes, bottom row first
+    vector<uint8_t> pixels = {
+      0, 0, 255, 0, 255, 0, 255, 0, 0, 0, 0, 0, // red, green, blue
+      0, 0, 0, 255, 255, 255, 128, 128, 128, 0, 0, 0, // black, white, gray
+    };
+    auto file = makeBmp(3, 2, 24, {}, pixels);
+
+    Texture texture;
+    ASSERT(Image::decode(file.data(), file.size(), texture), "decoded");
+    ASSERT_EQL(texture.getBitsPerPixel(), 24, "bits per pixel");
+    ASSERT_EQL(texture.getWidth(), 3, "width");
+    ASSERT_EQL(texture.getHeight(), 2, "height");
+
+    auto& gray = texture.rgb24At(2, 0);
+    auto& red = texture.rgb24At(0, 1);
+    auto& blue = texture.rgb24At(2, 1);
+    ASSERT(gray.red == 128 && gray.green == 128 && gray.blue == 128, "gray");
+    ASSERT(red.red == 255 && red.green == 0 && red.blue == 0, "red");
+    ASSERT(blue.red == 0 && blue.green == 0 && blue.blue == 255, "blue");
+  });
+
+  TEST("4 bpp BMP with palette", []() {
+    vector<uint8_t> palette(16 * 4, 0);
+    palette[1 * 4 + 2] = 255; // index 1: red
+    palette[2 * 4 + 1] = 255; // index 2: green
+
+    // 3x1, left pixel in the high nibble
+    vector<uint8_t> pixels = {0x12, 0x00, 0x00, 0x00};
+    auto file = makeBmp(3, 1, 4, palette, pixels);
+
+    Texture texture;
+    ASSERT(Image::decodeBmp(file.data(), file.size(), texture), "decoded");
+    ASSERT_EQL(texture.getBitsPerPixel(), 4, "bits per pixel");
+    ASSERT_EQL(texture.getNibbleAt(0, 0), 1, "pixel 0");
+    ASSERT_EQL(texture.getNibbleAt(1, 0), 2, "pixel 1");
+    ASSERT_EQL(texture.getNibbleAt(2, 0), 0, "pixel 2");
+    ASSERT(
+      isColor(texture.getPalette()->getColorRgb32(1), 255, 0, 0, 255),
+      "palette entry"
+    );
+  });
+
+  TEST("run-length encoded TGA from stream", []() {
+    vector<uint8_t> file = {
+      0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 2, 0, 32, 0x28,
+    };
+    // run of 4 red pixels across both rows, then 2 raw pixels
+    file.insert(file.end(), {0x83, 0, 0, 255, 255});
+    file.insert(file.end(), {0x01, 255, 0, 0, 128, 0, 255, 0, 255});
+
+    MemoryReader reader(file.data(), file.size());
+    Texture texture;
+    ASSERT(Image::decode(reader, texture), "decoded");
+    ASSERT_EQL(texture.getBitsPerPixel(), 32, "bits per pixel");
+    ASSERT(isColor(texture.rgb32At(0, 0), 255, 0, 0, 255), "run start");
+    ASSERT(isColor(texture.rgb32At(0, 1), 255, 0, 0, 255), "run wraps");
+    ASSERT(isColor(texture.rgb32At(1, 1), 0, 0, 255, 128), "raw pixel");
+    ASSERT(isColor(texture.rgb32At(2, 1), 0, 255, 0, 255), "last pixel");
+  });
+
+  TEST("QOI", []() {
+    vector<uint8_t> file = {'q', 'o', 'i', 'f'};
+    putBe32(file, 4);
+    putBe32(file, 1);
+    file.push_back(4);
+    file.push_back(0);
+
+    file.insert(file.end(), {0xfe, 10, 20, 30}); // RGB
+    file.push_back(0x40 | (3 << 4) | (2 << 2) | 1); // diff +1, 0, -1
+    file.push_back(0xc0 | 0); // run of 1
+    file.insert(file.end(), {0xff, 1, 2, 3, 4}); // RGBA
+    file.insert(file.end(), {0, 0, 0, 0, 0, 0, 0, 1}); // end marker
+
+    Texture texture;
+    ASSERT(Image::decodeQoi(file.data(), file.size(), texture), "decoded");
+    ASSERT_EQL(texture.getBitsPerPixel(), 32, "bits per pixel");
+    ASSERT(isColor(texture.rgb32At(0, 0), 10, 20, 30, 255), "rgb");
+    ASSERT(isColor(texture.rgb32At(1, 0), 11, 20, 29, 255), "diff");
+    ASSERT(isColor(texture.rgb32At(2, 0), 11, 20, 29, 255), "run");
+    ASSERT(isColor(texture.rgb32At(3, 0), 1, 2, 3, 4), "rgba");
+  });
+
+  TEST("truncated data fails", []() {
+    vector<uint8_t> pixels(12, 0);
+    auto file = makeBmp(3, 2, 24, {}, pixels);
+    file.resize(file.size() - 4);
+
+    Texture texture;
+    ASSERT(!Image::decode(file.data(), file.size(), texture), "rejected");
+    ASSERT_EQL(texture.getWidth(), 0, "texture untouched");
+  });
+
+  TEST("oversized TGA fails", []() {
+    // 65535x65535 would allocate 16 GB before reading any pixels
+    uint8_t file[18] = {
+      0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 32, 0x28,
+    };
+
+    Texture texture;
+    ASSERT(!Image::decode(file, sizeof(file), texture), "rejected");
+  });
+
+  TEST("oversized BMP and QOI fail", []() {
+    auto bmp = makeBmp(1, -2147483647 - 1, 24, {}, vector<uint8_t>(4, 0));
+
+    Texture texture;
+    ASSERT(!Image::decode(bmp.data(), bmp.size(), texture), "BMP rejected");
+
+    vector<uint8_t> qoi = {'q', 'o', 'i', 'f'};
+    putBe32(qoi, 20000);
+    putBe32(qoi, 20000);
+    qoi.push_back(4);
+    qoi.push_back(0);
+
+    ASSERT(!Image::decodeQoi(qoi.data(), qoi.size(), texture), "QOI rejected");
+  });
+
+  return runTests();
+}
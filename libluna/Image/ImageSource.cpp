@@ -0,0 +1,100 @@
+#include <libluna/Image/ImageSource.hpp>
+
+#include <algorithm>
+#include <cstring> // memcpy
+
+using namespace Luna::Image;
+
+ImageSource::ImageSource(const uint8_t* data, std::size_t size)
+    : mStream{nullptr}, mBase{data}, mCursor{data}, mEnd{data + size},
+      mStart{0}, mBufferOffset{0} {}
+
+ImageSource::ImageSource(InputStream& stream)
+    : mStream{&stream}, mStart{stream.tell()}, mBufferOffset{0} {
+  mBase = mBuffer.data();
+  mCursor = mBase;
+  mEnd = mBase;
+}
+
+std::size_t ImageSource::tell() const {
+  return mBufferOffset + static_cast<std::size_t>(mCursor - mBase);
+}
+
+bool ImageSource::seek(std::size_t position) {
+  auto bufferSize = static_cast<std::size_t>(mEnd - mBase);
+
+  if (position >= mBufferOffset && position <= mBufferOffset + bufferSize) {
+    mCursor = mBase + (position - mBufferOffset);
+    return true;
+  }
+
+  if (!mStream) {
+    return false;
+  }
+
+  if (mStream->seek(mStart + position) != mStart + position) {
+    return false;
+  }
+
+  mBufferOffset = position;
+  mCursor = mBase;
+  mEnd = mBase;
+
+  return true;
+}
+
+bool ImageSource::read(uint8_t* buffer, std::size_t count) {
+  auto available = std::min(count, static_cast<std::size_t>(mEnd - mCursor));
+  std::memcpy(buffer, mCursor, available);
+  mCursor += available;
+  buffer += available;
+  count -= available;
+
+  if (count == 0) {
+    return true;
+  }
+
+  if (!mStream) {
+    return false;
+  }
+
+  if (count >= mBuffer.size()) {
+    // large reads go straight into the destination
+    mBufferOffset += static_cast<std::size_t>(mEnd - mBase);
+    mCursor = mBase;
+    mEnd = mBase;
+
+    auto bytesRead = mStream->read(buffer, 1, count);
+    mBufferOffset += bytesRead;
+
+    return bytesRead == count;
+  }
+
+  if (!refill() || static_cast<std::size_t>(mEnd - mCursor) < count) {
+    return false;
+  }
+
+  std::memcpy(buffer, mCursor, count);
+  mCursor += count;
+
+  return true;
+}
+
+bool ImageSource::refill() {
+  if (!mStream) {
+    return false;
+  }
+
+  // keep unread bytes at the front of the buffer
+  auto remaining = static_cast<std::size_t>(mEnd - mCursor);
+  mBufferOffset += static_cast<std::size_t>(mCursor - mBase);
+  std::memmove(mBuffer.data(), mCursor, remaining);
+
+  auto bytesRead =
+    mStream->read(mBuffer.data() + remaining, 1, mBuffer.size() - remaining);
+
+  mCursor = mBase;
+  mEnd = mBase + remaining + bytesRead;
+
+  return bytesRead > 0;
+}
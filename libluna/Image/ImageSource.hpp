@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <libluna/InputStream.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna::Image {
+  /**
+   * @brief Byte source shared by the image decoders.
+   *
+   * Memory buffers are accessed in place. Streams are read in small chunks for
+   * byte-wise parsing, while larger reads (such as whole pixel rows) bypass
+   * the chunk buffer and go straight into the destination.
+   */
+  class ImageSource {
+    public:
+    ImageSource(const uint8_t* data, std::size_t size);
+    explicit ImageSource(InputStream& stream);
+    ImageSource(const ImageSource& other) = delete;
+    ImageSource& operator=(const ImageSource& other) = delete;
+
+    /**
+     * @brief Get the current position relative to the start of the data.
+     */
+    std::size_t tell() const;
+
+    bool seek(std::size_t position);
+
+    inline bool skip(std::size_t count) { return seek(tell() + count); }
+
+    /**
+     * @brief Read exactly @p count bytes.
+     *
+     * @return false if not enough data is available.
+     */
+    bool read(uint8_t* buffer, std::size_t count);
+
+    inline bool readByte(uint8_t& byte) {
+      if (mCursor == mEnd && !refill()) {
+        return false;
+      }
+
+      byte = *mCursor++;
+
+      return true;
+    }
+
+    private:
+    bool refill();
+
+    InputStream* mStream;
+    const uint8_t* mBase;
+    const uint8_t* mCursor;
+    const uint8_t* mEnd;
+    std::size_t mStart;        ///< Stream position of the first byte.
+    std::size_t mBufferOffset; ///< Position of mBase relative to mStart.
+    std::array<uint8_t, 4096> mBuffer;
+  };
+
+  bool decodeBmp(ImageSource& source, Texture& texture);
+  bool decodeTga(ImageSource& source, Texture& texture);
+  bool decodeQoi(ImageSource& source, Texture& texture);
+
+  inline uint16_t readLe16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+  }
+
+  inline uint32_t readLe32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) |
+           (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) |
+           (static_cast<uint32_t>(data[3]) << 24);
+  }
+
+  inline uint32_t readBe32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) |
+           (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) |
+           static_cast<uint32_t>(data[3]);
+  }
+} // namespace Luna::Image
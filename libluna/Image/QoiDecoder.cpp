@@ -0,0 +1,154 @@
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/Image/ImageSource.hpp>
+
+#include <array>
+#include <utility>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Image;
+
+namespace {
+  constexpr uint8_t kOpIndex = 0x00;
+  constexpr uint8_t kOpDiff = 0x40;
+  constexpr uint8_t kOpLuma = 0x80;
+  constexpr uint8_t kOpRun = 0xc0;
+  constexpr uint8_t kOpRgb = 0xfe;
+  constexpr uint8_t kOpRgba = 0xff;
+  constexpr uint8_t kOpMask = 0xc0;
+
+  constexpr uint32_t kMaxDimension = 16384;
+
+  inline std::size_t hashColor(const ColorRgb32& color) {
+    return static_cast<std::size_t>(
+      (color.red * 3 + color.green * 5 + color.blue * 7 + color.alpha * 11) % 64
+    );
+  }
+} // namespace
+
+bool Image::decodeQoi(ImageSource& source, Texture& texture) {
+  std::array<uint8_t, 14> header;
+
+  if (!source.read(header.data(), header.size()) || header[0] != 'q' ||
+      header[1] != 'o' || header[2] != 'i' || header[3] != 'f') {
+    logError("invalid QOI signature");
+    return false;
+  }
+
+  uint32_t width = readBe32(header.data() + 4);
+  uint32_t height = readBe32(header.data() + 8);
+  uint8_t channels = header[12];
+
+  if (width == 0 || height == 0 || width > kMaxDimension ||
+      height > kMaxDimension ||
+      (channels != 3 && channels != 4)) {
+    logError("invalid QOI header ({}x{}, {} channels)", width, height, channels);
+    return false;
+  }
+
+  Texture result(
+    channels * 8,
+    Vector2i(static_cast<int>(width), static_cast<int>(height))
+  );
+
+  std::array<ColorRgb32, 64> index{};
+  // the index starts zeroed, including alpha
+  for (auto& color : index) {
+    color.alpha = 0;
+  }
+
+  ColorRgb32 pixel{0, 0, 0, 255};
+  std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+  uint8_t* output = result.getData();
+  int run = 0;
+
+  for (std::size_t i = 0; i < pixelCount; ++i) {
+    if (run > 0) {
+      --run;
+    } else {
+      uint8_t op;
+
+      if (!source.readByte(op)) {
+        logError("unexpected end of QOI data");
+        return false;
+      }
+
+      if (op == kOpRgb || op == kOpRgba) {
+        uint8_t values[4];
+
+        if (!source.read(values, op == kOpRgba ? 4 : 3)) {
+          logError("unexpected end of QOI data");
+          return false;
+        }
+
+        pixel.red = values[0];
+        pixel.green = values[1];
+        pixel.blue = values[2];
+
+        if (op == kOpRgba) {
+          pixel.alpha = values[3];
+        }
+      } else {
+        switch (op & kOpMask) {
+        case kOpIndex:
+          pixel = index[op];
+          break;
+        case kOpDiff:
+          pixel.red = static_cast<uint8_t>(pixel.red + ((op >> 4) & 3) - 2);
+          pixel.green = static_cast<uint8_t>(pixel.green + ((op >> 2) & 3) - 2);
+          pixel.blue = static_cast<uint8_t>(pixel.blue + (op & 3) - 2);
+          break;
+        case kOpLuma: {
+          uint8_t next;
+
+          if (!source.readByte(next)) {
+            logError("unexpected end of QOI data");
+            return false;
+          }
+
+          int greenDiff = (op & 0x3f) - 32;
+          pixel.red = static_cast<uint8_t>(
+            pixel.red + greenDiff - 8 + ((next >> 4) & 0x0f)
+          );
+          pixel.green = static_cast<uint8_t>(pixel.green + greenDiff);
+          pixel.blue =
+            static_cast<uint8_t>(pixel.blue + greenDiff - 8 + (next & 0x0f));
+          break;
+        }
+        case kOpRun:
+          run = op & 0x3f;
+          break;
+        }
+      }
+
+      index[hashColor(pixel)] = pixel;
+    }
+
+    output[0] = pixel.red;
+    output[1] = pixel.green;
+    output[2] = pixel.blue;
+
+    if (channels == 4) {
+      output[3] = pixel.alpha;
+    }
+
+    output += channels;
+  }
+
+  texture = std::move(result);
+
+  return true;
+}
+
+bool Image::decodeQoi(InputStream& input, Texture& texture) {
+  ImageSource source(input);
+
+  return decodeQoi(source, texture);
+}
+
+bool Image::decodeQoi(const uint8_t* data, std::size_t size, Texture& texture) {
+  ImageSource source(data, size);
+
+  return decodeQoi(source, texture);
+}
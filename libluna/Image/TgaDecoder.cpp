@@ -0,0 +1,350 @@
+#include <libluna/Image/ImageDecoder.hpp>
+#include <libluna/Image/ImageSource.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring> // memcpy
+#include <utility>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Image;
+
+namespace {
+  enum ImageType : uint8_t {
+    kColorMapped = 1,
+    kTrueColor = 2,
+    kGrayscale = 3,
+    kRunLengthFlag = 8,
+  };
+
+  constexpr int kMaxDimension = 16384;
+
+  struct TgaInfo {
+    int width;
+    int height;
+    uint8_t imageType; ///< Without run-length flag.
+    bool runLength;
+    int bitsPerPixel;
+    int bytesPerPixel; ///< In the file.
+    int alphaBits;
+    bool topDown;
+    bool rightToLeft;
+  };
+
+  /**
+   * @brief Run-length packet state, packets may span multiple rows.
+   */
+  struct RlePacket {
+    int remaining{0};
+    bool isRun{false};
+    std::array<uint8_t, 4> pixel{};
+  };
+
+  inline ColorRgb32 decodeColor(const uint8_t* data, int bitsPerColor) {
+    switch (bitsPerColor) {
+    case 15:
+    case 16: {
+      uint16_t value = readLe16(data);
+      auto expand = [](int channel) {
+        return static_cast<uint8_t>((channel << 3) | (channel >> 2));
+      };
+
+      return ColorRgb32{
+        expand((value >> 10) & 31), expand((value >> 5) & 31),
+        expand(value & 31), 255};
+    }
+    case 24:
+      return ColorRgb32{data[2], data[1], data[0], 255};
+    default:
+      return ColorRgb32{data[2], data[1], data[0], data[3]};
+    }
+  }
+
+  bool readColorMap(
+    ImageSource& source, Texture& texture, const uint8_t* header,
+    bool isUsed
+  ) {
+    int firstEntry = readLe16(header + 3);
+    int length = readLe16(header + 5);
+    int entryBits = header[7];
+    int entrySize = (entryBits + 7) / 8;
+
+    if (!isUsed) {
+      return source.skip(static_cast<std::size_t>(length * entrySize));
+    }
+
+    if (entrySize < 2 || entrySize > 4) {
+      logError("unsupported TGA color map entry size {}", entryBits);
+      return false;
+    }
+
+    auto palette = Palette::make(32, 256);
+    std::array<uint8_t, 4> entry;
+
+    for (int i = 0; i < length; ++i) {
+      if (!source.read(entry.data(), static_cast<std::size_t>(entrySize))) {
+        logError("unexpected end of TGA color map");
+        return false;
+      }
+
+      if (firstEntry + i < palette->getColorCount()) {
+        palette->rgb32At(firstEntry + i) = decodeColor(entry.data(), entryBits);
+      }
+    }
+
+    texture.setPalette(palette);
+
+    return true;
+  }
+
+  void makeGrayscalePalette(Texture& texture) {
+    auto palette = Palette::make(32, 256);
+
+    for (int i = 0; i < 256; ++i) {
+      auto value = static_cast<uint8_t>(i);
+      palette->rgb32At(i) = ColorRgb32{value, value, value, 255};
+    }
+
+    texture.setPalette(palette);
+  }
+
+  bool readPixels(
+    ImageSource& source, uint8_t* output, int pixelCount, int bytesPerPixel,
+    bool runLength, RlePacket& packet
+  ) {
+    if (!runLength) {
+      return source.read(
+        output, static_cast<std::size_t>(pixelCount * bytesPerPixel)
+      );
+    }
+
+    auto size = static_cast<std::size_t>(bytesPerPixel);
+
+    while (pixelCount > 0) {
+      if (packet.remaining == 0) {
+        uint8_t packetHeader;
+
+        if (!source.readByte(packetHeader)) {
+          return false;
+        }
+
+        packet.isRun = (packetHeader & 0x80) != 0;
+        packet.remaining = (packetHeader & 0x7f) + 1;
+
+        if (packet.isRun && !source.read(packet.pixel.data(), size)) {
+          return false;
+        }
+      }
+
+      int count = std::min(packet.remaining, pixelCount);
+
+      if (packet.isRun) {
+        for (int i = 0; i < count; ++i, output += size) {
+          std::memcpy(output, packet.pixel.data(), size);
+        }
+      } else {
+        auto byteCount = static_cast<std::size_t>(count) * size;
+
+        if (!source.read(output, byteCount)) {
+          return false;
+        }
+
+        output += byteCount;
+      }
+
+      packet.remaining -= count;
+      pixelCount -= count;
+    }
+
+    return true;
+  }
+
+  void convertRow(uint8_t* row, const TgaInfo& info) {
+    int width = info.width;
+
+    if (info.imageType == kGrayscale && info.bitsPerPixel == 16) {
+      // gray and alpha, stored at the end of the row to expand in place
+      const uint8_t* input = row + width * 2;
+
+      for (int x = 0; x < width; ++x) {
+        uint8_t gray = input[x * 2];
+        uint8_t alpha = input[x * 2 + 1];
+        row[x * 4 + 0] = gray;
+        row[x * 4 + 1] = gray;
+        row[x * 4 + 2] = gray;
+        row[x * 4 + 3] = alpha;
+      }
+
+      return;
+    }
+
+    if (info.imageType != kTrueColor) {
+      return;
+    }
+
+    switch (info.bytesPerPixel) {
+    case 2: {
+      auto output = reinterpret_cast<ColorRgb16*>(row);
+
+      for (int x = 0; x < width; ++x) {
+        uint16_t value = readLe16(row + x * 2);
+        ColorRgb16 color;
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        color.red = static_cast<uint8_t>((value >> 10) & 31);
+        color.green = static_cast<uint8_t>((value >> 5) & 31);
+        color.blue = static_cast<uint8_t>(value & 31);
+        color.alpha = info.alphaBits > 0 ? static_cast<uint8_t>(value >> 15) : 1;
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+        output[x] = color;
+      }
+      break;
+    }
+    case 3:
+      for (int x = 0; x < width; ++x, row += 3) {
+        std::swap(row[0], row[2]);
+      }
+      break;
+    case 4:
+      for (int x = 0; x < width; ++x, row += 4) {
+        std::swap(row[0], row[2]);
+
+        if (info.alphaBits == 0) {
+          row[3] = 255;
+        }
+      }
+      break;
+    }
+  }
+
+  void mirrorRow(uint8_t* row, int width, int bytesPerPixel) {
+    for (int left = 0, right = width - 1; left < right; ++left, --right) {
+      std::swap_ranges(
+        row + left * bytesPerPixel, row + (left + 1) * bytesPerPixel,
+        row + right * bytesPerPixel
+      );
+    }
+  }
+} // namespace
+
+bool Image::decodeTga(ImageSource& source, Texture& texture) {
+  std::array<uint8_t, 18> header;
+
+  if (!source.read(header.data(), header.size())) {
+    logError("unexpected end of TGA header");
+    return false;
+  }
+
+  TgaInfo info;
+  info.imageType = static_cast<uint8_t>(header[2] & ~kRunLengthFlag);
+  info.runLength = (header[2] & kRunLengthFlag) != 0;
+  info.width = readLe16(header.data() + 12);
+  info.height = readLe16(header.data() + 14);
+  info.bitsPerPixel = header[16];
+  info.bytesPerPixel = (info.bitsPerPixel + 7) / 8;
+  info.alphaBits = header[17] & 0x0f;
+  info.rightToLeft = (header[17] & 0x10) != 0;
+  info.topDown = (header[17] & 0x20) != 0;
+
+  int textureBitsPerPixel = 0;
+
+  if (info.imageType == kColorMapped && info.bitsPerPixel == 8) {
+    textureBitsPerPixel = 8;
+  } else if (info.imageType == kTrueColor) {
+    switch (info.bitsPerPixel) {
+    case 15:
+    case 16:
+      textureBitsPerPixel = 16;
+      break;
+    case 24:
+    case 32:
+      textureBitsPerPixel = info.bitsPerPixel;
+      break;
+    }
+  } else if (info.imageType == kGrayscale) {
+    if (info.bitsPerPixel == 8) {
+      textureBitsPerPixel = 8;
+    } else if (info.bitsPerPixel == 16) {
+      textureBitsPerPixel = 32;
+    }
+  }
+
+  if (textureBitsPerPixel == 0) {
+    logError(
+      "unsupported TGA image type {} with {} bpp", header[2], info.bitsPerPixel
+    );
+    return false;
+  }
+
+  if (info.width == 0 || info.height == 0 || info.width > kMaxDimension ||
+      info.height > kMaxDimension) {
+    logError("invalid TGA size {}x{}", info.width, info.height);
+    return false;
+  }
+
+  // image ID
+  if (!source.skip(header[0])) {
+    logError("unexpected end of TGA image ID");
+    return false;
+  }
+
+  Texture result(textureBitsPerPixel, Vector2i(info.width, info.height));
+
+  if (header[1] == 1) {
+    if (!readColorMap(source, result, header.data(), info.imageType == kColorMapped)) {
+      return false;
+    }
+  } else if (info.imageType == kColorMapped) {
+    logError("TGA color-mapped image without color map");
+    return false;
+  }
+
+  if (info.imageType == kGrayscale && textureBitsPerPixel == 8) {
+    makeGrayscalePalette(result);
+  }
+
+  auto rowSize = static_cast<std::size_t>(result.getBytesPerRow());
+  auto fileRowSize = static_cast<std::size_t>(info.width * info.bytesPerPixel);
+  RlePacket packet;
+
+  for (int fileY = 0; fileY < info.height; ++fileY) {
+    int y = info.topDown ? fileY : info.height - 1 - fileY;
+    auto row = result.getData() + rowSize * static_cast<std::size_t>(y);
+
+    if (!readPixels(
+          source, row + (rowSize - fileRowSize), info.width, info.bytesPerPixel,
+          info.runLength, packet
+        )) {
+      logError("unexpected end of TGA pixel data");
+      return false;
+    }
+
+    convertRow(row, info);
+
+    if (info.rightToLeft) {
+      mirrorRow(row, info.width, textureBitsPerPixel / 8);
+    }
+  }
+
+  texture = std::move(result);
+
+  return true;
+}
+
+bool Image::decodeTga(InputStream& input, Texture& texture) {
+  ImageSource source(input);
+
+  return decodeTga(source, texture);
+}
+
+bool Image::decodeTga(const uint8_t* data, std::size_t size, Texture& texture) {
+  ImageSource source(data, size);
+
+  return decodeTga(source, texture);
+}
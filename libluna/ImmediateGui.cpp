@@ -23,14 +23,49 @@ void ImmediateGui::newFrame() {
 void ImmediateGui::render(ImmediateGui* gui) { gui->render(); }
 
 #ifdef LUNA_WINDOW_SDL2
-bool ImmediateGui::processSdlEvent([[maybe_unused]] const SDL_Event* event) {
+void ImmediateGui::processSdlEvent([[maybe_unused]] const SDL_Event* event) {
 #ifdef LUNA_IMGUI
   ImGui_ImplSDL2_ProcessEvent(event);
-  return ImGui::IsWindowFocused(ImGuiFocusedFlags_AnyWindow);
-#else
-  return false;
 #endif
 }
+
+int ImmediateGui::getInputCapture() {
+  int capture = 0;
+
+#ifdef LUNA_IMGUI
+  if (!ImGui::GetCurrentContext()) {
+    return capture;
+  }
+
+  auto& io = ImGui::GetIO();
+
+  if (io.WantCaptureMouse) {
+    capture |= kCaptureMouse;
+  }
+
+  if (io.WantCaptureKeyboard || io.WantTextInput) {
+    capture |= kCaptureKeyboard;
+  }
+#endif
+
+  return capture;
+}
+
+int ImmediateGui::getSdlEventInput(const SDL_Event* event) {
+  switch (event->type) {
+  case SDL_MOUSEMOTION:
+  case SDL_MOUSEWHEEL:
+  case SDL_MOUSEBUTTONDOWN:
+  case SDL_MOUSEBUTTONUP:
+    return kCaptureMouse;
+  case SDL_KEYDOWN:
+  case SDL_KEYUP:
+  case SDL_TEXTINPUT:
+    return kCaptureKeyboard;
+  }
+
+  return 0;
+}
 #endif
 
 ImmediateGui::ImmediateGui() = default;
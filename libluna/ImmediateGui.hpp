@@ -29,7 +29,31 @@ namespace Luna {
     void newFrame();
     void render(ImmediateGui* gui);
 #ifdef LUNA_WINDOW_SDL2
-    static bool processSdlEvent(const SDL_Event* event);
+    /**
+     * @brief Kinds of input the gui wants to receive exclusively.
+     */
+    enum InputCapture {
+      kCaptureMouse = 1 << 0,
+      kCaptureKeyboard = 1 << 1,
+    };
+
+    static void processSdlEvent(const SDL_Event* event);
+
+    /**
+     * @brief Get the input the gui captured during the last frame.
+     *
+     * Must be called on the thread the gui is rendered on.
+     *
+     * @return A combination of @ref InputCapture flags.
+     */
+    static int getInputCapture();
+
+    /**
+     * @brief Get the kind of input an event belongs to.
+     *
+     * @return One of @ref InputCapture or 0 if the event is no input.
+     */
+    static int getSdlEventInput(const SDL_Event* event);
 #endif
     Canvas* mCanvas{nullptr};
 #ifdef LUNA_IMGUI
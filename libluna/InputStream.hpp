@@ -176,6 +176,12 @@ namespace Luna {
       );
     }
 
+    /**
+     * @brief Read the next line, one byte at a time.
+     *
+     * Wrap the stream into a BufferedInputStream for parsing larger text
+     * files.
+     */
     bool readLine(char* buffer, std::size_t bufferSize) {
       if (bufferSize == 0) {
         return false;
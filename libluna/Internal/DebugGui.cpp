@@ -50,6 +50,13 @@ void DebugGui::render() {
       ImGui::Separator();
 
       ImGui::Text("Frames elapsed: %d", mMetrics->framesElapsed);
+
+      if (auto tickRate = Application::getInstance()->getFixedTickRate()) {
+        ImGui::Text(
+          "Fixed ticks: %d/s (%u elapsed, %u dropped)", tickRate,
+          mMetrics->ticksElapsed, mMetrics->ticksDropped
+        );
+      }
       ImGui::Text(
         "Average tick duration: %.2fms",
         mMetrics->frameTicker.getTickDuration() * std::milli::den
@@ -65,6 +72,22 @@ void DebugGui::render() {
         "Renders per second: %0.1f", mMetrics->renderTicker.getTicksPerSecond()
       );
 
+      if (ImGui::TreeNode("Startup")) {
+        ImGui::Text(
+          "Time to first frame: %.2fms",
+          mMetrics->timeToFirstFrame * std::milli::den
+        );
+
+        for (auto& phase : mMetrics->startupTimer.getPhases()) {
+          ImGui::Text(
+            "%s: %.2fms (started at %.2fms)", phase.name.c_str(),
+            phase.duration * std::milli::den, phase.start * std::milli::den
+          );
+        }
+
+        ImGui::TreePop();
+      }
+
       ImGui::Separator();
 
       float audioLoad =
@@ -112,6 +135,22 @@ void DebugGui::render() {
             ImGui::EndTabItem();
           }
 
+          if (ImGui::BeginTabItem("Commands")) {
+            ImGui::Text(
+              "Queue depth: %d (max %d of %d)", metrics.commandQueueDepth,
+              metrics.commandQueueMaxDepth, metrics.commandQueueCapacity
+            );
+            ImGui::Text(
+              "Main thread wait: %.2fms",
+              metrics.mainThreadWaitTime * std::milli::den
+            );
+            ImGui::Text(
+              "Render thread wait: %.2fms",
+              metrics.renderThreadWaitTime * std::milli::den
+            );
+            ImGui::EndTabItem();
+          }
+
           if (ImGui::BeginTabItem("Sprites")) {
             ImGui::Text("Sprites: %d", metrics.spriteCount);
             ImGui::EndTabItem();
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <libluna/Performance/PhaseTimer.hpp>
 #include <libluna/Performance/Ticker.hpp>
 
 namespace Luna::Internal {
   struct DebugMetrics {
     unsigned int framesElapsed{0};
+    unsigned int ticksElapsed{0}; ///< Fixed ticks, see Application::setFixedTickRate().
+    unsigned int ticksDropped{0}; ///< Fixed ticks skipped to catch up.
     Performance::Ticker frameTicker;
     Performance::Ticker renderTicker;
+    Performance::PhaseTimer startupTimer; ///< Phases of Application::run() until the first frame.
+    double timeToFirstFrame{0.0}; ///< Seconds from Application::run() until the first frame has been rendered.
   };
 } // namespace Luna::Internal
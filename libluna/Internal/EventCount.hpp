@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace Luna::Internal {
+  /**
+   * @brief Lets threads sleep until a condition on lock-free state is true.
+   *
+   * The state itself (e.g. the indices of a CommandQueue) is not protected by
+   * this class. Whoever changes it calls @ref notify() afterwards, which is a
+   * single atomic load unless a thread is actually sleeping. Only then the
+   * mutex is locked to wake the sleeping threads, similar to a futex.
+   */
+  class EventCount {
+    public:
+    /**
+     * @brief Wake all threads waiting for a condition to change.
+     */
+    void notify() {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (mWaiters.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+
+      { std::lock_guard lock(mMutex); }
+      mCv.notify_all();
+    }
+
+    /**
+     * @brief Block until @p predicate returns true.
+     */
+    template <typename Predicate> void wait(Predicate predicate) {
+      if (predicate()) {
+        return;
+      }
+
+      mWaiters.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      {
+        std::unique_lock lock(mMutex);
+        mCv.wait(lock, predicate);
+      }
+
+      mWaiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Block until @p predicate returns true or the timeout expired.
+     *
+     * @return The result of the last @p predicate call.
+     */
+    template <typename Predicate, typename Rep, typename Period>
+    bool waitFor(
+      Predicate predicate, const std::chrono::duration<Rep, Period>& timeout
+    ) {
+      if (predicate()) {
+        return true;
+      }
+
+      mWaiters.fetch_add(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      bool result;
+
+      {
+        std::unique_lock lock(mMutex);
+        result = mCv.wait_for(lock, timeout, predicate);
+      }
+
+      mWaiters.fetch_sub(1, std::memory_order_relaxed);
+
+      return result;
+    }
+
+    private:
+    std::atomic<int> mWaiters{0};
+    std::mutex mMutex;
+    std::condition_variable mCv;
+  };
+} // namespace Luna::Internal
@@ -11,5 +11,10 @@ namespace Luna::Internal {
     int glMinor{0};
     String vendor;
     String shadingLangVersion;
+    int commandQueueDepth{0}; ///< Commands not yet processed.
+    int commandQueueMaxDepth{0}; ///< Highest depth observed.
+    int commandQueueCapacity{0};
+    float mainThreadWaitTime{0.0f}; ///< Seconds blocked during the last frame.
+    float renderThreadWaitTime{0.0f}; ///< Seconds idle during the last frame.
   };
 } // namespace Luna::Internal
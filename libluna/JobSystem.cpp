@@ -0,0 +1,396 @@
+#include <libluna/JobSystem.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <libluna/Logger.hpp>
+#include <libluna/System.hpp>
+
+using namespace Luna;
+
+namespace Luna::Internal {
+  struct Job {
+    JobSystem::Job callback;
+    bool mainThread{false};
+
+#ifdef LUNA_STD_THREAD
+    /**
+     * @brief Dependencies not finished yet, plus one while scheduling.
+     */
+    std::atomic<int> pendingDependencies{1};
+    std::atomic<bool> finished{false};
+
+    /**
+     * @brief Guards @ref continuations and the transition to finished.
+     */
+    std::mutex mutex;
+#else
+    int pendingDependencies{1};
+    bool finished{false};
+#endif
+
+    /**
+     * @brief Jobs depending on this one.
+     */
+    std::vector<std::shared_ptr<Job>> continuations;
+  };
+} // namespace Luna::Internal
+
+namespace {
+#ifdef LUNA_STD_THREAD
+  thread_local const JobSystem* tJobSystem = nullptr;
+  thread_local int tWorkerIndex = -1;
+#endif
+
+  /**
+   * @brief Register @p continuation to be released when @p job finishes.
+   *
+   * @return false if @p job has already finished.
+   */
+  bool addContinuation(
+    const std::shared_ptr<Internal::Job>& job,
+    const std::shared_ptr<Internal::Job>& continuation
+  ) {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(job->mutex);
+#endif
+
+    if (job->finished) {
+      return false;
+    }
+
+    job->continuations.push_back(continuation);
+
+    return true;
+  }
+} // namespace
+
+JobHandle::JobHandle() = default;
+
+JobHandle::JobHandle(std::shared_ptr<Internal::Job> job) : mJob{job} {}
+
+JobHandle::~JobHandle() = default;
+
+bool JobHandle::isValid() const { return mJob != nullptr; }
+
+bool JobHandle::isFinished() const { return !mJob || mJob->finished; }
+
+JobSystem* JobSystem::getInstance() {
+  static JobSystem instance;
+
+  return &instance;
+}
+
+JobSystem::JobSystem([[maybe_unused]] unsigned int workerCount) {
+#ifdef LUNA_STD_THREAD
+  if (workerCount == 0) {
+    // leave one processor to the main thread, which helps while waiting
+    workerCount = std::max(2u, System::getProcessorCount()) - 1;
+  }
+
+  mMainThreadId = std::this_thread::get_id();
+
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    mQueues.emplace_back(std::make_unique<WorkerQueue>());
+  }
+
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    mWorkers.emplace_back(&JobSystem::workerThread, this, static_cast<int>(i));
+  }
+#endif
+}
+
+JobSystem::~JobSystem() {
+#ifdef LUNA_STD_THREAD
+  mExitRequested = true;
+  mEvent.notify();
+
+  for (auto& worker : mWorkers) {
+    worker.join();
+  }
+#endif
+}
+
+JobHandle JobSystem::schedule(Job job, const Dependencies& dependencies) {
+  return scheduleJob(std::move(job), dependencies, false);
+}
+
+JobHandle
+JobSystem::scheduleOnMainThread(Job job, const Dependencies& dependencies) {
+  return scheduleJob(std::move(job), dependencies, true);
+}
+
+JobHandle JobSystem::parallelFor(
+  int begin, int end, int grainSize, RangeJob job,
+  const Dependencies& dependencies
+) {
+  if (grainSize <= 0) {
+    auto chunkCount = static_cast<int>(std::max(1u, getWorkerCount()) * 4);
+    grainSize = std::max(1, (end - begin + chunkCount - 1) / chunkCount);
+  }
+
+  // shared by all chunks instead of copying the callback for each of them
+  auto rangeJob = std::make_shared<RangeJob>(std::move(job));
+  Dependencies chunks;
+  chunks.reserve(static_cast<std::size_t>(
+    std::max(0, (end - begin + grainSize - 1) / grainSize)
+  ));
+
+  for (int chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize) {
+    int chunkEnd = std::min(end, chunkBegin + grainSize);
+
+    chunks.push_back(schedule(
+      [rangeJob, chunkBegin, chunkEnd]() { (*rangeJob)(chunkBegin, chunkEnd); },
+      dependencies
+    ));
+  }
+
+  if (chunks.empty()) {
+    return schedule([]() {}, dependencies);
+  }
+
+  return schedule([]() {}, chunks);
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+  if (handle.isFinished()) {
+    return;
+  }
+
+#ifdef LUNA_STD_THREAD
+  bool isMainThread = std::this_thread::get_id() == mMainThreadId;
+  int workerIndex = getCurrentWorkerIndex();
+
+  while (!handle.isFinished()) {
+    if (isMainThread && executeMainThreadJob()) {
+      continue;
+    }
+
+    if (auto job = findJob(workerIndex)) {
+      execute(job);
+      continue;
+    }
+
+    mEvent.wait([&]() {
+      return handle.isFinished() || mQueuedJobCount > 0 ||
+             (isMainThread && mQueuedMainThreadJobCount > 0);
+    });
+  }
+#else
+  while (!handle.isFinished() && executeMainThreadJob()) {
+  }
+
+  if (!handle.isFinished()) {
+    logError("waiting for a job whose dependencies never finish");
+  }
+#endif
+}
+
+void JobSystem::executeMainThreadJobs() {
+#ifdef LUNA_STD_THREAD
+  int count = mQueuedMainThreadJobCount;
+#else
+  auto count = mMainThreadJobs.size();
+#endif
+
+  for (; count > 0 && executeMainThreadJob(); --count) {
+  }
+}
+
+void JobSystem::setMainThread() {
+#ifdef LUNA_STD_THREAD
+  mMainThreadId = std::this_thread::get_id();
+#endif
+}
+
+unsigned int JobSystem::getWorkerCount() const {
+#ifdef LUNA_STD_THREAD
+  return static_cast<unsigned int>(mWorkers.size());
+#else
+  return 0;
+#endif
+}
+
+JobHandle JobSystem::scheduleJob(
+  Job callback, const Dependencies& dependencies, bool mainThread
+) {
+  auto job = std::make_shared<Internal::Job>();
+  job->callback = std::move(callback);
+  job->mainThread = mainThread;
+
+  for (auto& dependency : dependencies) {
+    if (!dependency.mJob) {
+      continue;
+    }
+
+    ++job->pendingDependencies;
+
+    if (!addContinuation(dependency.mJob, job)) {
+      --job->pendingDependencies;
+    }
+  }
+
+  // release the reference held while scheduling
+  releaseDependency(job);
+
+  return JobHandle(job);
+}
+
+void JobSystem::releaseDependency(const JobPtr& job) {
+  if (--job->pendingDependencies == 0) {
+    enqueue(job);
+  }
+}
+
+void JobSystem::enqueue(JobPtr job) {
+#ifdef LUNA_STD_THREAD
+  // the counts are increased first, so they are never lower than the actual
+  // number of queued jobs
+  if (job->mainThread) {
+    ++mQueuedMainThreadJobCount;
+    std::lock_guard lock(mMainThreadMutex);
+    mMainThreadJobs.push_back(std::move(job));
+  } else {
+    int workerIndex = getCurrentWorkerIndex();
+    auto& queue = workerIndex >= 0
+                    ? *mQueues[static_cast<std::size_t>(workerIndex)]
+                    : mInjectionQueue;
+
+    ++mQueuedJobCount;
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+
+  mEvent.notify();
+#else
+  if (job->mainThread) {
+    mMainThreadJobs.push_back(std::move(job));
+  } else {
+    execute(job);
+  }
+#endif
+}
+
+void JobSystem::execute(const JobPtr& job) {
+  job->callback();
+
+  // free the captures right away, the handle may live much longer
+  job->callback = nullptr;
+
+  std::vector<JobPtr> continuations;
+
+  {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(job->mutex);
+#endif
+    job->finished = true;
+    std::swap(continuations, job->continuations);
+  }
+
+#ifdef LUNA_STD_THREAD
+  mEvent.notify();
+#endif
+
+  for (auto& continuation : continuations) {
+    releaseDependency(continuation);
+  }
+}
+
+bool JobSystem::executeMainThreadJob() {
+  JobPtr job;
+
+  {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(mMainThreadMutex);
+#endif
+
+    if (mMainThreadJobs.empty()) {
+      return false;
+    }
+
+    job = std::move(mMainThreadJobs.front());
+    mMainThreadJobs.pop_front();
+  }
+
+#ifdef LUNA_STD_THREAD
+  --mQueuedMainThreadJobCount;
+#endif
+
+  execute(job);
+
+  return true;
+}
+
+#ifdef LUNA_STD_THREAD
+void JobSystem::workerThread(int index) {
+  tJobSystem = this;
+  tWorkerIndex = index;
+  Logger::getInstance().setThreadIdentifier(fmt::format("Job {}", index + 1));
+
+  while (!mExitRequested) {
+    if (auto job = findJob(index)) {
+      execute(job);
+      continue;
+    }
+
+    mEvent.wait([this]() { return mExitRequested || mQueuedJobCount > 0; });
+  }
+}
+
+JobSystem::JobPtr JobSystem::findJob(int workerIndex) {
+  if (mQueuedJobCount <= 0) {
+    return nullptr;
+  }
+
+  auto take = [this](WorkerQueue& queue, bool newest) -> JobPtr {
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.jobs.empty()) {
+      return nullptr;
+    }
+
+    JobPtr job;
+
+    if (newest) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    } else {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+
+    --mQueuedJobCount;
+
+    return job;
+  };
+
+  // own jobs first, newest first since their data is likely still cached
+  if (workerIndex >= 0) {
+    if (auto job = take(*mQueues[static_cast<std::size_t>(workerIndex)], true)) {
+      return job;
+    }
+  }
+
+  if (auto job = take(mInjectionQueue, false)) {
+    return job;
+  }
+
+  // steal the oldest job of another worker
+  auto queueCount = static_cast<int>(mQueues.size());
+
+  for (int i = 1; i <= queueCount; ++i) {
+    auto victim = (std::max(workerIndex, 0) + i) % queueCount;
+
+    if (auto job = take(*mQueues[static_cast<std::size_t>(victim)], false)) {
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+int JobSystem::getCurrentWorkerIndex() const {
+  return tJobSystem == this ? tWorkerIndex : -1;
+}
+#endif
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <libluna/config.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef LUNA_STD_THREAD
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <libluna/Internal/EventCount.hpp>
+#endif
+
+namespace Luna {
+  namespace Internal {
+    struct Job;
+  }
+
+  /**
+   * @brief Reference to a job scheduled on the JobSystem.
+   *
+   * Handles are cheap to copy. They can be waited for and passed as
+   * dependencies to other jobs.
+   *
+   * @ingroup system
+   */
+  class JobHandle {
+    public:
+    JobHandle();
+    ~JobHandle();
+
+    /**
+     * @brief Check whether the handle refers to a job.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Check whether the job has been executed.
+     *
+     * An invalid handle is always finished.
+     */
+    bool isFinished() const;
+
+    private:
+    friend class JobSystem;
+
+    JobHandle(std::shared_ptr<Internal::Job> job);
+
+    std::shared_ptr<Internal::Job> mJob;
+  };
+
+  /**
+   * @brief Work-stealing thread pool for small, independent tasks.
+   *
+   * Each worker thread has its own queue. Jobs scheduled from a worker are
+   * pushed to and taken from the back of its queue, which keeps related data
+   * in the cache. Idle workers steal the oldest jobs from the front of the
+   * other queues. Threads waiting for a job help executing jobs instead of
+   * blocking.
+   *
+   * A job only starts after all of its dependencies have finished. Jobs
+   * scheduled with @ref scheduleOnMainThread() are executed by the main thread
+   * in @ref executeMainThreadJobs(), which the Application calls once per
+   * frame. This is the place to hand results of background work over to
+   * objects that are not thread-safe, such as the stage or a canvas.
+   *
+   * ```cpp
+   * auto jobs = Luna::JobSystem::getInstance();
+   *
+   * auto decode = jobs->schedule([&]() { decodeImage(file, texture); });
+   *
+   * jobs->scheduleOnMainThread(
+   *   [&]() { canvas->uploadTexture(1, &texture); }, {decode}
+   * );
+   * ```
+   *
+   * Without `LUNA_STD_THREAD` (e.g. on N64 and NDS), there are no worker
+   * threads: jobs are executed right away once their dependencies have
+   * finished, while main thread jobs still wait for
+   * @ref executeMainThreadJobs() or @ref wait().
+   *
+   * @ingroup system
+   */
+  class JobSystem {
+    public:
+    using Job = std::function<void()>;
+
+    /**
+     * @brief Job processing the range of indices [begin, end).
+     */
+    using RangeJob = std::function<void(int begin, int end)>;
+
+    using Dependencies = std::vector<JobHandle>;
+
+    /**
+     * @brief Get the job system shared by the engine and the application.
+     *
+     * It is created on first use with one worker per processor, except for
+     * one processor left to the main thread.
+     */
+    static JobSystem* getInstance();
+
+    /**
+     * @brief Create a job system with the given number of worker threads.
+     *
+     * @param workerCount 0 to choose the number of workers based on
+     * System::getProcessorCount().
+     */
+    explicit JobSystem(unsigned int workerCount = 0);
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem();
+
+    /**
+     * @brief Schedule a job for execution on any worker thread.
+     *
+     * Jobs must not throw exceptions.
+     */
+    JobHandle schedule(Job job, const Dependencies& dependencies = {});
+
+    /**
+     * @brief Schedule a job for execution on the main thread.
+     *
+     * @see executeMainThreadJobs()
+     */
+    JobHandle
+    scheduleOnMainThread(Job job, const Dependencies& dependencies = {});
+
+    /**
+     * @brief Split the range [begin, end) into chunks processed in parallel.
+     *
+     * @param grainSize Number of indices per chunk. If 0 or less, the range is
+     * split into a few chunks per worker.
+     *
+     * @return A handle that finishes once all chunks have finished.
+     */
+    JobHandle parallelFor(
+      int begin, int end, int grainSize, RangeJob job,
+      const Dependencies& dependencies = {}
+    );
+
+    /**
+     * @brief Block until the job has finished.
+     *
+     * The calling thread executes other jobs while waiting. If called from
+     * the main thread, this includes main thread jobs.
+     */
+    void wait(const JobHandle& handle);
+
+    /**
+     * @brief Execute the main thread jobs that are ready.
+     *
+     * Jobs that become ready while doing so are executed on the next call.
+     */
+    void executeMainThreadJobs();
+
+    /**
+     * @brief Make the calling thread the one executing main thread jobs.
+     *
+     * Defaults to the thread that created the job system. Application::run()
+     * calls this, so the shared instance doesn't depend on which thread used
+     * it first.
+     */
+    void setMainThread();
+
+    unsigned int getWorkerCount() const;
+
+    private:
+    using JobPtr = std::shared_ptr<Internal::Job>;
+
+    JobHandle scheduleJob(Job job, const Dependencies& dependencies, bool mainThread);
+    void enqueue(JobPtr job);
+    void execute(const JobPtr& job);
+    void releaseDependency(const JobPtr& job);
+    bool executeMainThreadJob();
+
+#ifdef LUNA_STD_THREAD
+    struct WorkerQueue {
+      std::mutex mutex;
+      std::deque<JobPtr> jobs;
+    };
+
+    void workerThread(int index);
+    JobPtr findJob(int workerIndex);
+    int getCurrentWorkerIndex() const;
+
+    std::vector<std::thread> mWorkers;
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+
+    /**
+     * @brief Jobs scheduled from threads other than the workers.
+     */
+    WorkerQueue mInjectionQueue;
+    std::atomic<int> mQueuedJobCount{0};
+
+    std::mutex mMainThreadMutex;
+    std::atomic<int> mQueuedMainThreadJobCount{0};
+    std::atomic<std::thread::id> mMainThreadId;
+
+    /**
+     * @brief Notified whenever a job is queued or has finished.
+     */
+    Internal::EventCount mEvent;
+    std::atomic<bool> mExitRequested{false};
+#endif
+
+    std::deque<JobPtr> mMainThreadJobs;
+  };
+} // namespace Luna
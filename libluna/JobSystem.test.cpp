@@ -0,0 +1,107 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <libluna/config.h>
+
+#ifdef LUNA_STD_THREAD
+#include <thread>
+#endif
+
+#include <libluna/JobSystem.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+int main(int, char**) {
+  TEST("schedule() and wait()", []() {
+    JobSystem jobs(2);
+    int value = 0;
+
+    auto handle = jobs.schedule([&]() { value = 42; });
+    jobs.wait(handle);
+
+    ASSERT(handle.isFinished(), "finished");
+    ASSERT_EQL(value, 42, "job executed");
+  });
+
+  TEST("jobs start after their dependencies", []() {
+    JobSystem jobs(2);
+    atomic<int> step{0};
+    int firstStep = -1;
+    int secondStep = -1;
+
+    auto first = jobs.schedule([&]() { firstStep = step++; });
+    auto second = jobs.schedule([&]() { secondStep = step++; }, {first});
+    jobs.wait(second);
+
+    ASSERT_EQL(firstStep, 0, "first job");
+    ASSERT_EQL(secondStep, 1, "second job");
+  });
+
+  TEST("parallelFor() covers the whole range", []() {
+    JobSystem jobs(3);
+    vector<int> values(1000, 0);
+
+    jobs.wait(jobs.parallelFor(0, 1000, 0, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        values[static_cast<size_t>(i)] += i;
+      }
+    }));
+
+    int sum = 0;
+
+    for (int value : values) {
+      sum += value;
+    }
+
+    ASSERT_EQL(sum, 999 * 1000 / 2, "sum");
+    ASSERT(jobs.parallelFor(5, 5, 1, [](int, int) {}).isValid(), "empty range");
+  });
+
+  TEST("main thread jobs", []() {
+    JobSystem jobs(2);
+    int value = 0;
+
+    auto background = jobs.schedule([&]() { value = 1; });
+    auto continuation =
+      jobs.scheduleOnMainThread([&]() { value *= 10; }, {background});
+
+    jobs.wait(background);
+    jobs.executeMainThreadJobs();
+    jobs.wait(continuation);
+
+    ASSERT_EQL(value, 10, "continuation executed");
+  });
+
+  TEST("setMainThread()", []() {
+    // created by another thread, like a job system first used by a worker
+    unique_ptr<JobSystem> jobs;
+#ifdef LUNA_STD_THREAD
+    thread([&]() { jobs = make_unique<JobSystem>(2); }).join();
+#else
+    jobs = make_unique<JobSystem>(2);
+#endif
+    jobs->setMainThread();
+
+    int value = 0;
+    auto handle = jobs->scheduleOnMainThread([&]() { value = 42; });
+    jobs->wait(handle);
+
+    ASSERT_EQL(value, 42, "executed while waiting");
+  });
+
+  TEST("getInstance()", []() {
+    auto jobs = JobSystem::getInstance();
+    atomic<int> count{0};
+
+    jobs->wait(jobs->parallelFor(0, 64, 1, [&](int begin, int end) {
+      count += end - begin;
+    }));
+
+    ASSERT_EQL(count.load(), 64, "chunks executed");
+  });
+
+  return runTests();
+}
@@ -0,0 +1,281 @@
+#include <libluna/Lz.hpp>
+
+#include <algorithm>
+#include <cstring> // memcpy
+
+using namespace Luna;
+
+namespace {
+  constexpr int kHashBits = 12;
+
+  uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+
+    return value;
+  }
+
+  uint32_t hash(uint32_t value) {
+    return (value * 2654435761u) >> (32 - kHashBits);
+  }
+
+  void writeLe(uint8_t* output, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+      output[i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+  }
+
+  /**
+   * @brief Write compressed data, failing instead of exceeding the capacity.
+   */
+  class BlockWriter {
+    public:
+    BlockWriter(uint8_t* output, std::size_t capacity)
+        : mBegin(output), mPosition(output), mEnd(output + capacity) {}
+
+    bool writeSequence(
+      const uint8_t* literals, std::size_t literalCount,
+      std::size_t matchLength, std::size_t distance
+    ) {
+      if (mPosition == mEnd) {
+        return false;
+      }
+
+      uint8_t* token = mPosition++;
+      auto matchNibble = matchLength == 0 ? 0 : matchLength - Lz::kMinMatch;
+
+      *token = static_cast<uint8_t>(
+        (std::min<std::size_t>(literalCount, 15) << 4) |
+        std::min<std::size_t>(matchNibble, 15)
+      );
+
+      if (literalCount >= 15 && !writeLength(literalCount - 15)) {
+        return false;
+      }
+
+      if (literalCount > static_cast<std::size_t>(mEnd - mPosition)) {
+        return false;
+      }
+
+      std::memcpy(mPosition, literals, literalCount);
+      mPosition += literalCount;
+
+      if (matchLength == 0) {
+        return true;
+      }
+
+      if (mEnd - mPosition < 2) {
+        return false;
+      }
+
+      *mPosition++ = static_cast<uint8_t>(distance);
+      *mPosition++ = static_cast<uint8_t>(distance >> 8);
+
+      return matchNibble < 15 || writeLength(matchNibble - 15);
+    }
+
+    std::size_t getSize() const {
+      return static_cast<std::size_t>(mPosition - mBegin);
+    }
+
+    private:
+    bool writeLength(std::size_t length) {
+      for (; length >= 255; length -= 255) {
+        if (mPosition == mEnd) {
+          return false;
+        }
+
+        *mPosition++ = 255;
+      }
+
+      if (mPosition == mEnd) {
+        return false;
+      }
+
+      *mPosition++ = static_cast<uint8_t>(length);
+
+      return true;
+    }
+
+    uint8_t* mBegin;
+    uint8_t* mPosition;
+    uint8_t* mEnd;
+  };
+
+  bool readLength(const uint8_t*& input, const uint8_t* end, std::size_t& length) {
+    uint8_t byte;
+
+    do {
+      if (input == end) {
+        return false;
+      }
+
+      byte = *input++;
+      length += byte;
+    } while (byte == 255);
+
+    return true;
+  }
+} // namespace
+
+std::size_t Lz::compressBlock(
+  const uint8_t* input, std::size_t inputSize, uint8_t* output,
+  std::size_t outputCapacity
+) {
+  BlockWriter writer(output, outputCapacity);
+
+  // positions of recent 4-byte sequences, verified before being used
+  std::vector<uint32_t> table(std::size_t(1) << kHashBits, 0);
+
+  std::size_t position = 0;
+  std::size_t anchor = 0;
+
+  while (position + kMinMatch <= inputSize) {
+    auto sequence = read32(input + position);
+    auto& entry = table[hash(sequence)];
+    std::size_t candidate = entry;
+    entry = static_cast<uint32_t>(position);
+
+    if (candidate >= position || position - candidate > kMaxDistance ||
+        read32(input + candidate) != sequence) {
+      // skip faster through data that doesn't compress
+      position += 1 + ((position - anchor) >> 6);
+      continue;
+    }
+
+    auto length = kMinMatch;
+
+    while (position + length < inputSize &&
+           input[candidate + length] == input[position + length]) {
+      ++length;
+    }
+
+    if (!writer.writeSequence(
+          input + anchor, position - anchor, length, position - candidate
+        )) {
+      return 0;
+    }
+
+    position += length;
+    anchor = position;
+  }
+
+  if (!writer.writeSequence(input + anchor, inputSize - anchor, 0, 0)) {
+    return 0;
+  }
+
+  return writer.getSize();
+}
+
+bool Lz::decompressBlock(
+  const uint8_t* input, std::size_t inputSize, uint8_t* output,
+  std::size_t outputSize
+) {
+  const uint8_t* inputEnd = input + inputSize;
+  uint8_t* position = output;
+  uint8_t* outputEnd = output + outputSize;
+
+  while (input < inputEnd) {
+    auto token = *input++;
+    std::size_t literalCount = token >> 4;
+
+    if (literalCount == 15 && !readLength(input, inputEnd, literalCount)) {
+      return false;
+    }
+
+    if (literalCount > static_cast<std::size_t>(inputEnd - input) ||
+        literalCount > static_cast<std::size_t>(outputEnd - position)) {
+      return false;
+    }
+
+    std::memcpy(position, input, literalCount);
+    input += literalCount;
+    position += literalCount;
+
+    if (input == inputEnd) {
+      // the last token has literals only
+      return position == outputEnd;
+    }
+
+    if (inputEnd - input < 2) {
+      return false;
+    }
+
+    auto distance = static_cast<std::size_t>(input[0] | (input[1] << 8));
+    input += 2;
+
+    std::size_t length = token & 15;
+
+    if (length == 15 && !readLength(input, inputEnd, length)) {
+      return false;
+    }
+
+    length += kMinMatch;
+
+    if (distance == 0 ||
+        distance > static_cast<std::size_t>(position - output) ||
+        length > static_cast<std::size_t>(outputEnd - position)) {
+      return false;
+    }
+
+    const uint8_t* match = position - distance;
+
+    if (distance >= length) {
+      std::memcpy(position, match, length);
+      position += length;
+    } else {
+      // overlapping matches repeat the last bytes
+      for (std::size_t i = 0; i < length; ++i) {
+        *position++ = *match++;
+      }
+    }
+  }
+
+  return false;
+}
+
+std::vector<uint8_t>
+Lz::compress(const uint8_t* data, std::size_t size, std::size_t blockSize) {
+  std::size_t blockCount = (size + blockSize - 1) / blockSize;
+
+  std::vector<uint8_t> output;
+
+  // reserving the worst case keeps the blocks from reallocating the output
+  output.reserve(
+    kHeaderSize + blockCount * 4 +
+    (blockCount == 0 ? 0 : (blockCount - 1) * getBlockBound(blockSize) +
+                             getBlockBound(size - (blockCount - 1) * blockSize))
+  );
+  output.resize(kHeaderSize + blockCount * 4);
+  std::memcpy(output.data(), kMagic, sizeof(kMagic));
+  writeLe(output.data() + 4, blockSize, 4);
+  writeLe(output.data() + 8, size, 8);
+
+  std::vector<uint8_t> block(getBlockBound(blockSize));
+
+  for (std::size_t i = 0; i < blockCount; ++i) {
+    auto blockData = data + i * blockSize;
+    auto blockLength = std::min(blockSize, size - i * blockSize);
+
+    // only keep blocks that got smaller
+    auto storedSize =
+      compressBlock(blockData, blockLength, block.data(), blockLength - 1);
+    uint32_t indexValue = static_cast<uint32_t>(storedSize);
+
+    const uint8_t* source = block.data();
+
+    if (storedSize == 0) {
+      source = blockData;
+      storedSize = blockLength;
+      indexValue = static_cast<uint32_t>(blockLength) | kStoredFlag;
+    }
+
+    auto offset = output.size();
+    output.resize(offset + storedSize);
+    std::memcpy(output.data() + offset, source, storedSize);
+
+    writeLe(output.data() + kHeaderSize + i * 4, indexValue, 4);
+  }
+
+  return output;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Fast LZ77 block compression in the style of LZ4.
+ *
+ * Data is split into blocks that are compressed independently, so they can
+ * be decompressed in parallel and in any order. A compressed stream is laid
+ * out as follows, all values being little-endian:
+ *
+ * | Part   | Contents                                                    |
+ * |--------|-------------------------------------------------------------|
+ * | Header | @ref kMagic, block size (4 bytes), uncompressed size (8)    |
+ * | Index  | stored size of each block (4 bytes), @ref kStoredFlag if raw |
+ * | Blocks | the blocks, one after another                               |
+ *
+ * A block is a sequence of tokens. The high nibble of a token is the number
+ * of literals following it, the low nibble is the match length minus
+ * @ref kMinMatch. A nibble of 15 is followed by bytes that are added to it,
+ * up to and including the first byte below 255. After the literals follow
+ * the distance of the match (2 bytes) and the extra match length bytes. The
+ * last token of a block has literals only.
+ *
+ * This code has no dependencies, so the packer tool can use it as well.
+ *
+ * @ingroup streams
+ */
+namespace Luna::Lz {
+  constexpr char kMagic[4] = {'L', 'L', 'Z', '1'};
+  constexpr std::size_t kHeaderSize = 16;
+  constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+  constexpr std::size_t kMinMatch = 4;
+  constexpr std::size_t kMaxDistance = 0xffff;
+
+  /**
+   * @brief Set in the index for blocks stored without compression.
+   */
+  constexpr uint32_t kStoredFlag = 0x80000000u;
+
+  /**
+   * @brief Get the largest possible size of a compressed block.
+   */
+  constexpr std::size_t getBlockBound(std::size_t size) {
+    return size + size / 255 + 16;
+  }
+
+  /**
+   * @brief Compress a single block.
+   *
+   * @return The compressed size or 0 if it would exceed @p outputCapacity.
+   */
+  std::size_t compressBlock(
+    const uint8_t* input, std::size_t inputSize, uint8_t* output,
+    std::size_t outputCapacity
+  );
+
+  /**
+   * @brief Decompress a single block.
+   *
+   * Corrupt input is detected and never causes reads or writes out of
+   * bounds.
+   *
+   * @return false unless exactly @p outputSize bytes were decompressed.
+   */
+  bool decompressBlock(
+    const uint8_t* input, std::size_t inputSize, uint8_t* output,
+    std::size_t outputSize
+  );
+
+  /**
+   * @brief Compress data into a stream of independent blocks.
+   *
+   * Blocks that don't get smaller are stored as they are.
+   */
+  std::vector<uint8_t> compress(
+    const uint8_t* data, std::size_t size,
+    std::size_t blockSize = kDefaultBlockSize
+  );
+} // namespace Luna::Lz
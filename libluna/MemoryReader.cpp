@@ -7,8 +7,10 @@
 
 using namespace Luna;
 
-MemoryReader::MemoryReader(void* address, std::size_t size)
-    : mAddress{address}, mSize{size} {}
+MemoryReader::MemoryReader(
+  void* address, std::size_t size, Endian::Endian endian
+)
+    : mAddress{address}, mSize{size}, mEndian{endian} {}
 
 MemoryReader::~MemoryReader() = default;
 
@@ -47,5 +49,9 @@ std::size_t MemoryReader::read(
 
   mPos += objectCount * objectSize;
 
+  if (mEndian != Endian::getEndian()) {
+    Endian::swapArray(buffer, objectSize, objectCount);
+  }
+
   return objectCount;
 }
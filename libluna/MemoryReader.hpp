@@ -1,11 +1,19 @@
 #pragma once
 
+#include <libluna/Endian.hpp>
 #include <libluna/InputStream.hpp>
 
 namespace Luna {
   class MemoryReader final : public InputStream {
     public:
-    MemoryReader(void* address, std::size_t size);
+    /**
+     * @param endian Endianness of the values read with an object size of 2, 4
+     * or 8 bytes. By default, values are read as they are in memory.
+     */
+    MemoryReader(
+      void* address, std::size_t size,
+      Endian::Endian endian = Endian::getEndian()
+    );
     ~MemoryReader();
 
     bool isValid() const override;
@@ -22,5 +30,6 @@ namespace Luna {
     void* mAddress;
     std::size_t mSize;
     std::size_t mPos{0};
+    Endian::Endian mEndian;
   };
 } // namespace Luna
@@ -17,3 +17,17 @@ std::vector<Vector3f>& Mesh::getNormals() { return mNormals; }
 std::vector<Vector3f>& Mesh::getTangents() { return mTangents; }
 
 std::vector<Vector3f>& Mesh::getBitangents() { return mBiTangents; }
+
+const std::vector<Vector3f>& Mesh::getVertices() const { return mVertices; }
+
+const std::vector<Mesh::Face>& Mesh::getFaces() const { return mFaces; }
+
+const std::vector<Vector2f>& Mesh::getTexCoords() const { return mTexCoords; }
+
+const std::vector<Vector3f>& Mesh::getNormals() const { return mNormals; }
+
+const std::vector<Vector3f>& Mesh::getTangents() const { return mTangents; }
+
+const std::vector<Vector3f>& Mesh::getBitangents() const {
+  return mBiTangents;
+}
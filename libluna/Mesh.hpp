@@ -23,6 +23,13 @@ namespace Luna {
     std::vector<Vector3f>& getTangents();
     std::vector<Vector3f>& getBitangents();
 
+    const std::vector<Vector3f>& getVertices() const;
+    const std::vector<Face>& getFaces() const;
+    const std::vector<Vector2f>& getTexCoords() const;
+    const std::vector<Vector3f>& getNormals() const;
+    const std::vector<Vector3f>& getTangents() const;
+    const std::vector<Vector3f>& getBitangents() const;
+
     private:
     std::vector<Vector3f> mVertices;
     std::vector<Face> mFaces;
@@ -0,0 +1,157 @@
+#include <libluna/ObjDecoder.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+
+namespace {
+  using VertexKey = std::array<int, 3>;
+
+  const char* skipSpaces(const char* cursor) {
+    while (*cursor == ' ' || *cursor == '\t') {
+      ++cursor;
+    }
+
+    return cursor;
+  }
+
+  template <std::size_t kCount>
+  std::array<float, kCount> parseFloats(const char* cursor) {
+    std::array<float, kCount> values{};
+
+    for (auto& value : values) {
+      char* end;
+      value = std::strtof(cursor, &end);
+      cursor = end;
+    }
+
+    return values;
+  }
+
+  /**
+   * @brief Resolve a 1-based or negative (relative) index into a 0-based one.
+   *
+   * @return -1 if the index is missing or out of range.
+   */
+  int resolveIndex(long index, std::size_t count) {
+    auto signedCount = static_cast<long>(count);
+    long resolved = index < 0 ? signedCount + index : index - 1;
+
+    return index == 0 || resolved < 0 || resolved >= signedCount
+             ? -1
+             : static_cast<int>(resolved);
+  }
+} // namespace
+
+bool Luna::decodeObj(const uint8_t* data, std::size_t size, Mesh& mesh) {
+  std::vector<Vector3f> positions;
+  std::vector<Vector2f> texCoords;
+  std::vector<Vector3f> normals;
+  std::map<VertexKey, uint32_t> vertexIndices;
+  Mesh result;
+
+  auto text = reinterpret_cast<const char*>(data);
+  auto end = text + size;
+  std::string line;
+  int lineNumber = 0;
+
+  while (text < end) {
+    auto lineEnd = static_cast<const char*>(
+      std::memchr(text, '\n', static_cast<std::size_t>(end - text))
+    );
+
+    if (!lineEnd) {
+      lineEnd = end;
+    }
+
+    // copied to have a null-terminated string for strtof()
+    line.assign(text, lineEnd);
+    text = lineEnd + 1;
+    ++lineNumber;
+
+    auto cursor = skipSpaces(line.c_str());
+
+    if (cursor[0] == 'v' && cursor[1] == ' ') {
+      auto values = parseFloats<3>(cursor + 2);
+      positions.push_back({values[0], values[1], values[2]});
+    } else if (cursor[0] == 'v' && cursor[1] == 't') {
+      auto values = parseFloats<2>(cursor + 2);
+      texCoords.push_back({values[0], values[1]});
+    } else if (cursor[0] == 'v' && cursor[1] == 'n') {
+      auto values = parseFloats<3>(cursor + 2);
+      normals.push_back({values[0], values[1], values[2]});
+    } else if (cursor[0] == 'f' && cursor[1] == ' ') {
+      std::vector<uint32_t> polygon;
+      cursor = skipSpaces(cursor + 2);
+
+      while (*cursor && *cursor != '\r' && *cursor != '#') {
+        VertexKey key{-1, -1, -1};
+        std::array<std::size_t, 3> counts{
+          positions.size(), texCoords.size(), normals.size()};
+
+        for (std::size_t i = 0; i < key.size(); ++i) {
+          char* next;
+          long index = std::strtol(cursor, &next, 10);
+          key[i] = next == cursor ? -1 : resolveIndex(index, counts[i]);
+          cursor = next;
+
+          if (*cursor != '/') {
+            break;
+          }
+
+          ++cursor;
+        }
+
+        if (key[0] < 0) {
+          logError("invalid face in OBJ file at line {}", lineNumber);
+          return false;
+        }
+
+        auto [it, inserted] = vertexIndices.try_emplace(
+          key, static_cast<uint32_t>(result.getVertices().size())
+        );
+
+        if (inserted) {
+          auto& position = positions[static_cast<std::size_t>(key[0])];
+          result.getVertices().push_back(position);
+          result.getTexCoords().push_back(
+            key[1] < 0 ? Vector2f{0, 0}
+                       : texCoords[static_cast<std::size_t>(key[1])]
+          );
+          result.getNormals().push_back(
+            key[2] < 0 ? Vector3f{0, 0, 0}
+                       : normals[static_cast<std::size_t>(key[2])]
+          );
+        }
+
+        polygon.push_back(it->second);
+        cursor = skipSpaces(cursor);
+      }
+
+      if (polygon.size() < 3) {
+        logError("face with less than 3 vertices at line {}", lineNumber);
+        return false;
+      }
+
+      // triangle fan, assuming convex polygons
+      for (std::size_t i = 2; i < polygon.size(); ++i) {
+        result.getFaces().push_back({polygon[0], polygon[i - 1], polygon[i]});
+      }
+    }
+  }
+
+  if (result.getFaces().empty()) {
+    logError("OBJ file contains no faces");
+    return false;
+  }
+
+  mesh = std::move(result);
+
+  return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#include <libluna/Mesh.hpp>
+
+namespace Luna {
+  /**
+   * @brief Decode a Wavefront OBJ file into a mesh.
+   *
+   * Supports vertex positions, texture coordinates, normals and polygonal
+   * faces, which are split into triangles. Each distinct combination of
+   * position, texture coordinate and normal becomes a vertex of the mesh, so
+   * all vertex attributes have the same number of elements. Missing
+   * attributes are zero. Groups, objects and materials are ignored.
+   *
+   * @return false and logs an error if the file is invalid. The mesh is left
+   * untouched in that case.
+   */
+  bool decodeObj(const uint8_t* data, std::size_t size, Mesh& mesh);
+} // namespace Luna
@@ -0,0 +1,150 @@
+#include <libluna/PackArchive.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+
+namespace {
+  uint64_t readLe(const uint8_t* data, int bytes) {
+    uint64_t value = 0;
+
+    for (int i = bytes - 1; i >= 0; --i) {
+      value = (value << 8) | data[i];
+    }
+
+    return value;
+  }
+
+  int compareEntry(
+    const PackArchive::Entry& entry, uint64_t hash, const std::string& name
+  ) {
+    if (entry.hash != hash) {
+      return entry.hash < hash ? -1 : 1;
+    }
+
+    auto length = std::min(entry.nameLength, name.size());
+    int result = std::memcmp(entry.name, name.data(), length);
+
+    if (result != 0 || entry.nameLength == name.size()) {
+      return result;
+    }
+
+    return entry.nameLength < name.size() ? -1 : 1;
+  }
+} // namespace
+
+PackArchive::PackArchive() = default;
+
+PackArchive::~PackArchive() = default;
+
+PackArchivePtr PackArchive::open(const Filesystem::Path& path) {
+  PackArchivePtr archive(new PackArchive());
+
+  try {
+    archive->mFile = Filesystem::MappedFileReader::make(path);
+  } catch (const std::exception& error) {
+    logError("could not open pack: {}", error.what());
+    return nullptr;
+  }
+
+  if (!archive->parse(archive->mFile->getData(), archive->mFile->getSize())) {
+    logError("invalid pack {}", path.getRawPath().c_str());
+    return nullptr;
+  }
+
+  return archive;
+}
+
+PackArchivePtr PackArchive::open(const uint8_t* data, std::size_t size) {
+  PackArchivePtr archive(new PackArchive());
+
+  if (!archive->parse(data, size)) {
+    logError("invalid pack");
+    return nullptr;
+  }
+
+  return archive;
+}
+
+const PackArchive::Entry* PackArchive::find(const char* name) const {
+  auto normalized = Pack::normalizeName(name);
+  auto hash = Pack::hashName(normalized.data(), normalized.size());
+
+  auto it = std::lower_bound(
+    mEntries.begin(), mEntries.end(), hash,
+    [&normalized](const Entry& entry, uint64_t value) {
+      return compareEntry(entry, value, normalized) < 0;
+    }
+  );
+
+  if (it == mEntries.end() || compareEntry(*it, hash, normalized) != 0) {
+    return nullptr;
+  }
+
+  return &*it;
+}
+
+const std::vector<PackArchive::Entry>& PackArchive::getEntries() const {
+  return mEntries;
+}
+
+bool PackArchive::parse(const uint8_t* data, std::size_t size) {
+  if (size < Pack::kHeaderSize ||
+      std::memcmp(data, Pack::kMagic, sizeof(Pack::kMagic)) != 0) {
+    return false;
+  }
+
+  auto version = readLe(data + 4, 4);
+
+  if (version != Pack::kVersion) {
+    logError("unsupported pack version {}", version);
+    return false;
+  }
+
+  auto entryCount = readLe(data + 8, 4);
+  auto indexOffset = readLe(data + 16, 8);
+  auto namesOffset = readLe(data + 24, 8);
+
+  if (indexOffset > size || namesOffset > size ||
+      entryCount > (size - indexOffset) / Pack::kEntrySize) {
+    return false;
+  }
+
+  mEntries.clear();
+  mEntries.reserve(static_cast<std::size_t>(entryCount));
+
+  for (std::size_t i = 0; i < entryCount; ++i) {
+    auto record = data + indexOffset + i * Pack::kEntrySize;
+    auto offset = readLe(record + 8, 8);
+    auto storedSize = readLe(record + 16, 8);
+    auto nameOffset = namesOffset + readLe(record + 32, 4);
+    auto nameLength = readLe(record + 36, 2);
+
+    if (offset > size || storedSize > size - offset || nameOffset > size ||
+        nameLength > size - nameOffset) {
+      return false;
+    }
+
+    Entry entry;
+    entry.hash = readLe(record, 8);
+    entry.data = data + offset;
+    entry.storedSize = static_cast<std::size_t>(storedSize);
+    entry.size = static_cast<std::size_t>(readLe(record + 24, 8));
+    entry.name = reinterpret_cast<const char*>(data + nameOffset);
+    entry.nameLength = static_cast<std::size_t>(nameLength);
+    entry.compression = static_cast<Pack::Compression>(readLe(record + 38, 2));
+
+    if (entry.compression == Pack::kUncompressed &&
+        entry.size != entry.storedSize) {
+      return false;
+    }
+
+    mEntries.push_back(entry);
+  }
+
+  return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <libluna/Filesystem/MappedFileReader.hpp>
+#include <libluna/Filesystem/Path.hpp>
+#include <libluna/PackFormat.hpp>
+
+namespace Luna {
+  class PackArchive;
+  using PackArchivePtr = std::shared_ptr<PackArchive>;
+
+  /**
+   * @brief Read-only access to the entries of an asset pack.
+   *
+   * The whole pack is mapped into memory once. Looking up an entry is a
+   * binary search on the hash index, and the contents of uncompressed entries
+   * are accessed in place.
+   *
+   * @see Pack for the file format and ResourceReader::mount() for serving
+   * assets from a pack.
+   *
+   * @ingroup streams
+   */
+  class PackArchive final {
+    public:
+    struct Entry {
+      uint64_t hash;
+      const uint8_t* data;
+      std::size_t storedSize;
+      std::size_t size;
+      const char* name;
+      std::size_t nameLength;
+      Pack::Compression compression;
+    };
+
+    /**
+     * @brief Open the pack at the given path.
+     *
+     * @return nullptr and logs an error if the file can't be opened or is not
+     * a valid pack.
+     */
+    static PackArchivePtr open(const Filesystem::Path& path);
+
+    /**
+     * @brief Open a pack that is already in memory.
+     *
+     * The data must stay valid as long as the archive exists.
+     */
+    static PackArchivePtr open(const uint8_t* data, std::size_t size);
+
+    ~PackArchive();
+
+    /**
+     * @brief Find an entry by its name.
+     *
+     * @return nullptr if there is no such entry.
+     */
+    const Entry* find(const char* name) const;
+
+    const std::vector<Entry>& getEntries() const;
+
+    private:
+    PackArchive();
+    bool parse(const uint8_t* data, std::size_t size);
+
+    Filesystem::MappedFileReaderPtr mFile;
+
+    /**
+     * @brief Entries sorted by hash and name.
+     */
+    std::vector<Entry> mEntries;
+  };
+} // namespace Luna
@@ -0,0 +1,100 @@
+#include <string>
+#include <vector>
+
+#include <libluna/PackArchive.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+static vector<uint8_t> bytes(const string& text) {
+  return vector<uint8_t>(text.begin(), text.end());
+}
+
+int main(int, char**) {
+  TEST("find entries", []() {
+    Pack::Builder builder;
+    builder.add("readme.txt", bytes("hello"));
+    builder.add("sprites/hero.bmp", vector<uint8_t>(5000, 7));
+    builder.add("./sounds\\jump.wav", bytes("jump"));
+    ASSERT(!builder.add("/readme.txt", bytes("duplicate")), "duplicate");
+
+    auto data = builder.build();
+    auto archive = PackArchive::open(data.data(), data.size());
+    ASSERT(archive != nullptr, "opened");
+    ASSERT_EQL(static_cast<int>(archive->getEntries().size()), 3, "entries");
+
+    auto readme = archive->find("readme.txt");
+    ASSERT(readme != nullptr, "found");
+    ASSERT_EQL(
+      string(reinterpret_cast<const char*>(readme->data), readme->size),
+      "hello", "contents"
+    );
+
+    auto jump = archive->find("sounds/jump.wav");
+    ASSERT(jump != nullptr, "normalized name");
+    ASSERT_EQL(static_cast<int>(jump->size), 4, "size");
+
+    auto hero = archive->find("./sprites/hero.bmp");
+    ASSERT(hero != nullptr, "found nested");
+    ASSERT_EQL(
+      static_cast<int>((hero->data - data.data()) % Pack::kPageAlignment), 0,
+      "page aligned"
+    );
+    ASSERT_EQL(
+      static_cast<int>((readme->data - data.data()) % Pack::kSmallAlignment),
+      0, "aligned"
+    );
+
+    ASSERT(archive->find("missing.txt") == nullptr, "missing");
+    ASSERT(archive->find("readme.tx") == nullptr, "prefix");
+  });
+
+  TEST("index is sorted by hash", []() {
+    Pack::Builder builder;
+
+    for (int i = 0; i < 100; ++i) {
+      builder.add("file" + to_string(i), bytes(to_string(i)));
+    }
+
+    auto data = builder.build();
+    auto archive = PackArchive::open(data.data(), data.size());
+    auto& entries = archive->getEntries();
+
+    for (size_t i = 1; i < entries.size(); ++i) {
+      ASSERT(entries[i - 1].hash <= entries[i].hash, "sorted");
+    }
+
+    auto entry = archive->find("file42");
+    ASSERT(entry != nullptr, "found");
+    ASSERT_EQL(
+      string(reinterpret_cast<const char*>(entry->data), entry->size), "42",
+      "contents"
+    );
+  });
+
+  TEST("reject invalid packs", []() {
+    auto data = bytes("this is not a pack file at all...");
+    ASSERT(PackArchive::open(data.data(), data.size()) == nullptr, "magic");
+
+    Pack::Builder builder;
+    builder.add("file", bytes("contents"));
+    auto truncated = builder.build();
+    truncated.resize(truncated.size() - 20);
+    ASSERT(
+      PackArchive::open(truncated.data(), truncated.size()) == nullptr,
+      "truncated"
+    );
+
+    // an uncompressed entry claiming to be larger than its stored data
+    auto oversized = builder.build();
+    auto indexOffset = oversized[16] | oversized[17] << 8;
+    oversized[static_cast<size_t>(indexOffset) + 24] = 0xff;
+    ASSERT(
+      PackArchive::open(oversized.data(), oversized.size()) == nullptr,
+      "size mismatch"
+    );
+  });
+
+  return runTests();
+}
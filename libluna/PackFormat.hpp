@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <libluna/Lz.hpp>
+
+/**
+ * @brief Layout of asset pack archives.
+ *
+ * A pack stores many asset files in a single file, so they can be served from
+ * one memory mapping instead of opening each file separately. All values are
+ * little-endian.
+ *
+ * | Part    | Contents                                               |
+ * |---------|--------------------------------------------------------|
+ * | Header  | @ref Header                                            |
+ * | Data    | entry contents, each aligned to 16 or 4096 bytes       |
+ * | Index   | @ref Header::entryCount @ref Entry records, 8-aligned  |
+ * | Names   | entry names without terminators, referred to by offset |
+ *
+ * The index is sorted by the FNV-1a hash of the entry names (and by name for
+ * equal hashes), so entries are found using a binary search. Entries of at
+ * least one page are page-aligned, so they can be mapped and shared by
+ * themselves.
+ *
+ * Entries compressed with @ref kLz are stored in the format of Lz::compress()
+ * and can be read using a DecompressingReader.
+ *
+ * This header only depends on Lz, so the packer tool can use it as well.
+ *
+ * @ingroup streams
+ */
+namespace Luna::Pack {
+  constexpr char kMagic[4] = {'L', 'P', 'A', 'K'};
+  constexpr uint32_t kVersion = 1;
+  constexpr std::size_t kHeaderSize = 32;
+  constexpr std::size_t kEntrySize = 40;
+  constexpr std::size_t kSmallAlignment = 16;
+  constexpr std::size_t kPageAlignment = 4096;
+
+  enum Compression : uint16_t {
+    kUncompressed = 0,
+
+    /**
+     * @brief Block compression, see Lz.
+     */
+    kLz = 1,
+  };
+
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+    uint64_t namesOffset;
+  };
+
+  struct Entry {
+    uint64_t hash;
+
+    /**
+     * @brief Position of the contents relative to the start of the pack.
+     */
+    uint64_t offset;
+
+    /**
+     * @brief Number of bytes stored in the pack.
+     */
+    uint64_t storedSize;
+
+    /**
+     * @brief Number of bytes after decompression.
+     */
+    uint64_t size;
+
+    /**
+     * @brief Position of the name relative to Header::namesOffset.
+     */
+    uint32_t nameOffset;
+    uint16_t nameLength;
+    uint16_t compression;
+  };
+
+  /**
+   * @brief Hash an entry name using 64-bit FNV-1a.
+   */
+  constexpr uint64_t hashName(const char* name, std::size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (std::size_t i = 0; i < length; ++i) {
+      hash ^= static_cast<uint8_t>(name[i]);
+      hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+  }
+
+  /**
+   * @brief Convert a path into the form used for entry names.
+   *
+   * Backslashes become slashes and leading `./` and `/` are removed.
+   */
+  inline std::string normalizeName(std::string name) {
+    std::replace(name.begin(), name.end(), '\\', '/');
+
+    std::size_t start = 0;
+
+    while (start < name.size()) {
+      if (name[start] == '/') {
+        ++start;
+      } else if (name.compare(start, 2, "./") == 0) {
+        start += 2;
+      } else {
+        break;
+      }
+    }
+
+    return name.substr(start);
+  }
+
+  inline bool entryLess(
+    uint64_t hash, const std::string& name, uint64_t otherHash,
+    const std::string& otherName
+  ) {
+    return hash != otherHash ? hash < otherHash : name < otherName;
+  }
+
+  /**
+   * @brief Assemble a pack in memory.
+   *
+   * ```cpp
+   * Luna::Pack::Builder builder;
+   * builder.add("sprites/hero.bmp", heroData);
+   * auto pack = builder.build();
+   * ```
+   */
+  class Builder {
+    public:
+    /**
+     * @brief Add a file to the pack.
+     *
+     * @param compression Compression to apply. Files that don't get smaller
+     * are stored uncompressed.
+     *
+     * @return false if an entry with the same name already exists.
+     */
+    bool add(
+      const std::string& name, std::vector<uint8_t> data,
+      Compression compression = kUncompressed
+    ) {
+      auto normalized = normalizeName(name);
+
+      for (auto& file : mFiles) {
+        if (file.name == normalized) {
+          return false;
+        }
+      }
+
+      File file{normalized, data.size(), kUncompressed, std::move(data)};
+
+      if (compression == kLz) {
+        auto compressed = Lz::compress(file.data.data(), file.data.size());
+
+        if (compressed.size() < file.data.size()) {
+          file.data = std::move(compressed);
+          file.compression = kLz;
+        }
+      }
+
+      mFiles.push_back(std::move(file));
+
+      return true;
+    }
+
+    std::size_t getFileCount() const { return mFiles.size(); }
+
+    std::vector<uint8_t> build() const {
+      std::vector<uint8_t> pack(kHeaderSize, 0);
+      std::vector<IndexEntry> index;
+      std::string names;
+
+      // the data is stored in the order the files were added, which keeps
+      // files that are used together close to each other
+      for (auto& file : mFiles) {
+        // compressed entries can't be mapped by themselves
+        auto alignment =
+          file.compression == kUncompressed && file.data.size() >= kPageAlignment
+            ? kPageAlignment
+            : kSmallAlignment;
+        pack.resize((pack.size() + alignment - 1) / alignment * alignment, 0);
+
+        IndexEntry entry;
+        entry.name = file.name;
+        entry.hash = hashName(file.name.data(), file.name.size());
+        entry.offset = pack.size();
+        entry.storedSize = file.data.size();
+        entry.size = file.size;
+        entry.compression = file.compression;
+        entry.nameOffset = names.size();
+        index.push_back(entry);
+
+        pack.insert(pack.end(), file.data.begin(), file.data.end());
+        names += file.name;
+      }
+
+      std::sort(
+        index.begin(), index.end(),
+        [](const IndexEntry& left, const IndexEntry& right) {
+          return entryLess(left.hash, left.name, right.hash, right.name);
+        }
+      );
+
+      pack.resize((pack.size() + 7) / 8 * 8, 0);
+      uint64_t indexOffset = pack.size();
+
+      for (auto& entry : index) {
+        write(pack, entry.hash, 8);
+        write(pack, entry.offset, 8);
+        write(pack, entry.storedSize, 8);
+        write(pack, entry.size, 8);
+        write(pack, entry.nameOffset, 4);
+        write(pack, entry.name.size(), 2);
+        write(pack, entry.compression, 2);
+      }
+
+      uint64_t namesOffset = pack.size();
+      pack.insert(pack.end(), names.begin(), names.end());
+
+      std::vector<uint8_t> header;
+      header.insert(header.end(), kMagic, kMagic + 4);
+      write(header, kVersion, 4);
+      write(header, index.size(), 4);
+      write(header, 0, 4);
+      write(header, indexOffset, 8);
+      write(header, namesOffset, 8);
+      std::copy(header.begin(), header.end(), pack.begin());
+
+      return pack;
+    }
+
+    private:
+    struct File {
+      std::string name;
+
+      /**
+       * @brief Size before compression.
+       */
+      std::size_t size;
+      Compression compression;
+
+      /**
+       * @brief Data as stored in the pack.
+       */
+      std::vector<uint8_t> data;
+    };
+
+    struct IndexEntry {
+      std::string name;
+      uint64_t hash;
+      uint64_t offset;
+      uint64_t storedSize;
+      uint64_t size;
+      uint64_t nameOffset;
+      Compression compression;
+    };
+
+    static void write(std::vector<uint8_t>& output, uint64_t value, int bytes) {
+      for (int i = 0; i < bytes; ++i) {
+        output.push_back(static_cast<uint8_t>(value >> (i * 8)));
+      }
+    }
+
+    std::vector<File> mFiles;
+  };
+} // namespace Luna::Pack
@@ -5,15 +5,20 @@ using namespace Luna;
 Palette::Palette(int bitsPerColor, int colorCount) {
   mBitsPerColor = bitsPerColor;
   mColorCount = colorCount;
-  mColors.resize(colorCount * bitsPerColor / 8);
+  mColors.resize(static_cast<std::size_t>(colorCount * bitsPerColor / 8));
 }
 
 Palette::~Palette() = default;
 
 PalettePtr Palette::make(int bitsPerColor, int colorCount) {
-  return std::make_shared<Palette>(bitsPerColor, colorCount);
+  // std::make_shared can not access the private constructor
+  return PalettePtr(new Palette(bitsPerColor, colorCount));
 }
 
+int Palette::getBitsPerColor() const { return mBitsPerColor; }
+
+int Palette::getColorCount() const { return mColorCount; }
+
 ColorRgb16* Palette::colorsRgb16() {
   return reinterpret_cast<ColorRgb16*>(mColors.data());
 }
@@ -25,3 +30,37 @@ ColorRgb24* Palette::colorsRgb24() {
 ColorRgb32* Palette::colorsRgb32() {
   return reinterpret_cast<ColorRgb32*>(mColors.data());
 }
+
+const ColorRgb16* Palette::colorsRgb16() const {
+  return reinterpret_cast<const ColorRgb16*>(mColors.data());
+}
+
+const ColorRgb24* Palette::colorsRgb24() const {
+  return reinterpret_cast<const ColorRgb24*>(mColors.data());
+}
+
+const ColorRgb32* Palette::colorsRgb32() const {
+  return reinterpret_cast<const ColorRgb32*>(mColors.data());
+}
+
+ColorRgb32 Palette::getColorRgb32(int index) const {
+  switch (mBitsPerColor) {
+  case 16: {
+    auto color = colorsRgb16()[index];
+    return ColorRgb32{
+      static_cast<uint8_t>((color.red << 3) | (color.red >> 2)),
+      static_cast<uint8_t>((color.green << 3) | (color.green >> 2)),
+      static_cast<uint8_t>((color.blue << 3) | (color.blue >> 2)),
+      static_cast<uint8_t>(color.alpha ? 255 : 0),
+    };
+  }
+  case 24: {
+    auto color = colorsRgb24()[index];
+    return ColorRgb32{color.red, color.green, color.blue, 255};
+  }
+  case 32:
+    return colorsRgb32()[index];
+  default:
+    return ColorRgb32{};
+  }
+}
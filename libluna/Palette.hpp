@@ -9,14 +9,26 @@ namespace Luna {
   class Palette;
   using PalettePtr = std::shared_ptr<Palette>;
 
+  /**
+   * @brief A list of colors referenced by indexed (4 or 8 bpp) textures.
+   *
+   * The colors are stored in one of the packed formats ColorRgb16, ColorRgb24
+   * or ColorRgb32, depending on the bits per color.
+   */
   class Palette {
     public:
     static PalettePtr make(int bitsPerColor, int colorCount);
     ~Palette();
 
+    int getBitsPerColor() const;
+    int getColorCount() const;
+
     ColorRgb16* colorsRgb16();
     ColorRgb24* colorsRgb24();
     ColorRgb32* colorsRgb32();
+    const ColorRgb16* colorsRgb16() const;
+    const ColorRgb24* colorsRgb24() const;
+    const ColorRgb32* colorsRgb32() const;
 
     inline ColorRgb16& rgb16At(int index) { return colorsRgb16()[index]; }
 
@@ -24,6 +36,12 @@ namespace Luna {
 
     inline ColorRgb32& rgb32At(int index) { return colorsRgb32()[index]; }
 
+    /**
+     * @brief Get the color at given index as RGBA32, regardless of the bits
+     * per color.
+     */
+    ColorRgb32 getColorRgb32(int index) const;
+
     private:
     Palette(int bitsPerColor, int colorCount);
     int mBitsPerColor;
@@ -0,0 +1,58 @@
+#include <libluna/Performance/PhaseTimer.hpp>
+
+#include <chrono>
+
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+using namespace Luna::Performance;
+
+PhaseTimer::Scope::Scope(PhaseTimer* timer, std::string name)
+    : mTimer(timer), mName(std::move(name)), mStart(Clock::now()) {}
+
+PhaseTimer::Scope::~Scope() {
+  mTimer->record(std::move(mName), mStart, Clock::now());
+}
+
+PhaseTimer::PhaseTimer() : mOrigin(Clock::now()) {}
+
+PhaseTimer::~PhaseTimer() = default;
+
+PhaseTimer::Scope PhaseTimer::measure(std::string name) {
+  return Scope(this, std::move(name));
+}
+
+void PhaseTimer::record(
+  std::string name, Clock::TimePoint start, Clock::TimePoint end
+) {
+  Phase phase{
+    std::move(name), Clock::timeSpan(mOrigin, start),
+    Clock::timeSpan(start, end)};
+
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  mPhases.push_back(std::move(phase));
+}
+
+std::vector<PhaseTimer::Phase> PhaseTimer::getPhases() const {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(mMutex);
+#endif
+
+  return mPhases;
+}
+
+double PhaseTimer::getElapsed() const {
+  return Clock::timeSpan(mOrigin, Clock::now());
+}
+
+void PhaseTimer::log(const char* title) const {
+  for (auto& phase : getPhases()) {
+    logInfo(
+      "{} phase {}: {:.2f}ms (started at {:.2f}ms)", title, phase.name,
+      phase.duration * std::milli::den, phase.start * std::milli::den
+    );
+  }
+}
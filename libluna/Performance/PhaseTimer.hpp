@@ -0,0 +1,107 @@
+#pragma once
+
+#include <libluna/config.h>
+
+#include <string>
+#include <vector>
+
+#ifdef LUNA_STD_THREAD
+#include <mutex>
+#endif
+
+#include <libluna/Clock.hpp>
+
+namespace Luna::Performance {
+  /**
+   * @brief Measure the named phases of a process, such as the startup.
+   *
+   * All times are relative to the creation of the timer, so phases running
+   * concurrently on other threads show up side by side.
+   *
+   * @par Example
+   * @code{.cpp}
+   * Luna::Performance::PhaseTimer timer;
+   *
+   * {
+   *   auto phase = timer.measure("load level");
+   *   loadLevel();
+   * }
+   *
+   * timer.log();
+   * @endcode
+   *
+   * @ingroup system
+   */
+  class PhaseTimer {
+    public:
+    struct Phase {
+      std::string name;
+
+      /**
+       * @brief Seconds between the creation of the timer and the start of the
+       * phase.
+       */
+      double start;
+
+      /**
+       * @brief Duration in seconds.
+       */
+      double duration;
+    };
+
+    /**
+     * @brief Record the phase when going out of scope.
+     */
+    class Scope {
+      public:
+      Scope(PhaseTimer* timer, std::string name);
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+      ~Scope();
+
+      private:
+      PhaseTimer* mTimer;
+      std::string mName;
+      Clock::TimePoint mStart;
+    };
+
+    PhaseTimer();
+    ~PhaseTimer();
+
+    /**
+     * @name Thread-safe
+     */
+    ///@{
+    /**
+     * @brief Measure the phase until the returned scope is destroyed.
+     */
+    Scope measure(std::string name);
+
+    void record(std::string name, Clock::TimePoint start, Clock::TimePoint end);
+
+    /**
+     * @brief Get the phases in the order they have finished.
+     */
+    std::vector<Phase> getPhases() const;
+
+    /**
+     * @brief Get the seconds elapsed since the creation of the timer.
+     */
+    double getElapsed() const;
+
+    /**
+     * @brief Write the phases to the log.
+     */
+    void log(const char* title) const;
+    ///@}
+
+    private:
+    Clock::TimePoint mOrigin;
+
+#ifdef LUNA_STD_THREAD
+    mutable std::mutex mMutex;
+#endif
+
+    std::vector<Phase> mPhases;
+  };
+} // namespace Luna::Performance
@@ -1,7 +1,7 @@
 #include <libluna/Performance/Ticker.hpp>
 
+#include <algorithm>
 #include <chrono>
-#include <deque>
 #include <map>
 
 #include <libluna/Clock.hpp>
@@ -9,8 +9,6 @@
 using namespace Luna::Performance;
 using Luna::String;
 
-static constexpr std::size_t kTicksPerQueue = 10;
-
 static std::map<String, Ticker&> gTickers;
 
 Ticker::Ticker(const String& pName) {
@@ -30,30 +28,25 @@ Ticker::~Ticker() {
 }
 
 void Ticker::tick() {
-  mTicks.emplace_back(Clock::now());
+  mTicks[mTickCount % kTicksPerQueue] = Clock::now();
   ++mTickCount;
-
-  if (mTicks.size() > kTicksPerQueue) {
-    mTicks.pop_front();
-  }
 }
 
 void Ticker::measure() {
-  if (mTicks.empty()) {
+  if (mTickCount == 0) {
     return;
   }
 
   auto now = Clock::now();
-  auto last = mTicks.back();
-  mTickTimes.push_back(now - last);
-
-  if (mTickTimes.size() > kTicksPerQueue) {
-    mTickTimes.pop_front();
-  }
+  auto last = mTicks[(mTickCount - 1) % kTicksPerQueue];
+  mTickTimes[mTickTimeCount % kTicksPerQueue] = now - last;
+  ++mTickTimeCount;
 }
 
 float Ticker::getTickDuration() const {
-  if (mTickTimes.size() == 0) {
+  auto count = std::min<std::size_t>(mTickTimeCount, kTicksPerQueue);
+
+  if (count == 0) {
     return 0.f;
   }
 
@@ -64,7 +57,8 @@ float Ticker::getTickDuration() const {
   long sum = 0;
 #endif
 
-  for (auto time : mTickTimes) {
+  for (std::size_t i = 0; i < count; ++i) {
+    auto time = mTickTimes[i];
 #ifdef N64
     sum += time;
 #else
@@ -76,44 +70,37 @@ float Ticker::getTickDuration() const {
   }
 
 #ifdef N64
-  return static_cast<float>(sum) / TICKS_PER_SECOND / static_cast<float>(mTickTimes.size());
+  return static_cast<float>(sum) / TICKS_PER_SECOND / static_cast<float>(count);
 #else
   return static_cast<float>(sum) / static_cast<float>(unit) /
-         static_cast<float>(mTickTimes.size());
+         static_cast<float>(count);
 #endif
 }
 
 float Ticker::getTicksPerSecond() const {
-  if (mTicks.size() < 2) {
+  auto count = std::min<std::size_t>(mTickCount, kTicksPerQueue);
+
+  if (count < 2) {
     // we can't calculate anything meaningful with < 2 entries
     return 0.f;
   }
 
-#ifdef N64
-  long long sum = 0;
-
-  // aggregate the deltas from a tick and following tick
-  for (std::size_t i = 0; i < mTicks.size() - 1; ++i) {
-    sum += mTicks[i + 1] - mTicks[i];
-  }
+  // the deltas between consecutive ticks add up to the span of all ticks
+  auto first = mTicks[(mTickCount - count) % kTicksPerQueue];
+  auto last = mTicks[(mTickCount - 1) % kTicksPerQueue];
 
-  auto averageDuration =
-    static_cast<float>(sum) / static_cast<float>(mTicks.size() - 1) / TICKS_PER_SECOND;
+#ifdef N64
+  auto averageDuration = static_cast<float>(last - first) /
+                         static_cast<float>(count - 1) / TICKS_PER_SECOND;
 #else
   auto unit = std::nano().den;
-  long sum = 0;
-
-  // aggregate the deltas from a tick and following tick
-  for (std::size_t i = 0; i < mTicks.size() - 1; ++i) {
-    auto diff = mTicks[i + 1] - mTicks[i];
-    sum += static_cast<long>(
-      diff.count() * unit * std::chrono::steady_clock::period().num /
-      std::chrono::steady_clock::period().den
-    );
-  }
+  auto sum = static_cast<long>(
+    (last - first).count() * unit * std::chrono::steady_clock::period().num /
+    std::chrono::steady_clock::period().den
+  );
 
   auto averageDuration = static_cast<float>(sum) / static_cast<float>(unit) /
-                         static_cast<float>(mTicks.size() - 1);
+                         static_cast<float>(count - 1);
 #endif
 
   return 1.f / averageDuration;
@@ -2,8 +2,8 @@
 
 #include <libluna/String.hpp>
 
+#include <array>
 #include <chrono>
-#include <deque>
 #include <map>
 
 #include <libluna/Clock.hpp>
@@ -12,6 +12,9 @@ namespace Luna::Performance {
   /**
    * @brief Measure average ticks per second and tick duration.
    *
+   * The last ticks are kept in fixed-size buffers, so ticking never allocates
+   * and can be done on the audio thread.
+   *
    * @ingroup system
    */
   class Ticker {
@@ -62,9 +65,19 @@ namespace Luna::Performance {
     static Ticker* getTickerByName(const String& name);
 
     private:
+    static constexpr std::size_t kTicksPerQueue = 10;
+
     unsigned long mTickCount = 0;
-    std::deque<Clock::TimePoint> mTicks;
-    std::deque<Clock::Duration> mTickTimes;
+    unsigned long mTickTimeCount = 0;
+
+    /**
+     * @brief Ring buffers of the last ticks and tick times.
+     */
+    ///@{
+    std::array<Clock::TimePoint, kTicksPerQueue> mTicks{};
+    std::array<Clock::Duration, kTicksPerQueue> mTickTimes{};
+    ///@}
+
     String mName;
   };
 } // namespace Luna::Performance
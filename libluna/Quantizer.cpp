@@ -0,0 +1,472 @@
+#include <libluna/config.h>
+
+#include <libluna/Quantizer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include <libluna/JobSystem.hpp>
+#include <libluna/Logger.hpp>
+
+using namespace Luna;
+
+namespace {
+  /**
+   * @brief A color in OKLab space with alpha as fourth component.
+   */
+  using LabColor = std::array<float, 4>;
+
+  struct HistogramEntry {
+    LabColor lab;
+    uint32_t rgba;
+    uint32_t count;
+  };
+
+  struct Box {
+    std::size_t begin;
+    std::size_t end;
+    double error;
+    int axis;
+  };
+
+  const std::array<int, 16> kBayer4x4 = {
+    0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5,
+  };
+
+  constexpr std::size_t kMappingCacheSize = 4096;
+
+  const std::array<float, 256>& getLinearTable() {
+    static std::array<float, 256> table = []() {
+      std::array<float, 256> result;
+
+      for (std::size_t i = 0; i < result.size(); ++i) {
+        float value = static_cast<float>(i) / 255.0f;
+        result[i] = value <= 0.04045f
+                      ? value / 12.92f
+                      : std::pow((value + 0.055f) / 1.055f, 2.4f);
+      }
+
+      return result;
+    }();
+
+    return table;
+  }
+
+  uint8_t linearToSrgb(float value) {
+    value = std::clamp(value, 0.0f, 1.0f);
+    value = value <= 0.0031308f
+              ? value * 12.92f
+              : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+
+    return static_cast<uint8_t>(std::lround(value * 255.0f));
+  }
+
+  inline uint32_t packRgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    // collapse all fully transparent pixels into a single color
+    if (a == 0) {
+      return 0;
+    }
+
+    return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) |
+           (static_cast<uint32_t>(b) << 16) | (static_cast<uint32_t>(a) << 24);
+  }
+
+  LabColor rgbaToLab(uint32_t rgba) {
+    auto& linear = getLinearTable();
+    float r = linear[rgba & 0xff];
+    float g = linear[(rgba >> 8) & 0xff];
+    float b = linear[(rgba >> 16) & 0xff];
+
+    float l = std::cbrt(0.4122214708f * r + 0.5363325363f * g + 0.0514459929f * b);
+    float m = std::cbrt(0.2119034982f * r + 0.6806995451f * g + 0.1073969566f * b);
+    float s = std::cbrt(0.0883024619f * r + 0.2817188376f * g + 0.6299787005f * b);
+
+    return LabColor{
+      0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s,
+      1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s,
+      0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s,
+      static_cast<float>(rgba >> 24) / 255.0f,
+    };
+  }
+
+  ColorRgb32 labToRgba(const LabColor& lab) {
+    float l = lab[0] + 0.3963377774f * lab[1] + 0.2158037573f * lab[2];
+    float m = lab[0] - 0.1055613458f * lab[1] - 0.0638541728f * lab[2];
+    float s = lab[0] - 0.0894841775f * lab[1] - 1.2914855480f * lab[2];
+    l = l * l * l;
+    m = m * m * m;
+    s = s * s * s;
+
+    return ColorRgb32{
+      linearToSrgb(4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s),
+      linearToSrgb(-1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s),
+      linearToSrgb(-0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s),
+      static_cast<uint8_t>(std::lround(std::clamp(lab[3], 0.0f, 1.0f) * 255.0f)),
+    };
+  }
+
+  inline float distanceSquared(const LabColor& a, const LabColor& b) {
+    float result = 0.0f;
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      float delta = a[i] - b[i];
+      result += delta * delta;
+    }
+
+    return result;
+  }
+
+  inline uint32_t readPixel(const Texture& texture, int x, int y) {
+    const uint8_t* data = texture.getData();
+
+    if (texture.getBitsPerPixel() == 32) {
+      auto pixel = data + (y * texture.getWidth() + x) * 4;
+
+      return packRgba(pixel[0], pixel[1], pixel[2], pixel[3]);
+    }
+
+    auto pixel = data + (y * texture.getWidth() + x) * 3;
+
+    return packRgba(pixel[0], pixel[1], pixel[2], 255);
+  }
+
+  /**
+   * @brief Run @p callback for every tile index, distributed over the job
+   * system.
+   */
+  template <typename Callback>
+  void forEachTile(int tileCount, const Callback& callback) {
+    auto jobs = JobSystem::getInstance();
+
+    jobs->wait(jobs->parallelFor(0, tileCount, 1, [&](int begin, int end) {
+      for (int tile = begin; tile < end; ++tile) {
+        callback(tile);
+      }
+    }));
+  }
+
+  int getTileCount(const Texture& texture, int tileHeight) {
+    tileHeight = std::max(1, tileHeight);
+
+    return (texture.getHeight() + tileHeight - 1) / tileHeight;
+  }
+
+  bool isSupportedSource(const Texture& texture) {
+    if (texture.getBitsPerPixel() != 24 && texture.getBitsPerPixel() != 32) {
+      logError(
+        "quantizer does not support {} bpp textures", texture.getBitsPerPixel()
+      );
+      return false;
+    }
+
+    return true;
+  }
+
+  void measureBox(std::vector<HistogramEntry>& entries, Box& box) {
+    double count = 0.0;
+    std::array<double, 4> sum{};
+    std::array<double, 4> sumSquared{};
+
+    for (std::size_t i = box.begin; i < box.end; ++i) {
+      auto& entry = entries[i];
+      double weight = entry.count;
+      count += weight;
+
+      for (std::size_t axis = 0; axis < 4; ++axis) {
+        sum[axis] += entry.lab[axis] * weight;
+        sumSquared[axis] += entry.lab[axis] * entry.lab[axis] * weight;
+      }
+    }
+
+    box.error = 0.0;
+    box.axis = 0;
+    double maxAxisError = -1.0;
+
+    for (std::size_t axis = 0; axis < 4; ++axis) {
+      double axisError = sumSquared[axis] - sum[axis] * sum[axis] / count;
+      box.error += axisError;
+
+      if (axisError > maxAxisError) {
+        maxAxisError = axisError;
+        box.axis = static_cast<int>(axis);
+      }
+    }
+
+    if (box.end - box.begin < 2) {
+      box.error = 0.0;
+    }
+  }
+
+  ColorRgb32
+  getBoxColor(const std::vector<HistogramEntry>& entries, const Box& box) {
+    if (box.end - box.begin == 1) {
+      uint32_t rgba = entries[box.begin].rgba;
+
+      return ColorRgb32{
+        static_cast<uint8_t>(rgba & 0xff),
+        static_cast<uint8_t>((rgba >> 8) & 0xff),
+        static_cast<uint8_t>((rgba >> 16) & 0xff),
+        static_cast<uint8_t>(rgba >> 24),
+      };
+    }
+
+    double count = 0.0;
+    std::array<double, 4> sum{};
+
+    for (std::size_t i = box.begin; i < box.end; ++i) {
+      count += entries[i].count;
+
+      for (std::size_t axis = 0; axis < 4; ++axis) {
+        sum[axis] += entries[i].lab[axis] * static_cast<double>(entries[i].count);
+      }
+    }
+
+    LabColor mean;
+
+    for (std::size_t axis = 0; axis < 4; ++axis) {
+      mean[axis] = static_cast<float>(sum[axis] / count);
+    }
+
+    return labToRgba(mean);
+  }
+} // namespace
+
+PalettePtr Quantizer::generatePalette(
+  const Texture& texture, int colorCount, int tileHeight
+) {
+  if (colorCount <= 0) {
+    logError("quantizer can not generate {} colors", colorCount);
+    return Palette::make(32, 0);
+  }
+
+  auto palette = Palette::make(32, colorCount);
+
+  if (!isSupportedSource(texture)) {
+    return palette;
+  }
+
+  tileHeight = std::max(1, tileHeight);
+  int tileCount = getTileCount(texture, tileHeight);
+  std::vector<std::unordered_map<uint32_t, uint32_t>> tileHistograms(
+    static_cast<std::size_t>(tileCount)
+  );
+
+  forEachTile(tileCount, [&](int tile) {
+    auto& histogram = tileHistograms[static_cast<std::size_t>(tile)];
+    int endY = std::min(texture.getHeight(), (tile + 1) * tileHeight);
+
+    for (int y = tile * tileHeight; y < endY; ++y) {
+      for (int x = 0; x < texture.getWidth(); ++x) {
+        ++histogram[readPixel(texture, x, y)];
+      }
+    }
+  });
+
+  std::unordered_map<uint32_t, uint32_t> histogram;
+
+  for (auto& tileHistogram : tileHistograms) {
+    for (auto& [rgba, count] : tileHistogram) {
+      histogram[rgba] += count;
+    }
+  }
+
+  std::vector<HistogramEntry> entries;
+  entries.reserve(histogram.size());
+
+  for (auto& [rgba, count] : histogram) {
+    entries.push_back({rgbaToLab(rgba), rgba, count});
+  }
+
+  if (entries.empty()) {
+    return palette;
+  }
+
+  std::vector<Box> boxes;
+  boxes.reserve(static_cast<std::size_t>(colorCount));
+  boxes.push_back({0, entries.size(), 0.0, 0});
+  measureBox(entries, boxes.back());
+
+  while (static_cast<int>(boxes.size()) < colorCount) {
+    auto box = std::max_element(
+      boxes.begin(), boxes.end(),
+      [](const Box& a, const Box& b) { return a.error < b.error; }
+    );
+
+    if (box->error <= 0.0) {
+      break;
+    }
+
+    auto axis = static_cast<std::size_t>(box->axis);
+    auto begin = entries.begin() + static_cast<std::ptrdiff_t>(box->begin);
+    auto end = entries.begin() + static_cast<std::ptrdiff_t>(box->end);
+    std::sort(begin, end, [axis](const HistogramEntry& a, const HistogramEntry& b) {
+      return a.lab[axis] < b.lab[axis];
+    });
+
+    uint64_t total = 0;
+
+    for (auto it = begin; it != end; ++it) {
+      total += it->count;
+    }
+
+    // split at the weighted median, keeping at least one entry on each side
+    uint64_t accumulated = 0;
+    std::size_t split = box->begin;
+
+    while (split < box->end - 1 && accumulated * 2 < total) {
+      accumulated += entries[split].count;
+      ++split;
+    }
+
+    split = std::clamp(split, box->begin + 1, box->end - 1);
+
+    Box upper{split, box->end, 0.0, 0};
+    box->end = split;
+    measureBox(entries, *box);
+    measureBox(entries, upper);
+    boxes.push_back(upper);
+  }
+
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    palette->rgb32At(static_cast<int>(i)) = getBoxColor(entries, boxes[i]);
+  }
+
+  for (auto i = static_cast<int>(boxes.size()); i < colorCount; ++i) {
+    palette->rgb32At(i) = ColorRgb32{0, 0, 0, 0};
+  }
+
+  return palette;
+}
+
+Texture Quantizer::applyPalette(
+  const Texture& texture, PalettePtr palette, const Options& options
+) {
+  if (!isSupportedSource(texture) || !palette) {
+    return Texture();
+  }
+
+  if (options.bitsPerPixel != 4 && options.bitsPerPixel != 8) {
+    logError("quantizer can not produce {} bpp textures", options.bitsPerPixel);
+    return Texture();
+  }
+
+  int colorCount = std::min(palette->getColorCount(), 1 << options.bitsPerPixel);
+
+  if (colorCount <= 0) {
+    logError("quantizer can not apply an empty palette");
+    return Texture();
+  }
+  std::vector<LabColor> paletteLab;
+  paletteLab.reserve(static_cast<std::size_t>(colorCount));
+
+  for (int i = 0; i < colorCount; ++i) {
+    auto color = palette->getColorRgb32(i);
+    paletteLab.push_back(
+      rgbaToLab(packRgba(color.red, color.green, color.blue, color.alpha))
+    );
+  }
+
+  float ditherSpread = options.dithering == kOrdered
+                         ? options.ditherStrength * 128.0f /
+                             std::cbrt(static_cast<float>(colorCount))
+                         : 0.0f;
+
+  int width = texture.getWidth();
+  int tileHeight = std::max(1, options.tileHeight);
+  int tileCount = getTileCount(texture, tileHeight);
+  std::vector<uint8_t> indices(
+    static_cast<std::size_t>(width) * static_cast<std::size_t>(texture.getHeight())
+  );
+
+  forEachTile(tileCount, [&](int tile) {
+    // direct mapped cache, most sprite sheets only use a few distinct colors;
+    // every color is a valid key, so empty slots are marked by their value
+    std::vector<uint32_t> cacheKeys(kMappingCacheSize, 0);
+    std::vector<int16_t> cacheValues(kMappingCacheSize, -1);
+    int endY = std::min(texture.getHeight(), (tile + 1) * tileHeight);
+
+    for (int y = tile * tileHeight; y < endY; ++y) {
+      for (int x = 0; x < width; ++x) {
+        uint32_t rgba = readPixel(texture, x, y);
+
+        if (ditherSpread > 0.0f && rgba != 0) {
+          auto bayerIndex = static_cast<std::size_t>((y & 3) * 4 + (x & 3));
+          float threshold =
+            (static_cast<float>(kBayer4x4[bayerIndex]) + 0.5f) / 16.0f - 0.5f;
+          int offset = static_cast<int>(std::lround(threshold * ditherSpread));
+          uint32_t dithered = rgba & 0xff000000;
+
+          for (int shift = 0; shift < 24; shift += 8) {
+            int channel = static_cast<int>((rgba >> shift) & 0xff) + offset;
+            dithered |= static_cast<uint32_t>(std::clamp(channel, 0, 255))
+                        << shift;
+          }
+
+          rgba = dithered;
+        }
+
+        std::size_t cacheIndex =
+          ((rgba * 2654435761u) >> 20) % kMappingCacheSize;
+        uint8_t index;
+
+        if (cacheValues[cacheIndex] >= 0 && cacheKeys[cacheIndex] == rgba) {
+          index = static_cast<uint8_t>(cacheValues[cacheIndex]);
+        } else {
+          auto lab = rgbaToLab(rgba);
+          float bestDistance = distanceSquared(lab, paletteLab[0]);
+          index = 0;
+
+          for (int i = 1; i < colorCount; ++i) {
+            float distance =
+              distanceSquared(lab, paletteLab[static_cast<std::size_t>(i)]);
+
+            if (distance < bestDistance) {
+              bestDistance = distance;
+              index = static_cast<uint8_t>(i);
+            }
+          }
+
+          cacheKeys[cacheIndex] = rgba;
+          cacheValues[cacheIndex] = index;
+        }
+
+        indices[static_cast<std::size_t>(y * width + x)] = index;
+      }
+    }
+  });
+
+  Texture result(options.bitsPerPixel, texture.getSize());
+  result.setPalette(palette);
+  result.setInterpolation(texture.isInterpolated());
+
+  if (options.bitsPerPixel == 8) {
+    std::copy(indices.begin(), indices.end(), result.getData());
+  } else {
+    for (int y = 0; y < texture.getHeight(); ++y) {
+      for (int x = 0; x < width; ++x) {
+        result.setNibbleAt(x, y, indices[static_cast<std::size_t>(y * width + x)]);
+      }
+    }
+  }
+
+  return result;
+}
+
+Texture Quantizer::quantize(const Texture& texture, const Options& options) {
+  if (options.bitsPerPixel != 4 && options.bitsPerPixel != 8) {
+    logError("quantizer can not produce {} bpp textures", options.bitsPerPixel);
+    return Texture();
+  }
+
+  if (!isSupportedSource(texture)) {
+    return Texture();
+  }
+
+  auto palette =
+    generatePalette(texture, 1 << options.bitsPerPixel, options.tileHeight);
+
+  return applyPalette(texture, palette, options);
+}
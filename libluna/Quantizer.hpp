@@ -0,0 +1,63 @@
+#pragma once
+
+#include <libluna/Palette.hpp>
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  /**
+   * @brief Convert true color textures into indexed textures.
+   *
+   * The palette is generated using median cut in the OKLab color space, which
+   * distributes the available colors according to perceived color differences
+   * rather than raw RGB distances. The alpha channel is treated as an
+   * additional axis, so semi-transparent pixels get their own palette entries.
+   *
+   * Both the histogram and the pixel mapping run in parallel over horizontal
+   * tiles of the image if threading is available.
+   *
+   * @ingroup colors
+   */
+  namespace Quantizer {
+    enum Dithering {
+      kNone,    ///< Map every pixel to its closest palette color.
+      kOrdered, ///< Apply a 4x4 Bayer matrix before mapping.
+    };
+
+    struct Options {
+      int bitsPerPixel{8}; ///< Either 4 (16 colors) or 8 (256 colors).
+      Dithering dithering{kNone};
+      float ditherStrength{1.0f}; ///< Scales the ordered dither offsets.
+      int tileHeight{64};         ///< Number of rows processed per task.
+    };
+
+    /**
+     * @brief Generate a palette with at most @p colorCount colors.
+     *
+     * The source texture must be 24 or 32 bpp. The returned palette is always
+     * RGBA32 and contains exactly @p colorCount entries; unused entries are
+     * transparent black.
+     */
+    PalettePtr
+    generatePalette(const Texture& texture, int colorCount, int tileHeight = 64);
+
+    /**
+     * @brief Map each pixel of a 24 or 32 bpp texture to the closest color of
+     * the given palette.
+     *
+     * The resulting texture has the given bits per pixel (4 or 8) and
+     * references @p palette.
+     */
+    Texture applyPalette(
+      const Texture& texture, PalettePtr palette, const Options& options = {}
+    );
+
+    /**
+     * @brief Generate a palette for the texture and map it to an indexed
+     * texture.
+     *
+     * Returns an empty texture if the source or target format is not
+     * supported.
+     */
+    Texture quantize(const Texture& texture, const Options& options = {});
+  } // namespace Quantizer
+} // namespace Luna
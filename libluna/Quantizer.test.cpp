@@ -0,0 +1,156 @@
+#include <libluna/Quantizer.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+namespace {
+  bool sameColor(ColorRgb32 a, ColorRgb32 b) {
+    return a.red == b.red && a.green == b.green && a.blue == b.blue &&
+           a.alpha == b.alpha;
+  }
+} // namespace
+
+int main(int, char**) {
+  TEST("few colors are kept exactly (4bpp)", []() {
+    auto texture = Texture(32, {4, 2});
+    ColorRgb32 red{255, 0, 0, 255};
+    ColorRgb32 blue{0, 0, 255, 255};
+    ColorRgb32 clear{0, 0, 0, 0};
+
+    for (int x = 0; x < 4; ++x) {
+      texture.rgb32At(x, 0) = x < 2 ? red : blue;
+      texture.rgb32At(x, 1) = clear;
+    }
+
+    Quantizer::Options options;
+    options.bitsPerPixel = 4;
+    auto indexed = Quantizer::quantize(texture, options);
+
+    ASSERT_EQL(indexed.getBitsPerPixel(), 4, "bits per pixel");
+    ASSERT(indexed.getPalette() != nullptr, "palette assigned");
+    ASSERT_EQL(indexed.getPalette()->getColorCount(), 16, "color count");
+
+    auto palette = indexed.getPalette();
+
+    for (int x = 0; x < 4; ++x) {
+      ASSERT(
+        sameColor(palette->getColorRgb32(indexed.getNibbleAt(x, 0)), x < 2 ? red : blue),
+        "opaque pixel " + to_string(x)
+      );
+      ASSERT_EQL(
+        palette->getColorRgb32(indexed.getNibbleAt(x, 1)).alpha, 0,
+        "transparent pixel " + to_string(x)
+      );
+    }
+  });
+
+  TEST("opaque white is kept", []() {
+    auto texture = Texture(32, {2, 1});
+    ColorRgb32 white{255, 255, 255, 255};
+    ColorRgb32 black{0, 0, 0, 255};
+    texture.rgb32At(0, 0) = white;
+    texture.rgb32At(1, 0) = black;
+
+    Quantizer::Options options;
+    options.bitsPerPixel = 4;
+    auto indexed = Quantizer::quantize(texture, options);
+    auto palette = indexed.getPalette();
+
+    ASSERT(
+      sameColor(palette->getColorRgb32(indexed.getNibbleAt(0, 0)), white),
+      "white pixel"
+    );
+    ASSERT(
+      sameColor(palette->getColorRgb32(indexed.getNibbleAt(1, 0)), black),
+      "black pixel"
+    );
+  });
+
+  TEST("gradient is approximated (8bpp)", []() {
+    auto texture = Texture(24, {128, 128});
+
+    for (int y = 0; y < 128; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        texture.rgb24At(x, y) = ColorRgb24{
+          static_cast<uint8_t>(x * 2), static_cast<uint8_t>(y * 2),
+          static_cast<uint8_t>(255 - x - y)};
+      }
+    }
+
+    auto indexed = Quantizer::quantize(texture);
+    ASSERT_EQL(indexed.getBitsPerPixel(), 8, "bits per pixel");
+    ASSERT_EQL(indexed.getWidth(), 128, "width");
+    ASSERT_EQL(indexed.getHeight(), 128, "height");
+
+    int totalError = 0;
+
+    for (int y = 0; y < 128; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        auto source = texture.rgb24At(x, y);
+        auto color = indexed.getPalette()->getColorRgb32(indexed.byteAt(x, y));
+        totalError += abs(source.red - color.red);
+        totalError += abs(source.green - color.green);
+        totalError += abs(source.blue - color.blue);
+      }
+    }
+
+    int averageError = totalError / (128 * 128 * 3);
+    ASSERT(averageError < 8, "average channel error " + to_string(averageError));
+  });
+
+  TEST("ordered dithering mixes neighbouring colors", []() {
+    auto texture = Texture(32, {8, 8});
+
+    for (int y = 0; y < 8; ++y) {
+      for (int x = 0; x < 8; ++x) {
+        texture.rgb32At(x, y) = ColorRgb32{128, 128, 128, 255};
+      }
+    }
+
+    auto palette = Palette::make(32, 16);
+    palette->rgb32At(0) = ColorRgb32{0, 0, 0, 255};
+    palette->rgb32At(1) = ColorRgb32{255, 255, 255, 255};
+
+    for (int i = 2; i < 16; ++i) {
+      palette->rgb32At(i) = ColorRgb32{255, 255, 255, 255};
+    }
+
+    Quantizer::Options options;
+    options.bitsPerPixel = 4;
+    options.dithering = Quantizer::kOrdered;
+    options.ditherStrength = 2.0f;
+    auto indexed = Quantizer::applyPalette(texture, palette, options);
+
+    int blackCount = 0;
+    int whiteCount = 0;
+
+    for (int y = 0; y < 8; ++y) {
+      for (int x = 0; x < 8; ++x) {
+        auto index = indexed.getNibbleAt(x, y);
+        blackCount += index == 0;
+        whiteCount += index == 1;
+      }
+    }
+
+    ASSERT(blackCount > 0, "contains black pixels");
+    ASSERT(whiteCount > 0, "contains white pixels");
+  });
+
+  TEST("unsupported source format", []() {
+    auto texture = Texture(8, {2, 2});
+    auto indexed = Quantizer::quantize(texture);
+    ASSERT_EQL(indexed.getWidth(), 0, "empty result");
+  });
+
+  TEST("no colors", []() {
+    auto texture = Texture(32, {2, 2});
+    auto palette = Quantizer::generatePalette(texture, -1);
+    ASSERT_EQL(palette->getColorCount(), 0, "empty palette");
+
+    auto indexed = Quantizer::applyPalette(texture, palette);
+    ASSERT_EQL(indexed.getWidth(), 0, "empty result");
+  });
+
+  return runTests();
+}
@@ -0,0 +1,157 @@
+#include <libluna/RenderSnapshot.hpp>
+
+#include <algorithm>
+
+using namespace Luna;
+
+namespace {
+  /**
+   * @brief Overwrite the element at @p index or append it.
+   *
+   * Assigning into existing elements keeps their storage (e.g. tile data),
+   * which avoids allocations if the stage did not grow.
+   */
+  template <typename T>
+  void assignAt(std::vector<T>& vector, std::size_t index, const T& value) {
+    if (index < vector.size()) {
+      vector[index] = value;
+    } else {
+      vector.push_back(value);
+    }
+  }
+
+  float getPriority(const Stage::Drawable2dVariant& drawable) {
+    if (auto sprite = std::get_if<Sprite>(&drawable)) {
+      return sprite->getPriority();
+    }
+
+    if (auto primitive = std::get_if<Primitive>(&drawable)) {
+      return primitive->getPriority();
+    }
+
+    if (auto text = std::get_if<Text>(&drawable)) {
+      return text->getPriority();
+    }
+
+    return 0.0f;
+  }
+
+  template <typename T> void truncate(std::vector<T>& vector, std::size_t size) {
+    vector.erase(
+      vector.begin() + static_cast<std::ptrdiff_t>(size), vector.end()
+    );
+  }
+} // namespace
+
+RenderSnapshot::RenderSnapshot() = default;
+
+RenderSnapshot::~RenderSnapshot() = default;
+
+void RenderSnapshot::capture(
+  ColorRgb backgroundColor, const Camera2d* camera2d, const Camera3d* camera3d,
+  float interpolationAlpha
+) {
+  mBackgroundColor = backgroundColor;
+  mHasCamera2d = camera2d != nullptr;
+  mHasCamera3d = camera3d != nullptr;
+
+  std::size_t drawableCount = 0;
+
+  if (camera2d) {
+    mCamera2d = *camera2d;
+    mCamera2d.setPosition(camera2d->getInterpolatedPosition(interpolationAlpha));
+
+    if (auto stage = camera2d->getStage()) {
+      sortDrawables2d(*stage);
+
+      for (auto&& sorted : mSortedDrawables2d) {
+        assignAt(mDrawables2d, drawableCount, *sorted.drawable);
+
+        if (interpolationAlpha < 1.0f) {
+          std::visit(
+            [interpolationAlpha](Drawable2d& copy) {
+              copy.setPosition(copy.getInterpolatedPosition(interpolationAlpha));
+            },
+            mDrawables2d[drawableCount]
+          );
+        }
+
+        ++drawableCount;
+      }
+    }
+  }
+
+  truncate(mDrawables2d, drawableCount);
+
+  std::size_t modelCount = 0;
+  std::size_t pointLightCount = 0;
+  mAmbientLight = AmbientLight();
+
+  if (camera3d) {
+    mCamera3d = *camera3d;
+
+    if (auto stage = camera3d->getStage()) {
+      for (auto&& model : stage->getDrawables3d()) {
+        assignAt(
+          mModels, modelCount++,
+          ModelInstance{
+            model->getMesh(), model->getTransform(), model->getMaterial()}
+        );
+      }
+
+      mAmbientLight = stage->getAmbientLight();
+
+      for (auto&& pointLight : stage->getPointLights()) {
+        assignAt(mPointLights, pointLightCount++, *pointLight);
+      }
+    }
+  }
+
+  truncate(mModels, modelCount);
+  truncate(mPointLights, pointLightCount);
+}
+
+ColorRgb RenderSnapshot::getBackgroundColor() const { return mBackgroundColor; }
+
+const Camera2d* RenderSnapshot::getCamera2d() const {
+  return mHasCamera2d ? &mCamera2d : nullptr;
+}
+
+const Camera3d* RenderSnapshot::getCamera3d() const {
+  return mHasCamera3d ? &mCamera3d : nullptr;
+}
+
+const std::vector<Stage::Drawable2dVariant>&
+RenderSnapshot::getDrawables2d() const {
+  return mDrawables2d;
+}
+
+const std::vector<RenderSnapshot::ModelInstance>&
+RenderSnapshot::getModels() const {
+  return mModels;
+}
+
+AmbientLight RenderSnapshot::getAmbientLight() const { return mAmbientLight; }
+
+const std::vector<PointLight>& RenderSnapshot::getPointLights() const {
+  return mPointLights;
+}
+
+void RenderSnapshot::sortDrawables2d(const Stage& stage) {
+  std::size_t order = 0;
+  mSortedDrawables2d.clear();
+
+  for (auto&& drawable : stage.getDrawables2d()) {
+    mSortedDrawables2d.push_back({getPriority(drawable), order++, &drawable});
+  }
+
+  // drawables of the same priority keep the order of
+  // Stage::getSortedDrawables2d(), the one added last first
+  std::sort(
+    mSortedDrawables2d.begin(), mSortedDrawables2d.end(),
+    [](const SortedDrawable2d& a, const SortedDrawable2d& b) {
+      return a.priority < b.priority ||
+             (a.priority == b.priority && a.order > b.order);
+    }
+  );
+}
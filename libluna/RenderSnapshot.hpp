@@ -0,0 +1,111 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <libluna/Camera2d.hpp>
+#include <libluna/Camera3d.hpp>
+#include <libluna/Color.hpp>
+#include <libluna/Light.hpp>
+#include <libluna/Material.hpp>
+#include <libluna/Matrix.hpp>
+#include <libluna/Mesh.hpp>
+#include <libluna/Stage.hpp>
+
+namespace Luna {
+  /**
+   * @brief Immutable copy of everything a renderer needs to draw one frame.
+   *
+   * The canvas captures a snapshot of its cameras and their stages on the main
+   * thread when a frame is submitted. The renderer only reads from the
+   * snapshot, so the application may already modify the stage for the next
+   * frame while the previous one is still being rendered.
+   *
+   * The drawables and transforms are copied by value. Resources they refer to
+   * (fonts, tilesets, shapes, meshes and uploaded textures) are not copied and
+   * must stay valid and unmodified while a frame using them is in flight.
+   *
+   * Snapshots are meant to be reused: capturing into an existing snapshot
+   * reuses its storage, so steady-state frames don't allocate.
+   *
+   * @ingroup canvas
+   */
+  class RenderSnapshot {
+    public:
+    /**
+     * @brief A 3D model as it was at the time of the capture.
+     */
+    struct ModelInstance {
+      std::shared_ptr<Mesh> mesh;
+      Matrix4x4 transform;
+      Material material;
+    };
+
+    RenderSnapshot();
+    ~RenderSnapshot();
+
+    /**
+     * @brief Copy the state of the given cameras and their stages.
+     *
+     * Either camera may be nullptr.
+     *
+     * @param interpolationAlpha Position between the previous and the current
+     * tick at which the 2D drawables and camera are captured, see
+     * Application::getInterpolationAlpha().
+     */
+    void capture(
+      ColorRgb backgroundColor, const Camera2d* camera2d,
+      const Camera3d* camera3d, float interpolationAlpha = 1.0f
+    );
+
+    ColorRgb getBackgroundColor() const;
+
+    /**
+     * @brief Get the 2D camera or nullptr if the canvas had none.
+     */
+    const Camera2d* getCamera2d() const;
+
+    /**
+     * @brief Get the 3D camera or nullptr if the canvas had none.
+     */
+    const Camera3d* getCamera3d() const;
+
+    /**
+     * @brief Get the 2D drawables, sorted by priority.
+     */
+    const std::vector<Stage::Drawable2dVariant>& getDrawables2d() const;
+
+    const std::vector<ModelInstance>& getModels() const;
+
+    AmbientLight getAmbientLight() const;
+
+    const std::vector<PointLight>& getPointLights() const;
+
+    private:
+    /**
+     * @brief Drawable of the stage with the key it is sorted by.
+     */
+    struct SortedDrawable2d {
+      float priority;
+      std::size_t order;
+      const Stage::Drawable2dVariant* drawable;
+    };
+
+    /**
+     * @brief Sort the drawables of @p stage by priority into
+     * mSortedDrawables2d, reusing its storage.
+     */
+    void sortDrawables2d(const Stage& stage);
+
+    ColorRgb mBackgroundColor;
+    Camera2d mCamera2d;
+    Camera3d mCamera3d;
+    bool mHasCamera2d{false};
+    bool mHasCamera3d{false};
+    std::vector<Stage::Drawable2dVariant> mDrawables2d;
+    std::vector<SortedDrawable2d> mSortedDrawables2d;
+    std::vector<ModelInstance> mModels;
+    AmbientLight mAmbientLight;
+    std::vector<PointLight> mPointLights;
+  };
+} // namespace Luna
@@ -0,0 +1,134 @@
+#include <libluna/Audio/AllocationGuard.hpp>
+#include <libluna/RenderSnapshot.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+int main(int, char**) {
+  TEST("capture() without cameras", []() {
+    RenderSnapshot snapshot;
+    snapshot.capture(ColorRgb{1.0f, 0.5f, 0.0f}, nullptr, nullptr);
+
+    ASSERT(snapshot.getCamera2d() == nullptr, "no 2D camera");
+    ASSERT(snapshot.getCamera3d() == nullptr, "no 3D camera");
+    ASSERT(snapshot.getDrawables2d().empty(), "no drawables");
+    ASSERT_EQL(snapshot.getBackgroundColor().green, 0.5f, "background color");
+  });
+
+  TEST("capture() sorts and copies 2D drawables", []() {
+    Stage stage;
+    Camera2d camera;
+    camera.setStage(&stage);
+    camera.setPosition({10, 20});
+
+    auto front = stage.allocSprite();
+    front->setPriority(2.0f);
+    front->setTexture(2);
+
+    auto back = stage.allocSprite();
+    back->setPriority(-1.0f);
+    back->setTexture(1);
+
+    RenderSnapshot snapshot;
+    snapshot.capture(ColorRgb{}, &camera, nullptr);
+
+    // modifying the stage must not affect the captured frame
+    front->setPosition({100, 100});
+    camera.setPosition({0, 0});
+
+    auto& drawables = snapshot.getDrawables2d();
+    ASSERT_EQL(static_cast<int>(drawables.size()), 2, "drawable count");
+    ASSERT_EQL(get<Sprite>(drawables[0]).getTexture(), 1, "back first");
+    ASSERT_EQL(get<Sprite>(drawables[1]).getTexture(), 2, "front last");
+    ASSERT_EQL(get<Sprite>(drawables[1]).getPosition().x, 0.0f, "old position");
+    ASSERT_EQL(snapshot.getCamera2d()->getPosition().y, 20.0f, "old camera");
+  });
+
+  TEST("capture() reuses the snapshot", []() {
+    Stage stage;
+    Camera2d camera;
+    camera.setStage(&stage);
+
+    auto first = stage.allocSprite();
+    stage.allocSprite();
+
+    RenderSnapshot snapshot;
+    snapshot.capture(ColorRgb{}, &camera, nullptr);
+    auto data = snapshot.getDrawables2d().data();
+
+    stage.freeSprite(first);
+    snapshot.capture(ColorRgb{}, &camera, nullptr);
+
+    ASSERT_EQL(
+      static_cast<int>(snapshot.getDrawables2d().size()), 1, "drawable count"
+    );
+    ASSERT(snapshot.getDrawables2d().data() == data, "same storage");
+
+    {
+      // steady-state frames don't allocate, not even for sorting
+      Audio::AllocationGuard guard;
+      snapshot.capture(ColorRgb{}, &camera, nullptr);
+    }
+  });
+
+  TEST("capture() interpolates 2D positions", []() {
+    Stage stage;
+    Camera2d camera;
+    camera.setStage(&stage);
+
+    auto sprite = stage.allocSprite();
+    sprite->setPosition({10, 0});
+
+    // a new drawable has no previous position yet
+    RenderSnapshot snapshot;
+    snapshot.capture(ColorRgb{}, &camera, nullptr, 0.25f);
+    ASSERT_EQL(
+      get<Sprite>(snapshot.getDrawables2d()[0]).getPosition().x, 10.0f,
+      "not interpolated"
+    );
+
+    stage.storePreviousPositions();
+    camera.storePreviousPosition();
+    sprite->setPosition({20, 0});
+    camera.setPosition({0, 8});
+
+    snapshot.capture(ColorRgb{}, &camera, nullptr, 0.25f);
+    ASSERT_EQL(
+      get<Sprite>(snapshot.getDrawables2d()[0]).getPosition().x, 12.5f,
+      "interpolated sprite"
+    );
+    ASSERT_EQL(
+      snapshot.getCamera2d()->getPosition().y, 2.0f, "interpolated camera"
+    );
+    ASSERT_EQL(sprite->getPosition().x, 20.0f, "stage not modified");
+  });
+
+  TEST("capture() copies 3D state", []() {
+    Stage stage;
+    Camera3d camera;
+    camera.setStage(&stage);
+
+    auto model = stage.allocModel();
+    model->getTransform() = Matrix4x4::identity().translate({1, 2, 3});
+
+    auto light = stage.makePointLight();
+    light->position = {4, 5, 6};
+
+    RenderSnapshot snapshot;
+    snapshot.capture(ColorRgb{}, nullptr, &camera);
+
+    light->position = {0, 0, 0};
+
+    ASSERT(snapshot.getCamera3d() != nullptr, "has 3D camera");
+    ASSERT_EQL(static_cast<int>(snapshot.getModels().size()), 1, "model count");
+    ASSERT_EQL(
+      static_cast<int>(snapshot.getPointLights().size()), 1, "light count"
+    );
+    ASSERT_EQL(snapshot.getPointLights()[0].position.y, 5.0f, "old light");
+
+    stage.freeModel(model);
+  });
+
+  return runTests();
+}
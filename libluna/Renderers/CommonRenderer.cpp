@@ -1,5 +1,6 @@
 #include <libluna/config.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 #ifdef LUNA_WINDOW_SDL2
@@ -37,7 +38,9 @@ CommonRenderer::~CommonRenderer() {
   // todo
 }
 
-void CommonRenderer::render() {
+void CommonRenderer::render(const RenderSnapshot& snapshot) {
+  mSnapshot = &snapshot;
+
   startRender();
   imguiNewFrame();
 
@@ -46,8 +49,7 @@ void CommonRenderer::render() {
 
   auto canvas = getCanvas();
 
-  auto bgColor = canvas->getBackgroundColor();
-  clearBackground(bgColor);
+  clearBackground(snapshot.getBackgroundColor());
 
   renderWorld(canvas);
 
@@ -67,8 +69,12 @@ void CommonRenderer::render() {
   end2dFramebuffer(canvas);
 #endif
   endRender();
+
+  mSnapshot = nullptr;
 }
 
+const RenderSnapshot& CommonRenderer::getSnapshot() const { return *mSnapshot; }
+
 void CommonRenderer::declareGpuTexture(
   int slot, GpuTexture& texture
 ) {
@@ -101,6 +107,37 @@ CommonRenderer::GpuTexture* CommonRenderer::getGpuTexture(int slot) {
   return &mGpuTextureSlotMapping.at(slot);
 }
 
+CommonRenderer::GpuTexture* CommonRenderer::getGpuTextureForRegion(
+  int slot, const Recti& rect, const TextureView& data
+) {
+  auto gpuTexture = getGpuTexture(slot);
+
+  if (!gpuTexture) {
+    logWarn("no texture uploaded at slot {}", slot);
+    return nullptr;
+  }
+
+  if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 ||
+      rect.x + rect.width > gpuTexture->size.width ||
+      rect.y + rect.height > gpuTexture->size.height) {
+    logWarn(
+      "region {}x{}+{}+{} exceeds texture at slot {}", rect.width, rect.height,
+      rect.x, rect.y, slot
+    );
+    return nullptr;
+  }
+
+  if (data.getWidth() < rect.width || data.getHeight() < rect.height) {
+    logWarn(
+      "region data {}x{} is smaller than region {}x{}", data.getWidth(),
+      data.getHeight(), rect.width, rect.height
+    );
+    return nullptr;
+  }
+
+  return gpuTexture;
+}
+
 void CommonRenderer::freeGpuTexture(int slot) {
   if (mGpuTextureSlotMapping.find(slot) == mGpuTextureSlotMapping.end()) {
     return;
@@ -238,19 +275,37 @@ Vector2i CommonRenderer::getTextureSize(int slot) const {
   return mGpuTextureSlotMapping.at(slot).size;
 }
 
-void CommonRenderer::renderWorld(Canvas* canvas) {
-  auto stage = canvas->getCamera3d()->getStage();
+void CommonRenderer::makePaletteLut(
+  const Palette* palette, int bitsPerPixel, PaletteLut& lut
+) {
+  lut.fill(ColorRgb32{0, 0, 0, 0});
+
+  if (!palette) {
+    int colorCount = 1 << bitsPerPixel;
+    int step = 255 / (colorCount - 1);
+
+    for (int i = 0; i < colorCount; ++i) {
+      auto value = static_cast<uint8_t>(i * step);
+      lut[static_cast<std::size_t>(i)] = ColorRgb32{value, value, value, 255};
+    }
 
-  if (!stage) {
     return;
   }
 
-  for (auto&& model : stage->getDrawables3d()) {
+  int colorCount = std::min(palette->getColorCount(), static_cast<int>(lut.size()));
+
+  for (int i = 0; i < colorCount; ++i) {
+    lut[static_cast<std::size_t>(i)] = palette->getColorRgb32(i);
+  }
+}
+
+void CommonRenderer::renderWorld(Canvas* canvas) {
+  for (auto&& model : mSnapshot->getModels()) {
     RenderMeshInfo info;
-    info.meshId = mKnownMeshes.at(model->getMesh());
-    info.transform = model->getTransform();
+    info.meshId = mKnownMeshes.at(model.mesh);
+    info.transform = model.transform;
 
-    auto material = model->getMaterial();
+    auto& material = model.material;
 
     int diffuseTextureSlot = material.getDiffuseTexture();
     if (diffuseTextureSlot != 0 && mGpuTextureSlotMapping.find(diffuseTextureSlot) != mGpuTextureSlotMapping.end()) {
@@ -271,13 +326,15 @@ void CommonRenderer::renderWorld(Canvas* canvas) {
 void CommonRenderer::render2d(
   Canvas* canvas, [[maybe_unused]] Vector2i renderSize
 ) {
-  auto stage = canvas->getCamera2d()->getStage();
+  auto camera = mSnapshot->getCamera2d();
 
-  if (!stage) {
+  if (!camera) {
     return;
   }
 
-  for (auto&& drawable : stage->getSortedDrawables2d()) {
+  auto cameraPosition = camera->getPosition();
+
+  for (auto&& drawable : mSnapshot->getDrawables2d()) {
     std::visit(
       overloaded{
         [](auto) {},
@@ -300,7 +357,7 @@ void CommonRenderer::render2d(
             info.textureId = gpuTexture.id;
             info.size = gpuTexture.size;
             info.position =
-              sprite.getPosition() - canvas->getCamera2d()->getPosition();
+              sprite.getPosition() - cameraPosition;
             renderTexture(canvas, &info);
           } else if (!gpuTexture.subTextures.empty()) {
             for (auto& subTexture : gpuTexture.subTextures) {
@@ -316,7 +373,7 @@ void CommonRenderer::render2d(
               // info.crop = subTexture.crop;
               info.size = {subTexture.crop.width, subTexture.crop.height};
               info.position =
-                offset + sprite.getPosition() - canvas->getCamera2d()->getPosition();
+                offset + sprite.getPosition() - cameraPosition;
               renderTexture(canvas, &info);
             }
           }
@@ -420,7 +477,7 @@ void CommonRenderer::render2d(
             x += text.getSize() * static_cast<float>(glyph->advance);
           }
         }},
-      *drawable
+      drawable
     );
   }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <forward_list>
 #include <map>
 #include <set>
@@ -103,10 +104,24 @@ namespace Luna {
       Matrix4x4 transform;
     };
 
+    /**
+     * @brief Lookup table from color index to RGBA32 color.
+     */
+    using PaletteLut = std::array<ColorRgb32, 256>;
+
     CommonRenderer();
     virtual ~CommonRenderer() override;
 
-    void render() override;
+    /**
+     * @brief Fill a lookup table for an indexed texture.
+     *
+     * Without a palette, a grayscale ramp matching the bits per pixel is used.
+     * Entries not covered by the palette are transparent black.
+     */
+    static void
+    makePaletteLut(const Palette* palette, int bitsPerPixel, PaletteLut& lut);
+
+    void render(const RenderSnapshot& snapshot) override;
 
     /**
      * @brief Declare a texture in the GPU texture mapping.
@@ -125,6 +140,17 @@ namespace Luna {
 
     GpuTexture* getGpuTexture(int slot);
 
+    /**
+     * @brief Get the GPU texture a region update applies to.
+     *
+     * This should be called by implementations of @ref updateTextureRegion().
+     *
+     * @return nullptr (and log a warning) if there is no texture at the slot,
+     * the region is out of bounds or the data is smaller than the region.
+     */
+    GpuTexture*
+    getGpuTextureForRegion(int slot, const Recti& rect, const TextureView& data);
+
     /**
      * @brief Free the GPU texture mapping for the given slot.
      *
@@ -222,6 +248,14 @@ namespace Luna {
 
     Vector2i getTextureSize(int slot) const;
 
+    protected:
+    /**
+     * @brief Get the snapshot of the frame currently being rendered.
+     *
+     * Only valid during @ref render().
+     */
+    const RenderSnapshot& getSnapshot() const;
+
     private:
     /**
      * @brief Render all 3D mesh on the canvas.
@@ -244,6 +278,7 @@ namespace Luna {
 
     IdAllocator<uint16_t> mTextureIdAllocator;
     uint16_t mRenderTargetId;
+    const RenderSnapshot* mSnapshot{nullptr};
     Vector2i mCurrentRenderSize;
     std::map<int, GpuTexture> mGpuTextureSlotMapping;
     std::unordered_map<Shape*, int> mKnownShapes;
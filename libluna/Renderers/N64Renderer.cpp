@@ -10,6 +10,7 @@
 #include <rspq_profile.h>
 
 #include <libluna/Canvas.hpp>
+#include <libluna/Logger.hpp>
 #include <libluna/Math.hpp>
 #include <libluna/Renderers/N64Renderer.hpp>
 
@@ -18,43 +19,46 @@ using namespace Luna;
 constexpr int kTmemSize = 4096;
 
 namespace {
-  void uploadTextureData(GLuint textureId, const Texture* texture) {
+  void uploadTextureData(GLuint textureId, const TextureView& texture) {
     GLenum inputFormat = GL_RGBA;
     GLenum inputType = GL_UNSIGNED_SHORT_5_5_5_1_EXT;
     GLenum internalFormat = GL_RGB5_A1;
 
-    if (texture->getBitsPerPixel() == 24) {
+    if (texture.getBitsPerPixel() == 24) {
       inputFormat = GL_RGB;
       inputType = GL_UNSIGNED_BYTE;
-    } else if (texture->getBitsPerPixel() == 32) {
+    } else if (texture.getBitsPerPixel() == 32) {
       inputType = GL_UNSIGNED_INT_8_8_8_8_EXT;
       internalFormat = GL_RGBA;
     }
 
     glBindTexture(GL_TEXTURE_2D, textureId);
     // note: on N64, a texture size that's not a power of 2, must be clamped
-    if (!Math::isPowerOfTwo(texture->getWidth())) {
+    if (!Math::isPowerOfTwo(texture.getWidth())) {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
     }
 
-    if (!Math::isPowerOfTwo(texture->getHeight())) {
+    if (!Math::isPowerOfTwo(texture.getHeight())) {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
     }
 
+    // slices of larger textures are read in place
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, texture.getRowLength());
     glTexImage2D(
       GL_TEXTURE_2D, 0,                         /* mipmap level */
       internalFormat,                           /* internal format */
-      texture->getWidth(), texture->getHeight(), 0, /* format (legacy) */
+      texture.getWidth(), texture.getHeight(), 0, /* format (legacy) */
       inputFormat,                              /* input format */
-      inputType, texture->getData()
+      inputType, texture.getData()
     );
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     glTexParameteri(
       GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-      texture->isInterpolated() ? GL_LINEAR : GL_NEAREST
+      texture.isInterpolated() ? GL_LINEAR : GL_NEAREST
     );
     glTexParameteri(
       GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-      texture->isInterpolated() ? GL_LINEAR : GL_NEAREST
+      texture.isInterpolated() ? GL_LINEAR : GL_NEAREST
     );
   }
 }
@@ -142,17 +146,17 @@ void N64Renderer::freeTexture(int slot) {
   freeGpuTexture(slot);
 }
 
-void N64Renderer::uploadTexture(int slot, const Texture* texture) {
+void N64Renderer::uploadTexture(int slot, const TextureView& texture) {
   freeTexture(slot);
 
   GpuTexture gpuTexture;
-  gpuTexture.size = texture->getSize();
+  gpuTexture.size = texture.getSize();
 
-  if (texture->getByteCount() > kTmemSize) {
-    if (texture->getHeight() <= 64) {
+  if (texture.getByteCount() > kTmemSize) {
+    if (texture.getHeight() <= 64) {
       // sub textures from left to right
-      int sliceMaxWidth = kTmemSize / (texture->getBitsPerPixel() / 8) / texture->getHeight();
-      int sliceCount = (texture->getWidth() + sliceMaxWidth - 1) / sliceMaxWidth;
+      int sliceMaxWidth = kTmemSize / (texture.getBitsPerPixel() / 8) / texture.getHeight();
+      int sliceCount = (texture.getWidth() + sliceMaxWidth - 1) / sliceMaxWidth;
 
       gpuTexture.subTextures.reserve(sliceCount);
 
@@ -161,15 +165,15 @@ void N64Renderer::uploadTexture(int slot, const Texture* texture) {
           0,
           Recti(
             i * sliceMaxWidth, 0,
-            std::min(sliceMaxWidth, texture->getWidth() - i * sliceMaxWidth),
-            texture->getHeight()
+            std::min(sliceMaxWidth, texture.getWidth() - i * sliceMaxWidth),
+            texture.getHeight()
           )
         });
       }
-    } else if (texture->getWidth() <= 64) {
+    } else if (texture.getWidth() <= 64) {
       // sub textures from top to bottom
-      int sliceMaxHeight = kTmemSize / (texture->getBitsPerPixel() / 8) / texture->getWidth();
-      int sliceCount = (texture->getHeight() + sliceMaxHeight - 1) / sliceMaxHeight;
+      int sliceMaxHeight = kTmemSize / (texture.getBitsPerPixel() / 8) / texture.getWidth();
+      int sliceCount = (texture.getHeight() + sliceMaxHeight - 1) / sliceMaxHeight;
 
       gpuTexture.subTextures.reserve(sliceCount);
 
@@ -177,17 +181,17 @@ void N64Renderer::uploadTexture(int slot, const Texture* texture) {
         gpuTexture.subTextures.push_back({
           0,
           Recti(
-            0, i * sliceMaxHeight, texture->getWidth(),
-            std::min(sliceMaxHeight, texture->getHeight() - i * sliceMaxHeight)
+            0, i * sliceMaxHeight, texture.getWidth(),
+            std::min(sliceMaxHeight, texture.getHeight() - i * sliceMaxHeight)
           )
         });
       }
     } else {
       // grid of sub textures
       int sliceMaxWidth = 64;
-      int sliceMaxHeight = kTmemSize / (texture->getBitsPerPixel() / 8) / sliceMaxWidth;
-      int sliceCountX = (texture->getWidth() + sliceMaxWidth - 1) / sliceMaxWidth;
-      int sliceCountY = (texture->getHeight() + sliceMaxHeight - 1) / sliceMaxHeight;
+      int sliceMaxHeight = kTmemSize / (texture.getBitsPerPixel() / 8) / sliceMaxWidth;
+      int sliceCountX = (texture.getWidth() + sliceMaxWidth - 1) / sliceMaxWidth;
+      int sliceCountY = (texture.getHeight() + sliceMaxHeight - 1) / sliceMaxHeight;
 
       gpuTexture.subTextures.reserve(sliceCountX * sliceCountY);
 
@@ -197,8 +201,8 @@ void N64Renderer::uploadTexture(int slot, const Texture* texture) {
             0,
             Recti(
               x * sliceMaxWidth, y * sliceMaxHeight,
-              std::min(sliceMaxWidth, texture->getWidth() - x * sliceMaxWidth),
-              std::min(sliceMaxHeight, texture->getHeight() - y * sliceMaxHeight)
+              std::min(sliceMaxWidth, texture.getWidth() - x * sliceMaxWidth),
+              std::min(sliceMaxHeight, texture.getHeight() - y * sliceMaxHeight)
             )
           });
         }
@@ -226,15 +230,29 @@ void N64Renderer::uploadTexture(int slot, const Texture* texture) {
       auto& subTexture = gpuTexture.subTextures[i];
       mTextureIdMapping.emplace(subTexture.id, glTextures[i]);
 
-      Texture croppedTexture =
-        texture->crop(Vector2i(subTexture.crop.width, subTexture.crop.height),
-                      Vector2i(subTexture.crop.x, subTexture.crop.y));
+      auto slice =
+        texture.crop(Vector2i(subTexture.crop.width, subTexture.crop.height),
+                     Vector2i(subTexture.crop.x, subTexture.crop.y));
 
-      uploadTextureData(glTextures[i], &croppedTexture);
+      uploadTextureData(glTextures[i], slice);
     }
   }
 }
 
+void N64Renderer::updateTextureRegion(
+  int slot, [[maybe_unused]] const Recti& rect,
+  [[maybe_unused]] const TextureView& data
+) {
+  // textures may be split into TMEM slices, upload the whole texture instead
+  logWarn("partial texture updates are not supported (slot {})", slot);
+}
+
+void N64Renderer::uploadPalette(
+  [[maybe_unused]] int slot, [[maybe_unused]] const Palette* palette
+) {
+  // stub
+}
+
 void N64Renderer::renderTexture(
   [[maybe_unused]] Canvas* canvas, [[maybe_unused]] RenderTextureInfo* info
 ) {
@@ -368,7 +386,8 @@ void N64Renderer::renderMesh(
   auto listId = mMeshIdMapping.at(info->meshId);
   auto texture = mTextureIdMapping.at(info->diffuseTextureId);
 
-  auto ambientLight = canvas->getCamera3d()->getStage()->getAmbientLight();
+  auto& snapshot = getSnapshot();
+  auto ambientLight = snapshot.getAmbientLight();
   float ambient[4] = {
     ambientLight.color.red, ambientLight.color.green, ambientLight.color.blue,
     ambientLight.color.alpha};
@@ -377,15 +396,15 @@ void N64Renderer::renderMesh(
 
   int lightId = 0;
 
-  for (auto&& pointLight : canvas->getCamera3d()->getStage()->getPointLights()) {
+  for (auto&& pointLight : snapshot.getPointLights()) {
     glEnable(GL_LIGHT0 + lightId);
     float pos[4] = {
-      pointLight->position.x, pointLight->position.y, pointLight->position.z,
+      pointLight.position.x, pointLight.position.y, pointLight.position.z,
       1};
     glLightfv(GL_LIGHT0 + lightId, GL_POSITION, pos);
     float color[4] = {
-      pointLight->color.red, pointLight->color.green, pointLight->color.blue,
-      pointLight->color.alpha};
+      pointLight.color.red, pointLight.color.green, pointLight.color.blue,
+      pointLight.color.alpha};
     glLightfv(GL_LIGHT0 + lightId, GL_DIFFUSE, color);
     float lightRadius = 10.0f;
     glLightf(GL_LIGHT0 + lightId, GL_LINEAR_ATTENUATION, 2.0f / lightRadius);
@@ -402,7 +421,7 @@ void N64Renderer::renderMesh(
   glEnable(GL_DEPTH_TEST);
   glBindTexture(GL_TEXTURE_2D, texture);
 
-  auto camera = canvas->getCamera3d();
+  auto camera = snapshot.getCamera3d();
 
   glMatrixMode(GL_PROJECTION);
   glLoadMatrixf((camera->getProjectionMatrix(4.0f / 3.0f) *
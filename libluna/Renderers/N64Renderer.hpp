@@ -35,7 +35,11 @@ namespace Luna {
     void resizeFramebufferTexture(uint16_t id, Vector2i size) override;
     void destroyFramebufferTexture(uint16_t id) override;
     void freeTexture(int slot) override;
-    void uploadTexture(int slot, const Texture* texture) override;
+    void uploadTexture(int slot, const TextureView& texture) override;
+    void updateTextureRegion(
+      int slot, const Recti& rect, const TextureView& data
+    ) override;
+    void uploadPalette(int slot, const Palette* palette) override;
     void renderTexture(Canvas* canvas, RenderTextureInfo* info) override;
 
     void createShape(int id) override;
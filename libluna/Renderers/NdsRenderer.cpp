@@ -23,13 +23,10 @@ void NdsRenderer::quitImmediateGui() {}
 
 void NdsRenderer::close() {}
 
-void NdsRenderer::render() {
-  auto canvas = getCanvas();
-  auto bgColor = canvas->getBackgroundColor();
+void NdsRenderer::render(const RenderSnapshot& snapshot) {
+  setBackdropColor(makeColorUint16(snapshot.getBackgroundColor()));
 
-  setBackdropColor(makeColorUint16(bgColor));
-
-  if (!canvas->getCamera2d().getStage()) {
+  if (snapshot.getDrawables2d().empty()) {
     return;
   }
 }
@@ -38,7 +35,18 @@ void NdsRenderer::present() { swiWaitForVBlank(); }
 
 Internal::GraphicsMetrics NdsRenderer::getMetrics() { return *mImpl->mMetrics; }
 
-void NdsRenderer::uploadTexture([[maybe_unused]] int slot, [[maybe_unused]] const Texture* texture) {
+void NdsRenderer::uploadTexture([[maybe_unused]] int slot, [[maybe_unused]] const TextureView& texture) {
+  // stub
+}
+
+void NdsRenderer::updateTextureRegion(
+  [[maybe_unused]] int slot, [[maybe_unused]] const Recti& rect,
+  [[maybe_unused]] const TextureView& data
+) {
+  // stub
+}
+
+void NdsRenderer::uploadPalette([[maybe_unused]] int slot, [[maybe_unused]] const Palette* palette) {
   // stub
 }
 
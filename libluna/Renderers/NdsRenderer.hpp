@@ -12,9 +12,13 @@ namespace Luna {
     void initializeImmediateGui() override;
     void quitImmediateGui() override;
     void close() override;
-    void render() override;
+    void render(const RenderSnapshot& snapshot) override;
     void present() override;
-    void uploadTexture(int slot, const Texture* texture) override;
+    void uploadTexture(int slot, const TextureView& texture) override;
+    void updateTextureRegion(
+      int slot, const Recti& rect, const TextureView& data
+    ) override;
+    void uploadPalette(int slot, const Palette* palette) override;
     void freeTexture(int slot) override;
 
     Internal::GraphicsMetrics getMetrics() override;
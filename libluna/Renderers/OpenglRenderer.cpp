@@ -5,6 +5,8 @@
 
 #include <list>
 #include <map>
+#include <optional>
+#include <vector>
 
 #ifdef LUNA_WINDOW_SDL2
 #include <SDL2/SDL.h>
@@ -61,6 +63,79 @@
 
 using namespace Luna;
 
+namespace {
+  void uploadPaletteData(
+    GLuint glPalette, const Palette* palette, int bitsPerPixel
+  ) {
+    CommonRenderer::PaletteLut lut;
+    CommonRenderer::makePaletteLut(palette, bitsPerPixel, lut);
+
+    CHECK_GL(glBindTexture(GL_TEXTURE_2D, glPalette));
+    CHECK_GL(glTexSubImage2D(
+      GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(lut.size()), 1, GL_RGBA,
+      GL_UNSIGNED_BYTE, lut.data()
+    ));
+  }
+
+  struct PixelData {
+    GLint internalFormat{GL_RGBA};
+    GLenum inputFormat{GL_RGBA};
+    GLenum inputType{GL_UNSIGNED_BYTE};
+    const void* data{nullptr};
+    int rowLength{0};
+    bool indexed{false};
+  };
+
+  /**
+   * @brief Describe the pixels of a view for glTexImage2D/glTexSubImage2D.
+   *
+   * 4 bpp views are expanded into @p indices, since there is no 4-bit texture
+   * format. All other formats are read in place.
+   */
+  PixelData
+  getPixelData(const TextureView& view, std::vector<uint8_t>& indices) {
+    PixelData pixels;
+    pixels.data = view.getData();
+    pixels.rowLength = view.getRowLength();
+
+    switch (view.getBitsPerPixel()) {
+    case 4:
+      indices.resize(
+        static_cast<std::size_t>(view.getWidth()) *
+        static_cast<std::size_t>(view.getHeight())
+      );
+
+      for (int y = 0; y < view.getHeight(); ++y) {
+        for (int x = 0; x < view.getWidth(); ++x) {
+          indices[static_cast<std::size_t>(y * view.getWidth() + x)] =
+            view.getNibbleAt(x, y);
+        }
+      }
+
+      pixels.data = indices.data();
+      pixels.rowLength = view.getWidth();
+      [[fallthrough]];
+    case 8:
+      pixels.internalFormat = GL_R8;
+      pixels.inputFormat = GL_RED;
+      pixels.indexed = true;
+      break;
+    case 16:
+      pixels.inputFormat = GL_RGBA;
+      pixels.inputType = GL_UNSIGNED_SHORT_1_5_5_5_REV;
+      break;
+    case 24:
+      pixels.inputFormat = GL_RGB;
+      break;
+    case 32:
+      pixels.inputFormat = GL_RGBA;
+      break;
+    }
+
+    return pixels;
+  }
+} // namespace
+
 OpenglRenderer::OpenglRenderer() {
   mMetrics = std::make_shared<Internal::GraphicsMetrics>();
 }
@@ -79,41 +154,85 @@ void OpenglRenderer::initialize() {
   mMetrics->shadingLangVersion =
     reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION));
 
-  GL::ShaderLib shaderLib;
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "sprite_vert.glsl",
     std::make_unique<MemoryReader>(sprite_vert_glsl, sprite_vert_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "sprite_frag.glsl",
     std::make_unique<MemoryReader>(sprite_frag_glsl, sprite_frag_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "primitive_vert.glsl",
     std::make_unique<MemoryReader>(primitive_vert_glsl, primitive_vert_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "primitive_frag.glsl",
     std::make_unique<MemoryReader>(primitive_frag_glsl, primitive_frag_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "3d_vert.glsl",
     std::make_unique<MemoryReader>(__3d_vert_glsl, __3d_vert_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "3d_frag.glsl",
     std::make_unique<MemoryReader>(__3d_frag_glsl, __3d_frag_glsl_len)
   );
-  shaderLib.registerShader(
+  mShaderLib.registerShader(
     "common3d.glsl",
     std::make_unique<MemoryReader>(common3d_glsl, common3d_glsl_len)
   );
 
   mSpriteShader =
-    shaderLib.compileShader("sprite_vert.glsl", "sprite_frag.glsl");
+    mShaderLib.compileShader("sprite_vert.glsl", "sprite_frag.glsl");
   mPrimitiveShader =
-    shaderLib.compileShader("primitive_vert.glsl", "primitive_frag.glsl");
-  mModelShader = shaderLib.compileShader("3d_vert.glsl", "3d_frag.glsl");
+    mShaderLib.compileShader("primitive_vert.glsl", "primitive_frag.glsl");
+  mModelShader = mShaderLib.compileShader("3d_vert.glsl", "3d_frag.glsl");
+}
+
+void OpenglRenderer::reloadShader(
+  const std::string& filename, const std::string& source
+) {
+  if (!mShaderLib.hasShader(filename)) {
+    logWarn("unknown shader file {}", filename);
+    return;
+  }
+
+  mShaderLib.replaceShader(filename, String(source.data(), source.size()));
+
+  struct Program {
+    GL::Shader* shader;
+    const char* vertex;
+    const char* fragment;
+  };
+
+  Program programs[] = {
+    {&mSpriteShader, "sprite_vert.glsl", "sprite_frag.glsl"},
+    {&mPrimitiveShader, "primitive_vert.glsl", "primitive_frag.glsl"},
+    {&mModelShader, "3d_vert.glsl", "3d_frag.glsl"},
+  };
+
+  for (auto& program : programs) {
+    if (!mShaderLib.dependsOn(program.vertex, filename) &&
+        !mShaderLib.dependsOn(program.fragment, filename)) {
+      continue;
+    }
+
+    try {
+      auto shader = mShaderLib.compileShader(program.vertex, program.fragment);
+
+      if (!shader.isLinked()) {
+        logError("keeping the previous program of {}", program.fragment);
+        continue;
+      }
+
+      *program.shader = std::move(shader);
+      logInfo("reloaded {} and {}", program.vertex, program.fragment);
+    } catch (const std::bad_optional_access&) {
+      // an #include without quotes
+      logError("invalid include in {}", filename);
+    }
+  }
 }
 
 void OpenglRenderer::initializeImmediateGui() {
@@ -280,14 +399,21 @@ void OpenglRenderer::freeTexture(int slot) {
   mTextureIdMapping.erase(gpuTexture->id);
   CHECK_GL(glDeleteTextures(1, &texture));
 
+  auto paletteIt = mPaletteIdMapping.find(gpuTexture->id);
+
+  if (paletteIt != mPaletteIdMapping.end()) {
+    CHECK_GL(glDeleteTextures(1, &paletteIt->second.id));
+    mPaletteIdMapping.erase(paletteIt);
+  }
+
   freeGpuTexture(slot);
 }
 
-void OpenglRenderer::uploadTexture(int slot, const Texture* texture) {
+void OpenglRenderer::uploadTexture(int slot, const TextureView& texture) {
   freeTexture(slot);
 
   GpuTexture gpuTexture;
-  gpuTexture.size = texture->getSize();
+  gpuTexture.size = texture.getSize();
 
   declareGpuTexture(slot, gpuTexture);
 
@@ -296,37 +422,98 @@ void OpenglRenderer::uploadTexture(int slot, const Texture* texture) {
   CHECK_GL(glGenTextures(1, &glTexture));
   mTextureIdMapping.emplace(gpuTexture.id, glTexture);
 
-  GLenum inputFormat = GL_RGBA;
-  GLenum inputType = GL_UNSIGNED_BYTE;
-
-  switch (texture->getBitsPerPixel()) {
-  case 16:
-    inputFormat = GL_RGBA;
-    inputType = GL_UNSIGNED_SHORT_1_5_5_5_REV;
-    break;
-  case 24:
-    inputFormat = GL_RGB;
-    break;
-  case 32:
-    inputFormat = GL_RGBA;
-    break;
-  }
+  std::vector<uint8_t> indices;
+  auto pixels = getPixelData(texture, indices);
+
+  // indices must never be interpolated
+  bool interpolate = texture.isInterpolated() && !pixels.indexed;
 
+  CHECK_GL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+  // regions of larger images are read in place
+  CHECK_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, pixels.rowLength));
   CHECK_GL(glBindTexture(GL_TEXTURE_2D, glTexture));
   CHECK_GL(glTexImage2D(
     GL_TEXTURE_2D, 0,                         /* mipmap level */
-    GL_RGBA,                                  /* internal format */
-    texture->getWidth(), texture->getHeight(), 0, /* format (legacy) */
-    inputFormat,                              /* input format */
-    inputType, texture->getData()
+    pixels.internalFormat,                    /* internal format */
+    texture.getWidth(), texture.getHeight(), 0, /* format (legacy) */
+    pixels.inputFormat,                       /* input format */
+    pixels.inputType, pixels.data
   ));
+  CHECK_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+  CHECK_GL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
   glTexParameteri(
-    GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-    texture->isInterpolated() ? GL_LINEAR : GL_NEAREST
+    GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, interpolate ? GL_LINEAR : GL_NEAREST
   );
   glTexParameteri(
-    GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-    texture->isInterpolated() ? GL_LINEAR : GL_NEAREST
+    GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, interpolate ? GL_LINEAR : GL_NEAREST
+  );
+
+  if (pixels.indexed) {
+    GLuint glPalette;
+    CHECK_GL(glGenTextures(1, &glPalette));
+    mPaletteIdMapping.emplace(
+      gpuTexture.id, GpuPalette{glPalette, texture.getBitsPerPixel()}
+    );
+
+    CHECK_GL(glBindTexture(GL_TEXTURE_2D, glPalette));
+    CHECK_GL(glTexImage2D(
+      GL_TEXTURE_2D, 0, GL_RGBA8, static_cast<GLsizei>(PaletteLut().size()), 1,
+      0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr
+    ));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    uploadPaletteData(
+      glPalette, texture.getPalette().get(), texture.getBitsPerPixel()
+    );
+  }
+}
+
+void OpenglRenderer::updateTextureRegion(
+  int slot, const Recti& rect, const TextureView& data
+) {
+  auto gpuTexture = getGpuTextureForRegion(slot, rect, data);
+
+  if (!gpuTexture) {
+    return;
+  }
+
+  std::vector<uint8_t> indices;
+  auto pixels = getPixelData(data.crop({rect.width, rect.height}), indices);
+
+  if (pixels.indexed != (mPaletteIdMapping.count(gpuTexture->id) > 0)) {
+    logWarn("region data format does not match texture at slot {}", slot);
+    return;
+  }
+
+  CHECK_GL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+  CHECK_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, pixels.rowLength));
+  CHECK_GL(glBindTexture(GL_TEXTURE_2D, mTextureIdMapping.at(gpuTexture->id)));
+  CHECK_GL(glTexSubImage2D(
+    GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height,
+    pixels.inputFormat, pixels.inputType, pixels.data
+  ));
+  CHECK_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+  CHECK_GL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+}
+
+void OpenglRenderer::uploadPalette(int slot, const Palette* palette) {
+  auto gpuTexture = getGpuTexture(slot);
+
+  if (!gpuTexture) {
+    logWarn("no texture uploaded at slot {}", slot);
+    return;
+  }
+
+  auto paletteIt = mPaletteIdMapping.find(gpuTexture->id);
+
+  if (paletteIt == mPaletteIdMapping.end()) {
+    logWarn("texture at slot {} is not indexed", slot);
+    return;
+  }
+
+  uploadPaletteData(
+    paletteIt->second.id, palette, paletteIt->second.bitsPerPixel
   );
 }
 
@@ -370,6 +557,18 @@ void OpenglRenderer::renderTexture(
   mUniforms.spriteTexture = 0;
   CHECK_GL(glBindTexture(GL_TEXTURE_2D, texture));
 
+  auto paletteIt = mPaletteIdMapping.find(info->textureId);
+  mUniforms.spriteIndexed = mSpriteShader.getUniform("uIndexed");
+  mUniforms.spriteIndexed = paletteIt != mPaletteIdMapping.end() ? 1 : 0;
+
+  if (paletteIt != mPaletteIdMapping.end()) {
+    mUniforms.spritePalette = mSpriteShader.getUniform("uPaletteTexture");
+    mUniforms.spritePalette = 1;
+    glActiveTexture(GL_TEXTURE1);
+    CHECK_GL(glBindTexture(GL_TEXTURE_2D, paletteIt->second.id));
+    glActiveTexture(GL_TEXTURE0);
+  }
+
   mUniforms.spritePos = mSpriteShader.getUniform("uSpritePos");
   mUniforms.spritePos = info->position;
 
@@ -400,7 +599,8 @@ void OpenglRenderer::renderMesh(
   glEnable(GL_CULL_FACE);
   glEnable(GL_MULTISAMPLE);
 
-  auto ambientLight = canvas->getCamera3d()->getStage()->getAmbientLight();
+  auto& snapshot = getSnapshot();
+  auto ambientLight = snapshot.getAmbientLight();
   mUniforms.ambientLightColor = mModelShader.getUniform("uAmbientLight.color");
   mUniforms.ambientLightIntensity =
     mModelShader.getUniform("uAmbientLight.intensity");
@@ -412,9 +612,9 @@ void OpenglRenderer::renderMesh(
   mUniforms.pointLightsPosition =
     mModelShader.getUniform("uPointLights[{}].position", 1);
 
-  for (auto&& pointLight : canvas->getCamera3d()->getStage()->getPointLights()) {
-    mUniforms.pointLightsColor[0] = pointLight->color;
-    mUniforms.pointLightsPosition[0] = pointLight->position;
+  for (auto&& pointLight : snapshot.getPointLights()) {
+    mUniforms.pointLightsColor[0] = pointLight.color;
+    mUniforms.pointLightsPosition[0] = pointLight.position;
   }
 
   auto mesh = mMeshMapping.at(info->meshId);
@@ -441,7 +641,7 @@ void OpenglRenderer::renderMesh(
   mUniforms.transformModel = mModelShader.getUniform("uTransform.model");
   mUniforms.transformModel = info->transform;
 
-  auto camera = canvas->getCamera3d();
+  auto camera = snapshot.getCamera3d();
 
   mUniforms.transformView = mModelShader.getUniform("uTransform.view");
   mUniforms.transformView = camera->getViewMatrix();
@@ -8,6 +8,7 @@
 
 #include <libluna/GL/MeshBuffer.hpp>
 #include <libluna/GL/Shader.hpp>
+#include <libluna/GL/ShaderLib.hpp>
 #include <libluna/GL/Uniform.hpp>
 #include <libluna/GL/common.hpp>
 
@@ -38,7 +39,11 @@ namespace Luna {
     void destroyFramebufferTexture(uint16_t id) override;
 
     void freeTexture(int slot) override;
-    void uploadTexture(int slot, const Texture* texture) override;
+    void uploadTexture(int slot, const TextureView& texture) override;
+    void updateTextureRegion(
+      int slot, const Recti& rect, const TextureView& data
+    ) override;
+    void uploadPalette(int slot, const Palette* palette) override;
     void renderTexture(Canvas* canvas, RenderTextureInfo* info) override;
 
     void createShape(int id) override;
@@ -60,11 +65,18 @@ namespace Luna {
 
     void imguiNewFrame() override;
 
+    void
+    reloadShader(const std::string& filename, const std::string& source) override;
+
     private:
 #ifdef LUNA_IMGUI
     ImGuiContext* mImGuiContext{nullptr};
 #endif
 
+    /**
+     * @brief Sources of the shaders, kept for reloading them.
+     */
+    GL::ShaderLib mShaderLib;
     GL::Shader mSpriteShader;
     GL::Shader mPrimitiveShader;
     GL::Shader mModelShader;
@@ -74,6 +86,8 @@ namespace Luna {
       GL::Uniform screenSize;
       GL::Uniform spritePos;
       GL::Uniform spriteTexture;
+      GL::Uniform spritePalette;
+      GL::Uniform spriteIndexed;
       GL::Uniform primitiveColor;
       GL::Uniform uPrimitivePos;
       GL::Uniform transformModel;
@@ -89,7 +103,16 @@ namespace Luna {
       GL::Uniform viewPos;
     } mUniforms;
 
+    /**
+     * @brief Palette texture of an indexed texture.
+     */
+    struct GpuPalette {
+      GLuint id;
+      int bitsPerPixel; ///< Of the indexed texture, for the grayscale ramp.
+    };
+
     std::map<uint16_t, GLuint> mTextureIdMapping;
+    std::map<uint16_t, GpuPalette> mPaletteIdMapping; ///< For indexed textures.
     std::map<int, Luna::Shape*> mShapeIdMapping;
     std::map<uint16_t, GLuint> mFramebuffers;
     std::map<int, std::shared_ptr<GL::MeshBuffer>> mMeshMapping;
@@ -46,6 +46,17 @@ inline T* assertSdl(T* ptr) {
 
 static bool gDidPrintRenderDrivers{false};
 
+static uint32_t getSurfaceFormat(int bitsPerPixel) {
+  switch (bitsPerPixel) {
+  case 16:
+    return SDL_PIXELFORMAT_ABGR1555;
+  case 24:
+    return SDL_PIXELFORMAT_RGB24;
+  default:
+    return SDL_PIXELFORMAT_RGBA32;
+  }
+}
+
 SdlRenderer::SdlRenderer() {
   mMetrics = std::make_shared<Internal::GraphicsMetrics>();
 }
@@ -202,6 +213,8 @@ void SdlRenderer::freeTexture(int slot) {
         SDL_DestroyTexture(textureIt->second);
         mTextureIdMapping.erase(textureIt);
       }
+
+      mIndexedTextures.erase(gpuTexture->id);
     }
 
     for (auto& subTexture : gpuTexture->subTextures) {
@@ -216,31 +229,58 @@ void SdlRenderer::freeTexture(int slot) {
   freeGpuTexture(slot);
 }
 
-void SdlRenderer::uploadTexture(int slot, const Texture* texture) {
+void SdlRenderer::uploadTexture(int slot, const TextureView& texture) {
   freeTexture(slot);
 
   GpuTexture gpuTexture;
-  gpuTexture.size = texture->getSize();
+  gpuTexture.size = texture.getSize();
 
   declareGpuTexture(slot, gpuTexture);
 
-  uint32_t surfaceFormat = SDL_PIXELFORMAT_RGBA32;
+  if (texture.getBitsPerPixel() == 4 || texture.getBitsPerPixel() == 8) {
+    IndexedTexture indexed;
+    indexed.size = texture.getSize();
+    indexed.bitsPerPixel = texture.getBitsPerPixel();
+    indexed.indices.resize(
+      static_cast<std::size_t>(texture.getWidth()) *
+      static_cast<std::size_t>(texture.getHeight())
+    );
+
+    for (int y = 0; y < texture.getHeight(); ++y) {
+      for (int x = 0; x < texture.getWidth(); ++x) {
+        auto index = static_cast<std::size_t>(y * texture.getWidth() + x);
+        indexed.indices[index] = texture.getBitsPerPixel() == 4
+                                   ? texture.getNibbleAt(x, y)
+                                   : texture.getByteAt(x, y);
+      }
+    }
 
-  switch (texture->getBitsPerPixel()) {
-  case 16:
-    surfaceFormat = SDL_PIXELFORMAT_ABGR1555;
-    break;
-  case 24:
-    surfaceFormat = SDL_PIXELFORMAT_RGB24;
-    break;
-  case 32:
-    surfaceFormat = SDL_PIXELFORMAT_RGBA32;
-    break;
+    makePaletteLut(
+      texture.getPalette().get(), texture.getBitsPerPixel(), indexed.lut
+    );
+
+    auto sdlTexture = assertSdl(SDL_CreateTexture(
+      mRenderer.get(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+      texture.getWidth(), texture.getHeight()
+    ));
+    SDL_SetTextureBlendMode(sdlTexture, SDL_BLENDMODE_BLEND);
+    blitIndexedTexture(
+      sdlTexture, indexed, Recti(0, 0, indexed.size.width, indexed.size.height)
+    );
+
+    mTextureIdMapping.emplace(gpuTexture.id, sdlTexture);
+    mIndexedTextures.emplace(gpuTexture.id, std::move(indexed));
+
+    return;
   }
 
+  uint32_t surfaceFormat = getSurfaceFormat(texture.getBitsPerPixel());
+
+  // the pitch lets SDL read regions of larger images in place
   SDL_Surface* surface = assertSdl(SDL_CreateRGBSurfaceWithFormatFrom(
-    (void*)(texture->getData()), texture->getSize().width, texture->getSize().height,
-    texture->getBitsPerPixel(), texture->getBytesPerRow(), surfaceFormat
+    const_cast<uint8_t*>(texture.getData()), texture.getWidth(),
+    texture.getHeight(), texture.getBitsPerPixel(), texture.getStride(),
+    surfaceFormat
   ));
 
   auto sdlTexture = assertSdl(SDL_CreateTextureFromSurface(mRenderer.get(), surface));
@@ -250,6 +290,118 @@ void SdlRenderer::uploadTexture(int slot, const Texture* texture) {
   mTextureIdMapping.emplace(gpuTexture.id, sdlTexture);
 }
 
+void SdlRenderer::updateTextureRegion(
+  int slot, const Recti& rect, const TextureView& data
+) {
+  auto gpuTexture = getGpuTextureForRegion(slot, rect, data);
+
+  if (!gpuTexture) {
+    return;
+  }
+
+  auto sdlTexture = mTextureIdMapping.at(gpuTexture->id);
+  auto region = data.crop({rect.width, rect.height});
+  bool isIndexedData =
+    region.getBitsPerPixel() == 4 || region.getBitsPerPixel() == 8;
+  auto indexedIt = mIndexedTextures.find(gpuTexture->id);
+
+  if (isIndexedData != (indexedIt != mIndexedTextures.end())) {
+    logWarn("region data format does not match texture at slot {}", slot);
+    return;
+  }
+
+  if (isIndexedData) {
+    // update the CPU side indices and expand only the changed region
+    auto& indexed = indexedIt->second;
+
+    for (int y = 0; y < rect.height; ++y) {
+      auto indices = indexed.indices.data() +
+                     static_cast<std::ptrdiff_t>(rect.y + y) * indexed.size.width +
+                     rect.x;
+
+      for (int x = 0; x < rect.width; ++x) {
+        indices[x] = region.getBitsPerPixel() == 4 ? region.getNibbleAt(x, y)
+                                                   : region.getByteAt(x, y);
+      }
+    }
+
+    blitIndexedTexture(sdlTexture, indexed, rect);
+
+    return;
+  }
+
+  SDL_Rect sdlRect{rect.x, rect.y, rect.width, rect.height};
+  uint32_t dataFormat = getSurfaceFormat(region.getBitsPerPixel());
+  uint32_t textureFormat;
+  CHECK_SDL(SDL_QueryTexture(sdlTexture, &textureFormat, nullptr, nullptr, nullptr));
+
+  if (textureFormat == dataFormat) {
+    CHECK_SDL(SDL_UpdateTexture(
+      sdlTexture, &sdlRect, region.getData(), region.getStride()
+    ));
+    return;
+  }
+
+  // SDL may have picked a different format on upload, so convert the region
+  int pitch = rect.width * SDL_BYTESPERPIXEL(textureFormat);
+  std::vector<uint8_t> converted(
+    static_cast<std::size_t>(pitch) * static_cast<std::size_t>(rect.height)
+  );
+  CHECK_SDL(SDL_ConvertPixels(
+    rect.width, rect.height, dataFormat, region.getData(), region.getStride(),
+    textureFormat, converted.data(), pitch
+  ));
+  CHECK_SDL(SDL_UpdateTexture(sdlTexture, &sdlRect, converted.data(), pitch));
+}
+
+void SdlRenderer::uploadPalette(int slot, const Palette* palette) {
+  auto gpuTexture = getGpuTexture(slot);
+
+  if (!gpuTexture) {
+    logWarn("no texture uploaded at slot {}", slot);
+    return;
+  }
+
+  auto indexedIt = mIndexedTextures.find(gpuTexture->id);
+
+  if (indexedIt == mIndexedTextures.end()) {
+    logWarn("texture at slot {} is not indexed", slot);
+    return;
+  }
+
+  auto& indexed = indexedIt->second;
+  makePaletteLut(palette, indexed.bitsPerPixel, indexed.lut);
+  blitIndexedTexture(
+    mTextureIdMapping.at(gpuTexture->id), indexed,
+    Recti(0, 0, indexed.size.width, indexed.size.height)
+  );
+}
+
+void SdlRenderer::blitIndexedTexture(
+  SDL_Texture* texture, const IndexedTexture& indexed, const Recti& rect
+) {
+  SDL_Rect sdlRect{rect.x, rect.y, rect.width, rect.height};
+  void* pixels;
+  int pitch;
+
+  CHECK_SDL(SDL_LockTexture(texture, &sdlRect, &pixels, &pitch));
+
+  for (int y = 0; y < rect.height; ++y) {
+    auto row = reinterpret_cast<ColorRgb32*>(
+      static_cast<uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * pitch
+    );
+    auto indices = indexed.indices.data() +
+                   static_cast<std::ptrdiff_t>(rect.y + y) * indexed.size.width +
+                   rect.x;
+
+    for (int x = 0; x < rect.width; ++x) {
+      row[x] = indexed.lut[indices[x]];
+    }
+  }
+
+  SDL_UnlockTexture(texture);
+}
+
 void SdlRenderer::renderTexture(
   [[maybe_unused]] Canvas* canvas, RenderTextureInfo* info
 ) {
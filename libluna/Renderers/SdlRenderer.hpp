@@ -48,7 +48,11 @@ namespace Luna {
     void destroyFramebufferTexture(uint16_t id) override;
 
     void freeTexture(int slot) override;
-    void uploadTexture(int slot, const Texture* texture) override;
+    void uploadTexture(int slot, const TextureView& texture) override;
+    void updateTextureRegion(
+      int slot, const Recti& rect, const TextureView& data
+    ) override;
+    void uploadPalette(int slot, const Palette* palette) override;
     void renderTexture(Canvas* canvas, RenderTextureInfo* info) override;
 
     void createShape(int id) override;
@@ -65,6 +69,23 @@ namespace Luna {
     void imguiNewFrame() override;
 
     private:
+    /**
+     * @brief CPU side copy of an indexed texture.
+     *
+     * SDL can not resolve palettes on the GPU, so the indices are kept in order
+     * to expand them again whenever the palette changes.
+     */
+    struct IndexedTexture {
+      Vector2i size;
+      std::vector<uint8_t> indices; ///< One index per pixel.
+      int bitsPerPixel;
+      PaletteLut lut;
+    };
+
+    void blitIndexedTexture(
+      SDL_Texture* texture, const IndexedTexture& indexed, const Recti& rect
+    );
+
 #ifdef LUNA_IMGUI
     ImGuiContext* mImGuiContext{nullptr};
 #endif
@@ -73,6 +94,7 @@ namespace Luna {
     std::shared_ptr<Internal::GraphicsMetrics> mMetrics;
 
     std::map<uint16_t, SDL_Texture*> mTextureIdMapping;
+    std::map<uint16_t, IndexedTexture> mIndexedTextures;
     std::map<int, Luna::Shape*> mShapeIdMapping;
   };
 } // namespace Luna
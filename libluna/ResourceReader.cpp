@@ -1,39 +1,161 @@
+#include <libluna/config.h>
+
 #include <libluna/ResourceReader.hpp>
 
+#include <stdexcept>
+#include <vector>
+
+#ifdef LUNA_STD_THREAD
+#include <mutex>
+#endif
+
+#include <fmt/format.h>
+
 #include <libluna/Application.hpp>
+#include <libluna/DecompressingReader.hpp>
 #include <libluna/Filesystem/FileReader.hpp>
+#include <libluna/Filesystem/MappedFileReader.hpp>
+#include <libluna/MemoryReader.hpp>
 
 using namespace Luna;
 
-ResourceReaderPtr ResourceReader::make(const char* name) {
-  return ResourceReaderPtr(new ResourceReader(name));
+namespace {
+  std::vector<PackArchivePtr> gMountedPacks;
+
+#ifdef LUNA_STD_THREAD
+  std::mutex gMountedPacksMutex;
+#endif
+
+  PackArchivePtr findPack(const char* name, const PackArchive::Entry*& entry) {
+#ifdef LUNA_STD_THREAD
+    std::lock_guard lock(gMountedPacksMutex);
+#endif
+
+    for (auto it = gMountedPacks.rbegin(); it != gMountedPacks.rend(); ++it) {
+      if ((entry = (*it)->find(name))) {
+        return *it;
+      }
+    }
+
+    return nullptr;
+  }
+} // namespace
+
+ResourceReaderPtr ResourceReader::make(const char* name, Access access) {
+  return ResourceReaderPtr(new ResourceReader(name, access));
 }
 
-ResourceReader::ResourceReader(const char* name) {
+ResourceReader::ResourceReader(const char* name, Access access) {
+  const PackArchive::Entry* entry = nullptr;
+
+  if ((mArchive = findPack(name, entry))) {
+    auto storedData = const_cast<uint8_t*>(entry->data);
+    auto size = entry->storedSize;
+
+    if (entry->compression == Pack::kLz) {
+      // decompress the whole entry up front, so decoders can work in place
+      DecompressingReader reader(
+        std::make_unique<MemoryReader>(storedData, entry->storedSize)
+      );
+
+      // the sizes are compared first, so a corrupt index can't request an
+      // arbitrary allocation
+      if (!reader.isValid() || reader.getSize() != entry->size) {
+        throw std::runtime_error(
+          fmt::format("corrupt compressed data of \"{}\"", name)
+        );
+      }
+
+      mContents.resize(entry->size);
+
+      if (reader.read(mContents.data(), 1, entry->size) != entry->size) {
+        throw std::runtime_error(
+          fmt::format("corrupt compressed data of \"{}\"", name)
+        );
+      }
+
+      storedData = mContents.data();
+      size = entry->size;
+    } else if (entry->compression != Pack::kUncompressed) {
+      throw std::runtime_error(fmt::format(
+        "unsupported compression {} of \"{}\"", entry->compression, name
+      ));
+    }
+
+    mData = storedData;
+    mStream = std::make_unique<MemoryReader>(storedData, size, Endian::Little);
+
+    return;
+  }
+
   auto filePath = Application::getInstance()->getAssetsPath().cd(name);
-  fileReader = Filesystem::FileReader::make(filePath);
+
+  if (access == kCopy) {
+    auto fileReader = Filesystem::FileReader::make(filePath);
+    mContents.resize(fileReader->getSize());
+
+    if (fileReader->read(mContents.data(), 1, mContents.size()) !=
+        mContents.size()) {
+      throw std::runtime_error(fmt::format("could not read \"{}\"", name));
+    }
+
+    mData = mContents.data();
+    mStream = std::make_unique<MemoryReader>(
+      mContents.data(), mContents.size(), Endian::Little
+    );
+
+    return;
+  }
+
+  auto fileReader = Filesystem::MappedFileReader::make(filePath);
+  mData = fileReader->getData();
+  mStream = std::move(fileReader);
 }
 
 ResourceReader::~ResourceReader() = default;
 
-bool ResourceReader::isValid() const { return fileReader->isValid(); }
+bool ResourceReader::mount(const Filesystem::Path& path) {
+  auto archive = PackArchive::open(path);
 
-std::size_t ResourceReader::getSize() const { return fileReader->getSize(); }
+  if (!archive) {
+    return false;
+  }
 
-bool ResourceReader::eof() const { return fileReader->eof(); }
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(gMountedPacksMutex);
+#endif
+  gMountedPacks.push_back(archive);
 
-std::size_t ResourceReader::tell() { return fileReader->tell(); }
+  return true;
+}
+
+void ResourceReader::unmountAll() {
+#ifdef LUNA_STD_THREAD
+  std::lock_guard lock(gMountedPacksMutex);
+#endif
+  gMountedPacks.clear();
+}
+
+bool ResourceReader::isValid() const { return mStream->isValid(); }
+
+std::size_t ResourceReader::getSize() const { return mStream->getSize(); }
+
+bool ResourceReader::eof() const { return mStream->eof(); }
+
+std::size_t ResourceReader::tell() { return mStream->tell(); }
 
 std::size_t ResourceReader::seek(std::size_t position) {
-  return fileReader->seek(position);
+  return mStream->seek(position);
 }
 
 std::size_t ResourceReader::seekRelative(int relativePosition) {
-  return fileReader->seekRelative(relativePosition);
+  return mStream->seekRelative(relativePosition);
 }
 
 std::size_t ResourceReader::read(
   uint8_t* buffer, std::size_t objectSize, std::size_t objectCount
 ) {
-  return fileReader->read(buffer, objectSize, objectCount);
+  return mStream->read(buffer, objectSize, objectCount);
 }
+
+const uint8_t* ResourceReader::getData() const { return mData; }
@@ -1,7 +1,10 @@
 #pragma once
 
-#include <libluna/Filesystem/FileReader.hpp>
+#include <vector>
+
+#include <libluna/Filesystem/MappedFileReader.hpp>
 #include <libluna/InputStream.hpp>
+#include <libluna/PackArchive.hpp>
 
 namespace Luna {
   class ResourceReader;
@@ -9,14 +12,55 @@ namespace Luna {
 
   /**
    * @brief Read files from the assets.
-   * 
+   *
+   * Files are looked up in the mounted packs first, starting with the pack
+   * mounted last, and then in the assets directory. Either way, the contents
+   * are mapped into memory, see Filesystem::MappedFileReader. Compressed pack
+   * entries are decompressed into memory when opened.
+   *
+   * Files that may be truncated while reading, like those edited during hot
+   * reloading, must be copied instead, as accessing a mapped page past the
+   * new end of the file is a bus error.
+   *
+   * Values are read as little-endian from any of them, like with a
+   * Filesystem::FileReader.
+   *
    * @ingroup streams
    */
   class ResourceReader final : public InputStream {
     public:
-    static ResourceReaderPtr make(const char* name);
+    enum Access {
+      /**
+       * @brief Map files of the assets directory into memory.
+       */
+      kMap,
+
+      /**
+       * @brief Copy files of the assets directory into memory.
+       */
+      kCopy
+    };
+
+    /**
+     * @brief Open an asset.
+     *
+     * @throw std::runtime_error if the asset can't be opened.
+     */
+    static ResourceReaderPtr make(const char* name, Access access = kMap);
     ~ResourceReader();
 
+    /**
+     * @brief Serve assets from the pack at the given path.
+     *
+     * Entries of packs mounted later take precedence, so patches can be
+     * mounted on top of the base pack.
+     *
+     * @return false if the pack could not be opened.
+     */
+    static bool mount(const Filesystem::Path& path);
+
+    static void unmountAll();
+
     bool isValid() const override;
     std::size_t getSize() const override;
     bool eof() const override;
@@ -28,8 +72,26 @@ namespace Luna {
     ) override;
     using InputStream::read;
 
+    /**
+     * @brief Get the contents of the file without copying them.
+     *
+     * The data stays valid as long as the reader exists.
+     */
+    const uint8_t* getData() const;
+
     private:
-    ResourceReader(const char* name);
-    std::unique_ptr<Filesystem::FileReader> fileReader;
+    ResourceReader(const char* name, Access access);
+    std::unique_ptr<InputStream> mStream;
+    const uint8_t* mData{nullptr};
+
+    /**
+     * @brief Contents of a compressed pack entry or a copied file.
+     */
+    std::vector<uint8_t> mContents;
+
+    /**
+     * @brief Pack the file is read from, kept alive while reading.
+     */
+    PackArchivePtr mArchive;
   };
 } // namespace Luna
@@ -22,14 +22,45 @@ namespace Luna {
 #ifdef N64
   void Sound::setSource(const char* source) { mSource = source; }
 #else
-  void Sound::setSource(SoundSource* source) { mSource = source; }
+  Sound::Sound(Audio::VoiceMixer* mixer) : mMixer(mixer) {}
+
+  void Sound::setSource(SoundSource* source) {
+    mSource = source;
+    mBufferSource.reset();
+  }
+
+  void Sound::setSource(const SoundBufferSource& source) {
+    mSource = nullptr;
+    mBufferSource = source;
+  }
+
+  Audio::VoiceMixer::Parameters Sound::getParameters() const {
+    return {mPitch, mPan, mVolume, mPriority};
+  }
 #endif
 
-  void Sound::setPitch(float pitch) { mPitch = pitch; }
+  void Sound::setPitch(float pitch) {
+    mPitch = pitch;
+#ifndef N64
+    mMixer->setParameters(mVoice, getParameters());
+#endif
+  }
 
-  void Sound::setPan(float pan) { mPan = pan; }
+  void Sound::setPan(float pan) {
+    mPan = pan;
+#ifndef N64
+    mMixer->setParameters(mVoice, getParameters());
+#endif
+  }
+
+  void Sound::setVolume(float volume) {
+    mVolume = volume;
+#ifndef N64
+    mMixer->setParameters(mVoice, getParameters());
+#endif
+  }
 
-  void Sound::setVolume(float volume) { mVolume = volume; }
+  void Sound::setPriority(int priority) { mPriority = priority; }
 
   void Sound::play() {
 #ifdef N64
@@ -47,12 +78,22 @@ namespace Luna {
     wav64_play(&mSound, 0);
     float normalizedPan = (mPan + 1.0f) / 2.0f;
     mixer_ch_set_vol_pan(0, mVolume, normalizedPan);
+#else
+    mMixer->stop(mVoice);
+
+    if (mBufferSource) {
+      mVoice = mMixer->play(*mBufferSource, getParameters());
+    } else if (mSource) {
+      mVoice = mMixer->play(mSource, getParameters());
+    }
 #endif
   }
 
   void Sound::stop() {
 #ifdef N64
     mixer_ch_stop(mChannel);
+#else
+    mMixer->stop(mVoice);
 #endif
   }
 
@@ -60,7 +101,7 @@ namespace Luna {
 #ifdef N64
     return mChannel != -1 && mixer_ch_playing(mChannel);
 #else
-    return false; // not implemented yet
+    return mMixer->isPlaying(mVoice);
 #endif
   }
 } // namespace Luna
@@ -1,18 +1,45 @@
 #pragma once
 
+#include <optional>
+
 #include <libluna/SoundSource.hpp>
 
 #ifdef N64
 #include <libdragon.h>
+#else
+#include <libluna/Audio/VoiceMixer.hpp>
 #endif
 
 namespace Luna {
+  /**
+   * @brief A sound played on a voice of the audio system.
+   *
+   * Except for N64, the sound plays on a voice of the Audio::VoiceMixer of
+   * the AudioManager it has been created by. Changes apply with the next
+   * AudioManager::update().
+   */
   class Sound {
     public:
+#ifdef N64
+    Sound() = default;
+#else
+    Sound(Audio::VoiceMixer* mixer);
+#endif
+
 #ifdef N64
     void setSource(const char* source);
 #else
+    /**
+     * @brief Play @p source, which must stay alive while playing.
+     */
     void setSource(SoundSource* source);
+
+    /**
+     * @brief Play a copy of @p source from the start with every play().
+     *
+     * Only the buffer must stay alive while playing.
+     */
+    void setSource(const SoundBufferSource& source);
 #endif
 
     void setPitch(float pitch);
@@ -26,6 +53,14 @@ namespace Luna {
 
     void setVolume(float volume);
 
+    /**
+     * @brief Set the priority for taking over a voice.
+     *
+     * If all voices are busy, playing a sound stops the sound with the lowest
+     * priority, as long as it isn't higher than the priority of this sound.
+     */
+    void setPriority(int priority);
+
     void play();
 
     void stop();
@@ -37,11 +72,17 @@ namespace Luna {
     const char* mSource;
     wav64_t mSound;
 #else
-    SoundSource* mSource;
+    Audio::VoiceMixer::Parameters getParameters() const;
+
+    SoundSource* mSource{nullptr};
+    std::optional<SoundBufferSource> mBufferSource;
+    Audio::VoiceMixer* mMixer;
+    Audio::VoiceMixer::Handle mVoice;
 #endif
     float mPitch{1.0f};
     float mPan{0.0f};
     float mVolume{1.0f};
+    int mPriority{0};
     int mChannel{-1};
   };
 } // namespace Luna
@@ -18,7 +18,18 @@ namespace Luna {
 
     const std::vector<float>& getSamples() const { return mSamples; }
 
+    std::vector<float>& getSamples() { return mSamples; }
+
+    /**
+     * @brief Get the number of frames per second the samples were recorded
+     * with.
+     */
+    int getFrameRate() const { return mFrameRate; }
+
+    void setFrameRate(int frameRate) { mFrameRate = frameRate; }
+
     private:
     std::vector<float> mSamples;
+    int mFrameRate{48000};
   };
 }
@@ -1,23 +1,38 @@
+#include <algorithm>
+
+#include <libluna/Audio/Dsp.hpp>
 #include <libluna/SoundBufferSource.hpp>
 
 namespace Luna {
   SoundBufferSource::SoundBufferSource(SoundBuffer* buffer, bool loop) : mBuffer(buffer), mLoop(loop) {}
 
+  SoundBuffer* SoundBufferSource::getBuffer() const { return mBuffer; }
+
+  bool SoundBufferSource::isLooping() const { return mLoop; }
+
   int SoundBufferSource::write(float* buffer, int frames) {
     int framesWritten = 0;
-    auto samples = mBuffer->getSamples();
+    const auto& samples = mBuffer->getSamples();
     auto sampleCount = samples.size();
 
-    for (int i = 0; i < frames; i++) {
-      float sample = samples[mSamplePosition];
+    if (sampleCount == 0) {
+      return 0;
+    }
+
+    while (framesWritten < frames) {
+      auto position = static_cast<std::size_t>(mSamplePosition);
+      auto count = std::min(
+        static_cast<std::size_t>(frames - framesWritten), sampleCount - position
+      );
 
-      buffer[i * 2] = sample;
-      buffer[i * 2 + 1] = sample;
-      ++framesWritten;
+      // the samples are mono, so they are written to both channels
+      const float* mono = samples.data() + position;
+      Audio::Dsp::interleave(buffer + framesWritten * 2, mono, mono, count);
 
-      ++mSamplePosition;
+      framesWritten += static_cast<int>(count);
+      mSamplePosition += static_cast<int>(count);
 
-      if (mSamplePosition >= sampleCount) {
+      if (static_cast<std::size_t>(mSamplePosition) >= sampleCount) {
         if (mLoop) {
           mSamplePosition = 0;
         } else {
@@ -10,6 +10,10 @@ namespace Luna {
 
     int write(float* buffer, int frames) override;
 
+    SoundBuffer* getBuffer() const;
+
+    bool isLooping() const;
+
     private:
     SoundBuffer* mBuffer;
     int mSamplePosition{0};
@@ -168,6 +168,15 @@ const std::list<Stage::Drawable3d>& Stage::getDrawables3d() const {
   return mDrawables3d;
 }
 
+void Stage::storePreviousPositions() {
+  for (auto&& drawable : mDrawables2d) {
+    std::visit(
+      [](Drawable2d& drawable2d) { drawable2d.storePreviousPosition(); },
+      drawable
+    );
+  }
+}
+
 void Stage::setAmbientLight(const AmbientLight& ambientLight) {
   mAmbientLight = ambientLight;
 }
@@ -87,6 +87,15 @@ namespace Luna {
     const std::forward_list<const Drawable2dVariant*> getSortedDrawables2d() const;
     const std::list<Drawable3d>& getDrawables3d() const;
 
+    /**
+     * @brief Remember the current positions of all 2D drawables.
+     *
+     * This is called at the start of every fixed tick.
+     *
+     * @see Drawable2d::storePreviousPosition()
+     */
+    void storePreviousPositions();
+
     void setAmbientLight(const AmbientLight& ambientLight);
     AmbientLight getAmbientLight() const;
 
@@ -1,4 +1,5 @@
 #include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
 
 #include <cstring> // memcpy
 #include <iostream>
@@ -109,46 +110,16 @@ Texture Texture::toRgb16() {
 }
 
 Texture Texture::crop(Vector2i size, Vector2i offset) const {
-  auto maxSize = this->getSize() - offset;
-  size = Vector2i(
-    std::min(size.width, maxSize.width), std::min(size.height, maxSize.height)
-  );
-
-  auto croppedTexture = Texture(mBitsPerPixel, size);
-  int bytesPerRowFull = this->getBytesPerRow();
-  int bytesPerRowCropped = croppedTexture.getBytesPerRow();
-  int bytesPerPixel = this->getBitsPerPixel() / 8;
-  int xOffset = offset.x * bytesPerPixel;
-
-  for (int y = 0; y < size.height; ++y) {
-    auto inputRow =
-      this->getData() + xOffset + bytesPerRowFull * (offset.y + y);
-    auto outputRow = croppedTexture.getData() + bytesPerRowCropped * y;
-    std::memcpy(outputRow, inputRow, bytesPerRowCropped);
-  }
-
-  return croppedTexture;
+  return TextureView(*this).crop(size, offset).toTexture();
 }
 
 std::vector<Texture> Texture::slice(Vector2i maxSliceSize, Vector2i& sliceCount) const {
   std::vector<Texture> slices;
+  auto views = TextureView(*this).slice(maxSliceSize, sliceCount);
+  slices.reserve(views.size());
 
-  // add 1 to round integer calculation up
-  sliceCount.x =
-    (getSize().width + maxSliceSize.width - 1) / maxSliceSize.width;
-  sliceCount.y =
-    (getSize().height + maxSliceSize.height - 1) / maxSliceSize.height;
-
-  slices.reserve(sliceCount.x * sliceCount.y);
-
-  for (int y = 0; y < getSize().height; y += maxSliceSize.height) {
-    for (int x = 0; x < getSize().width; x += maxSliceSize.width) {
-      auto sliceSize = Vector2i(
-        std::min(maxSliceSize.width, getSize().width - x),
-        std::min(maxSliceSize.height, getSize().height - y)
-      );
-      slices.push_back(crop(sliceSize, Vector2i(x, y)));
-    }
+  for (auto& view : views) {
+    slices.push_back(view.toTexture());
   }
 
   return slices;
@@ -168,9 +139,9 @@ void Texture::setNibbleAt(int x, int y, uint8_t value) {
   auto& byte = getData()[(x + y * getSize().width) / 2];
 
   if (x % 2) {
-    byte = (value & 0xf) | (byte & 0xf0);
+    byte = static_cast<uint8_t>(((value << 4) & 0xf0) | (byte & 0xf));
   } else {
-    byte = ((value << 4) & 0xf0) | (byte & 0xf);
+    byte = static_cast<uint8_t>((value & 0xf) | (byte & 0xf0));
   }
 }
 
@@ -104,6 +104,9 @@ namespace Luna {
      *
      * If the given size exceeds the texture dimensions from offset, the cropped
      * texture may be smaller than the given size.
+     *
+     * The pixels are copied. Use TextureView::crop() to refer to a region
+     * without copying.
      */
     Texture crop(Vector2i size, Vector2i offset = Vector2i(0, 0)) const;
 
@@ -111,6 +114,9 @@ namespace Luna {
      * @brief Slice a texture into smaller textures.
      *
      * The slices are from left to right, then top to bottom.
+     *
+     * The pixels are copied. Use TextureView::slice() to refer to the slices
+     * without copying.
      */
     std::vector<Texture> slice(Vector2i maxSliceSize, Vector2i& sliceCount) const;
 
@@ -47,6 +47,18 @@ int main(int, char**) {
     ASSERT_EQL(texture.getNibbleAt(1, 1), 3, "(1, 1)");
   });
 
+  TEST("setNibbleAt()", []() {
+    auto texture = Texture(4, {2, 2});
+    texture.setNibbleAt(0, 0, 4);
+    texture.setNibbleAt(1, 0, 5);
+    texture.setNibbleAt(0, 1, 6);
+    texture.setNibbleAt(1, 1, 7);
+
+    ASSERT_EQL(texture.getData()[0], 4 | (5 << 4), "byte 0");
+    ASSERT_EQL(texture.getData()[1], 6 | (7 << 4), "byte 1");
+    ASSERT_EQL(texture.getNibbleAt(1, 0), 5, "(1, 0)");
+  });
+
   TEST("pixels (8bpp indexed)", []() {
     auto texture = Texture(8, {2, 2});
     uint8_t frame[] = {0, 1, 2, 3};
@@ -0,0 +1,101 @@
+#include <libluna/TextureView.hpp>
+
+#include <algorithm>
+#include <cstring> // memcpy
+
+using namespace Luna;
+
+TextureView::TextureView() = default;
+
+TextureView::TextureView(const Texture& texture)
+    : mData{texture.getData()}, mBitsPerPixel{texture.getBitsPerPixel()},
+      mSize{texture.getSize()}, mRowLength{texture.getWidth()},
+      mPalette{texture.getPalette()}, mInterpolate{texture.isInterpolated()} {}
+
+TextureView::TextureView(
+  int bitsPerPixel, const Vector2i& size, const uint8_t* data, int rowLength
+)
+    : mData{data}, mBitsPerPixel{bitsPerPixel}, mSize{size},
+      mRowLength{rowLength > 0 ? rowLength : size.width} {}
+
+uint8_t TextureView::getNibbleAt(int x, int y) const {
+  auto nibble = static_cast<std::ptrdiff_t>(mNibbleOffset + x) +
+                static_cast<std::ptrdiff_t>(y) * mRowLength;
+  auto byte = mData[nibble / 2];
+
+  if (nibble % 2) {
+    return (byte >> 4) & 0xf;
+  } else {
+    return byte & 0xf;
+  }
+}
+
+TextureView TextureView::crop(Vector2i size, Vector2i offset) const {
+  auto maxSize = getSize() - offset;
+  TextureView view = *this;
+  view.mSize = Vector2i(
+    std::max(0, std::min(size.width, maxSize.width)),
+    std::max(0, std::min(size.height, maxSize.height))
+  );
+
+  if (mBitsPerPixel == 4) {
+    auto nibble = static_cast<std::ptrdiff_t>(mNibbleOffset + offset.x) +
+                  static_cast<std::ptrdiff_t>(offset.y) * mRowLength;
+    view.mData = mData + nibble / 2;
+    view.mNibbleOffset = static_cast<int>(nibble % 2);
+  } else {
+    view.mData = getRowData(offset.y) + offset.x * (mBitsPerPixel / 8);
+  }
+
+  return view;
+}
+
+std::vector<TextureView>
+TextureView::slice(Vector2i maxSliceSize, Vector2i& sliceCount) const {
+  std::vector<TextureView> slices;
+
+  // add 1 to round integer calculation up
+  sliceCount.x =
+    (getSize().width + maxSliceSize.width - 1) / maxSliceSize.width;
+  sliceCount.y =
+    (getSize().height + maxSliceSize.height - 1) / maxSliceSize.height;
+
+  slices.reserve(static_cast<std::size_t>(sliceCount.x * sliceCount.y));
+
+  for (int y = 0; y < getSize().height; y += maxSliceSize.height) {
+    for (int x = 0; x < getSize().width; x += maxSliceSize.width) {
+      slices.push_back(crop(maxSliceSize, Vector2i(x, y)));
+    }
+  }
+
+  return slices;
+}
+
+Texture TextureView::toTexture() const {
+  Texture texture(mBitsPerPixel, mSize);
+  texture.setPalette(mPalette);
+  texture.setInterpolation(mInterpolate);
+
+  if (isContiguous()) {
+    std::memcpy(
+      texture.getData(), mData, static_cast<std::size_t>(texture.getByteCount())
+    );
+  } else if (mBitsPerPixel == 4) {
+    for (int y = 0; y < mSize.height; ++y) {
+      for (int x = 0; x < mSize.width; ++x) {
+        texture.setNibbleAt(x, y, getNibbleAt(x, y));
+      }
+    }
+  } else {
+    auto bytesPerRow = static_cast<std::size_t>(getBytesPerRow());
+
+    for (int y = 0; y < mSize.height; ++y) {
+      std::memcpy(
+        texture.getData() + bytesPerRow * static_cast<std::size_t>(y),
+        getRowData(y), bytesPerRow
+      );
+    }
+  }
+
+  return texture;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <vector>
+
+#include <libluna/Texture.hpp>
+
+namespace Luna {
+  /**
+   * @brief Non-owning view of a 2D pixel bitmap or a region of it.
+   *
+   * A view is defined by a pointer to its first pixel, its size, its number of
+   * bits per pixel and the row length of the underlying bitmap (the number of
+   * pixels from the start of one row to the start of the next one). Cropping
+   * and slicing a view produces new views into the same memory, so sub-images
+   * cost neither memory nor copies.
+   *
+   * The underlying pixel data must outlive the view. Use @ref toTexture() to
+   * get a contiguous copy.
+   *
+   * For 4 bpp images, the pixels are packed like in Texture, that is two
+   * pixels per byte continuing across rows, with even pixels stored in the
+   * low nibble.
+   */
+  class TextureView {
+    public:
+    /**
+     * @brief Create an empty view.
+     */
+    TextureView();
+
+    /**
+     * @brief Create a view of the whole texture.
+     */
+    TextureView(const Texture& texture);
+
+    /**
+     * @brief Create a view of raw pixel data.
+     *
+     * @param rowLength Number of pixels per row in the underlying data. If 0,
+     * the rows are assumed to be tightly packed.
+     */
+    TextureView(
+      int bitsPerPixel, const Vector2i& size, const uint8_t* data,
+      int rowLength = 0
+    );
+
+    inline int getBitsPerPixel() const { return mBitsPerPixel; }
+
+    inline Vector2i getSize() const { return mSize; }
+
+    inline int getWidth() const { return mSize.width; }
+
+    inline int getHeight() const { return mSize.height; }
+
+    inline bool isEmpty() const { return mSize.width == 0 || mSize.height == 0; }
+
+    inline void setPalette(PalettePtr palette) { mPalette = palette; }
+
+    inline PalettePtr getPalette() const { return mPalette; }
+
+    inline void setInterpolation(bool enabled) { mInterpolate = enabled; }
+
+    inline bool isInterpolated() const { return mInterpolate; }
+
+    /**
+     * @brief Get a pointer to the first pixel.
+     *
+     * For 4 bpp views starting at an odd pixel, this points to the byte whose
+     * high nibble is the first pixel.
+     */
+    inline const uint8_t* getData() const { return mData; }
+
+    /**
+     * @brief Get the number of pixels from one row to the next one in the
+     * underlying data.
+     */
+    inline int getRowLength() const { return mRowLength; }
+
+    /**
+     * @brief Get the number of bytes from one row to the next one in the
+     * underlying data.
+     *
+     * Only meaningful for 8 bpp and above.
+     */
+    inline int getStride() const { return mRowLength * (mBitsPerPixel / 4) / 2; }
+
+    /**
+     * @brief Get the number of bytes the viewed pixels take up when packed.
+     */
+    inline int getByteCount() const {
+      return mSize.width * mSize.height * (mBitsPerPixel / 4) / 2;
+    }
+
+    /**
+     * @brief Get the number of bytes of a single row of the view.
+     */
+    inline int getBytesPerRow() const {
+      return mSize.width * (mBitsPerPixel / 4) / 2;
+    }
+
+    /**
+     * @brief Check if the view covers whole rows of the underlying data.
+     *
+     * Contiguous views can be passed to APIs that don't support strides.
+     */
+    inline bool isContiguous() const {
+      return mRowLength == mSize.width && mNibbleOffset == 0;
+    }
+
+    /**
+     * @brief Get a pointer to the first pixel of the given row.
+     *
+     * Only meaningful for 8 bpp and above.
+     */
+    inline const uint8_t* getRowData(int y) const {
+      return mData + static_cast<std::ptrdiff_t>(y) * getStride();
+    }
+
+    uint8_t getNibbleAt(int x, int y) const;
+
+    inline uint8_t getByteAt(int x, int y) const { return getRowData(y)[x]; }
+
+    inline const ColorRgb16& rgb16At(int x, int y) const {
+      return reinterpret_cast<const ColorRgb16*>(getRowData(y))[x];
+    }
+
+    inline const ColorRgb24& rgb24At(int x, int y) const {
+      return reinterpret_cast<const ColorRgb24*>(getRowData(y))[x];
+    }
+
+    inline const ColorRgb32& rgb32At(int x, int y) const {
+      return reinterpret_cast<const ColorRgb32*>(getRowData(y))[x];
+    }
+
+    /**
+     * @brief Get a view of a rectangular region of this view.
+     *
+     * If the given size exceeds the view dimensions from offset, the cropped
+     * view may be smaller than the given size.
+     */
+    TextureView crop(Vector2i size, Vector2i offset = Vector2i(0, 0)) const;
+
+    /**
+     * @brief Slice the view into smaller views.
+     *
+     * The slices are from left to right, then top to bottom.
+     */
+    std::vector<TextureView>
+    slice(Vector2i maxSliceSize, Vector2i& sliceCount) const;
+
+    /**
+     * @brief Copy the viewed pixels into a new, contiguous texture.
+     */
+    Texture toTexture() const;
+
+    private:
+    const uint8_t* mData{nullptr};
+    int mBitsPerPixel{0};
+    Vector2i mSize;
+    int mRowLength{0};
+    int mNibbleOffset{0}; ///< 1 if a 4 bpp view starts in a high nibble.
+    PalettePtr mPalette;
+    bool mInterpolate{false};
+  };
+} // namespace Luna
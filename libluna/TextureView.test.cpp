@@ -0,0 +1,89 @@
+#include <libluna/Texture.hpp>
+#include <libluna/TextureView.hpp>
+#include <libluna/Test.hpp>
+
+using namespace std;
+using namespace Luna;
+
+int main(int, char**) {
+  TEST("view of whole texture", []() {
+    auto texture = Texture(32, {4, 3});
+    auto view = TextureView(texture);
+
+    ASSERT(view.getData() == texture.getData(), "same data");
+    ASSERT_EQL(view.getWidth(), 4, "width");
+    ASSERT_EQL(view.getHeight(), 3, "height");
+    ASSERT_EQL(view.getStride(), 16, "stride");
+    ASSERT(view.isContiguous(), "contiguous");
+  });
+
+  TEST("crop() does not copy", []() {
+    auto texture = Texture(8, {8, 4});
+
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 8; ++x) {
+        texture.byteAt(x, y) = static_cast<uint8_t>(y * 8 + x);
+      }
+    }
+
+    auto view = TextureView(texture).crop({3, 2}, {2, 1});
+
+    ASSERT(view.getData() == &texture.byteAt(2, 1), "points into texture");
+    ASSERT_EQL(view.getWidth(), 3, "width");
+    ASSERT_EQL(view.getHeight(), 2, "height");
+    ASSERT_EQL(view.getRowLength(), 8, "row length");
+    ASSERT(!view.isContiguous(), "not contiguous");
+    ASSERT_EQL(view.getByteAt(0, 0), 10, "first pixel");
+    ASSERT_EQL(view.getByteAt(2, 1), 20, "last pixel");
+
+    auto nested = view.crop({10, 10}, {1, 1});
+    ASSERT_EQL(nested.getWidth(), 2, "clamped width");
+    ASSERT_EQL(nested.getHeight(), 1, "clamped height");
+    ASSERT_EQL(nested.getByteAt(0, 0), 19, "nested pixel");
+  });
+
+  TEST("crop() at odd 4 bpp offset", []() {
+    auto texture = Texture(4, {4, 2});
+
+    for (int y = 0; y < 2; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        texture.setNibbleAt(x, y, static_cast<uint8_t>(y * 4 + x));
+      }
+    }
+
+    auto view = TextureView(texture).crop({2, 2}, {1, 0});
+    ASSERT_EQL(view.getNibbleAt(0, 0), 1, "pixel (0, 0)");
+    ASSERT_EQL(view.getNibbleAt(1, 0), 2, "pixel (1, 0)");
+    ASSERT_EQL(view.getNibbleAt(0, 1), 5, "pixel (0, 1)");
+
+    auto copy = view.toTexture();
+    ASSERT_EQL(copy.getNibbleAt(1, 1), 6, "copied pixel (1, 1)");
+  });
+
+  TEST("slice() and toTexture()", []() {
+    auto texture = Texture(24, {5, 3});
+
+    for (int y = 0; y < 3; ++y) {
+      for (int x = 0; x < 5; ++x) {
+        texture.rgb24At(x, y) = ColorRgb24{
+          static_cast<uint8_t>(x), static_cast<uint8_t>(y), 0};
+      }
+    }
+
+    Vector2i sliceCount;
+    auto slices = TextureView(texture).slice({2, 2}, sliceCount);
+
+    ASSERT_EQL(sliceCount.x, 3, "horizontal slices");
+    ASSERT_EQL(sliceCount.y, 2, "vertical slices");
+    ASSERT_EQL(static_cast<int>(slices.size()), 6, "slice count");
+    ASSERT_EQL(slices[2].getWidth(), 1, "last column width");
+    ASSERT_EQL(slices[5].getHeight(), 1, "last row height");
+
+    auto copy = slices[4].toTexture();
+    ASSERT_EQL(copy.getWidth(), 2, "copy width");
+    ASSERT_EQL(copy.rgb24At(1, 0).red, 3, "copy red");
+    ASSERT_EQL(copy.rgb24At(1, 0).green, 2, "copy green");
+  });
+
+  return runTests();
+}
@@ -0,0 +1,104 @@
+/**
+ * lunapack: pack the files of a directory into an asset pack.
+ *
+ * Usage: lunapack [--compress] <input directory> <output file>
+ *
+ * Entry names are the paths relative to the input directory, using slashes.
+ * With --compress, files are compressed unless they don't get smaller.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <libluna/PackFormat.hpp>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv) {
+  auto compression = Luna::Pack::kUncompressed;
+  int argIndex = 1;
+
+  if (argc == 4 && std::strcmp(argv[1], "--compress") == 0) {
+    compression = Luna::Pack::kLz;
+    ++argIndex;
+  }
+
+  if (argc - argIndex != 2) {
+    std::fprintf(
+      stderr, "usage: %s [--compress] <input directory> <output file>\n",
+      argv[0]
+    );
+    return 1;
+  }
+
+  const char* inputArg = argv[argIndex];
+  const char* outputArg = argv[argIndex + 1];
+  fs::path inputPath(inputArg);
+  fs::path outputPath(outputArg);
+  std::error_code error;
+
+  if (!fs::is_directory(inputPath, error)) {
+    std::fprintf(stderr, "%s is not a directory\n", inputArg);
+    return 1;
+  }
+
+  std::vector<fs::path> files;
+
+  for (auto& entry : fs::recursive_directory_iterator(inputPath)) {
+    if (entry.is_regular_file()) {
+      files.push_back(entry.path());
+    }
+  }
+
+  // sorted for reproducible packs
+  std::sort(files.begin(), files.end());
+
+  Luna::Pack::Builder builder;
+
+  for (auto& file : files) {
+    std::ifstream input(file, std::ios::binary);
+
+    if (!input) {
+      std::fprintf(stderr, "unable to read %s\n", file.string().c_str());
+      return 1;
+    }
+
+    std::vector<uint8_t> data(
+      (std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>()
+    );
+
+    auto name = fs::relative(file, inputPath).generic_string();
+
+    if (name.size() > 0xffff) {
+      std::fprintf(stderr, "name of %s is too long\n", name.c_str());
+      return 1;
+    }
+
+    builder.add(name, std::move(data), compression);
+  }
+
+  auto pack = builder.build();
+  std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+  output.write(
+    reinterpret_cast<const char*>(pack.data()),
+    static_cast<std::streamsize>(pack.size())
+  );
+
+  if (!output) {
+    std::fprintf(stderr, "unable to write %s\n", outputArg);
+    return 1;
+  }
+
+  std::printf(
+    "packed %zu files into %s (%zu bytes)\n", builder.getFileCount(), outputArg,
+    pack.size()
+  );
+
+  return 0;
+}